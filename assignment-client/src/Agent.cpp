@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
+#include <QtCore/QJsonObject>
 #include <QtCore/QStandardPaths>
 #include <QtNetwork/QNetworkDiskCache>
 #include <QtNetwork/QNetworkRequest>
@@ -35,6 +36,8 @@
 #include <ResourceScriptingInterface.h>
 #include <ScriptCache.h>
 #include <ScriptEngines.h>
+#include <ScriptProfiler.h>
+#include <ScriptProfilerScriptingInterface.h>
 #include <SoundCacheScriptingInterface.h>
 #include <SoundCache.h>
 #include <UserActivityLoggerScriptingInterface.h>
@@ -112,6 +115,7 @@ Agent::Agent(ReceivedMessage& message) :
         { PacketType::OctreeStats, PacketType::EntityData, PacketType::EntityErase },
         this, "handleOctreePacket");
     packetReceiver.registerListener(PacketType::SelectedAudioFormat, this, "handleSelectedAudioFormat");
+    packetReceiver.registerListener(PacketType::AvatarJointResyncRequest, this, "handleAvatarJointResyncRequest");
 
     // 100Hz timer for audio
     const int TARGET_INTERVAL_MSEC = 10; // 10ms
@@ -302,6 +306,11 @@ void Agent::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
     selectAudioFormat(selectedCodecName);
 }
 
+void Agent::handleAvatarJointResyncRequest(QSharedPointer<ReceivedMessage> message) {
+    // the avatar mixer missed a frame of our joints
+    DependencyManager::get<ScriptableAvatar>()->requestJointKeyFrame();
+}
+
 void Agent::selectAudioFormat(const QString& selectedCodecName) {
     if (_selectedCodecName == selectedCodecName) {
         return;
@@ -482,6 +491,7 @@ void Agent::executeScript() {
 
         _scriptEngine->registerGlobalObject("AnimationCache", DependencyManager::get<AnimationCacheScriptingInterface>().data());
         _scriptEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
+        _scriptEngine->registerGlobalObject("ScriptProfiler", new ScriptProfilerScriptingInterface(_scriptEngine.data()));
 
         QScriptValue webSocketServerConstructorValue = _scriptEngine->newFunction(WebSocketServerClass::constructor);
         _scriptEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
@@ -751,8 +761,38 @@ void Agent::processAgentAvatarAudio() {
 
         int16_t numAvailableSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
         const int16_t* nextSoundOutput = NULL;
+        int16_t streamedSoundOutput[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+
+        if (_avatarSound && _avatarSound->isStreaming()) {
+            if (!_avatarSoundStream) {
+                _avatarSoundStream = std::make_shared<SoundStream>(_avatarSound->getStreamSource(), false);
+                _avatarSoundStream->start();
+            }
+
+            uint64_t numUnderrunSamples = _avatarSoundStream->getNumUnderrunSamples();
+            numAvailableSamples = _avatarSoundStream->read(streamedSoundOutput, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            _numAvatarSoundUnderrunSamples += _avatarSoundStream->getNumUnderrunSamples() - numUnderrunSamples;
+            if (!_avatarSoundStream->isFinished()) {
+                // the decoder fell behind, keep up the timing with silence
+                memset(streamedSoundOutput + numAvailableSamples, 0,
+                       (AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL - numAvailableSamples) * sizeof(int16_t));
+                numAvailableSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+            }
+            nextSoundOutput = streamedSoundOutput;
+
+            for (int i = 0; i < numAvailableSamples; ++i) {
+                if (nextSoundOutput[i] != 0) {
+                    silentFrame = false;
+                    break;
+                }
+            }
 
-        if (_avatarSound) {
+            if (_avatarSoundStream->isFinished()) {
+                _avatarSound.clear();
+                _avatarSoundStream.reset();
+                _flushEncoder = true;
+            }
+        } else if (_avatarSound) {
             const QByteArray& soundByteArray = _avatarSound->getByteArray();
             nextSoundOutput = reinterpret_cast<const int16_t*>(soundByteArray.data()
                     + _numAvatarSoundSentBytes);
@@ -863,6 +903,47 @@ void Agent::processAgentAvatarAudio() {
     }
 }
 
+void Agent::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    auto injectorManager = DependencyManager::get<AudioInjectorManager>();
+    if (injectorManager) {
+        auto injectorStats = injectorManager->getAndResetStats();
+
+        QJsonObject injectorsObject;
+        injectorsObject["injectors"] = injectorStats.numInjectors;
+        injectorsObject["ticks"] = (qint64)injectorStats.numTicks;
+        injectorsObject["frames_sent"] = (qint64)injectorStats.numFramesSent;
+        injectorsObject["late_frames"] = (qint64)injectorStats.numLateFrames;
+        injectorsObject["underrun_samples"] = (qint64)injectorStats.numUnderrunSamples;
+        statsObject["audio_injectors"] = injectorsObject;
+    }
+
+    QJsonObject avatarSoundObject;
+    avatarSoundObject["underrun_samples"] = (qint64)_numAvatarSoundUnderrunSamples;
+    statsObject["avatar_sound"] = avatarSoundObject;
+    _numAvatarSoundUnderrunSamples = 0;
+
+    if (_scriptEngine) {
+        auto timerStats = _scriptEngine->getAndResetTimerStats();
+        int numTimersFired = timerStats["fired"].toInt();
+
+        QJsonObject timersObject;
+        timersObject["timers"] = timerStats["timers"];
+        timersObject["fired"] = numTimersFired;
+        timersObject["avg_lag_msecs"] = numTimersFired > 0 ? timerStats["total_lag_msecs"].toDouble() / numTimersFired : 0.0;
+        timersObject["max_lag_msecs"] = timerStats["max_lag_msecs"];
+        statsObject["script_timers"] = timersObject;
+    }
+
+    auto& profiler = ScriptProfiler::getInstance();
+    if (profiler.isEnabled()) {
+        statsObject["script_profiler"] = profiler.getSummary(true);
+    }
+
+    addPacketStatsAndSendStatsPacket(statsObject);
+}
+
 void Agent::aboutToFinish() {
     setIsAvatar(false);// will stop timers for sending identity packets
 
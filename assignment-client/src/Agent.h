@@ -70,6 +70,8 @@ public slots:
 
     Q_INVOKABLE virtual void stop() override;
 
+    void sendStatsPacket() override;
+
 private slots:
     void requestScript();
     void scriptRequestFinished();
@@ -78,6 +80,7 @@ private slots:
     void handleAudioPacket(QSharedPointer<ReceivedMessage> message);
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
+    void handleAvatarJointResyncRequest(QSharedPointer<ReceivedMessage> message);
 
     void nodeActivated(SharedNodePointer activatedNode);
     void nodeKilled(SharedNodePointer killedNode);
@@ -98,7 +101,7 @@ private:
     MixedAudioStream _receivedAudioStream;
     float _lastReceivedAudioLoudness;
 
-    void setAvatarSound(SharedSoundPointer avatarSound) { _avatarSound = avatarSound; }
+    void setAvatarSound(SharedSoundPointer avatarSound) { _avatarSound = avatarSound; _avatarSoundStream.reset(); }
 
     void sendAvatarIdentityPacket();
     void queryAvatars();
@@ -108,6 +111,8 @@ private:
     ResourceRequest* _pendingScriptRequest { nullptr };
     bool _isListeningToAudioStream = false;
     SharedSoundPointer _avatarSound;
+    SoundStreamPointer _avatarSoundStream; // for long avatar sounds, which are decoded as they are sent
+    uint64_t _numAvatarSoundUnderrunSamples { 0 }; // since the last stats packet
     int _numAvatarSoundSentBytes = 0;
     bool _isAvatar = false;
     QTimer* _avatarIdentityTimer = nullptr;
@@ -0,0 +1,122 @@
+//
+//  AssetFileCache.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetFileCache.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+
+const qint64 AssetFileCache::DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+QByteArray AssetFileCache::getOrLoad(const QString& hash, const QString& filePath) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, it->lruPosition);
+        _hits++;
+        return it->data;
+    }
+    locker.unlock();
+
+    QFileInfo fileInfo { filePath };
+    if (!fileInfo.exists() || fileInfo.size() == 0) {
+        return QByteArray();
+    }
+    if (fileInfo.size() > getMaxCachedFileSize()) {
+        _uncacheable++;
+        return QByteArray();
+    }
+
+    locker.relock();
+
+    // another thread may be reading this file already, in which case wait for it instead of reading it again
+    while (_loading.contains(hash)) {
+        _loadFinished.wait(&_mutex);
+    }
+    it = _entries.find(hash);
+    if (it != _entries.end()) {
+        _lru.splice(_lru.begin(), _lru, it->lruPosition);
+        _hits++;
+        return it->data;
+    }
+    _loading.insert(hash);
+    locker.unlock();
+
+    _misses++;
+
+    QByteArray data;
+    QFile file { filePath };
+    if (file.open(QIODevice::ReadOnly)) {
+        data = file.readAll();
+    }
+
+    locker.relock();
+    _loading.remove(hash);
+    if (_removedWhileLoading.remove(hash)) {
+        // the file was deleted while we were reading it, don't keep it around
+        data = QByteArray();
+    } else if (!data.isEmpty()) {
+        insertLocked(hash, data);
+    }
+    _loadFinished.wakeAll();
+
+    return data;
+}
+
+void AssetFileCache::remove(const QString& hash) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _entries.find(hash);
+    if (it != _entries.end()) {
+        _size -= it->data.size();
+        _lru.erase(it->lruPosition);
+        _entries.erase(it);
+    }
+    if (_loading.contains(hash)) {
+        _removedWhileLoading.insert(hash);
+    }
+}
+
+void AssetFileCache::setMaxSize(qint64 maxSize) {
+    QMutexLocker locker(&_mutex);
+    _maxSize = maxSize;
+    evictLocked(_maxSize);
+}
+
+qint64 AssetFileCache::getSize() const {
+    QMutexLocker locker(&_mutex);
+    return _size;
+}
+
+int AssetFileCache::getNumEntries() const {
+    QMutexLocker locker(&_mutex);
+    return _entries.size();
+}
+
+void AssetFileCache::insertLocked(const QString& hash, const QByteArray& data) {
+    if (data.size() > getMaxCachedFileSize()) {
+        return;
+    }
+    evictLocked(_maxSize - data.size());
+
+    _lru.push_front(hash);
+    _entries.insert(hash, { data, _lru.begin() });
+    _size += data.size();
+}
+
+void AssetFileCache::evictLocked(qint64 maxSize) {
+    while (_size > maxSize && !_lru.empty()) {
+        auto it = _entries.find(_lru.back());
+        _size -= it->data.size();
+        _entries.erase(it);
+        _lru.pop_back();
+    }
+}
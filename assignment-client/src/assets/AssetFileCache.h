@@ -0,0 +1,84 @@
+//
+//  AssetFileCache.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetFileCache_h
+#define hifi_AssetFileCache_h
+
+#include <atomic>
+#include <list>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QWaitCondition>
+
+// AssetFileCache keeps the contents of recently requested asset files in memory, keyed by their hash, so that many
+// clients fetching the same assets at once are served from one copy instead of each re-reading the file from disk.
+//
+// Asset files are content addressed and never change, so entries only leave the cache when they are evicted to stay
+// under the size limit or when the asset file is deleted.
+class AssetFileCache {
+public:
+    static const qint64 DEFAULT_MAX_SIZE;
+
+    AssetFileCache(qint64 maxSize = DEFAULT_MAX_SIZE) : _maxSize(maxSize) {}
+
+    /// Returns the contents of the asset file, from the cache if it is there, and otherwise from disk (adding it to
+    /// the cache). Returns a null QByteArray if the file doesn't exist, is empty, or is too large to be cached.
+    /// If several threads miss on the same hash at once, only one of them reads the file.
+    QByteArray getOrLoad(const QString& hash, const QString& filePath);
+
+    void remove(const QString& hash);
+
+    void setMaxSize(qint64 maxSize);
+    qint64 getMaxSize() const { return _maxSize; }
+
+    /// Files larger than this are never cached, so one large asset can't evict everything else
+    qint64 getMaxCachedFileSize() const { return _maxSize / 4; }
+
+    void addBytesServed(qint64 bytes) { _bytesServed += bytes; }
+
+    /// Requests for files that exist are counted once each: as hits when they are served from memory, including after
+    /// waiting for another thread to read the file, as misses when they read it from disk, and as uncacheable when the
+    /// file is too large to be cached.
+    uint64_t getHits() const { return _hits; }
+    uint64_t getMisses() const { return _misses; }
+    uint64_t getUncacheable() const { return _uncacheable; }
+    uint64_t getBytesServed() const { return _bytesServed; }
+    qint64 getSize() const;
+    int getNumEntries() const;
+
+private:
+    struct Entry {
+        QByteArray data;
+        std::list<QString>::iterator lruPosition;
+    };
+
+    void insertLocked(const QString& hash, const QByteArray& data);
+    void evictLocked(qint64 maxSize);
+
+    mutable QMutex _mutex;
+    QWaitCondition _loadFinished;
+    QHash<QString, Entry> _entries;
+    std::list<QString> _lru; // most recently used at the front
+    QSet<QString> _loading;
+    QSet<QString> _removedWhileLoading;
+    qint64 _size { 0 };
+    qint64 _maxSize;
+
+    std::atomic<uint64_t> _hits { 0 };
+    std::atomic<uint64_t> _misses { 0 };
+    std::atomic<uint64_t> _uncacheable { 0 };
+    std::atomic<uint64_t> _bytesServed { 0 };
+};
+
+#endif // hifi_AssetFileCache_h
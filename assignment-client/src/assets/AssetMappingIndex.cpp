@@ -0,0 +1,285 @@
+//
+//  AssetMappingIndex.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMappingIndex.h"
+
+// "/a/b.fbx" => ("a", "b.fbx"), "/a/b/" => ("a", "b"), "/" => ()
+static QStringList pathSegments(const AssetUtils::AssetPath& path) {
+    QStringList segments = path.split('/');
+    if (!segments.isEmpty() && segments.first().isEmpty()) {
+        segments.removeFirst();
+    }
+    if (!segments.isEmpty() && segments.last().isEmpty()) {
+        segments.removeLast();
+    }
+    return segments;
+}
+
+void AssetMappingIndex::clear() {
+    _root.hash.clear();
+    _root.children.clear();
+    _root.count = 0;
+    _hashReferences.clear();
+}
+
+AssetUtils::AssetHash AssetMappingIndex::value(const AssetUtils::AssetPath& path) const {
+    const Node* node = &_root;
+    for (const auto& segment : pathSegments(path)) {
+        auto it = node->children.find(segment);
+        if (it == node->children.end()) {
+            return AssetUtils::AssetHash();
+        }
+        node = it->second.get();
+    }
+    return node->hash;
+}
+
+AssetUtils::AssetHash AssetMappingIndex::insert(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
+    auto nodes = findOrCreatePath(pathSegments(path));
+    Node* node = nodes.back();
+
+    auto replacedHash = node->hash;
+    if (replacedHash.isEmpty()) {
+        for (auto pathNode : nodes) {
+            ++pathNode->count;
+        }
+    } else {
+        removeReference(replacedHash);
+    }
+
+    node->hash = hash;
+    addReference(hash);
+
+    return replacedHash;
+}
+
+AssetUtils::AssetHash AssetMappingIndex::remove(const AssetUtils::AssetPath& path) {
+    auto segments = pathSegments(path);
+    auto nodes = findPath(segments);
+    if (nodes.size() != (size_t)segments.size() + 1 || nodes.back()->hash.isEmpty()) {
+        return AssetUtils::AssetHash();
+    }
+
+    Node* node = nodes.back();
+    auto removedHash = node->hash;
+    node->hash.clear();
+    for (auto pathNode : nodes) {
+        --pathNode->count;
+    }
+    removeReference(removedHash);
+
+    prune(nodes, segments);
+
+    return removedHash;
+}
+
+AssetUtils::Mappings AssetMappingIndex::removeFolder(const AssetUtils::AssetPath& folder) {
+    AssetUtils::Mappings removedMappings;
+
+    auto segments = pathSegments(folder);
+    auto nodes = findPath(segments);
+    if (nodes.size() != (size_t)segments.size() + 1) {
+        return removedMappings;
+    }
+
+    Node* folderNode = nodes.back();
+    for (const auto& child : folderNode->children) {
+        collect(*child.second, folder + child.first, removedMappings);
+    }
+    folderNode->children.clear();
+
+    for (auto pathNode : nodes) {
+        pathNode->count -= removedMappings.size();
+    }
+    for (const auto& mapping : removedMappings) {
+        removeReference(mapping.second);
+    }
+
+    prune(nodes, segments);
+
+    return removedMappings;
+}
+
+size_t AssetMappingIndex::renameFolder(const AssetUtils::AssetPath& oldFolder, const AssetUtils::AssetPath& newFolder) {
+    auto oldSegments = pathSegments(oldFolder);
+    auto oldNodes = findPath(oldSegments);
+    if (oldNodes.size() != (size_t)oldSegments.size() + 1) {
+        return 0;
+    }
+
+    // detach everything below the old folder, the hash references don't change since the mappings only move
+    Node movedNode;
+    Node* oldFolderNode = oldNodes.back();
+    movedNode.children = std::move(oldFolderNode->children);
+    oldFolderNode->children.clear();
+    movedNode.count = oldFolderNode->count - (oldFolderNode->hash.isEmpty() ? 0 : 1);
+
+    for (auto pathNode : oldNodes) {
+        pathNode->count -= movedNode.count;
+    }
+    prune(oldNodes, oldSegments);
+
+    size_t numMoved = movedNode.count;
+    if (numMoved == 0) {
+        return 0;
+    }
+
+    // and attach it below the new one, which is usually a move of the whole subtree
+    auto newNodes = findOrCreatePath(pathSegments(newFolder));
+    size_t numAdded = merge(*newNodes.back(), movedNode);
+    for (size_t i = 0; i + 1 < newNodes.size(); ++i) {
+        newNodes[i]->count += numAdded;
+    }
+
+    return numMoved;
+}
+
+QStringList AssetMappingIndex::subfolders(const AssetUtils::AssetPath& folder) const {
+    QStringList names;
+
+    auto segments = pathSegments(folder);
+    auto nodes = findPath(segments);
+    if (nodes.size() == (size_t)segments.size() + 1) {
+        for (const auto& child : nodes.back()->children) {
+            if (!child.second->children.empty()) {
+                names << child.first;
+            }
+        }
+    }
+
+    return names;
+}
+
+void AssetMappingIndex::forEachInRange(size_t offset, size_t count, const Visitor& visitor) const {
+    if (offset >= size() || count == 0) {
+        return;
+    }
+
+    size_t skip = offset;
+    size_t remaining = count;
+    visitRange(_root, QString(), skip, remaining, visitor);
+}
+
+std::vector<AssetMappingIndex::Node*> AssetMappingIndex::findPath(const QStringList& segments) const {
+    std::vector<Node*> nodes;
+    nodes.reserve(segments.size() + 1);
+
+    Node* node = const_cast<Node*>(&_root);
+    nodes.push_back(node);
+    for (const auto& segment : segments) {
+        auto it = node->children.find(segment);
+        if (it == node->children.end()) {
+            break;
+        }
+        node = it->second.get();
+        nodes.push_back(node);
+    }
+
+    return nodes;
+}
+
+std::vector<AssetMappingIndex::Node*> AssetMappingIndex::findOrCreatePath(const QStringList& segments) {
+    std::vector<Node*> nodes;
+    nodes.reserve(segments.size() + 1);
+
+    Node* node = &_root;
+    nodes.push_back(node);
+    for (const auto& segment : segments) {
+        auto& child = node->children[segment];
+        if (!child) {
+            child.reset(new Node());
+        }
+        node = child.get();
+        nodes.push_back(node);
+    }
+
+    return nodes;
+}
+
+void AssetMappingIndex::prune(std::vector<Node*>& nodes, const QStringList& segments) {
+    for (size_t i = nodes.size() - 1; i > 0; --i) {
+        if (nodes[i]->count > 0) {
+            break;
+        }
+        nodes[i - 1]->children.erase(segments[(int)i - 1]);
+    }
+}
+
+size_t AssetMappingIndex::merge(Node& destination, Node& source) {
+    size_t numAdded = 0;
+
+    if (!source.hash.isEmpty()) {
+        if (destination.hash.isEmpty()) {
+            ++numAdded;
+        } else {
+            removeReference(destination.hash);
+        }
+        destination.hash = source.hash;
+    }
+
+    for (auto& sourceChild : source.children) {
+        auto& destinationChild = destination.children[sourceChild.first];
+        if (!destinationChild) {
+            numAdded += sourceChild.second->count;
+            destinationChild = std::move(sourceChild.second);
+        } else {
+            numAdded += merge(*destinationChild, *sourceChild.second);
+        }
+    }
+
+    destination.count += numAdded;
+    return numAdded;
+}
+
+void AssetMappingIndex::collect(const Node& node, const QString& path, AssetUtils::Mappings& mappings) const {
+    if (!node.hash.isEmpty()) {
+        mappings[path] = node.hash;
+    }
+    for (const auto& child : node.children) {
+        collect(*child.second, path + "/" + child.first, mappings);
+    }
+}
+
+void AssetMappingIndex::visitRange(const Node& node, const QString& path, size_t& skip, size_t& remaining,
+                                   const Visitor& visitor) const {
+    if (!node.hash.isEmpty()) {
+        if (skip > 0) {
+            --skip;
+        } else {
+            visitor(path, node.hash);
+            --remaining;
+        }
+    }
+
+    for (const auto& child : node.children) {
+        if (remaining == 0) {
+            return;
+        }
+
+        // skip whole subtrees that end before the range starts
+        if (skip >= child.second->count) {
+            skip -= child.second->count;
+            continue;
+        }
+
+        visitRange(*child.second, path + "/" + child.first, skip, remaining, visitor);
+    }
+}
+
+void AssetMappingIndex::addReference(const AssetUtils::AssetHash& hash) {
+    ++_hashReferences[hash];
+}
+
+void AssetMappingIndex::removeReference(const AssetUtils::AssetHash& hash) {
+    auto it = _hashReferences.find(hash);
+    if (it != _hashReferences.end() && --it.value() == 0) {
+        _hashReferences.erase(it);
+    }
+}
@@ -0,0 +1,92 @@
+//
+//  AssetMappingIndex.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMappingIndex_h
+#define hifi_AssetMappingIndex_h
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+
+#include "AssetUtils.h"
+
+// AssetMappingIndex holds the asset server's path => hash mappings in a tree with one node per path segment, so that
+// folder deletes and renames only touch the folder being changed instead of scanning every mapping. Each node keeps
+// the number of mappings below it, which lets a page of the mappings be found without walking the pages before it,
+// and the number of paths mapped to each hash is counted so that unmapped asset files can be found without a scan.
+//
+// Folders are paths ending in a '/', and mappings are visited in the order of their path segments.
+class AssetMappingIndex {
+public:
+    using Visitor = std::function<void(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash)>;
+
+    size_t size() const { return _root.count; }
+    bool isEmpty() const { return _root.count == 0; }
+    void clear();
+
+    /// Returns the hash mapped to path, or an empty hash if there is no such mapping
+    AssetUtils::AssetHash value(const AssetUtils::AssetPath& path) const;
+    bool contains(const AssetUtils::AssetPath& path) const { return !value(path).isEmpty(); }
+
+    /// Returns true if at least one path is mapped to hash
+    bool isMapped(const AssetUtils::AssetHash& hash) const { return _hashReferences.contains(hash); }
+
+    /// Maps path to hash, returns the hash it replaced (empty if the path was not mapped)
+    AssetUtils::AssetHash insert(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
+
+    /// Removes the mapping for path, returns its hash (empty if the path was not mapped)
+    AssetUtils::AssetHash remove(const AssetUtils::AssetPath& path);
+
+    /// Removes every mapping below folder, returns the removed mappings
+    AssetUtils::Mappings removeFolder(const AssetUtils::AssetPath& folder);
+
+    /// Moves every mapping below oldFolder to the same place below newFolder, replacing mappings already there.
+    /// Returns the number of mappings moved.
+    size_t renameFolder(const AssetUtils::AssetPath& oldFolder, const AssetUtils::AssetPath& newFolder);
+
+    /// The names of the folders directly below folder
+    QStringList subfolders(const AssetUtils::AssetPath& folder) const;
+
+    void forEach(const Visitor& visitor) const { forEachInRange(0, size(), visitor); }
+
+    /// Visits up to count mappings, starting with the one at position offset
+    void forEachInRange(size_t offset, size_t count, const Visitor& visitor) const;
+
+private:
+    struct Node {
+        AssetUtils::AssetHash hash; // empty if no mapping ends at this node
+        std::map<QString, std::unique_ptr<Node>> children;
+        size_t count { 0 }; // mappings at and below this node
+    };
+
+    // returns the nodes from the root to the node for segments, stopping early if one doesn't exist
+    std::vector<Node*> findPath(const QStringList& segments) const;
+    std::vector<Node*> findOrCreatePath(const QStringList& segments);
+
+    // removes the empty nodes at the end of a path returned by findPath
+    void prune(std::vector<Node*>& nodes, const QStringList& segments);
+
+    size_t merge(Node& destination, Node& source);
+    void collect(const Node& node, const QString& path, AssetUtils::Mappings& mappings) const;
+    void visitRange(const Node& node, const QString& path, size_t& skip, size_t& remaining,
+                    const Visitor& visitor) const;
+
+    void addReference(const AssetUtils::AssetHash& hash);
+    void removeReference(const AssetUtils::AssetHash& hash);
+
+    Node _root;
+    QHash<AssetUtils::AssetHash, int> _hashReferences;
+};
+
+#endif // hifi_AssetMappingIndex_h
@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -22,9 +23,13 @@
 #include <QtCore/QDirIterator>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -121,12 +126,60 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        // resume with the priority this bake had before a restart, otherwise the newest bake goes first
+        int priority;
+        auto savedIt = _savedBakePriorities.find(assetHash);
+        if (savedIt != _savedBakePriorities.end()) {
+            priority = savedIt.value();
+            _savedBakePriorities.erase(savedIt);
+        } else {
+            priority = ++_nextBakePriority;
+        }
+        _bakePriorities[assetHash] = priority;
+
+        _bakingTaskPool.start(task.get(), priority);
+        scheduleBakeQueueWrite();
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end() || _bakePriorities.value(assetHash) == _nextBakePriority) {
+        return;
+    }
+
+    // a bake can only be moved while it is still waiting for a thread
+    if (_bakingTaskPool.tryTake(it->get())) {
+        qDebug() << "Moving bake for" << assetHash << "to the front of the queue";
+        auto priority = ++_nextBakePriority;
+        _bakePriorities[assetHash] = priority;
+        _bakingTaskPool.start(it->get(), priority);
+        scheduleBakeQueueWrite();
+    }
+}
+
+void AssetServer::removePendingBake(const AssetUtils::AssetHash& assetHash, quint64 publishTime) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end()) {
+        return;
+    }
+
+    const auto& timings = (*it)->getStageTimings();
+    _bakingStats.totalQueuedTime += timings.queued;
+    _bakingStats.totalBakingTime += timings.baking;
+    _bakingStats.totalPublishTime += publishTime;
+    if (timings.ovenStartup > 0) {
+        ++_bakingStats.ovenStarts;
+        _bakingStats.totalOvenStartupTime += timings.ovenStartup;
+    }
+
+    _pendingBakes.erase(it);
+    _bakePriorities.remove(assetHash);
+    scheduleBakeQueueWrite();
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -161,9 +214,9 @@ std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const A
     }
 
     auto bakedPath = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + hash + "/" + bakedFilename;
-    auto jt = _fileMappings.find(bakedPath);
-    if (jt != _fileMappings.end()) {
-        if (jt->second == hash) {
+    auto bakedHash = _fileMappings.value(bakedPath);
+    if (!bakedHash.isEmpty()) {
+        if (bakedHash == hash) {
             return { AssetUtils::NotBaked, "" };
         } else {
             return { AssetUtils::Baked, "" };
@@ -182,12 +235,9 @@ std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const A
 }
 
 void AssetServer::bakeAssets() {
-    auto it = _fileMappings.cbegin();
-    for (; it != _fileMappings.cend(); ++it) {
-        auto path = it->first;
-        auto hash = it->second;
+    _fileMappings.forEach([this](const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
         maybeBake(path, hash);
-    }
+    });
 }
 
 void AssetServer::maybeBake(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
@@ -213,7 +263,7 @@ void AssetServer::createEmptyMetaFile(const AssetUtils::AssetHash& hash) {
 bool AssetServer::hasMetaFile(const AssetUtils::AssetHash& hash) {
     QString metaFilePath = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + hash + "/meta.json";
 
-    return _fileMappings.find(metaFilePath) != _fileMappings.end();
+    return _fileMappings.contains(metaFilePath);
 }
 
 bool AssetServer::needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash) {
@@ -229,12 +279,12 @@ bool AssetServer::needsToBeBaked(const AssetUtils::AssetPath& path, const AssetU
 
     QString bakedFilename = bakedFilenameForAssetType(type);
     auto bakedPath = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + assetHash + "/" + bakedFilename;
-    auto mappingIt = _fileMappings.find(bakedPath);
-    bool bakedMappingExists = mappingIt != _fileMappings.end();
+    auto bakedHash = _fileMappings.value(bakedPath);
+    bool bakedMappingExists = !bakedHash.isEmpty();
 
     // If the path is mapped to the original file's hash, baking has been disabled for this
     // asset
-    if (bakedMappingExists && mappingIt->second == assetHash) {
+    if (bakedMappingExists && bakedHash == assetHash) {
         return false;
     }
 
@@ -299,7 +349,8 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+    // each baking thread drives one oven worker process, leave half of the cores for the rest of the server
+    _bakingTaskPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
@@ -325,6 +376,9 @@ void AssetServer::aboutToFinish() {
     // remove pending transfer tasks
     _transferTaskPool.clear();
 
+    // remember the queued bakes before they are taken off the thread pool, they are resumed on the next start
+    writeBakeQueueToFile();
+
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
     while (it != _pendingBakes.end()) {
@@ -423,6 +477,9 @@ void AssetServer::completeSetup() {
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
 
+        _uploadSessions.setFilesDirectory(_filesDirectory);
+        _uploadSessions.removeLeftoverPartialFiles();
+
         // Check the asset directory to output some information about what we have
         auto files = _filesDirectory.entryList(QDir::Files);
 
@@ -431,13 +488,14 @@ void AssetServer::completeSetup() {
 
         qCInfo(asset_server) << "There are" << hashedFiles.size() << "asset files in the asset directory.";
 
-        if (_fileMappings.size() > 0) {
+        if (!_fileMappings.isEmpty()) {
             cleanupUnmappedFiles();
             cleanupBakedFilesForDeletedAssets();
         }
 
         nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 
+        loadBakeQueueFromFile();
         bakeAssets();
     } else {
         qCCritical(asset_server) << "Asset Server assignment will not continue because mapping file could not be loaded.";
@@ -453,6 +511,15 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the in-memory cache of hot assets
+    static const QString ASSETS_CACHE_SIZE_OPTION = "assets_cache_size";
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto assetsCacheSizeJSONValue = assetServerObject[ASSETS_CACHE_SIZE_OPTION];
+    if (assetsCacheSizeJSONValue.isDouble()) {
+        _fileCache.setMaxSize(std::max(assetsCacheSizeJSONValue.toInt(), 0) * BYTES_PER_MEGABYTE);
+    }
+    qCDebug(asset_server) << "Caching up to" << _fileCache.getMaxSize() << "bytes of hot assets in memory";
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -522,20 +589,14 @@ void AssetServer::cleanupUnmappedFiles() {
     for (const auto& fileInfo : files) {
         auto filename = fileInfo.fileName();
         if (hashFileRegex.exactMatch(filename)) {
-            bool matched { false };
-            for (auto& pair : _fileMappings) {
-                if (pair.second == filename) {
-                    matched = true;
-                    break;
-                }
-            }
-            if (!matched) {
+            if (!_fileMappings.isMapped(filename)) {
                 // remove the unmapped file
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
 
+                    _fileCache.remove(filename);
                     removeBakedPathsForDeletedAsset(filename);
                 } else {
                     qCDebug(asset_server) << "\tAttempt to delete unmapped file" << filename << "failed";
@@ -548,29 +609,13 @@ void AssetServer::cleanupUnmappedFiles() {
 void AssetServer::cleanupBakedFilesForDeletedAssets() {
     qCInfo(asset_server) << "Performing baked asset cleanup for deleted assets";
 
-    std::set<AssetUtils::AssetHash> bakedHashes;
-
-    for (const auto& it : _fileMappings) {
-        // check if this is a mapping to baked content
-        if (it.first.startsWith(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
-            // extract the hash from the baked mapping
-            AssetUtils::AssetHash hash = it.first.mid(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER.length(),
-                                                      AssetUtils::SHA256_HASH_HEX_LENGTH);
-
-            // add the hash to our set of hashes for which we have baked content
-            bakedHashes.insert(hash);
-        }
-    }
+    // the baked content for each hash is in a folder named by the hash
+    auto bakedHashes = _fileMappings.subfolders(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER);
 
     // enumerate the hashes for which we have baked content
     for (const auto& hash : bakedHashes) {
         // check if we have a mapping that points to this hash
-        auto matchingMapping = std::find_if(std::begin(_fileMappings), std::end(_fileMappings),
-                                            [&hash](const std::pair<AssetUtils::AssetPath, AssetUtils::AssetHash> mappingPair) {
-            return mappingPair.second == hash;
-        });
-
-        if (matchingMapping == std::end(_fileMappings)) {
+        if (!_fileMappings.isMapped(hash)) {
             // we didn't find a mapping for this hash, remove any baked content we still have for it
             removeBakedPathsForDeletedAsset(hash);
         }
@@ -599,7 +644,7 @@ void AssetServer::handleAssetMappingOperation(QSharedPointer<ReceivedMessage> me
             handleGetMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::GetAll:
-            handleGetAllMappingOperation(*replyPacket);
+            handleGetAllMappingOperation(*message, *replyPacket);
             break;
         case AssetMappingOperationType::Set:
             handleSetMappingOperation(*message, canWriteToAssetServer, *replyPacket);
@@ -629,8 +674,8 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
     QUrl url { assetPath };
     assetPath = url.path();
 
-    auto it = _fileMappings.find(assetPath);
-    if (it != _fileMappings.end()) {
+    auto originalAssetHash = _fileMappings.value(assetPath);
+    if (!originalAssetHash.isEmpty()) {
 
         // check if we should re-direct to a baked asset
 
@@ -639,8 +684,7 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
 
         auto type = assetTypeForFilename(assetPath);
         QString bakedRootFile = bakedFilenameForAssetType(type);
-        
-        auto originalAssetHash = it->second;
+
         QString redirectedAssetHash;
         QString bakedAssetPath;
         quint8 wasRedirected = false;
@@ -649,13 +693,13 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
         if (!bakedRootFile.isEmpty()) {
             // we ran into an asset for which we could have a baked version, let's check if it's ready
             bakedAssetPath = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + originalAssetHash + "/" + bakedRootFile;
-            auto bakedIt = _fileMappings.find(bakedAssetPath);
+            auto bakedHash = _fileMappings.value(bakedAssetPath);
 
-            if (bakedIt != _fileMappings.end()) {
-                if (bakedIt->second != originalAssetHash) {
+            if (!bakedHash.isEmpty()) {
+                if (bakedHash != originalAssetHash) {
                     qDebug() << "Did find baked version for: " << originalAssetHash << assetPath;
                     // we found a baked version of the requested asset to serve, redirect to that
-                    redirectedAssetHash = bakedIt->second;
+                    redirectedAssetHash = bakedHash;
                     wasRedirected = true;
                 } else {
                     qDebug() << "Did not find baked version for: " << originalAssetHash << assetPath << " (disabled)";
@@ -663,6 +707,9 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
                 }
             } else {
                 qDebug() << "Did not find baked version for: " << originalAssetHash << assetPath;
+
+                // someone wants this asset now, bake it before the assets nobody asked for
+                prioritizeBake(originalAssetHash);
             }
         }
 
@@ -706,16 +753,25 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
     }
 }
 
-void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
+void AssetServer::handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket) {
+    // the mappings are sent a page at a time, so a domain with a huge number of them doesn't hold up the asset server
+    uint32_t offset;
+    uint32_t maxCount;
+    message.readPrimitive(&offset);
+    message.readPrimitive(&maxCount);
+
     replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
 
-    uint32_t count = (uint32_t)_fileMappings.size();
+    uint32_t totalCount = (uint32_t)_fileMappings.size();
+    uint32_t count = 0;
+    if (offset < totalCount) {
+        count = std::min({ maxCount, AssetUtils::MAX_MAPPINGS_PER_PAGE, totalCount - offset });
+    }
 
+    replyPacket.writePrimitive(totalCount);
     replyPacket.writePrimitive(count);
 
-    for (auto it = _fileMappings.cbegin(); it != _fileMappings.cend(); ++ it) {
-        auto mapping = it->first;
-        auto hash = it->second;
+    _fileMappings.forEachInRange(offset, count, [&](const AssetUtils::AssetPath& mapping, const AssetUtils::AssetHash& hash) {
         replyPacket.writeString(mapping);
         replyPacket.write(QByteArray::fromHex(hash.toUtf8()));
 
@@ -726,7 +782,7 @@ void AssetServer::handleGetAllMappingOperation(NLPacketList& replyPacket) {
         if (status == AssetUtils::Error) {
             replyPacket.writeString(lastBakeErrors);
         }
-    }
+    });
 }
 
 void AssetServer::handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket) {
@@ -872,7 +928,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _fileCache);
     _transferTaskPool.start(task);
 }
 
@@ -886,7 +942,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _uploadSessions);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -969,12 +1025,60 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     }
 
+    // add the hot asset cache stats
+    QJsonObject cacheStats;
+    cacheStats["1. Hits"] = (double)_fileCache.getHits();
+    cacheStats["2. Misses"] = (double)_fileCache.getMisses();
+    cacheStats["3. Too Large To Cache"] = (double)_fileCache.getUncacheable();
+    cacheStats["4. Bytes Served"] = (double)_fileCache.getBytesServed();
+    cacheStats["5. Cached Assets"] = _fileCache.getNumEntries();
+    cacheStats["6. Cache Size (MB)"] = (double)_fileCache.getSize() / (1024.0 * 1024.0);
+    serverStats["Asset Cache Stats"] = cacheStats;
+
+    // add the baking pipeline stats, average time spent in each stage of a bake
+    auto averageMs = [](quint64 totalUsecs, quint64 count) {
+        return count > 0 ? (double)totalUsecs / (double)(count * USECS_PER_MSEC) : 0.0;
+    };
+    auto finishedBakes = _bakingStats.completed + _bakingStats.failed + _bakingStats.aborted;
+    QJsonObject bakingStats;
+    bakingStats["1. Pending"] = _pendingBakes.size();
+    bakingStats["2. Completed"] = (double)_bakingStats.completed;
+    bakingStats["3. Failed"] = (double)_bakingStats.failed;
+    bakingStats["4. Oven Workers Started"] = (double)_bakingStats.ovenStarts;
+    bakingStats["5. Avg Queued (ms)"] = averageMs(_bakingStats.totalQueuedTime, finishedBakes);
+    bakingStats["6. Avg Oven Startup (ms)"] = averageMs(_bakingStats.totalOvenStartupTime, _bakingStats.ovenStarts);
+    bakingStats["7. Avg Bake (ms)"] = averageMs(_bakingStats.totalBakingTime, finishedBakes);
+    bakingStats["8. Avg Publish (ms)"] = averageMs(_bakingStats.totalPublishTime, _bakingStats.completed);
+    serverStats["Baking Stats"] = bakingStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
 
 static const QString MAP_FILE_NAME = "map.json";
 
+// mapping changes are appended to the journal, and the map file is only rewritten when the journal has grown to a good
+// fraction of the mappings (and when the server starts)
+static const QString MAP_JOURNAL_FILE_NAME = "map.journal";
+static const int MIN_MAPPING_JOURNAL_RECORDS_TO_COMPACT = 1000;
+
+// the first line of the journal names the map file it applies to by the hash of its contents, so a journal that was
+// already folded into the map file (the server stopped between writing one and clearing the other) isn't replayed twice
+static const QString JOURNAL_MAP_FILE_HASH_KEY = "map_file_hash";
+
+static const QString JOURNAL_OPERATION_KEY = "op";
+static const QString JOURNAL_PATH_KEY = "path";
+static const QString JOURNAL_PATHS_KEY = "paths";
+static const QString JOURNAL_HASH_KEY = "hash";
+static const QString JOURNAL_NEW_PATH_KEY = "new_path";
+static const QString JOURNAL_SET_OPERATION = "set";
+static const QString JOURNAL_DELETE_OPERATION = "delete";
+static const QString JOURNAL_RENAME_OPERATION = "rename";
+
+bool pathIsFolder(const AssetUtils::AssetPath& path) {
+    return path.endsWith('/');
+}
+
 bool AssetServer::loadMappingsFromFile() {
 
     auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
@@ -984,7 +1088,8 @@ bool AssetServer::loadMappingsFromFile() {
         if (mapFile.open(QIODevice::ReadOnly)) {
             QJsonParseError error;
 
-            auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
+            auto mapFileData = mapFile.readAll();
+            auto jsonDocument = QJsonDocument::fromJson(mapFileData, &error);
 
             if (error.error == QJsonParseError::NoError) {
                 if (!jsonDocument.isObject()) {
@@ -992,7 +1097,6 @@ bool AssetServer::loadMappingsFromFile() {
                     return false;
                 }
 
-                //_fileMappings = jsonDocument.object().toVariantHash();
                 auto root = jsonDocument.object();
                 for (auto it = root.begin(); it != root.end(); ++it) {
                     auto key = it.key();
@@ -1013,22 +1117,29 @@ bool AssetServer::loadMappingsFromFile() {
                         continue;
                     }
 
-
-                    qDebug() << "Added " << key << value.toString();
-                    _fileMappings[key] = value.toString();
+                    _fileMappings.insert(key, value.toString());
                 }
 
+                _mapFileHash = QCryptographicHash::hash(mapFileData, QCryptographicHash::Sha256).toHex();
+
                 qCInfo(asset_server) << "Loaded" << _fileMappings.size() << "mappings from map file at" << mapFilePath;
-                return true;
+            } else {
+                qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
+                return false;
             }
+        } else {
+            qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
+            return false;
         }
-
-        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
-        return false;
     } else {
         qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
     }
 
+    // bring in the changes made since the map file was written, and fold them into it
+    if (replayMappingJournal()) {
+        writeMappingsToFile();
+    }
+
     return true;
 }
 
@@ -1039,15 +1150,22 @@ bool AssetServer::writeMappingsToFile() {
     if (mapFile.open(QIODevice::WriteOnly)) {
         QJsonObject root;
 
-        for (auto it : _fileMappings) {
-            root[it.first] = it.second;
-        }
+        _fileMappings.forEach([&root](const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
+            root[path] = hash;
+        });
 
         QJsonDocument jsonDocument { root };
+        auto mapFileData = jsonDocument.toJson();
 
-        if (mapFile.write(jsonDocument.toJson()) != -1) {
+        if (mapFile.write(mapFileData) != -1) {
             if (mapFile.commit()) {
                 qCDebug(asset_server) << "Wrote JSON mappings to file at" << mapFilePath;
+
+                // the journal is now part of the map file, start a new one for it
+                _mapFileHash = QCryptographicHash::hash(mapFileData, QCryptographicHash::Sha256).toHex();
+                _numMappingJournalRecords = 0;
+                QFile::remove(_resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME));
+
                 return true;
             } else {
                 qCWarning(asset_server) << "Failed to commit JSON mappings to file at" << mapFilePath;
@@ -1062,6 +1180,143 @@ bool AssetServer::writeMappingsToFile() {
     return false;
 }
 
+bool AssetServer::replayMappingJournal() {
+    auto journalFilePath = _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME);
+
+    QFile journalFile { journalFilePath };
+    if (!journalFile.exists()) {
+        return false;
+    }
+
+    if (!journalFile.open(QIODevice::ReadOnly)) {
+        qCWarning(asset_server) << "Failed to open mapping journal at" << journalFilePath;
+        return false;
+    }
+
+    auto header = QJsonDocument::fromJson(journalFile.readLine()).object();
+    if (header[JOURNAL_MAP_FILE_HASH_KEY].toString() != _mapFileHash) {
+        qCInfo(asset_server) << "Ignoring mapping journal at" << journalFilePath << "since it is for a different map file";
+        return true;
+    }
+
+    int numRecords = 0;
+    while (!journalFile.atEnd()) {
+        QJsonParseError error;
+        auto record = QJsonDocument::fromJson(journalFile.readLine(), &error);
+
+        if (error.error != QJsonParseError::NoError || !record.isObject()) {
+            // only the last record can be damaged, by the server stopping while it was appended
+            qCWarning(asset_server) << "Stopped replaying mapping journal at damaged record" << numRecords + 1;
+            break;
+        }
+
+        applyMappingJournalRecord(record.object());
+        ++numRecords;
+    }
+
+    qCInfo(asset_server) << "Replayed" << numRecords << "mapping changes from journal at" << journalFilePath;
+    _numMappingJournalRecords = numRecords;
+
+    return true;
+}
+
+bool AssetServer::appendToMappingJournal(const QJsonObject& record) {
+    auto journalFilePath = _resourcesDirectory.absoluteFilePath(MAP_JOURNAL_FILE_NAME);
+
+    QFile journalFile { journalFilePath };
+    if (!journalFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(asset_server) << "Failed to open mapping journal at" << journalFilePath;
+        return false;
+    }
+
+    auto sizeBefore = journalFile.size();
+
+    QByteArray data;
+    if (sizeBefore == 0) {
+        QJsonObject header;
+        header[JOURNAL_MAP_FILE_HASH_KEY] = _mapFileHash;
+        data = QJsonDocument(header).toJson(QJsonDocument::Compact) + '\n';
+    }
+    data += QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+
+    if (journalFile.write(data) != data.size() || !journalFile.flush()) {
+        qCWarning(asset_server) << "Failed to write to mapping journal at" << journalFilePath;
+
+        // don't leave a partial record for the next one to be appended to
+        journalFile.resize(sizeBefore);
+        return false;
+    }
+
+    ++_numMappingJournalRecords;
+    return true;
+}
+
+void AssetServer::applyMappingJournalRecord(const QJsonObject& record, QSet<AssetUtils::AssetHash>* removedHashes) {
+    auto operation = record[JOURNAL_OPERATION_KEY].toString();
+
+    if (operation == JOURNAL_SET_OPERATION) {
+        auto replacedHash = _fileMappings.insert(record[JOURNAL_PATH_KEY].toString(), record[JOURNAL_HASH_KEY].toString());
+        if (removedHashes && !replacedHash.isEmpty()) {
+            *removedHashes << replacedHash;
+        }
+    } else if (operation == JOURNAL_DELETE_OPERATION) {
+        for (const auto& pathValue : record[JOURNAL_PATHS_KEY].toArray()) {
+            auto path = pathValue.toString();
+
+            // figure out if this path will delete a file or folder
+            if (pathIsFolder(path)) {
+                auto removedMappings = _fileMappings.removeFolder(path);
+
+                if (removedMappings.size() > 0) {
+                    qCDebug(asset_server) << "Deleted" << removedMappings.size() << "mappings in folder: " << path;
+                } else {
+                    qCDebug(asset_server) << "Did not find any mappings to delete in folder:" << path;
+                }
+
+                if (removedHashes) {
+                    for (const auto& mapping : removedMappings) {
+                        *removedHashes << mapping.second;
+                    }
+                }
+            } else {
+                auto removedHash = _fileMappings.remove(path);
+
+                if (!removedHash.isEmpty()) {
+                    qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << removedHash;
+
+                    if (removedHashes) {
+                        *removedHashes << removedHash;
+                    }
+                } else {
+                    qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
+                }
+            }
+        }
+    } else if (operation == JOURNAL_RENAME_OPERATION) {
+        auto oldPath = record[JOURNAL_PATH_KEY].toString();
+        auto newPath = record[JOURNAL_NEW_PATH_KEY].toString();
+
+        if (pathIsFolder(oldPath)) {
+            _fileMappings.renameFolder(oldPath, newPath);
+        } else {
+            auto hash = _fileMappings.remove(oldPath);
+            if (!hash.isEmpty()) {
+                _fileMappings.insert(newPath, hash);
+            }
+        }
+    } else {
+        qCWarning(asset_server) << "Skipping mapping journal record with unknown operation" << operation;
+    }
+}
+
+void AssetServer::compactMappingJournalIfNeeded() {
+    int maxRecords = std::max(MIN_MAPPING_JOURNAL_RECORDS_TO_COMPACT, (int)(_fileMappings.size() / 2));
+    if (_numMappingJournalRecords >= maxRecords) {
+        // failing here is harmless, the journal keeps growing and we try again after the next change
+        writeMappingsToFile();
+    }
+}
+
 bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash) {
     path = path.trimmed();
 
@@ -1075,37 +1330,26 @@ bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash h
         return false;
     }
 
-    // remember what the old mapping was in case persistence fails
-    auto it = _fileMappings.find(path);
-    auto oldMapping = it != _fileMappings.end() ? it->second : "";
+    QJsonObject record;
+    record[JOURNAL_OPERATION_KEY] = JOURNAL_SET_OPERATION;
+    record[JOURNAL_PATH_KEY] = path;
+    record[JOURNAL_HASH_KEY] = hash;
 
-    // update the in memory QHash
-    _fileMappings[path] = hash;
+    // persist the change before making it, so there is nothing to roll back if that fails
+    if (appendToMappingJournal(record)) {
+        applyMappingJournalRecord(record);
+        compactMappingJournalIfNeeded();
 
-    // attempt to write to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded, we are good to go
         qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
         maybeBake(path, hash);
         return true;
     } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.erase(_fileMappings.find(path));
-        } else {
-            _fileMappings[path] = oldMapping;
-        }
-
         qCWarning(asset_server) << "Failed to persist mapping:" << path << "=>" << hash;
 
         return false;
     }
 }
 
-bool pathIsFolder(const AssetUtils::AssetPath& path) {
-    return path.endsWith('/');
-}
-
 void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
     // we deleted the file with this hash
 
@@ -1119,74 +1363,33 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
 }
 
 bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
-
-    QSet<QString> hashesToCheckForDeletion;
-
-    // enumerate the paths to delete and remove them all
+    QJsonArray trimmedPaths;
     for (const auto& rawPath : paths) {
-        auto path = rawPath.trimmed();
-
-        // figure out if this path will delete a file or folder
-        if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
-            auto sizeBefore = _fileMappings.size();
-
-            while (it != _fileMappings.end()) {
-                if (it->first.startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it->second;
-
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-
-            auto sizeNow = _fileMappings.size();
-            if (sizeBefore != sizeNow) {
-                qCDebug(asset_server) << "Deleted" << sizeBefore - sizeNow << "mappings in folder: " << path;
-            } else {
-                qCDebug(asset_server) << "Did not find any mappings to delete in folder:" << path;
-            }
-
-        } else {
-            auto it = _fileMappings.find(path);
-            if (it != _fileMappings.end()) {
-                // add this hash to the list we need to check for asset removal from server
-                hashesToCheckForDeletion << it->second;
-
-                qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << it->second;
-                
-                _fileMappings.erase(it);
-            } else {
-                qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
-            }
-        }
+        trimmedPaths.append(rawPath.trimmed());
     }
 
-    // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded we are good to go
+    QJsonObject record;
+    record[JOURNAL_OPERATION_KEY] = JOURNAL_DELETE_OPERATION;
+    record[JOURNAL_PATHS_KEY] = trimmedPaths;
 
-        // TODO iterate through hashesToCheckForDeletion instead
-        for (auto& pair : _fileMappings) {
-            auto it = hashesToCheckForDeletion.find(pair.second);
-            if (it != hashesToCheckForDeletion.end()) {
-                hashesToCheckForDeletion.erase(it);
-            }
-        }
+    if (appendToMappingJournal(record)) {
+        QSet<QString> hashesToCheckForDeletion;
+        applyMappingJournalRecord(record, &hashesToCheckForDeletion);
+        compactMappingJournalIfNeeded();
 
-        // we now have a set of hashes that are unmapped - we will delete those asset files
+        // delete the asset files for hashes that are no longer mapped
         for (auto& hash : hashesToCheckForDeletion) {
+            if (_fileMappings.isMapped(hash)) {
+                continue;
+            }
+
             // remove the unmapped file
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
 
+                _fileCache.remove(hash);
                 removeBakedPathsForDeletedAsset(hash);
             } else {
                 qCDebug(asset_server) << "\tAttempt to delete unmapped file" << hash << "failed";
@@ -1195,10 +1398,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         return true;
     } else {
-        qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
-
-        // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
+        qCWarning(asset_server) << "Failed to persist deleted mappings";
 
         return false;
     }
@@ -1223,40 +1423,6 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
 
             return false;
         }
-
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
-
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
-
-        while (it != oldMappings.end()) {
-            auto& oldKey = it->first;
-            if (oldKey.startsWith(oldPath)) {
-                auto newKey = oldKey;
-                newKey.replace(0, oldPath.size(), newPath);
-
-                // remove the old version from the in memory file mappings
-                _fileMappings.erase(_fileMappings.find(oldKey));
-                _fileMappings[newKey] = it->second;
-            }
-
-            ++it;
-        }
-
-        if (writeMappingsToFile()) {
-            // persisted the changed mappings, return success
-            qCDebug(asset_server) << "Renamed folder mapping:" << oldPath << "=>" << newPath;
-
-            return true;
-        } else {
-            // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
-
-            qCWarning(asset_server) << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
-
-            return false;
-        }
     } else {
         if (pathIsFolder(newPath)) {
             // we were asked to rename a path to a file to a path that is a folder, this is a fail
@@ -1265,42 +1431,28 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take the old hash to remove the old mapping
-        auto it = _fileMappings.find(oldPath);
-        auto oldSourceMapping = it->second;
-        _fileMappings.erase(it);
-
-        // in case we're overwriting, keep the current destination mapping for potential rollback
-        auto oldDestinationIt = _fileMappings.find(newPath);
-
-        if (!oldSourceMapping.isEmpty()) {
-            _fileMappings[newPath] = oldSourceMapping;
+        if (!_fileMappings.contains(oldPath)) {
+            // failed to find a mapping that was to be renamed, return failure
+            return false;
+        }
+    }
 
-            if (writeMappingsToFile()) {
-                // persisted the renamed mapping, return success
-                qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
+    QJsonObject record;
+    record[JOURNAL_OPERATION_KEY] = JOURNAL_RENAME_OPERATION;
+    record[JOURNAL_PATH_KEY] = oldPath;
+    record[JOURNAL_NEW_PATH_KEY] = newPath;
 
-                return true;
-            } else {
-                // we couldn't persist the renamed mapping, rollback and return failure
-                _fileMappings[oldPath] = oldSourceMapping;
+    if (appendToMappingJournal(record)) {
+        applyMappingJournalRecord(record);
+        compactMappingJournalIfNeeded();
 
-                if (oldDestinationIt != _fileMappings.end()) {
-                    // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationIt->second;
-                } else {
-                    // clear the new mapping
-                    _fileMappings.erase(_fileMappings.find(newPath));
-                }
+        qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
 
-                qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
+        return true;
+    } else {
+        qCWarning(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
 
-                return false;
-            }
-        } else {
-            // failed to find a mapping that was to be renamed, return failure
-            return false;
-        }
+        return false;
     }
 }
 
@@ -1329,7 +1481,8 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    ++_bakingStats.failed;
+    removePendingBake(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1338,6 +1491,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
     QString errorReason;
 
     qDebug() << "Completing bake for " << originalAssetHash;
+    auto publishStart = usecTimestampNow();
 
     for (auto& filePath : bakedFilePaths) {
         // figure out the hash for the contents of this file
@@ -1429,14 +1583,85 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    ++_bakingStats.completed;
+    removePendingBake(originalAssetHash, usecTimestampNow() - publishStart);
 }
 
 void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath) {
     qDebug() << "Aborted bake:" << originalAssetHash;
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
-    _pendingBakes.remove(originalAssetHash);
+    ++_bakingStats.aborted;
+    removePendingBake(originalAssetHash);
+}
+
+static const QString BAKE_QUEUE_FILE_NAME = "bake_queue.json";
+static const int BAKE_QUEUE_WRITE_DELAY_MS = 1000;
+
+bool AssetServer::loadBakeQueueFromFile() {
+    QFile bakeQueueFile { _resourcesDirectory.absoluteFilePath(BAKE_QUEUE_FILE_NAME) };
+
+    if (!bakeQueueFile.exists()) {
+        return true;
+    }
+
+    if (!bakeQueueFile.open(QIODevice::ReadOnly)) {
+        qCWarning(asset_server) << "Failed to open bake queue file" << bakeQueueFile.fileName();
+        return false;
+    }
+
+    QJsonParseError error;
+    auto jsonDocument = QJsonDocument::fromJson(bakeQueueFile.readAll(), &error);
+    if (error.error != QJsonParseError::NoError || !jsonDocument.isObject()) {
+        qCWarning(asset_server) << "Failed to parse bake queue file" << bakeQueueFile.fileName() << error.errorString();
+        return false;
+    }
+
+    // the saved priorities are only relative to each other, the pool restarts counting from the highest one
+    auto jsonObject = jsonDocument.object();
+    for (auto it = jsonObject.constBegin(); it != jsonObject.constEnd(); ++it) {
+        auto priority = it.value().toInt();
+        _savedBakePriorities[it.key()] = priority;
+        _nextBakePriority = std::max(_nextBakePriority, priority);
+    }
+
+    qCInfo(asset_server) << "Resuming" << _savedBakePriorities.size() << "queued bakes";
+    return true;
+}
+
+bool AssetServer::writeBakeQueueToFile() {
+    QJsonObject root;
+    for (auto it = _bakePriorities.constBegin(); it != _bakePriorities.constEnd(); ++it) {
+        root[it.key()] = it.value();
+    }
+
+    QSaveFile bakeQueueFile { _resourcesDirectory.absoluteFilePath(BAKE_QUEUE_FILE_NAME) };
+    if (bakeQueueFile.open(QIODevice::WriteOnly)) {
+        bakeQueueFile.write(QJsonDocument(root).toJson());
+        if (bakeQueueFile.commit()) {
+            return true;
+        }
+    }
+
+    qCWarning(asset_server) << "Failed to write bake queue file" << bakeQueueFile.fileName();
+    return false;
+}
+
+void AssetServer::scheduleBakeQueueWrite() {
+    // batch the writes for bursts of uploads and completed bakes
+    if (_bakeQueueWriteScheduled) {
+        return;
+    }
+    _bakeQueueWriteScheduled = true;
+
+    QTimer::singleShot(BAKE_QUEUE_WRITE_DELAY_MS, this, [this] {
+        _bakeQueueWriteScheduled = false;
+
+        // once finishing, aborted bakes leave the queue but should still be resumed on the next start
+        if (!isFinished()) {
+            writeBakeQueueToFile();
+        }
+    });
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
@@ -1446,13 +1671,11 @@ static const QString LAST_BAKE_ERRORS_KEY = "last_bake_errors";
 std::pair<bool, AssetMeta> AssetServer::readMetaFile(AssetUtils::AssetHash hash) {
     auto metaFilePath = AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER + hash + "/" + "meta.json";
 
-    auto it = _fileMappings.find(metaFilePath);
-    if (it == _fileMappings.end()) {
+    auto metaFileHash = _fileMappings.value(metaFilePath);
+    if (metaFileHash.isEmpty()) {
         return { false, {} };
     }
 
-    auto metaFileHash = it->second;
-
     QFile metaFile(_filesDirectory.absoluteFilePath(metaFileHash));
 
     if (metaFile.open(QIODevice::ReadOnly)) {
@@ -1522,19 +1745,17 @@ bool AssetServer::writeMetaFile(AssetUtils::AssetHash originalAssetHash, const A
 
 bool AssetServer::setBakingEnabled(const AssetUtils::AssetPathList& paths, bool enabled) {
     for (const auto& path : paths) {
-        auto it = _fileMappings.find(path);
-        if (it != _fileMappings.end()) {
+        auto hash = _fileMappings.value(path);
+        if (!hash.isEmpty()) {
             auto type = assetTypeForFilename(path);
             if (type == BakedAssetType::Undefined) {
                 continue;
             }
             QString bakedFilename = bakedFilenameForAssetType(type);
 
-            auto hash = it->second;
             auto bakedMapping = getBakeMapping(hash, bakedFilename);
 
-            auto it = _fileMappings.find(bakedMapping);
-            bool currentlyDisabled = (it != _fileMappings.end() && it->second == hash);
+            bool currentlyDisabled = (_fileMappings.value(bakedMapping) == hash);
 
             if (enabled && currentlyDisabled) {
                 QStringList bakedMappings{ bakedMapping };
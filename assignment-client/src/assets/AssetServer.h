@@ -13,11 +13,16 @@
 #define hifi_AssetServer_h
 
 #include <QtCore/QDir>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSet>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
 
+#include "AssetFileCache.h"
+#include "AssetMappingIndex.h"
+#include "AssetUploadSessions.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -97,7 +102,7 @@ private:
     void replayRequests();
 
     void handleGetMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
-    void handleGetAllMappingOperation(NLPacketList& replyPacket);
+    void handleGetAllMappingOperation(ReceivedMessage& message, NLPacketList& replyPacket);
     void handleSetMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleDeleteMappingsOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
     void handleRenameMappingOperation(ReceivedMessage& message, bool hasWriteAccess, NLPacketList& replyPacket);
@@ -110,6 +115,14 @@ private:
     bool loadMappingsFromFile();
     bool writeMappingsToFile();
 
+    /// Mapping changes are appended to a journal next to the map file, which is only rewritten once the journal is long
+    bool appendToMappingJournal(const QJsonObject& record);
+    void applyMappingJournalRecord(const QJsonObject& record, QSet<AssetUtils::AssetHash>* removedHashes = nullptr);
+    void compactMappingJournalIfNeeded();
+
+    /// Replays the journal over the mappings loaded from the map file, returns true if there was a journal
+    bool replayMappingJournal();
+
     /// Set the mapping for path to hash
     bool setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash);
 
@@ -138,6 +151,17 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Move a bake that hasn't started yet to the front of the queue, used when a client asks for the asset
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
+
+    /// Remove a finished bake from the queue and add its stage timings to the baking stats
+    void removePendingBake(const AssetUtils::AssetHash& assetHash, quint64 publishTime = 0);
+
+    /// Persist the priorities of the queued bakes so that a restarted server resumes baking in the same order
+    bool loadBakeQueueFromFile();
+    bool writeBakeQueueToFile();
+    void scheduleBakeQueueWrite();
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir,
                              QVector<QString> bakedFilePaths);
@@ -151,17 +175,41 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
-    AssetUtils::Mappings _fileMappings;
+    AssetMappingIndex _fileMappings;
+    QString _mapFileHash; // of the map file the journal applies to
+    int _numMappingJournalRecords { 0 };
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// In-memory cache of hot asset files, shared by the send tasks (declared before the task pool so it outlives it)
+    AssetFileCache _fileCache;
+
+    /// Uploads that are still receiving chunks
+    AssetUploadSessions _uploadSessions;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
+    QHash<AssetUtils::AssetHash, int> _bakePriorities; // thread pool priority of each pending bake, higher bakes first
+    QHash<AssetUtils::AssetHash, int> _savedBakePriorities; // priorities loaded from file, for bakes not re-queued yet
+    int _nextBakePriority { 0 };
+    bool _bakeQueueWriteScheduled { false };
     QThreadPool _bakingTaskPool;
 
+    struct BakingStats {
+        quint64 completed { 0 };
+        quint64 failed { 0 };
+        quint64 aborted { 0 };
+        quint64 ovenStarts { 0 };
+        quint64 totalQueuedTime { 0 };
+        quint64 totalOvenStartupTime { 0 };
+        quint64 totalBakingTime { 0 };
+        quint64 totalPublishTime { 0 };
+    };
+    BakingStats _bakingStats;
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
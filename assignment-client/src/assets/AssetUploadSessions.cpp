@@ -0,0 +1,134 @@
+//
+//  AssetUploadSessions.cpp
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetUploadSessions.h"
+
+#include <algorithm>
+
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include <SharedUtil.h>
+
+#include "AssetServerLogging.h"
+
+const QString AssetUploadSessions::PARTIAL_UPLOAD_EXTENSION = ".partial";
+
+// uploads that haven't received a chunk for this long are considered abandoned
+static const quint64 MAX_SESSION_IDLE_USECS = 5 * 60 * USECS_PER_SECOND;
+
+static void addWrittenRange(std::map<uint64_t, uint64_t>& ranges, uint64_t start, uint64_t end) {
+    auto next = ranges.upper_bound(start);
+    if (next != ranges.begin()) {
+        auto previous = std::prev(next);
+        if (previous->second >= start) {
+            start = previous->first;
+            end = std::max(end, previous->second);
+            ranges.erase(previous);
+        }
+    }
+    while (next != ranges.end() && next->first <= end) {
+        end = std::max(end, next->second);
+        next = ranges.erase(next);
+    }
+    ranges[start] = end;
+}
+
+AssetUtils::AssetServerError AssetUploadSessions::writeChunk(const QString& uploadKey, uint64_t fileSize, uint64_t offset,
+                                                             const char* data, uint64_t size, QString& completedFilePath) {
+    if (offset + size > fileSize) {
+        return AssetUtils::AssetServerError::InvalidByteRange;
+    }
+
+    QString partialFilePath;
+    {
+        QMutexLocker locker(&_mutex);
+        quint64 now = usecTimestampNow();
+
+        auto it = _sessions.find(uploadKey);
+        if (it == _sessions.end()) {
+            removeStaleSessionsLocked(now);
+
+            // the first chunk to arrive creates the partial file at its full size, so later chunks can be written anywhere
+            Session session;
+            session.partialFilePath = _filesDirectory.absoluteFilePath(
+                uuidStringWithoutCurlyBraces(QUuid::createUuid()) + PARTIAL_UPLOAD_EXTENSION);
+            session.fileSize = fileSize;
+
+            QFile partialFile { session.partialFilePath };
+            if (!partialFile.open(QIODevice::WriteOnly) || !partialFile.resize(fileSize)) {
+                qCWarning(asset_server) << "Could not create partial upload file" << session.partialFilePath;
+                partialFile.remove();
+                return AssetUtils::AssetServerError::FileOperationFailed;
+            }
+            it = _sessions.insert(uploadKey, session);
+        } else if (it->fileSize != fileSize) {
+            return AssetUtils::AssetServerError::InvalidByteRange;
+        }
+        it->lastActivity = now;
+        partialFilePath = it->partialFilePath;
+    }
+
+    if (size > 0) {
+        QFile partialFile { partialFilePath };
+        if (!partialFile.open(QIODevice::ReadWrite) || !partialFile.seek(offset) ||
+            partialFile.write(data, size) != (qint64)size) {
+            qCWarning(asset_server) << "Failed to write to partial upload file" << partialFilePath;
+            abort(uploadKey);
+            return AssetUtils::AssetServerError::FileOperationFailed;
+        }
+    }
+
+    QMutexLocker locker(&_mutex);
+    auto it = _sessions.find(uploadKey);
+    if (it == _sessions.end()) {
+        // the upload was aborted while we were writing
+        return AssetUtils::AssetServerError::FileOperationFailed;
+    }
+    if (size > 0) {
+        addWrittenRange(it->writtenRanges, offset, offset + size);
+    }
+    auto& ranges = it->writtenRanges;
+    if (it->fileSize == 0 || (ranges.size() == 1 && ranges.begin()->first == 0 && ranges.begin()->second == it->fileSize)) {
+        completedFilePath = it->partialFilePath;
+        _sessions.erase(it);
+    }
+    return AssetUtils::AssetServerError::NoError;
+}
+
+void AssetUploadSessions::abort(const QString& uploadKey) {
+    QMutexLocker locker(&_mutex);
+    auto it = _sessions.find(uploadKey);
+    if (it != _sessions.end()) {
+        QFile::remove(it->partialFilePath);
+        _sessions.erase(it);
+    }
+}
+
+void AssetUploadSessions::removeLeftoverPartialFiles() {
+    QMutexLocker locker(&_mutex);
+    auto partialFiles = _filesDirectory.entryInfoList({ "*" + PARTIAL_UPLOAD_EXTENSION }, QDir::Files);
+    for (const auto& fileInfo : partialFiles) {
+        QFile::remove(fileInfo.absoluteFilePath());
+    }
+}
+
+void AssetUploadSessions::removeStaleSessionsLocked(quint64 now) {
+    auto it = _sessions.begin();
+    while (it != _sessions.end()) {
+        if (now - it->lastActivity > MAX_SESSION_IDLE_USECS) {
+            qCDebug(asset_server) << "Removing abandoned partial upload" << it->partialFilePath;
+            QFile::remove(it->partialFilePath);
+            it = _sessions.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
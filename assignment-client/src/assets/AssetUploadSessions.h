@@ -0,0 +1,62 @@
+//
+//  AssetUploadSessions.h
+//  assignment-client/src/assets
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetUploadSessions_h
+#define hifi_AssetUploadSessions_h
+
+#include <map>
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <AssetUtils.h>
+
+// AssetUploadSessions tracks uploads that arrive in chunks. Each upload is written to a partial file next to the
+// asset files as its chunks come in, so the asset server never holds more than the chunks in flight in memory.
+// Chunks of one upload can be handled by different transfer tasks at the same time and in any order.
+class AssetUploadSessions {
+public:
+    static const QString PARTIAL_UPLOAD_EXTENSION;
+
+    AssetUploadSessions(const QDir& filesDirectory = QDir()) : _filesDirectory(filesDirectory) {}
+
+    void setFilesDirectory(const QDir& filesDirectory) { _filesDirectory = filesDirectory; }
+
+    /// Writes a chunk of the upload identified by uploadKey to its partial file. Once every byte of the upload has
+    /// been written, the session is closed and completedFilePath is set to the partial file, which the caller then owns.
+    AssetUtils::AssetServerError writeChunk(const QString& uploadKey, uint64_t fileSize, uint64_t offset,
+                                            const char* data, uint64_t size, QString& completedFilePath);
+
+    /// Drops the session and partial file for an upload that failed
+    void abort(const QString& uploadKey);
+
+    /// Removes partial files left behind by a previous run of the asset server
+    void removeLeftoverPartialFiles();
+
+private:
+    struct Session {
+        QString partialFilePath;
+        uint64_t fileSize { 0 };
+        // the byte ranges written so far, start -> end, merged so that none of them overlap or touch.
+        // chunks can be retransmitted, so the upload is only complete once one range covers the whole file
+        std::map<uint64_t, uint64_t> writtenRanges;
+        quint64 lastActivity { 0 };
+    };
+
+    void removeStaleSessionsLocked(quint64 now);
+
+    QMutex _mutex;
+    QHash<QString, Session> _sessions;
+    QDir _filesDirectory;
+};
+
+#endif // hifi_AssetUploadSessions_h
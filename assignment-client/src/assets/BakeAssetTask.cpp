@@ -17,17 +17,27 @@
 #include <QCoreApplication>
 
 #include <PathUtils.h>
+#include <SharedUtil.h>
 
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
 static const int OVEN_STATUS_CODE_FAIL { 1 };
 static const int OVEN_STATUS_CODE_ABORT { 2 };
 
+// Each baking thread keeps one oven running in worker mode and hands it one asset at a time, so the cost of starting
+// the oven and loading its plugins is paid once per thread instead of once per asset. The process is stopped when
+// the thread pool retires the thread.
+static thread_local std::unique_ptr<QProcess> ovenWorker;
+
+// the asset server runs a baking thread for every two cores, so each worker compresses textures on two threads
+static const int OVEN_WORKER_COMPRESSION_THREADS = 2;
+
 std::once_flag registerMetaTypesFlag;
 
 BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _creationTime(usecTimestampNow())
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -57,73 +67,108 @@ void BakeAssetTask::run() {
         return;
     }
 
+    quint64 startTime = usecTimestampNow();
+    _stageTimings.queued = startTime - _creationTime;
+
     QString tempOutputDir = PathUtils::generateTemporaryDir();
-    auto base = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir();
-    QString path = base.absolutePath() + "/oven";
     QString extension = _assetPath.mid(_assetPath.lastIndexOf('.') + 1);
-    QStringList args {
-        "-i", _filePath,
-        "-o", tempOutputDir,
-        "-t", extension,
-    };
 
-    _ovenProcess.reset(new QProcess());
+    if (!ovenWorker || ovenWorker->state() != QProcess::Running) {
+        auto base = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir();
+        QString path = base.absolutePath() + "/oven";
 
-    QEventLoop loop;
+        ovenWorker.reset(new QProcess());
+        // the oven logs to stderr, forward it rather than buffering it for the life of the worker
+        ovenWorker->setProcessChannelMode(QProcess::ForwardedErrorChannel);
 
-    connect(_ovenProcess.get(), static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-            this, [&loop, this, tempOutputDir](int exitCode, QProcess::ExitStatus exitStatus) {
-        qDebug() << "Baking process finished: " << exitCode << exitStatus;
+        qDebug() << "Starting oven worker";
+        ovenWorker->start(path, { "--worker", "--compression-threads", QString::number(OVEN_WORKER_COMPRESSION_THREADS) });
+        if (!ovenWorker->waitForStarted(-1)) {
+            ovenWorker.reset();
+            QString errors = "Oven process failed to start";
+            emit bakeFailed(_assetHash, _assetPath, errors);
+            return;
+        }
+        _stageTimings.ovenStartup = usecTimestampNow() - startTime;
+    }
 
-        if (exitStatus == QProcess::CrashExit) {
-            if (_wasAborted) {
-                emit bakeAborted(_assetHash, _assetPath);
-            } else {
-                QString errors = "Fatal error occurred while baking";
-                emit bakeFailed(_assetHash, _assetPath, errors);
-            }
-        } else if (exitCode == OVEN_STATUS_CODE_SUCCESS) {
-            QDir outputDir = tempOutputDir;
-            auto files = outputDir.entryInfoList(QDir::Files);
-            QVector<QString> outputFiles;
-            for (auto& file : files) {
-                outputFiles.push_back(file.absoluteFilePath());
-            }
+    QProcess* oven = ovenWorker.get();
+    {
+        std::lock_guard<std::mutex> lock(_ovenProcessMutex);
+        _ovenProcess = oven;
+    }
 
-            emit bakeComplete(_assetHash, _assetPath, tempOutputDir, outputFiles);
-        } else if (exitStatus == QProcess::NormalExit && exitCode == OVEN_STATUS_CODE_ABORT) {
-            _wasAborted.store(true);
-            emit bakeAborted(_assetHash, _assetPath);
-        } else {
-            QString errors;
-            if (exitCode == OVEN_STATUS_CODE_FAIL) {
-                QDir outputDir = tempOutputDir;
-                auto errorFilePath = outputDir.absoluteFilePath("errors.txt");
-                QFile errorFile { errorFilePath };
-                if (errorFile.open(QIODevice::ReadOnly)) {
-                    errors = errorFile.readAll();
-                    errorFile.close();
-                } else {
-                    errors = "Unknown error occurred while baking";
-                }
+    // the loop lives on this thread, so the handlers below run here too
+    QEventLoop loop;
+    int exitCode = -1;
+    bool ovenExited = false;
+
+    QObject::connect(oven, &QProcess::readyReadStandardOutput, &loop, [&] {
+        while (oven->canReadLine()) {
+            auto line = QString::fromUtf8(oven->readLine()).trimmed();
+            if (line.startsWith(AssetUtils::OVEN_WORKER_RESULT_PREFIX)) {
+                exitCode = line.mid(AssetUtils::OVEN_WORKER_RESULT_PREFIX.size()).toInt();
+                loop.quit();
             }
-            emit bakeFailed(_assetHash, _assetPath, errors);
         }
-
+    });
+    QObject::connect(oven, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                     &loop, [&](int, QProcess::ExitStatus) {
+        ovenExited = true;
         loop.quit();
     });
 
-    qDebug() << "Starting oven for " << _assetPath;
-    _ovenProcess->start(path, args, QIODevice::ReadOnly);
-    if (!_ovenProcess->waitForStarted(-1)) {
-        QString errors = "Oven process failed to start";
-        emit bakeFailed(_assetHash, _assetPath, errors);
-        return;
+    qDebug() << "Baking" << _assetPath << "in oven worker";
+    quint64 bakeStartTime = usecTimestampNow();
+    oven->write(QString("%1\t%2\t%3\n").arg(_filePath, tempOutputDir, extension).toUtf8());
+
+    if (!_wasAborted) {
+        loop.exec();
     }
+    {
+        // once this is cleared abort() can't reach the worker, so it can be stopped and destroyed below
+        std::lock_guard<std::mutex> lock(_ovenProcessMutex);
+        _ovenProcess = nullptr;
+    }
+    _stageTimings.baking = usecTimestampNow() - bakeStartTime;
 
-    _isBaking = true;
+    if (ovenExited || _wasAborted) {
+        qDebug() << "Oven worker stopped while baking" << _assetPath;
+        ovenWorker.reset();
 
-    loop.exec();
+        if (_wasAborted) {
+            emit bakeAborted(_assetHash, _assetPath);
+        } else {
+            QString errors = "Fatal error occurred while baking";
+            emit bakeFailed(_assetHash, _assetPath, errors);
+        }
+    } else if (exitCode == OVEN_STATUS_CODE_SUCCESS) {
+        QDir outputDir = tempOutputDir;
+        auto files = outputDir.entryInfoList(QDir::Files);
+        QVector<QString> outputFiles;
+        for (auto& file : files) {
+            outputFiles.push_back(file.absoluteFilePath());
+        }
+
+        emit bakeComplete(_assetHash, _assetPath, tempOutputDir, outputFiles);
+    } else if (exitCode == OVEN_STATUS_CODE_ABORT) {
+        _wasAborted.store(true);
+        emit bakeAborted(_assetHash, _assetPath);
+    } else {
+        QString errors;
+        if (exitCode == OVEN_STATUS_CODE_FAIL) {
+            QDir outputDir = tempOutputDir;
+            auto errorFilePath = outputDir.absoluteFilePath("errors.txt");
+            QFile errorFile { errorFilePath };
+            if (errorFile.open(QIODevice::ReadOnly)) {
+                errors = errorFile.readAll();
+                errorFile.close();
+            } else {
+                errors = "Unknown error occurred while baking";
+            }
+        }
+        emit bakeFailed(_assetHash, _assetPath, errors);
+    }
 }
 
 void BakeAssetTask::abort() {
@@ -132,9 +177,14 @@ void BakeAssetTask::abort() {
         return;
     }
     qDebug() << "Aborting BakeAssetTask for" << _assetHash;
-    if (_ovenProcess->state() != QProcess::NotRunning) {
+    _wasAborted = true;
+
+    // the worker is busy with this asset, stop it, the baking thread starts a new one for its next bake.
+    // The worker lives on the baking thread, so terminate is queued to it. The baking thread only destroys the
+    // worker after clearing _ovenProcess, and destroying it drops the queued call if it hasn't run yet.
+    std::lock_guard<std::mutex> lock(_ovenProcessMutex);
+    if (_ovenProcess) {
         qDebug() << "Teminating oven process for" << _assetHash;
-        _wasAborted = true;
-        _ovenProcess->terminate();
+        QMetaObject::invokeMethod(_ovenProcess, "terminate", Qt::QueuedConnection);
     }
 }
@@ -12,7 +12,9 @@
 #ifndef hifi_BakeAssetTask_h
 #define hifi_BakeAssetTask_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <QtCore/QDebug>
 #include <QtCore/QObject>
@@ -25,12 +27,22 @@
 class BakeAssetTask : public QObject, public QRunnable {
     Q_OBJECT
 public:
+    // time spent in each stage of a bake, in usecs
+    struct StageTimings {
+        quint64 queued { 0 }; // waiting for a baking thread
+        quint64 ovenStartup { 0 }; // starting an oven worker, when the thread didn't have one running yet
+        quint64 baking { 0 }; // the oven baking the asset
+    };
+
     BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
 
+    // only valid once the bake has completed, failed or aborted
+    const StageTimings& getStageTimings() const { return _stageTimings; }
+
     void run() override;
 
 public slots:
@@ -46,8 +58,11 @@ private:
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
-    std::unique_ptr<QProcess> _ovenProcess { nullptr };
+    std::mutex _ovenProcessMutex;
+    QProcess* _ovenProcess { nullptr }; // the baking thread's oven worker, while it bakes this asset
     std::atomic<bool> _wasAborted { false };
+    quint64 _creationTime;
+    StageTimings _stageTimings;
 };
 
 #endif // hifi_BakeAssetTask_h
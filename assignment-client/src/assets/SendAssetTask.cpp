@@ -26,11 +26,13 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir,
+                             AssetFileCache& fileCache) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _fileCache(fileCache)
 {
     
 }
@@ -38,6 +40,7 @@ SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const Shar
 void SendAssetTask::run() {
     MessageID messageID;
     ByteRange byteRange;
+    bool isChunk;
 
     _message->readPrimitive(&messageID);
     QByteArray assetHash = _message->read(AssetUtils::SHA256_HASH_LENGTH);
@@ -47,6 +50,9 @@ void SendAssetTask::run() {
     // starting at index 1.
     _message->readPrimitive(&byteRange.fromInclusive);
     _message->readPrimitive(&byteRange.toExclusive);
+
+    // chunked downloads ask for fixed size chunks without knowing the file size, so the last one can run past the end
+    _message->readPrimitive(&isChunk);
     
     QString hexHash = assetHash.toHex();
     
@@ -64,17 +70,32 @@ void SendAssetTask::run() {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
         QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
+
+        // hot assets are served straight from the in-memory cache, anything the cache won't hold is mapped
+        // from disk, so either way the requested range is written into the packets without an intermediate copy
+        QByteArray cachedData = _fileCache.getOrLoad(hexHash, filePath);
         QFile file { filePath };
+        qint64 fileSize = 0;
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (!cachedData.isNull()) {
+            fileSize = cachedData.size();
+        } else if (file.open(QIODevice::ReadOnly)) {
+            fileSize = file.size();
+        }
+
+        if (!cachedData.isNull() || file.isOpen()) {
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(fileSize);
+
+            // a chunk that runs past the end of the file stops at the end of the file, explicit ranges must fit
+            if (isChunk && byteRange.fromInclusive >= 0 && byteRange.toExclusive > fileSize) {
+                byteRange.toExclusive = fileSize;
+            }
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (fileSize < byteRange.fromInclusive || fileSize < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,29 +103,32 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
-
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
+                // a positive range starts that far into the file, a negative range
+                // means at least the first part of the read is back from the end of the file
+                qint64 offset = (byteRange.fromInclusive >= 0) ? byteRange.fromInclusive : fileSize + byteRange.fromInclusive;
+
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
+                replyPacketList->writePrimitive((AssetUtils::DataOffset)fileSize);
+
+                if (!cachedData.isNull()) {
+                    replyPacketList->write(cachedData.constData() + offset, size);
+                    _fileCache.addBytesServed(size);
+                } else if (size > 0) {
+                    // only map the requested range, so a chunk of a large asset only touches that chunk's pages
+                    auto mappedData = file.map(offset, size);
+                    if (mappedData) {
+                        replyPacketList->write(reinterpret_cast<const char*>(mappedData), size);
+                        file.unmap(mappedData);
+                    } else {
+                        // the file couldn't be mapped, fall back to reading it
+                        file.seek(offset);
+                        replyPacketList->write(file.read(size));
+                    }
                 }
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
             qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
@@ -11,7 +11,6 @@
 
 #include "UploadAssetTask.h"
 
-#include <QtCore/QBuffer>
 #include <QtCore/QFile>
 
 #include <AssetUtils.h>
@@ -21,31 +20,37 @@
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit, AssetUploadSessions& uploadSessions) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _uploadSessions(uploadSessions)
 {
     
 }
 
 void UploadAssetTask::run() {
-    auto data = _receivedMessage->getMessage();
-    
-    QBuffer buffer { &data };
-    buffer.open(QIODevice::ReadOnly);
-    
+    // uploads arrive in chunks, each its own message with its own reply. The reply to the chunk
+    // that completes the upload carries the hash of the uploaded file.
     MessageID messageID;
-    buffer.read(reinterpret_cast<char*>(&messageID), sizeof(messageID));
-    
+    _receivedMessage->readPrimitive(&messageID);
+
+    MessageID uploadID;
+    _receivedMessage->readPrimitive(&uploadID);
+
     uint64_t fileSize;
-    buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
+    _receivedMessage->readPrimitive(&fileSize);
 
-    if (_senderNode) {
-        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
-    } else {
-        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << _receivedMessage->getSenderSockAddr();
+    uint64_t offset;
+    _receivedMessage->readPrimitive(&offset);
+
+    QString senderString = _senderNode ? uuidStringWithoutCurlyBraces(_senderNode->getUUID())
+                                       : _receivedMessage->getSenderSockAddr().toString();
+    QString uploadKey = QString("%1/%2").arg(senderString).arg(uploadID);
+
+    if (offset == 0) {
+        qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << senderString;
     }
     
     auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
@@ -54,58 +59,23 @@ void UploadAssetTask::run() {
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
-        auto hash = AssetUtils::hashData(fileData);
-        auto hexHash = hash.toHex();
-
-        if (_senderNode) {
-            qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
+        // write the chunk straight out of the received message
+        auto chunkSize = (uint64_t)_receivedMessage->getBytesLeftToRead();
+        const char* chunkData = _receivedMessage->getRawMessage() + _receivedMessage->getPosition();
+
+        QString completedFilePath;
+        auto error = _uploadSessions.writeChunk(uploadKey, fileSize, offset, chunkData, chunkSize, completedFilePath);
+
+        if (error != AssetUtils::AssetServerError::NoError) {
+            qWarning() << "Failed to write chunk at" << offset << "of upload from" << senderString << "- upload failed.";
+            _uploadSessions.abort(uploadKey);
+            replyPacket->writePrimitive(error);
+        } else if (completedFilePath.isEmpty()) {
+            // more chunks to come
+            replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
         } else {
-            qDebug() << "Hash for uploaded file from" << _receivedMessage->getSenderSockAddr() << "is: (" << hexHash << ")";
-        }
-        
-        QFile file { _resourcesDir.filePath(QString(hexHash)) };
-
-        bool existingCorrectFile = false;
-        
-        if (file.exists()) {
-            // check if the local file has the correct contents, otherwise we overwrite
-            if (file.open(QIODevice::ReadOnly) && AssetUtils::hashData(file.readAll()) == hash) {
-                qDebug() << "Not overwriting existing verified file: " << hexHash;
-
-                existingCorrectFile = true;
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
-                file.close();
-            }
+            finishUpload(completedFilePath, senderString, *replyPacket);
         }
-
-        if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
-                qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
-
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
-                replyPacket->write(hash);
-            } else {
-                qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
-
-                // upload has failed - remove the file and return an error
-                auto removed = file.remove();
-
-                if (!removed) {
-                    qWarning() << "Removal of failed upload file" << hexHash << "failed.";
-                }
-                
-                replyPacket->writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
-            }
-        }
-
-
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
@@ -115,3 +85,58 @@ void UploadAssetTask::run() {
         nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
     }
 }
+
+void UploadAssetTask::finishUpload(const QString& partialFilePath, const QString& senderString, NLPacket& replyPacket) {
+    QFile partialFile { partialFilePath };
+
+    QByteArray hash;
+    if (partialFile.open(QIODevice::ReadOnly)) {
+        hash = AssetUtils::hashFile(partialFile);
+        partialFile.close();
+    }
+
+    if (hash.isEmpty()) {
+        qWarning() << "Failed to read completed upload from" << senderString << "- upload failed.";
+        partialFile.remove();
+        replyPacket.writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+        return;
+    }
+
+    auto hexHash = hash.toHex();
+    qDebug() << "Hash for uploaded file from" << senderString << "is: (" << hexHash << ")";
+
+    QFile file { _resourcesDir.filePath(QString(hexHash)) };
+
+    if (file.exists()) {
+        // check if the local file has the correct contents, otherwise we overwrite
+        if (file.open(QIODevice::ReadOnly) && AssetUtils::hashFile(file) == hash) {
+            qDebug() << "Not overwriting existing verified file: " << hexHash;
+
+            partialFile.remove();
+
+            replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
+            replyPacket.write(hash);
+            return;
+        }
+
+        qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
+        file.close();
+        file.remove();
+    }
+
+    if (partialFile.rename(file.fileName())) {
+        qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
+
+        replyPacket.writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacket.write(hash);
+    } else {
+        qWarning() << "Failed to move upload to file" << hexHash << " - upload failed.";
+
+        // upload has failed - remove the partial file and return an error
+        if (!partialFile.remove()) {
+            qWarning() << "Removal of failed upload file" << hexHash << "failed.";
+        }
+
+        replyPacket.writePrimitive(AssetUtils::AssetServerError::FileOperationFailed);
+    }
+}
@@ -19,23 +19,28 @@
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include "AssetUploadSessions.h"
 #include "ReceivedMessage.h"
 
+class NLPacket;
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, AssetUploadSessions& uploadSessions);
 
     void run() override;
 
 private:
+    void finishUpload(const QString& partialFilePath, const QString& senderString, NLPacket& replyPacket);
+
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    AssetUploadSessions& _uploadSessions;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -47,6 +47,7 @@ static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
 static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
+bool AudioMixer::_timeStretchingJitterBuffers{ InboundAudioStream::DEFAULT_TIME_STRETCHING_ENABLED };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
 std::map<QString, std::shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
@@ -54,6 +55,11 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 QHash<QString, AABox> AudioMixer::_audioZones;
 QVector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 QVector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+std::vector<AABox> AudioMixer::_audioZoneBoxes;
+std::vector<int> AudioMixer::_zonePairSettings;
+std::vector<int> AudioMixer::_zoneReverbSettingsIndex;
+AudioMixer::AudioZoneMask AudioMixer::_attenuatedSourceZones { 0 };
+AudioMixer::AudioZoneMask AudioMixer::_attenuatedListenerZones { 0 };
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -270,6 +276,7 @@ void AudioMixer::sendStatsPacket() {
 
     // general stats
     statsObject["useDynamicJitterBuffers"] = _numStaticJitterFrames == DISABLE_STATIC_JITTER_FRAMES;
+    statsObject["useTimeStretchingJitterBuffers"] = _timeStretchingJitterBuffers;
 
     statsObject["threads"] = _slavePool.numThreads();
 
@@ -532,12 +539,14 @@ int AudioMixer::prepareFrame(const SharedNodePointer& node, unsigned int frame)
 
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
+    _timeStretchingJitterBuffers = InboundAudioStream::DEFAULT_TIME_STRETCHING_ENABLED;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    buildAudioZoneIndex();
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -578,6 +587,10 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
         }
 
+        const QString TIME_STRETCHING_JITTER_BUFFER_JSON_KEY = "time_stretching_jitter_buffer";
+        _timeStretchingJitterBuffers = audioBufferGroupObject[TIME_STRETCHING_JITTER_BUFFER_JSON_KEY].toBool();
+        qCDebug(audio) << "Time-stretching jitter buffers:" << (_timeStretchingJitterBuffers ? "enabled" : "disabled");
+
         // check for deprecated audio settings
         auto deprecationNotice = [](const QString& setting, const QString& value) {
             qInfo().nospace() << "[DEPRECATION NOTICE] " << setting << "(" << value << ") has been deprecated, and has no effect";
@@ -756,7 +769,102 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
                 }
             }
         }
+
+        buildAudioZoneIndex();
+    }
+}
+
+void AudioMixer::buildAudioZoneIndex() {
+    _audioZoneBoxes.clear();
+    _zonePairSettings.clear();
+    _zoneReverbSettingsIndex.clear();
+    _attenuatedSourceZones = 0;
+    _attenuatedListenerZones = 0;
+
+    QHash<QString, int> zoneIndices;
+    for (auto it = _audioZones.cbegin(); it != _audioZones.cend(); ++it) {
+        if ((int)_audioZoneBoxes.size() == MAX_AUDIO_ZONES) {
+            qCWarning(audio) << "Ignoring audio zone" << it.key() << "- only the first" << MAX_AUDIO_ZONES << "zones are used";
+            continue;
+        }
+        zoneIndices.insert(it.key(), (int)_audioZoneBoxes.size());
+        _audioZoneBoxes.push_back(it.value());
+    }
+
+    // keep the first setting for each pair, since the first match is the one that applies
+    const int numZones = (int)_audioZoneBoxes.size();
+    _zonePairSettings.resize(numZones * numZones, -1);
+    for (int i = 0; i < _zoneSettings.size(); ++i) {
+        auto source = zoneIndices.find(_zoneSettings[i].source);
+        auto listener = zoneIndices.find(_zoneSettings[i].listener);
+        if (source != zoneIndices.end() && listener != zoneIndices.end()) {
+            int& pairSetting = _zonePairSettings[source.value() * numZones + listener.value()];
+            if (pairSetting == -1) {
+                pairSetting = i;
+            }
+            _attenuatedSourceZones |= AudioZoneMask(1) << source.value();
+            _attenuatedListenerZones |= AudioZoneMask(1) << listener.value();
+        }
+    }
+
+    _zoneReverbSettingsIndex.resize(numZones, -1);
+    for (int i = 0; i < _zoneReverbSettings.size(); ++i) {
+        auto zone = zoneIndices.find(_zoneReverbSettings[i].zone);
+        if (zone != zoneIndices.end() && _zoneReverbSettingsIndex[zone.value()] == -1) {
+            _zoneReverbSettingsIndex[zone.value()] = i;
+        }
+    }
+}
+
+AudioMixer::AudioZoneMask AudioMixer::findAudioZones(const glm::vec3& position) {
+    AudioZoneMask zones = 0;
+    for (int i = 0; i < (int)_audioZoneBoxes.size(); ++i) {
+        if (_audioZoneBoxes[i].contains(position)) {
+            zones |= AudioZoneMask(1) << i;
+        }
+    }
+    return zones;
+}
+
+float AudioMixer::getZoneAttenuation(AudioZoneMask sourceZones, AudioZoneMask listenerZones) {
+    sourceZones &= _attenuatedSourceZones;
+    listenerZones &= _attenuatedListenerZones;
+
+    // streams are rarely in more than one zone, so this is usually a single lookup
+    const int numZones = (int)_audioZoneBoxes.size();
+    int firstSetting = -1;
+    for (int source = 0; sourceZones != 0; ++source, sourceZones >>= 1) {
+        if ((sourceZones & 1) == 0) {
+            continue;
+        }
+        AudioZoneMask listeners = listenerZones;
+        for (int listener = 0; listeners != 0; ++listener, listeners >>= 1) {
+            if ((listeners & 1) == 0) {
+                continue;
+            }
+            int setting = _zonePairSettings[source * numZones + listener];
+            if (setting != -1 && (firstSetting == -1 || setting < firstSetting)) {
+                firstSetting = setting;
+            }
+        }
+    }
+
+    return firstSetting != -1 ? _zoneSettings[firstSetting].coefficient : _attenuationPerDoublingInDistance;
+}
+
+const AudioMixer::ReverbSettings* AudioMixer::getZoneReverb(AudioZoneMask zones) {
+    int firstSetting = -1;
+    for (int zone = 0; zones != 0; ++zone, zones >>= 1) {
+        if ((zones & 1) == 0) {
+            continue;
+        }
+        int setting = _zoneReverbSettingsIndex[zone];
+        if (setting != -1 && (firstSetting == -1 || setting < firstSetting)) {
+            firstSetting = setting;
+        }
     }
+
+    return firstSetting != -1 ? &_zoneReverbSettings.at(firstSetting) : nullptr;
 }
 
 AudioMixer::Timer::Timing::Timing(uint64_t& sum) : _sum(sum) {
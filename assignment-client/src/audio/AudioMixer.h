@@ -46,11 +46,23 @@ public:
     };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
+    static bool getTimeStretchingJitterBuffers() { return _timeStretchingJitterBuffers; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
     static const QHash<QString, AABox>& getAudioZones() { return _audioZones; }
     static const QVector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const QVector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+
+    // zone membership is a mask, with bit i set for a position inside the i-th audio zone
+    static const int MAX_AUDIO_ZONES = 64;
+    using AudioZoneMask = uint64_t;
+    static AudioZoneMask findAudioZones(const glm::vec3& position);
+
+    // attenuation per doubling in distance from the first zone setting that matches, or the domain default
+    static float getZoneAttenuation(AudioZoneMask sourceZones, AudioZoneMask listenerZones);
+
+    // the first reverb setting for any of the zones, or nullptr
+    static const ReverbSettings* getZoneReverb(AudioZoneMask zones);
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
     static bool shouldReplicateTo(const Node& from, const Node& to) {
@@ -91,6 +103,7 @@ private:
 
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
+    static void buildAudioZoneIndex();
 
     float _trailingMixRatio { 0.0f };
     float _throttlingRatio { 0.0f };
@@ -132,6 +145,7 @@ private:
     Timer _packetsTiming;
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
+    static bool _timeStretchingJitterBuffers;
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
     static std::map<QString, CodecPluginPointer> _availableCodecs;
@@ -140,6 +154,13 @@ private:
     static QVector<ZoneSettings> _zoneSettings;
     static QVector<ReverbSettings> _zoneReverbSettings;
 
+    // index over the zone settings, rebuilt whenever they change
+    static std::vector<AABox> _audioZoneBoxes; // by zone index
+    static std::vector<int> _zonePairSettings; // [source zone * number of zones + listener zone] -> first _zoneSettings index, or -1
+    static std::vector<int> _zoneReverbSettingsIndex; // [zone] -> first _zoneReverbSettings index, or -1
+    static AudioZoneMask _attenuatedSourceZones; // zones that are the source of at least one zone setting
+    static AudioZoneMask _attenuatedListenerZones; // zones that are the listener of at least one zone setting
+
 };
 
 #endif // hifi_AudioMixer_h
@@ -295,6 +295,7 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
                 }
 
                 auto avatarAudioStream = new AvatarAudioStream(isStereo, AudioMixer::getStaticJitterFrames());
+                avatarAudioStream->setTimeStretchingEnabled(AudioMixer::getTimeStretchingJitterBuffers());
                 avatarAudioStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
                 qCDebug(audio) << "creating new AvatarAudioStream... codec:" << _selectedCodecName << "isStereo:" << isStereo;
 
@@ -332,6 +333,7 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
             if (streamIt == _audioStreams.end()) {
                 // we don't have this injected stream yet, so add it
                 auto injectorStream = new InjectedAudioStream(streamIdentifier, isStereo, AudioMixer::getStaticJitterFrames());
+                injectorStream->setTimeStretchingEnabled(AudioMixer::getTimeStretchingJitterBuffers());
 
 #if INJECTORS_SUPPORT_CODECS
                 injectorStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
@@ -379,6 +381,9 @@ int AudioMixerClientData::checkBuffersBeforeFrameSend() {
             stream->updateLastPopOutputLoudnessAndTrailingLoudness();
         }
 
+        // resolve zone membership once here instead of for every listener in the mix
+        stream->setAudioZones(AudioMixer::findAudioZones(stream->getPosition()));
+
         static const int INJECTOR_MAX_INACTIVE_BLOCKS = 500;
 
         // if we don't have new data for an injected stream in the last INJECTOR_MAX_INACTIVE_BLOCKS then
@@ -478,6 +483,10 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
     downstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
     downstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
     downstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
+    downstreamStats["added_latency_ms"] = (double) streamStats._addedLatencyMs;
+    downstreamStats["concealed%"] = streamStats.getConcealRate() * 100.0f;
+    downstreamStats["stretched"] = (double) streamStats._framesStretched;
+    downstreamStats["compressed"] = (double) streamStats._framesCompressed;
 
     result["downstream"] = downstreamStats;
 
@@ -504,6 +513,10 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         upstreamStats["min_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMin);
         upstreamStats["max_gap_30s"] = formatUsecTime(streamStats._timeGapWindowMax);
         upstreamStats["avg_gap_30s"] = formatUsecTime(streamStats._timeGapWindowAverage);
+        upstreamStats["added_latency_ms"] = (double) streamStats._addedLatencyMs;
+        upstreamStats["concealed%"] = streamStats.getConcealRate() * 100.0f;
+        upstreamStats["stretched"] = (double) streamStats._framesStretched;
+        upstreamStats["compressed"] = (double) streamStats._framesCompressed;
 
         result["upstream"] = upstreamStats;
     } else {
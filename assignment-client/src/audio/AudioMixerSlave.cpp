@@ -436,21 +436,14 @@ void sendEnvironmentPacket(const SharedNodePointer& node, AudioMixerClientData&
     bool hasReverb = false;
     float reverbTime, wetLevel;
 
-    auto& reverbSettings = AudioMixer::getReverbSettings();
-    auto& audioZones = AudioMixer::getAudioZones();
-
     AvatarAudioStream* stream = data.getAvatarAudioStream();
-    glm::vec3 streamPosition = stream->getPosition();
 
     // find reverb properties
-    for (int i = 0; i < reverbSettings.size(); ++i) {
-        AABox box = audioZones[reverbSettings[i].zone];
-        if (box.contains(streamPosition)) {
-            hasReverb = true;
-            reverbTime = reverbSettings[i].reverbTime;
-            wetLevel = reverbSettings[i].wetLevel;
-            break;
-        }
+    auto reverbSettings = AudioMixer::getZoneReverb(stream->getAudioZones());
+    if (reverbSettings) {
+        hasReverb = true;
+        reverbTime = reverbSettings->reverbTime;
+        wetLevel = reverbSettings->wetLevel;
     }
 
     // check if data changed
@@ -537,18 +530,9 @@ float computeGain(const AudioMixerClientData& listenerNodeData, const AvatarAudi
         gain *= listenerNodeData.getMasterAvatarGain();
     }
 
-    auto& audioZones = AudioMixer::getAudioZones();
-    auto& zoneSettings = AudioMixer::getZoneSettings();
-
     // find distance attenuation coefficient
-    float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
-    for (int i = 0; i < zoneSettings.length(); ++i) {
-        if (audioZones[zoneSettings[i].source].contains(streamToAdd.getPosition()) &&
-            audioZones[zoneSettings[i].listener].contains(listeningNodeStream.getPosition())) {
-            attenuationPerDoublingInDistance = zoneSettings[i].coefficient;
-            break;
-        }
-    }
+    float attenuationPerDoublingInDistance = AudioMixer::getZoneAttenuation(streamToAdd.getAudioZones(),
+                                                                            listeningNodeStream.getAudioZones());
     // translate the zone setting to gain per log2(distance)
     float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, EPSILON, 1.0f);
 
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <udt/PacketHeaders.h>
 
+#include <AvatarLogging.h>
 #include <DependencyManager.h>
 #include <NodeList.h>
 
@@ -24,6 +25,9 @@ AvatarMixerClientData::AvatarMixerClientData(const QUuid& nodeID, Node::LocalID
 {
     // in case somebody calls getSessionUUID on the AvatarData instance, make sure it has the right ID
     _avatar->setID(nodeID);
+
+    // the joints are passed on to receivers that may be a few frames behind
+    _avatar->setKeepsRecentJointFrames(true);
 }
 
 uint64_t AvatarMixerClientData::getLastOtherAvatarEncodeTime(QUuid otherAvatar) const {
@@ -43,6 +47,14 @@ void AvatarMixerClientData::setLastOtherAvatarEncodeTime(const QUuid& otherAvata
     }
 }
 
+int AvatarMixerClientData::getLastOtherAvatarJointFrame(const QUuid& otherAvatar) const {
+    auto itr = _lastOtherAvatarJointFrames.find(otherAvatar);
+    if (itr != _lastOtherAvatarJointFrames.end()) {
+        return itr->second;
+    }
+    return -1;
+}
+
 void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     if (!_packetQueue.node) {
         _packetQueue.node = node;
@@ -64,10 +76,14 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
         switch (packet->getType()) {
             case PacketType::AvatarData:
                 parseData(*packet);
+                _avatar->sendJointResyncRequestIfBehind(node);
                 break;
             case PacketType::SetAvatarTraits:
                 processSetTraitsMessage(*packet, slaveSharedData, *node);
                 break;
+            case PacketType::AvatarJointResyncRequest:
+                processJointResyncRequest(*packet);
+                break;
             default:
                 Q_UNREACHABLE();
         }
@@ -94,6 +110,19 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message) {
     return _avatar->parseDataFromBuffer(message.readWithoutCopy(message.getBytesLeftToRead()));
 }
 
+void AvatarMixerClientData::processJointResyncRequest(ReceivedMessage& message) {
+    if (message.getSize() < NUM_BYTES_RFC4122_UUID + (qint64)sizeof(qint32)) {
+        qCDebug(avatars) << "Malformed AvatarJointResyncRequest received from" << message.getSenderSockAddr().toString();
+        return;
+    }
+
+    // the frames sent since the one this node has will be caught up from it
+    QUuid otherAvatar = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    qint32 frame;
+    message.readPrimitive(&frame);
+    setLastOtherAvatarJointFrame(otherAvatar, frame);
+}
+
 void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                                                     const SlaveSharedData& slaveSharedData, Node& sendingNode) {
     // pull the trait version from the message
@@ -233,6 +262,7 @@ void AvatarMixerClientData::ignoreOther(const Node* self, const Node* other) {
             killPacket->writePrimitive(KillAvatarReason::YourAvatarEnteredTheirBubble);
         }
         setLastBroadcastTime(other->getUUID(), 0);
+        _lastOtherAvatarJointFrames.erase(other->getUUID());
 
         resetSentTraitData(other->getLocalID());
 
@@ -314,6 +344,7 @@ AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherA
 void AvatarMixerClientData::cleanupKilledNode(const QUuid& nodeUUID, Node::LocalID nodeLocalID) {
     removeLastBroadcastSequenceNumber(nodeUUID);
     removeLastBroadcastTime(nodeUUID);
+    _lastOtherAvatarJointFrames.erase(nodeUUID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
     _sentTraitVersions.erase(nodeLocalID);
 }
@@ -116,10 +116,15 @@ public:
 
     QVector<JointData>& getLastOtherAvatarSentJoints(QUuid otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
+    // the last frame of predicted joint data sent for another avatar, or -1 if this node doesn't have one to predict from
+    int getLastOtherAvatarJointFrame(const QUuid& otherAvatar) const;
+    void setLastOtherAvatarJointFrame(const QUuid& otherAvatar, int frame) { _lastOtherAvatarJointFrames[otherAvatar] = frame; }
+
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
 
     void processSetTraitsMessage(ReceivedMessage& message, const SlaveSharedData& slaveSharedData, Node& sendingNode);
+    void processJointResyncRequest(ReceivedMessage& message);
     void checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData, Node& sendingNode,
                                           AvatarTraits::TraitVersion traitVersion);
 
@@ -154,6 +159,7 @@ private:
     // sending to "this" node
     std::unordered_map<QUuid, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<QUuid, QVector<JointData>> _lastOtherAvatarSentJoints;
+    std::unordered_map<QUuid, int> _lastOtherAvatarJointFrames;
 
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
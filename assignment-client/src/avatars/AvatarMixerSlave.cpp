@@ -461,9 +461,38 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         bool dropFaceTracking = false;
 
         auto startSerialize = chrono::high_resolution_clock::now();
+
+        // predicted joint data is passed on as it was received, or caught up from the frame the receiver has
+        int predictedJointFrame = -1;
+        QByteArray predictedJointData;
+        if (detail == AvatarData::CullSmallData || detail == AvatarData::SendAllData) {
+            predictedJointData = otherAvatar->getPredictedJointDataToForward(
+                nodeData->getLastOtherAvatarJointFrame(otherNode->getUUID()), predictedJointFrame);
+        }
+
+        // A catch up pays off when the receiver is sent the frames after it. One that wasn't sent this avatar last frame
+        // will likely need catching up again next time, so it gets the six byte joints instead if they cost less.
+        const quint64 MAX_USECS_BETWEEN_FRAMES = 3 * USECS_PER_SECOND / (2 * AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+        QByteArray sixByteBytes;
+        AvatarDataPacket::HasFlags sixByteHasFlags;
+        QVector<JointData> sixByteSentJoints;
+        if (!predictedJointData.isEmpty() && usecTimestampNow() - lastEncodeForOther > MAX_USECS_BETWEEN_FRAMES
+            && PredictedJointData::isCatchUp(reinterpret_cast<const uint8_t*>(predictedJointData.constData()))) {
+            sixByteSentJoints = lastSentJointsForOther;
+            sixByteBytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                                                    sixByteHasFlags, dropFaceTracking, distanceAdjust, viewerPosition,
+                                                    &sixByteSentJoints);
+        }
+
         QByteArray bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
                                                     hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition,
-                                                    &lastSentJointsForOther);
+                                                    &lastSentJointsForOther, nullptr, &predictedJointData);
+        if (!sixByteBytes.isEmpty() && sixByteBytes.size() <= bytes.size()) {
+            bytes = sixByteBytes;
+            hasFlagsOut = sixByteHasFlags;
+            lastSentJointsForOther = sixByteSentJoints;
+            predictedJointData.clear();
+        }
         auto endSerialize = chrono::high_resolution_clock::now();
         _stats.toByteArrayElapsedTime +=
             (quint64) chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
@@ -474,14 +503,16 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 
             dropFaceTracking = true; // first try dropping the facial data
             bytes = otherAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                                             hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                                             hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther,
+                                             nullptr, &predictedJointData);
 
             if (bytes.size() > maxAvatarDataBytes) {
                 qCWarning(avatars) << "otherAvatar.toByteArray() for" << otherNode->getUUID()
                     << "without facial data resulted in very large buffer of" << bytes.size()
                     << "bytes - reducing to MinimumData";
                 bytes = otherAvatar->toByteArray(AvatarData::MinimumData, lastEncodeForOther, lastSentJointsForOther,
-                                                 hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther);
+                                                 hasFlagsOut, dropFaceTracking, distanceAdjust, viewerPosition, &lastSentJointsForOther,
+                                                 nullptr, &predictedJointData);
 
                 if (bytes.size() > maxAvatarDataBytes) {
                     qCWarning(avatars) << "otherAvatar.toByteArray() for" << otherNode->getUUID()
@@ -509,6 +540,13 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
                 nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
                                                          otherNodeData->getLastReceivedSequenceNumber());
                 nodeData->setLastOtherAvatarEncodeTime(otherNode->getUUID(), usecTimestampNow());
+
+                // remember which joint frame the receiver has, to pass on the frames that follow it
+                if (hasFlagsOut & AvatarDataPacket::PACKET_HAS_PREDICTED_JOINT_DATA) {
+                    nodeData->setLastOtherAvatarJointFrame(otherNode->getUUID(), predictedJointFrame);
+                } else if (hasFlagsOut & AvatarDataPacket::PACKET_HAS_JOINT_DATA) {
+                    nodeData->setLastOtherAvatarJointFrame(otherNode->getUUID(), -1);
+                }
             }
         } else {
             // TODO? this avatar is not included now, and will probably not be included next frame.
@@ -411,6 +411,33 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    // display edit filter stats, so the cost of edits that go through a filter script can be compared to those that don't
+    auto entityEditFilters = DependencyManager::get<EntityEditFilters>();
+    if (entityEditFilters) {
+        EntityEditFilters::Stats filterStats = entityEditFilters->getStats();
+        quint64 averageTimeWithoutScript = (filterStats.editsWithoutScript == 0) ? 0 :
+            filterStats.editsWithoutScriptTime / filterStats.editsWithoutScript;
+        quint64 averageTimeWithScript = (filterStats.editsWithScript == 0) ? 0 :
+            filterStats.editsWithScriptTime / filterStats.editsWithScript;
+
+        statsString += "<b>Entity Server Edit Filter Statistics</b>\r\n";
+        statsString += QString("           Edits without filter script: %1\r\n")
+            .arg(locale.toString((qulonglong)filterStats.editsWithoutScript).rightJustified(12, ' '));
+        statsString += QString("   Average filter time without script: %1 usecs\r\n")
+            .arg(locale.toString((qulonglong)averageTimeWithoutScript).rightJustified(12, ' '));
+        statsString += QString("              Edits with filter script: %1\r\n")
+            .arg(locale.toString((qulonglong)filterStats.editsWithScript).rightJustified(12, ' '));
+        statsString += QString("      Average filter time with script: %1 usecs\r\n")
+            .arg(locale.toString((qulonglong)averageTimeWithScript).rightJustified(12, ' '));
+        statsString += QString("                   Filter script calls: %1\r\n")
+            .arg(locale.toString((qulonglong)filterStats.scriptCalls).rightJustified(12, ' '));
+        statsString += QString("   Script calls skipped (no inspected): %1\r\n")
+            .arg(locale.toString((qulonglong)filterStats.skippedScriptCalls).rightJustified(12, ' '));
+        statsString += QString("              Edits rejected by rules: %1\r\n")
+            .arg(locale.toString((qulonglong)filterStats.rejectedByRules).rightJustified(12, ' '));
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
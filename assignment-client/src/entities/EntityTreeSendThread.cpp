@@ -33,6 +33,7 @@ void EntityTreeSendThread::resetState() {
 
     _knownState.clear();
     _traversal.reset();
+    _traverseFirstInParallel = false;
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -151,7 +152,12 @@ bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, O
         #else
         const uint64_t TIME_BUDGET = 200; // usec
         #endif
-        _traversal.traverse(TIME_BUDGET);
+        if (_traverseFirstInParallel) {
+            runFirstTraversal(TIME_BUDGET);
+            _traverseFirstInParallel = !_traversal.finished();
+        } else {
+            _traversal.traverse(TIME_BUDGET);
+        }
         OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
     }
 
@@ -223,6 +229,7 @@ bool EntityTreeSendThread::addDescendantsToExtraFlaggedEntities(const QUuid& fil
 void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root) {
 
     DiffTraversal::Type type = _traversal.prepareNewTraversal(view, root);
+    _traverseFirstInParallel = (type == DiffTraversal::First);
     // there are three types of traversal:
     //
     //      (1) FirstTime = at login --> find everything in view
@@ -234,21 +241,8 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     switch (type) {
         case DiffTraversal::First:
             // When we get to a First traversal, clear the _knownState
+            // (First traversals are run by runFirstTraversal, which scans with prioritizeFirstTimeEntities)
             _knownState.clear();
-            _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
-                next.element->forEachEntity([&](EntityItemPointer entity) {
-                    // Bail early if we've already checked this entity this frame
-                    if (_sendQueue.contains(entity.get())) {
-                        return;
-                    }
-                    const auto& view = _traversal.getCurrentView();
-                    float priority = view.computePriority(entity);
-
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority);
-                    }
-                });
-            });
             break;
         case DiffTraversal::Repeat:
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
@@ -311,6 +305,40 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     }
 }
 
+void EntityTreeSendThread::runFirstTraversal(uint64_t timeBudget) {
+    // a First traversal has to visit everything in view, so each pass fans as much of it as fits in the time budget
+    // out across the worker pool, and what it found can be sent while the rest of the tree is still being scanned
+    EntityPriorityQueue firstResults;
+    _traversal.traverseFirstInParallel(timeBudget, [this](DiffTraversal::VisibleElement& next, EntityPriorityQueue& queue) {
+        prioritizeFirstTimeEntities(next, queue);
+    }, firstResults);
+
+    while (!firstResults.empty()) {
+        const PrioritizedEntity& prioritizedEntity = firstResults.top();
+        EntityItemPointer entity = prioritizedEntity.getEntity();
+        if (entity && !_sendQueue.contains(entity.get())) {
+            _sendQueue.emplace(entity, prioritizedEntity.getPriority());
+        }
+        firstResults.pop();
+    }
+}
+
+void EntityTreeSendThread::prioritizeFirstTimeEntities(DiffTraversal::VisibleElement& next, EntityPriorityQueue& queue) const {
+    // NOTE: during a parallel First traversal this runs on worker threads, each with its own queue fragment
+    next.element->forEachEntity([&](EntityItemPointer entity) {
+        // Bail early if we've already checked this entity this frame
+        if (queue.contains(entity.get())) {
+            return;
+        }
+        const auto& view = _traversal.getCurrentView();
+        float priority = view.computePriority(entity);
+
+        if (priority != PrioritizedEntity::DO_NOT_SEND) {
+            queue.emplace(entity, priority);
+        }
+    });
+}
+
 bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) {
     if (_sendQueue.empty()) {
         params.stopReason = EncodeBitstreamParams::FINISHED;
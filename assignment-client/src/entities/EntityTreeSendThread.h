@@ -43,6 +43,8 @@ private:
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root);
+    void runFirstTraversal(uint64_t timeBudget);
+    void prioritizeFirstTimeEntities(DiffTraversal::VisibleElement& next, EntityPriorityQueue& queue) const;
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
     void preDistributionProcessing() override;
@@ -50,6 +52,7 @@ private:
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
 
     DiffTraversal _traversal;
+    bool _traverseFirstInParallel { false }; // set while a First traversal is prepared but not yet finished
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
 
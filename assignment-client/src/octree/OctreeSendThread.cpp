@@ -12,6 +12,8 @@
 #include "OctreeSendThread.h"
 
 #include <chrono>
+#include <cstdlib>
+#include <new>
 #include <thread>
 
 #include <NodeList.h>
@@ -23,6 +25,10 @@
 #include "OctreeServerConsts.h"
 #include "OctreeLogging.h"
 
+#ifdef Q_OS_WIN
+#include <malloc.h>
+#endif
+
 quint64 startSceneSleepTime = 0;
 quint64 endSceneSleepTime = 0;
 
@@ -44,6 +50,30 @@ OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePoint
                                             "- starting sending thread [" << this << "]";
 
     OctreeServer::clientConnected();
+    OctreeServer::startTrackingThread(this);
+}
+
+void* OctreeSendThread::operator new(size_t size) {
+    void* pointer = nullptr;
+#ifdef Q_OS_WIN
+    pointer = _aligned_malloc(size, alignof(OctreeSendThread));
+#else
+    if (posix_memalign(&pointer, alignof(OctreeSendThread), size) != 0) {
+        pointer = nullptr;
+    }
+#endif
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void OctreeSendThread::operator delete(void* pointer) {
+#ifdef Q_OS_WIN
+    _aligned_free(pointer);
+#else
+    free(pointer);
+#endif
 }
 
 OctreeSendThread::~OctreeSendThread() {
@@ -411,8 +441,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     }
 
     quint64 end = usecTimestampNow();
-    int elapsedmsec = (end - start) / USECS_PER_MSEC;
-    OctreeServer::trackLoopTime(elapsedmsec);
+    OctreeServer::trackLoopTime(end - start);
 
     // if we've sent everything, then we want to remember that we've sent all
     // the octree elements from the current view frustum
@@ -26,6 +26,18 @@ class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
+const size_t OCTREE_SEND_THREAD_CACHE_LINE_SIZE = 64;
+
+/// Timestamps of the last time a send thread reached each tracked state. Each send thread owns its own
+/// slots so the hot send path never takes a shared lock; the stats page reads them on demand.
+/// Each slot has a cache line of its own, so reading one never pulls in a line the send thread is writing to.
+struct alignas(OCTREE_SEND_THREAD_CACHE_LINE_SIZE) OctreeSendThreadActivity {
+    alignas(OCTREE_SEND_THREAD_CACHE_LINE_SIZE) std::atomic<quint64> didProcess { 0 };
+    alignas(OCTREE_SEND_THREAD_CACHE_LINE_SIZE) std::atomic<quint64> didPacketDistributor { 0 };
+    alignas(OCTREE_SEND_THREAD_CACHE_LINE_SIZE) std::atomic<quint64> didHandlePacketSend { 0 };
+    alignas(OCTREE_SEND_THREAD_CACHE_LINE_SIZE) std::atomic<quint64> didCallWriteDatagram { 0 };
+};
+
 /// Threaded processor for sending octree packets to a single client
 class OctreeSendThread : public GenericThread {
     Q_OBJECT
@@ -33,11 +45,18 @@ public:
     OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
     virtual ~OctreeSendThread();
 
+    // the global operator new doesn't honor the alignment of _activity before C++17
+    static void* operator new(size_t size);
+    static void operator delete(void* pointer);
+
     void setIsShuttingDown();
     bool isShuttingDown() { return _isShuttingDown; }
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    OctreeSendThreadActivity& getActivity() { return _activity; }
+    const OctreeSendThreadActivity& getActivity() const { return _activity; }
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -74,6 +93,8 @@ private:
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
     bool _isShuttingDown { false };
+
+    OctreeSendThreadActivity _activity;
 };
 
 #endif // hifi_OctreeSendThread_h
@@ -88,11 +88,15 @@ int OctreeServer::_longProcessWait = 0;
 int OctreeServer::_shortProcessWait = 0;
 int OctreeServer::_noProcessWait = 0;
 
+OctreeServer::TimingHistogram OctreeServer::_loopTimeHistogram;
+OctreeServer::TimingHistogram OctreeServer::_treeTraverseTimeHistogram;
+
 static const QString PERSIST_FILE_DOWNLOAD_PATH = "/models.json.gz";
 
 
 void OctreeServer::resetSendingStats() {
     _averageLoopTime.reset();
+    _loopTimeHistogram.reset();
 
     _averageEncodeTime.reset();
     _averageShortEncodeTime.reset();
@@ -114,6 +118,7 @@ void OctreeServer::resetSendingStats() {
     _noTreeWait = 0;
 
     _averageTreeTraverseTime.reset();
+    _treeTraverseTimeHistogram.reset();
 
     _averageNodeWaitTime.reset();
 
@@ -180,6 +185,17 @@ void OctreeServer::trackTreeWaitTime(float time) {
     }
 }
 
+void OctreeServer::trackLoopTime(quint64 elapsedUsecs) {
+    // the average keeps reporting whole msecs, the histogram gets usecs so sub-msec loops don't all land in one bucket
+    _averageLoopTime.updateAverage((float)(elapsedUsecs / USECS_PER_MSEC));
+    _loopTimeHistogram.addSample(elapsedUsecs);
+}
+
+void OctreeServer::trackTreeTraverseTime(float time) {
+    _averageTreeTraverseTime.updateAverage(time);
+    _treeTraverseTimeHistogram.addSample((uint64_t)std::max(time, 0.0f));
+}
+
 void OctreeServer::trackCompressAndWriteTime(float time) {
     const float MAX_SHORT_TIME = 10.0f;
     const float MAX_LONG_TIME = 100.0f;
@@ -616,6 +632,8 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
         statsString += QString("\r\n");
 
+        statsString += getTimingHistograms();
+
         statsString += QString("           Total Outbound Packets: %1 packets\r\n")
             .arg(locale.toString((uint)totalOutboundPackets).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("             Total Outbound Bytes: %1 bytes\r\n")
@@ -1403,6 +1421,50 @@ QString OctreeServer::getStatusLink() {
     return result;
 }
 
+static QString formatTimingHistogram(const QString& title, const QString& units,
+                                     const OctreeServer::TimingHistogram::Counts& counts) {
+    const int MAX_BAR_WIDTH = 40;
+    const float AS_PERCENT = 100.0f;
+
+    quint64 total = 0;
+    quint64 largest = 0;
+    int firstBucket = -1;
+    int lastBucket = -1;
+    for (int i = 0; i < (int)counts.size(); i++) {
+        total += counts[i];
+        largest = std::max(largest, (quint64)counts[i]);
+        if (counts[i] > 0) {
+            firstBucket = (firstBucket < 0) ? i : firstBucket;
+            lastBucket = i;
+        }
+    }
+
+    QString result = QString("  %1 histogram (%2 samples):\r\n").arg(title).arg(total);
+    if (total == 0) {
+        return result + "\r\n";
+    }
+
+    for (int i = firstBucket; i <= lastBucket; i++) {
+        quint64 lowerBound = (i == 0) ? 0 : OctreeServer::TimingHistogram::getBucketUpperBound(i - 1);
+        quint64 upperBound = OctreeServer::TimingHistogram::getBucketUpperBound(i);
+        QString range = (upperBound > 0) ? QString("%1 - %2").arg(lowerBound).arg(upperBound - 1)
+                                         : QString("%1 +").arg(lowerBound);
+        int barWidth = (int)((counts[i] * MAX_BAR_WIDTH) / largest);
+        result += QString().sprintf("    %18s %s: %12llu (%6.2f%%) %s\r\n",
+                                    range.toLocal8Bit().constData(), units.toLocal8Bit().constData(),
+                                    (unsigned long long)counts[i], (double)((counts[i] / (float)total) * AS_PERCENT),
+                                    QString(barWidth, '#').toLocal8Bit().constData());
+    }
+    return result + "\r\n";
+}
+
+QString OctreeServer::getTimingHistograms() {
+    QString result;
+    result += formatTimingHistogram("packetLoop() time", "usecs", _loopTimeHistogram.getCounts());
+    result += formatTimingHistogram("tree traverse time", "usecs", _treeTraverseTimeHistogram.getCounts());
+    return result;
+}
+
 void OctreeServer::sendStatsPacket() {
     // Stats Array 1
     QJsonObject threadsStats;
@@ -1480,90 +1542,65 @@ void OctreeServer::sendStatsPacket() {
     addPacketStatsAndSendStatsPacket(statsObject);
 }
 
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidProcess;
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidPacketDistributor;
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidHandlePacketSend;
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidCallWriteDatagram;
-
-QMutex OctreeServer::_threadsDidProcessMutex;
-QMutex OctreeServer::_threadsDidPacketDistributorMutex;
-QMutex OctreeServer::_threadsDidHandlePacketSendMutex;
-QMutex OctreeServer::_threadsDidCallWriteDatagramMutex;
+QSet<OctreeSendThread*> OctreeServer::_trackedThreads;
+QMutex OctreeServer::_trackedThreadsMutex;
 
+void OctreeServer::startTrackingThread(OctreeSendThread* thread) {
+    QMutexLocker locker(&_trackedThreadsMutex);
+    _trackedThreads.insert(thread);
+}
 
 void OctreeServer::didProcess(OctreeSendThread* thread) {
-    QMutexLocker locker(&_threadsDidProcessMutex);
-    _threadsDidProcess[thread] = usecTimestampNow();
+    thread->getActivity().didProcess.store(usecTimestampNow(), std::memory_order_relaxed);
 }
 
 void OctreeServer::didPacketDistributor(OctreeSendThread* thread) {
-    QMutexLocker locker(&_threadsDidPacketDistributorMutex);
-    _threadsDidPacketDistributor[thread] = usecTimestampNow();
+    thread->getActivity().didPacketDistributor.store(usecTimestampNow(), std::memory_order_relaxed);
 }
 
 void OctreeServer::didHandlePacketSend(OctreeSendThread* thread) {
-    QMutexLocker locker(&_threadsDidHandlePacketSendMutex);
-    _threadsDidHandlePacketSend[thread] = usecTimestampNow();
+    thread->getActivity().didHandlePacketSend.store(usecTimestampNow(), std::memory_order_relaxed);
 }
 
 void OctreeServer::didCallWriteDatagram(OctreeSendThread* thread) {
-    QMutexLocker locker(&_threadsDidCallWriteDatagramMutex);
-    _threadsDidCallWriteDatagram[thread] = usecTimestampNow();
+    thread->getActivity().didCallWriteDatagram.store(usecTimestampNow(), std::memory_order_relaxed);
 }
 
-
 void OctreeServer::stopTrackingThread(OctreeSendThread* thread) {
-    {
-        QMutexLocker locker(&_threadsDidProcessMutex);
-        _threadsDidProcess.remove(thread);
-    }
-    {
-        QMutexLocker locker(&_threadsDidPacketDistributorMutex);
-        _threadsDidPacketDistributor.remove(thread);
-    }
-    {
-        QMutexLocker locker(&_threadsDidHandlePacketSendMutex);
-        _threadsDidHandlePacketSend.remove(thread);
-    }
-    {
-        QMutexLocker locker(&_threadsDidCallWriteDatagramMutex);
-        _threadsDidCallWriteDatagram.remove(thread);
-    }
+    QMutexLocker locker(&_trackedThreadsMutex);
+    _trackedThreads.remove(thread);
 }
 
-int howManyThreadsDidSomething(QMutex& mutex, QMap<OctreeSendThread*, quint64>& something, quint64 since) {
+using ActivitySlot = std::atomic<quint64> OctreeSendThreadActivity::*;
+
+int howManyThreadsDidSomething(const QSet<OctreeSendThread*>& threads, ActivitySlot slot, quint64 since) {
+    // a zero timestamp means the thread never reached this state, so since == 0 counts every thread that ever did
     int count = 0;
-    if (mutex.tryLock()) {
-        if (since == 0) {
-            count = something.size();
-        } else {
-            QMap<OctreeSendThread*, quint64>::const_iterator i = something.constBegin();
-            while (i != something.constEnd()) {
-                if (i.value() > since) {
-                    count++;
-                }
-                ++i;
-            }
+    for (auto thread : threads) {
+        if ((thread->getActivity().*slot).load(std::memory_order_relaxed) > since) {
+            count++;
         }
-        mutex.unlock();
     }
     return count;
 }
 
 
 int OctreeServer::howManyThreadsDidProcess(quint64 since) {
-    return howManyThreadsDidSomething(_threadsDidProcessMutex, _threadsDidProcess, since);
+    QMutexLocker locker(&_trackedThreadsMutex);
+    return howManyThreadsDidSomething(_trackedThreads, &OctreeSendThreadActivity::didProcess, since);
 }
 
 int OctreeServer::howManyThreadsDidPacketDistributor(quint64 since) {
-    return howManyThreadsDidSomething(_threadsDidPacketDistributorMutex, _threadsDidPacketDistributor, since);
+    QMutexLocker locker(&_trackedThreadsMutex);
+    return howManyThreadsDidSomething(_trackedThreads, &OctreeSendThreadActivity::didPacketDistributor, since);
 }
 
 int OctreeServer::howManyThreadsDidHandlePacketSend(quint64 since) {
-    return howManyThreadsDidSomething(_threadsDidHandlePacketSendMutex, _threadsDidHandlePacketSend, since);
+    QMutexLocker locker(&_trackedThreadsMutex);
+    return howManyThreadsDidSomething(_trackedThreads, &OctreeSendThreadActivity::didHandlePacketSend, since);
 }
 
 int OctreeServer::howManyThreadsDidCallWriteDatagram(quint64 since) {
-    return howManyThreadsDidSomething(_threadsDidCallWriteDatagramMutex, _threadsDidCallWriteDatagram, since);
+    QMutexLocker locker(&_trackedThreadsMutex);
+    return howManyThreadsDidSomething(_trackedThreads, &OctreeSendThreadActivity::didCallWriteDatagram, since);
 }
-
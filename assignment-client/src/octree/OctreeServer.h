@@ -16,8 +16,11 @@
 
 #include <QStringList>
 #include <QDateTime>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
 #include <QtCore/QCoreApplication>
 
+#include <AtomicHistogram.h>
 #include <HTTPManager.h>
 
 #include <ThreadedAssignment.h>
@@ -87,7 +90,9 @@ public:
 
     static float SKIP_TIME; // use this for trackXXXTime() calls for non-times
 
-    static void trackLoopTime(float time) { _averageLoopTime.updateAverage(time); }
+    using TimingHistogram = AtomicHistogram<24>;
+
+    static void trackLoopTime(quint64 elapsedUsecs);
     static float getAverageLoopTime() { return _averageLoopTime.getAverage(); }
 
     static void trackEncodeTime(float time);
@@ -99,7 +104,7 @@ public:
     static void trackTreeWaitTime(float time);
     static float getAverageTreeWaitTime() { return _averageTreeWaitTime.getAverage(); }
 
-    static void trackTreeTraverseTime(float time) { _averageTreeTraverseTime.updateAverage(time); }
+    static void trackTreeTraverseTime(float time);
     static float getAverageTreeTraverseTime() { return _averageTreeTraverseTime.getAverage(); }
 
     static void trackNodeWaitTime(float time) { _averageNodeWaitTime.updateAverage(time); }
@@ -115,6 +120,7 @@ public:
     static float getAverageProcessWaitTime() { return _averageProcessWaitTime.getAverage(); }
 
     // these methods allow us to track which threads got to various states
+    static void startTrackingThread(OctreeSendThread* thread);
     static void didProcess(OctreeSendThread* thread);
     static void didPacketDistributor(OctreeSendThread* thread);
     static void didHandlePacketSend(OctreeSendThread* thread);
@@ -161,6 +167,7 @@ protected:
     QString getFileLoadTime();
     QString getConfiguration();
     QString getStatusLink();
+    QString getTimingHistograms();
 
     void beginRunning();
     
@@ -251,15 +258,13 @@ protected:
     static int _shortProcessWait;
     static int _noProcessWait;
 
-    static QMap<OctreeSendThread*, quint64> _threadsDidProcess;
-    static QMap<OctreeSendThread*, quint64> _threadsDidPacketDistributor;
-    static QMap<OctreeSendThread*, quint64> _threadsDidHandlePacketSend;
-    static QMap<OctreeSendThread*, quint64> _threadsDidCallWriteDatagram;
+    static TimingHistogram _loopTimeHistogram; // usecs
+    static TimingHistogram _treeTraverseTimeHistogram; // usecs
 
-    static QMutex _threadsDidProcessMutex;
-    static QMutex _threadsDidPacketDistributorMutex;
-    static QMutex _threadsDidHandlePacketSendMutex;
-    static QMutex _threadsDidCallWriteDatagramMutex;
+    // the send threads write their own OctreeSendThreadActivity slots, this set (and its mutex) is only
+    // touched when a send thread starts or stops and when the stats are aggregated
+    static QSet<OctreeSendThread*> _trackedThreads;
+    static QMutex _trackedThreadsMutex;
 };
 
 #endif // hifi_OctreeServer_h
@@ -13,12 +13,15 @@
 
 #include <mutex>
 
+#include <QtCore/QJsonObject>
+
 #include <AudioConstants.h>
 #include <AudioInjectorManager.h>
 #include <ClientServerUtils.h>
 #include <DebugDraw.h>
 #include <EntityNodeData.h>
 #include <EntityScriptingInterface.h>
+#include <EntityTreeElement.h>
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <plugins/CodecPlugin.h>
@@ -27,6 +30,7 @@
 #include <ResourceScriptingInterface.h>
 #include <ScriptCache.h>
 #include <ScriptEngines.h>
+#include <ScriptProfiler.h>
 #include <SoundCacheScriptingInterface.h>
 #include <UUID.h>
 #include <WebSocketServerClass.h>
@@ -112,7 +116,11 @@ void EntityScriptServer::handleReloadEntityServerScriptPacket(QSharedPointer<Rec
 
         if (_entityViewer.getTree() && !_shuttingDown) {
             qCDebug(entity_script_server) << "Reloading: " << entityID;
-            _entitiesScriptEngine->unloadEntityScript(entityID);
+            int shard = _entitiesScriptEngines->shardForEntity(entityID);
+            auto engine = _entitiesScriptEngines->getEngine(shard);
+            _entitiesScriptEngines->post(shard, [engine, entityID] {
+                engine->unloadEntityScript(entityID);
+            });
             checkAndCallPreload(entityID, true);
         }
     }
@@ -128,7 +136,7 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        if (_entitiesScriptEngines && _entitiesScriptEngines->engineForEntity(entityID)->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -157,6 +165,24 @@ void EntityScriptServer::handleSettings() {
 
     auto entityScriptServerSettings = settingsObject[ENTITY_SCRIPT_SERVER_SETTINGS_KEY].toObject();
 
+    static const QString SCRIPT_ENGINES_OPTION = "script_engines";
+
+    if (entityScriptServerSettings.contains(SCRIPT_ENGINES_OPTION)) {
+        int numScriptEngines = std::min(std::max(1, entityScriptServerSettings[SCRIPT_ENGINES_OPTION].toInt()),
+                                        MAX_NUM_SCRIPT_ENGINES);
+        if (numScriptEngines != _numScriptEngines) {
+            qDebug() << "Received entity script server settings, Script Engines:" << numScriptEngines;
+            _numScriptEngines = numScriptEngines;
+            reloadEntitiesScriptEngines();
+        }
+    }
+
+    static const QString PROFILER_SAMPLE_RATE_OPTION = "profiler_sample_rate";
+
+    if (entityScriptServerSettings.contains(PROFILER_SAMPLE_RATE_OPTION)) {
+        ScriptProfiler::getInstance().setSampleRate(entityScriptServerSettings[PROFILER_SAMPLE_RATE_OPTION].toInt());
+    }
+
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
 
@@ -173,7 +199,7 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entitiesScriptEngines ? _entitiesScriptEngines->getNumRunningEntityScripts() : 0;
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -235,7 +261,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entitiesScriptEngines && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -249,7 +275,8 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        // runs on the script engine that owns the entity
+        _entitiesScriptEngines->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -279,8 +306,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -310,6 +337,18 @@ void EntityScriptServer::run() {
     connect(tree, &EntityTree::deletingEntity, this, &EntityScriptServer::deletingEntity, Qt::QueuedConnection);
     connect(tree, &EntityTree::addingEntity, this, &EntityScriptServer::addingEntity, Qt::QueuedConnection);
     connect(tree, &EntityTree::entityServerScriptChanging, this, &EntityScriptServer::entityServerScriptChanging, Qt::QueuedConnection);
+
+    // update the tree at the script frame rate here rather than from a script engine's update, so that a busy
+    // engine doesn't hold up the entities of the others
+    auto treeUpdateTimer = new QTimer(this);
+    treeUpdateTimer->setInterval(MSECS_PER_SECOND / SCRIPT_FPS);
+    connect(treeUpdateTimer, &QTimer::timeout, this, [this] {
+        if (!_shuttingDown && _entityViewer.getTree()) {
+            _entityViewer.queryOctree();
+            _entityViewer.getTree()->update();
+        }
+    });
+    treeUpdateTimer->start();
 }
 
 void EntityScriptServer::cleanupOldKilledListeners() {
@@ -435,63 +474,106 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
-    auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    std::vector<ScriptEnginePointer> engines;
+    for (int i = 0; i < _numScriptEngines; ++i) {
+        auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+        auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
-    auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
-    newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
+        auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
+        newEngine->globalObject().setProperty("WebSocketServer", webSocketServerConstructorValue);
 
-    newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
+        newEngine->registerGlobalObject("SoundCache", DependencyManager::get<SoundCacheScriptingInterface>().data());
 
-    // connect this script engines printedMessage signal to the global ScriptEngines these various messages
-    auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
-    connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
-    connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
-    connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
-    connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
+        // connect this script engines printedMessage signal to the global ScriptEngines these various messages
+        auto scriptEngines = DependencyManager::get<ScriptEngines>().data();
+        connect(newEngine.data(), &ScriptEngine::printedMessage, scriptEngines, &ScriptEngines::onPrintedMessage);
+        connect(newEngine.data(), &ScriptEngine::errorMessage, scriptEngines, &ScriptEngines::onErrorMessage);
+        connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
+        connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
-        _entityViewer.queryOctree();
-        _entityViewer.getTree()->update();
-    });
+        connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
+                this, &EntityScriptServer::updateEntityPPS);
 
+        newEngine->runInThread();
+        engines.push_back(newEngine);
+    }
 
-    newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngineSP);
+    auto newEngines = QSharedPointer<EntityScriptShards>::create(engines);
+    DependencyManager::get<EntityScriptingInterface>()->setEntitiesScriptEngine(newEngines);
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+    if (_entitiesScriptEngines) {
+        for (int i = 0; i < _entitiesScriptEngines->size(); ++i) {
+            disconnect(_entitiesScriptEngines->getEngine(i).data(), &ScriptEngine::entityScriptDetailsUpdated,
+                       this, &EntityScriptServer::updateEntityPPS);
+        }
     }
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    _entitiesScriptEngines.swap(newEngines);
+    _lastExecutionTimeUsecs.assign(_numScriptEngines, 0);
 }
 
+void EntityScriptServer::stopEntitiesScriptEngines() {
+    if (!_entitiesScriptEngines) {
+        return;
+    }
 
-void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
-        // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+    // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
+    for (int i = 0; i < _entitiesScriptEngines->size(); ++i) {
+        auto& engine = _entitiesScriptEngines->getEngine(i);
+        engine->unloadAllEntityScripts();
+        engine->stop();
+    }
+    for (int i = 0; i < _entitiesScriptEngines->size(); ++i) {
+        _entitiesScriptEngines->getEngine(i)->waitTillDoneRunning();
     }
+}
+
+void EntityScriptServer::reloadEntitiesScriptEngines() {
+    auto tree = _entityViewer.getTree();
+    if (!tree || _shuttingDown || !_entitiesScriptEngines) {
+        return;
+    }
+
+    stopEntitiesScriptEngines();
+    resetEntitiesScriptEngines();
+
+    // the entities we already have won't be added again, so start their scripts on the new engines
+    QVector<EntityItemID> entityIDs;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](EntityItemPointer entity) {
+                if (!entity->getServerScripts().isEmpty()) {
+                    entityIDs << entity->getEntityItemID();
+                }
+            });
+            return true;
+        });
+    });
+
+    for (auto& entityID : entityIDs) {
+        checkAndCallPreload(entityID);
+    }
+}
+
+void EntityScriptServer::clear() {
+    // unload and stop the engines
+    stopEntitiesScriptEngines();
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entitiesScriptEngines) {
+        for (int i = 0; i < _entitiesScriptEngines->size(); ++i) {
+            // disconnect all slots/signals from the script engine, except essential
+            _entitiesScriptEngines->getEngine(i)->disconnectNonEssentialSignals();
+        }
     }
     _shuttingDown = true;
 
@@ -500,7 +582,7 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
+    _entitiesScriptEngines.clear();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
@@ -518,37 +600,95 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
+        int shard = _entitiesScriptEngines->shardForEntity(entityID);
+        auto engine = _entitiesScriptEngines->getEngine(shard);
+        _entitiesScriptEngines->post(shard, [engine, entityID] {
+            engine->unloadEntityScript(entityID, true);
+        });
     }
 }
 
 void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID, bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
+        int shard = _entitiesScriptEngines->shardForEntity(entityID);
+        auto engine = _entitiesScriptEngines->getEngine(shard);
+        _entitiesScriptEngines->post(shard, [engine, entityID] {
+            engine->unloadEntityScript(entityID, true);
+        });
         checkAndCallPreload(entityID, reload);
     }
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool reload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngines) {
+        int shard = _entitiesScriptEngines->shardForEntity(entityID);
+        auto engine = _entitiesScriptEngines->getEngine(shard);
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool notRunning = !_entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool notRunning = !engine->getEntityScriptDetails(entityID, details);
         if (entity && (reload || notRunning || details.scriptText != entity->getServerScripts())) {
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID;
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, reload);
+                qCDebug(entity_script_server) << "Loading entity server script" << scriptUrl << "for" << entityID
+                    << "on script engine" << shard;
+                _entitiesScriptEngines->post(shard, [engine, entityID, scriptUrl, reload] {
+                    engine->loadEntityScript(entityID, scriptUrl, reload);
+                });
             }
         }
     }
 }
 
 void EntityScriptServer::sendStatsPacket() {
+    QJsonObject statsObject;
+
+    if (_entitiesScriptEngines) {
+        auto now = usecTimestampNow();
+        auto elapsed = (_lastStatsTime > 0 && now > _lastStatsTime) ? now - _lastStatsTime : 0;
+        _lastStatsTime = now;
+
+        QJsonObject enginesObject;
+        int numTimers = 0;
+        int numTimersFired = 0;
+        double totalTimerLagMsecs = 0.0;
+        double maxTimerLagMsecs = 0.0;
+        for (int i = 0; i < _entitiesScriptEngines->size(); ++i) {
+            auto& engine = _entitiesScriptEngines->getEngine(i);
+            auto executionTime = engine->getExecutionTimeUsecs();
+            auto executionDelta = executionTime - _lastExecutionTimeUsecs[i];
+            _lastExecutionTimeUsecs[i] = executionTime;
+
+            QJsonObject engineObject;
+            engineObject["entity_scripts"] = engine->getNumRunningEntityScripts();
+            engineObject["pending_calls"] = _entitiesScriptEngines->getNumPendingCalls(i);
+            engineObject["busy_percent"] = elapsed > 0 ? (100.0 * executionDelta / elapsed) : 0.0;
+            enginesObject[QString::number(i)] = engineObject;
+
+            auto timerStats = engine->getAndResetTimerStats();
+            numTimers += timerStats["timers"].toInt();
+            numTimersFired += timerStats["fired"].toInt();
+            totalTimerLagMsecs += timerStats["total_lag_msecs"].toDouble();
+            maxTimerLagMsecs = std::max(maxTimerLagMsecs, timerStats["max_lag_msecs"].toDouble());
+        }
+        statsObject["script_engines"] = enginesObject;
+
+        QJsonObject timersObject;
+        timersObject["timers"] = numTimers;
+        timersObject["fired"] = numTimersFired;
+        timersObject["avg_lag_msecs"] = numTimersFired > 0 ? totalTimerLagMsecs / numTimersFired : 0.0;
+        timersObject["max_lag_msecs"] = maxTimerLagMsecs;
+        statsObject["script_timers"] = timersObject;
+    }
+
+    auto& profiler = ScriptProfiler::getInstance();
+    if (profiler.isEnabled()) {
+        statsObject["script_profiler"] = profiler.getSummary(true);
+    }
 
+    addPacketStatsAndSendStatsPacket(statsObject);
 }
 
 void EntityScriptServer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -23,6 +23,10 @@
 #include <ScriptEngine.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptShards.h"
+
+static const int DEFAULT_NUM_SCRIPT_ENGINES = 1;
+static const int MAX_NUM_SCRIPT_ENGINES = 32;
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -60,7 +64,9 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    void resetEntitiesScriptEngines();
+    void stopEntitiesScriptEngines();
+    void reloadEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
 
@@ -74,7 +80,10 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    QSharedPointer<EntityScriptShards> _entitiesScriptEngines;
+    int _numScriptEngines { DEFAULT_NUM_SCRIPT_ENGINES };
+    std::vector<quint64> _lastExecutionTimeUsecs; // per engine, at the last stats packet
+    quint64 _lastStatsTime { 0 };
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
 
@@ -0,0 +1,57 @@
+//
+//  EntityScriptShards.cpp
+//  assignment-client/src/scripts
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptShards.h"
+
+#include <QtCore/QMetaObject>
+
+EntityScriptShards::EntityScriptShards(std::vector<ScriptEnginePointer> engines) {
+    _shards.reserve(engines.size());
+    for (auto& engine : engines) {
+        _shards.push_back({ engine, std::make_shared<std::atomic<int>>(0) });
+    }
+}
+
+int EntityScriptShards::shardForEntity(const EntityItemID& entityID) const {
+    return (int)(qHash(static_cast<const QUuid&>(entityID)) % _shards.size());
+}
+
+void EntityScriptShards::post(int shard, std::function<void()> operation) {
+    auto& target = _shards[shard];
+    auto numPendingCalls = target.numPendingCalls;
+    ++(*numPendingCalls);
+
+    // run right away if we're already on the engine's thread
+    QMetaObject::invokeMethod(target.engine.data(), [numPendingCalls, operation] {
+        --(*numPendingCalls);
+        operation();
+    });
+}
+
+int EntityScriptShards::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (auto& shard : _shards) {
+        numRunningScripts += shard.engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params, const QUuid& remoteCallerID) {
+    int shard = shardForEntity(entityID);
+    auto engine = getEngine(shard);
+    post(shard, [engine, entityID, methodName, params, remoteCallerID] {
+        engine->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+    });
+}
+
+QFuture<QVariant> EntityScriptShards::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    return engineForEntity(entityID)->getLocalEntityScriptDetails(entityID);
+}
@@ -0,0 +1,59 @@
+//
+//  EntityScriptShards.h
+//  assignment-client/src/scripts
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptShards_h
+#define hifi_EntityScriptShards_h
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+
+// The entity script server spreads its entity scripts over several script engines, each running on its own thread,
+// so that one slow script only holds up the scripts that share its engine. An entity always hashes to the same
+// engine, and every call for an entity, from the entity script server or from another entity's script, is sent to it.
+class EntityScriptShards : public EntitiesScriptEngineProvider {
+public:
+    EntityScriptShards(std::vector<ScriptEnginePointer> engines);
+
+    int size() const { return (int)_shards.size(); }
+    const ScriptEnginePointer& getEngine(int shard) const { return _shards[shard].engine; }
+
+    int shardForEntity(const EntityItemID& entityID) const;
+    const ScriptEnginePointer& engineForEntity(const EntityItemID& entityID) const {
+        return getEngine(shardForEntity(entityID));
+    }
+
+    // runs operation on the engine's thread, it counts towards the shard's backlog until it has run
+    void post(int shard, std::function<void()> operation);
+
+    // the number of posted operations that haven't run yet
+    int getNumPendingCalls(int shard) const { return *_shards[shard].numPendingCalls; }
+
+    int getNumRunningEntityScripts() const;
+
+    // EntitiesScriptEngineProvider, for Entities.callEntityMethod and script status requests from entity scripts
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+private:
+    struct Shard {
+        ScriptEnginePointer engine;
+        std::shared_ptr<std::atomic<int>> numPendingCalls; // shared with the posted operations, which may outlive us
+    };
+
+    std::vector<Shard> _shards;
+};
+
+#endif // hifi_EntityScriptShards_h
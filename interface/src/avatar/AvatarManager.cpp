@@ -36,6 +36,7 @@
 #include <RegisteredMetaTypes.h>
 #include <Rig.h>
 #include <SettingHandle.h>
+#include <TBBHelpers.h>
 #include <UsersScriptingInterface.h>
 #include <UUID.h>
 #include <shared/ConicalViewFrustum.h>
@@ -55,6 +56,10 @@ static const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND /
 // We add _myAvatar into the hash with all the other AvatarData, and we use the default NULL QUid as the key.
 const QUuid MY_AVATAR_KEY;  // NULL key
 
+// The other avatars are simulated this many at a time, the joints of each batch in parallel,
+// and the time budget is checked between batches.
+static const size_t AVATAR_SIMULATION_BATCH_SIZE = 16;
+
 namespace {
     // For an unknown avatar-data packet, wait this long before requesting the identity.
     constexpr std::chrono::milliseconds REQUEST_UNKNOWN_IDENTITY_DELAY { 5 * 1000 };
@@ -70,6 +75,8 @@ AvatarManager::AvatarManager(QObject* parent) :
     qRegisterMetaType<QWeakPointer<Node> >("NodeWeakPointer");
 
     auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->getPacketReceiver().registerListener(PacketType::AvatarJointResyncRequest, this,
+                                                   "handleAvatarJointResyncRequest");
 
     // when we hear that the user has ignored an avatar by session UUID
     // immediately remove that avatar instead of waiting for the absence of packets from avatar mixer
@@ -230,37 +237,12 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
-    for (auto it = sortedAvatarVector.begin(); it != sortedAvatarVector.end(); ++it) {
-        const SortableAvatar& sortData = *it;
-        const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
-
-        // TODO: to help us scale to more avatars it would be nice to not have to poll orb state here
-        // if the geometry is loaded then turn off the orb
-        if (avatar->getSkeletonModel()->isLoaded()) {
-            // remove the orb if it is there
-            avatar->removeOrb();
-        } else {
-            avatar->updateOrbPosition();
-        }
-
-        // for ALL avatars...
-        if (_shouldRender) {
-            avatar->ensureInScene(avatar, qApp->getMain3DScene());
-        }
-        avatar->animateScaleChanges(deltaTime);
-
+    std::vector<std::pair<std::shared_ptr<OtherAvatar>, bool>> batch; // and whether it's in view
+    batch.reserve(AVATAR_SIMULATION_BATCH_SIZE);
+    auto it = sortedAvatarVector.begin();
+    while (it != sortedAvatarVector.end()) {
         uint64_t now = usecTimestampNow();
-        if (now < updateExpiry) {
-            // we're within budget
-            bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
-            if (inView && avatar->hasNewJointData()) {
-                numAvatarsUpdated++;
-            }
-            avatar->simulate(deltaTime, inView);
-            avatar->updateRenderItem(renderTransaction);
-            avatar->updateSpaceProxy(workloadTransaction);
-            avatar->setLastRenderUpdateTime(startTime);
-        } else {
+        if (now >= updateExpiry) {
             // we've spent our full time budget --> bail on the rest of the avatar updates
             // --> more avatars may freeze until their priority trickles up
             // --> some scale animations may glitch
@@ -280,6 +262,50 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
             }
             break;
         }
+
+        // we're within budget, take the next batch
+        batch.clear();
+        for (; it != sortedAvatarVector.end() && batch.size() < AVATAR_SIMULATION_BATCH_SIZE; ++it) {
+            const SortableAvatar& sortData = *it;
+            const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+
+            // TODO: to help us scale to more avatars it would be nice to not have to poll orb state here
+            // if the geometry is loaded then turn off the orb
+            if (avatar->getSkeletonModel()->isLoaded()) {
+                // remove the orb if it is there
+                avatar->removeOrb();
+            } else {
+                avatar->updateOrbPosition();
+            }
+
+            // for ALL avatars...
+            if (_shouldRender) {
+                avatar->ensureInScene(avatar, qApp->getMain3DScene());
+            }
+            avatar->animateScaleChanges(deltaTime);
+
+            bool inView = sortData.getPriority() > OUT_OF_VIEW_THRESHOLD;
+            if (inView && avatar->hasNewJointData()) {
+                numAvatarsUpdated++;
+            }
+            batch.push_back({ avatar, inView });
+        }
+
+        // each avatar's joints only depend on its own data, so they're computed on the worker threads...
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, batch.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+            for (size_t i = range.begin(); i != range.end(); ++i) {
+                batch[i].first->simulateJoints(deltaTime, batch[i].second);
+            }
+        });
+
+        // ...and whatever touches the scene, physics or entity tree is done here
+        for (const auto& entry : batch) {
+            const auto& avatar = entry.first;
+            avatar->finishSimulate(deltaTime, entry.second);
+            avatar->updateRenderItem(renderTransaction);
+            avatar->updateSpaceProxy(workloadTransaction);
+            avatar->setLastRenderUpdateTime(startTime);
+        }
     }
 
     if (_shouldRender) {
@@ -332,6 +358,11 @@ void AvatarManager::postUpdate(float deltaTime, const render::ScenePointer& scen
     }
 }
 
+void AvatarManager::handleAvatarJointResyncRequest(QSharedPointer<ReceivedMessage> message) {
+    // the avatar mixer missed a frame of our joints
+    _myAvatar->requestJointKeyFrame();
+}
+
 void AvatarManager::sendIdentityRequest(const QUuid& avatarID) const {
     auto nodeList = DependencyManager::get<NodeList>();
     QWeakPointer<NodeList> nodeListWeak = nodeList;
@@ -194,6 +194,9 @@ public slots:
      */
     void updateAvatarRenderStatus(bool shouldRenderAvatars);
 
+private slots:
+    void handleAvatarJointResyncRequest(QSharedPointer<ReceivedMessage> message);
+
 protected:
     AvatarSharedPointer addAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer) override;
 
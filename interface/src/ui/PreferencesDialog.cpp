@@ -294,6 +294,12 @@ void setupPreferences() {
         auto preference = new CheckPreference(AUDIO_BUFFERS, "Disable dynamic jitter buffer", getter, setter);
         preferences->addPreference(preference);
     }
+    {
+        auto getter = []()->bool { return DependencyManager::get<AudioClient>()->getReceivedAudioStream().timeStretchingEnabled(); };
+        auto setter = [](bool value) { DependencyManager::get<AudioClient>()->getReceivedAudioStream().setTimeStretchingEnabled(value); };
+        auto preference = new CheckPreference(AUDIO_BUFFERS, "Time-stretch to resize jitter buffer", getter, setter);
+        preferences->addPreference(preference);
+    }
     {
         auto getter = []()->float { return DependencyManager::get<AudioClient>()->getReceivedAudioStream().getStaticJitterBufferFrames(); };
         auto setter = [](float value) { DependencyManager::get<AudioClient>()->getReceivedAudioStream().setStaticJitterBufferFrames(value); };
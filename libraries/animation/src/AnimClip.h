@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipCache.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -57,7 +58,6 @@ protected:
     virtual void setCurrentFrameInternal(float frame) override;
 
     void copyFromNetworkAnim();
-    void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
     virtual const AnimPoseVec& getPosesInternal() const override;
@@ -65,9 +65,9 @@ protected:
     AnimationPointer _networkAnim;
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // shared with the other clips playing the same animation on the same kind of skeleton
+    AnimClipCache::Pointer _clipCache;
+    AnimPoseBuffer _blendedPoses; // the frames are blended in here, then copied out to _poses
 
     QString _url;
     float _startFrame;
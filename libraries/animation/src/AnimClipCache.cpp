@@ -0,0 +1,157 @@
+//
+//  AnimClipCache.cpp
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipCache.h"
+
+#include <map>
+
+#include "GLMHelpers.h"
+#include "AnimationLogging.h"
+#include "AnimUtil.h"
+
+// keyed by url and skeleton hash, skeletons whose hashes collide get their own entries under the same key
+static std::multimap<std::pair<QString, uint>, std::weak_ptr<AnimClipCache>> clipCacheRegistry;
+static std::mutex clipCacheRegistryMutex;
+
+AnimClipCache::Pointer AnimClipCache::get(const QString& url, const AnimationPointer& animation,
+                                          const AnimSkeleton::ConstPointer& skeleton) {
+    assert(animation && animation->isLoaded() && skeleton);
+    auto key = std::make_pair(url, skeleton->getHash());
+
+    // AnimClips can be evaluated on several threads at once.
+    std::lock_guard<std::mutex> guard(clipCacheRegistryMutex);
+    auto range = clipCacheRegistry.equal_range(key);
+    for (auto iter = range.first; iter != range.second; ++iter) {
+        Pointer clipCache = iter->second.lock();
+
+        // the animation may have been reloaded since, and a hash doesn't prove the skeletons are the same
+        if (clipCache && clipCache->_animation == animation && clipCache->_skeleton->isRetargetedLike(*skeleton)) {
+            return clipCache;
+        }
+    }
+
+    // drop the animations that nothing plays anymore
+    for (auto iter = clipCacheRegistry.begin(); iter != clipCacheRegistry.end();) {
+        if (iter->second.expired()) {
+            iter = clipCacheRegistry.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+
+    Pointer clipCache = std::make_shared<AnimClipCache>(url, animation, skeleton);
+    clipCacheRegistry.emplace(key, clipCache);
+    return clipCache;
+}
+
+AnimClipCache::AnimClipCache(const QString& url, const AnimationPointer& animation,
+                             const AnimSkeleton::ConstPointer& skeleton) :
+    _url(url),
+    _animation(animation),
+    _skeleton(skeleton)
+{
+    retargetFrames(animation);
+}
+
+void AnimClipCache::sample(int prevIndex, int nextIndex, float alpha, bool mirror, AnimPoseBuffer& blendedPoses,
+                           AnimPoseVec& poses) const {
+    // lazy creation of mirrored animation frames.
+    if (mirror) {
+        std::call_once(_mirrorAnimOnce, [this] { buildMirrorAnim(); });
+    }
+
+    const AnimPoseBuffer& prevFrame = mirror ? _mirrorAnim[prevIndex] : _anim[prevIndex];
+    const AnimPoseBuffer& nextFrame = mirror ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+
+    AnimPoseBuffer::blend(prevFrame, nextFrame, alpha, blendedPoses);
+    blendedPoses.toPoses(poses);
+}
+
+void AnimClipCache::retargetFrames(const AnimationPointer& networkAnim) {
+    _anim.clear();
+
+    // build a mapping from animation joint indices to skeleton joint indices.
+    // by matching joints with the same name.
+    const FBXGeometry& geom = networkAnim->getGeometry();
+    AnimSkeleton animSkeleton(geom);
+    const auto animJointCount = animSkeleton.getNumJoints();
+    const auto skeletonJointCount = _skeleton->getNumJoints();
+    std::vector<int> jointMap;
+    jointMap.reserve(animJointCount);
+    for (int i = 0; i < animJointCount; i++) {
+        int skeletonJoint = _skeleton->nameToJointIndex(animSkeleton.getJointName(i));
+        if (skeletonJoint == -1) {
+            qCWarning(animation) << "animation contains joint =" << animSkeleton.getJointName(i) << " which is not in the skeleton, url =" << _url;
+        }
+        jointMap.push_back(skeletonJoint);
+    }
+
+    const int frameCount = geom.animationFrames.size();
+    _anim.resize(frameCount);
+    AnimPoseVec framePoses;
+
+    for (int frame = 0; frame < frameCount; frame++) {
+
+        const FBXAnimationFrame& fbxAnimFrame = geom.animationFrames[frame];
+
+        // init all joints in animation to default pose
+        // this will give us a resonable result for bones in the model skeleton but not in the animation.
+        framePoses = _skeleton->getRelativeDefaultPoses();
+
+        for (int animJoint = 0; animJoint < animJointCount; animJoint++) {
+            int skeletonJoint = jointMap[animJoint];
+
+            const glm::vec3& fbxAnimTrans = fbxAnimFrame.translations[animJoint];
+            const glm::quat& fbxAnimRot = fbxAnimFrame.rotations[animJoint];
+
+            // skip joints that are in the animation but not in the skeleton.
+            if (skeletonJoint >= 0 && skeletonJoint < skeletonJointCount) {
+
+                AnimPose preRot, postRot;
+                preRot = animSkeleton.getPreRotationPose(animJoint);
+                postRot = animSkeleton.getPostRotationPose(animJoint);
+
+                // cancel out scale
+                preRot.scale() = glm::vec3(1.0f);
+                postRot.scale() = glm::vec3(1.0f);
+
+                AnimPose rot(glm::vec3(1.0f), fbxAnimRot, glm::vec3());
+
+                // adjust translation offsets, so large translation animatons on the reference skeleton
+                // will be adjusted when played on a skeleton with short limbs.
+                const glm::vec3& fbxZeroTrans = geom.animationFrames[0].translations[animJoint];
+                const AnimPose& relDefaultPose = _skeleton->getRelativeDefaultPose(skeletonJoint);
+                float boneLengthScale = 1.0f;
+                const float EPSILON = 0.0001f;
+                if (fabsf(glm::length(fbxZeroTrans)) > EPSILON) {
+                    boneLengthScale = glm::length(relDefaultPose.trans()) / glm::length(fbxZeroTrans);
+                }
+
+                AnimPose trans = AnimPose(glm::vec3(1.0f), glm::quat(), relDefaultPose.trans() + boneLengthScale * (fbxAnimTrans - fbxZeroTrans));
+
+                framePoses[skeletonJoint] = trans * preRot * rot * postRot;
+            }
+        }
+        _anim[frame].fromPoses(framePoses);
+    }
+
+    // mirrorAnim will be re-built on demand, if needed.
+    _mirrorAnim.clear();
+}
+
+void AnimClipCache::buildMirrorAnim() const {
+    _mirrorAnim.clear();
+    _mirrorAnim.reserve(_anim.size());
+    AnimPoseVec relPoses;
+    for (auto& frame : _anim) {
+        frame.toPoses(relPoses);
+        _skeleton->mirrorRelativePoses(relPoses);
+        _mirrorAnim.emplace_back(relPoses);
+    }
+}
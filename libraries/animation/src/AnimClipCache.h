@@ -0,0 +1,60 @@
+//
+//  AnimClipCache.h
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipCache_h
+#define hifi_AnimClipCache_h
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "AnimationCache.h"
+#include "AnimPoseBuffer.h"
+#include "AnimSkeleton.h"
+
+// The frames of an animation retargeted onto a skeleton, shared by every AnimClip that plays the same animation url on an
+// equivalent skeleton (see AnimSkeleton::isRetargetedLike), so the frames are retargeted and held in memory once.
+// The default avatar graph plays several of its animations from more than one clip, the side steps and jumps from four
+// or five each, some of them mirrored, and a graph loaded again for the same skeleton finds its frames already retargeted.
+// The frames are kept as AnimPoseBuffers, so that sampling between two of them is a SIMD blend.
+class AnimClipCache {
+public:
+    using Pointer = std::shared_ptr<AnimClipCache>;
+
+    // Returns the cache for url on skeleton, retargeting the frames of animation if no other clip has already.
+    // animation must be loaded.
+    static Pointer get(const QString& url, const AnimationPointer& animation, const AnimSkeleton::ConstPointer& skeleton);
+
+    AnimClipCache(const QString& url, const AnimationPointer& animation, const AnimSkeleton::ConstPointer& skeleton);
+
+    int getFrameCount() const { return (int)_anim.size(); }
+
+    // blends the frames at prevIndex and nextIndex into poses, blendedPoses is the caller's scratch buffer
+    void sample(int prevIndex, int nextIndex, float alpha, bool mirror, AnimPoseBuffer& blendedPoses, AnimPoseVec& poses) const;
+
+protected:
+    void retargetFrames(const AnimationPointer& networkAnim);
+    void buildMirrorAnim() const;
+
+    QString _url;
+    QWeakPointer<Animation> _animation;
+    AnimSkeleton::ConstPointer _skeleton;
+
+    // _anim[frame] holds a pose per joint
+    std::vector<AnimPoseBuffer> _anim;
+    mutable std::vector<AnimPoseBuffer> _mirrorAnim;
+
+    mutable std::once_flag _mirrorAnimOnce; // the mirrored frames are built the first time they are sampled
+
+    // no copies
+    AnimClipCache(const AnimClipCache&) = delete;
+    AnimClipCache& operator=(const AnimClipCache&) = delete;
+};
+
+#endif // hifi_AnimClipCache_h
@@ -0,0 +1,189 @@
+//
+//  AnimPoseBuffer.cpp
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBuffer.h"
+
+#include <assert.h>
+
+#include "AnimUtil.h"
+
+static const float IDENTITY_COMPONENTS[AnimPoseBuffer::NumComponents] = {
+    1.0f, 1.0f, 1.0f,       // scale
+    0.0f, 0.0f, 0.0f, 1.0f, // rot
+    0.0f, 0.0f, 0.0f        // trans
+};
+
+// on x86 architecture, assume that SSE2 is present
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void lerpComponents_SSE(const float* a, const float* b, float alpha, float* result, size_t numFloats) {
+    __m128 f = _mm_set1_ps(alpha);
+
+    for (size_t i = 0; i < numFloats; i += 4) {
+        __m128 x0 = _mm_loadu_ps(&a[i]);
+        __m128 x1 = _mm_loadu_ps(&b[i]);
+
+        x0 = _mm_add_ps(x0, _mm_mul_ps(f, _mm_sub_ps(x1, x0)));
+
+        _mm_storeu_ps(&result[i], x0);
+    }
+}
+
+// the rotations are given x, y, z, w
+static void nlerpRotations_SSE(const float* const a[4], const float* const b[4], float alpha, float* const result[4],
+                               size_t numRotations) {
+    const __m128 f = _mm_set1_ps(alpha);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    for (size_t i = 0; i < numRotations; i += 4) {
+        __m128 ax = _mm_loadu_ps(&a[0][i]);
+        __m128 ay = _mm_loadu_ps(&a[1][i]);
+        __m128 az = _mm_loadu_ps(&a[2][i]);
+        __m128 aw = _mm_loadu_ps(&a[3][i]);
+        __m128 bx = _mm_loadu_ps(&b[0][i]);
+        __m128 by = _mm_loadu_ps(&b[1][i]);
+        __m128 bz = _mm_loadu_ps(&b[2][i]);
+        __m128 bw = _mm_loadu_ps(&b[3][i]);
+
+        // flip b into the same hemisphere as a
+        __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)),
+                                _mm_add_ps(_mm_mul_ps(az, bz), _mm_mul_ps(aw, bw)));
+        __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+        bx = _mm_xor_ps(bx, sign);
+        by = _mm_xor_ps(by, sign);
+        bz = _mm_xor_ps(bz, sign);
+        bw = _mm_xor_ps(bw, sign);
+
+        // lerp
+        __m128 rx = _mm_add_ps(ax, _mm_mul_ps(f, _mm_sub_ps(bx, ax)));
+        __m128 ry = _mm_add_ps(ay, _mm_mul_ps(f, _mm_sub_ps(by, ay)));
+        __m128 rz = _mm_add_ps(az, _mm_mul_ps(f, _mm_sub_ps(bz, az)));
+        __m128 rw = _mm_add_ps(aw, _mm_mul_ps(f, _mm_sub_ps(bw, aw)));
+
+        // normalize
+        __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)),
+                                          _mm_add_ps(_mm_mul_ps(rz, rz), _mm_mul_ps(rw, rw)));
+        __m128 oneOverLength = _mm_div_ps(one, _mm_sqrt_ps(lengthSquared));
+
+        _mm_storeu_ps(&result[0][i], _mm_mul_ps(rx, oneOverLength));
+        _mm_storeu_ps(&result[1][i], _mm_mul_ps(ry, oneOverLength));
+        _mm_storeu_ps(&result[2][i], _mm_mul_ps(rz, oneOverLength));
+        _mm_storeu_ps(&result[3][i], _mm_mul_ps(rw, oneOverLength));
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+
+#include "CPUDetect.h"
+
+void lerpComponents_AVX2(const float* a, const float* b, float alpha, float* result, size_t numFloats);
+void nlerpRotations_AVX2(const float* const a[4], const float* const b[4], float alpha, float* const result[4],
+                         size_t numRotations);
+
+static void lerpComponents(const float* a, const float* b, float alpha, float* result, size_t numFloats) {
+    static auto f = cpuSupportsAVX2() ? lerpComponents_AVX2 : lerpComponents_SSE;
+    (*f)(a, b, alpha, result, numFloats); // dispatch
+}
+
+static void nlerpRotations(const float* const a[4], const float* const b[4], float alpha, float* const result[4],
+                           size_t numRotations) {
+    static auto f = cpuSupportsAVX2() ? nlerpRotations_AVX2 : nlerpRotations_SSE;
+    (*f)(a, b, alpha, result, numRotations); // dispatch
+}
+
+#else   // portable reference code
+
+static void lerpComponents(const float* a, const float* b, float alpha, float* result, size_t numFloats) {
+    for (size_t i = 0; i < numFloats; i++) {
+        result[i] = a[i] + alpha * (b[i] - a[i]);
+    }
+}
+
+static void nlerpRotations(const float* const a[4], const float* const b[4], float alpha, float* const result[4],
+                           size_t numRotations) {
+    for (size_t i = 0; i < numRotations; i++) {
+        glm::quat rot = safeLerp(glm::quat(a[3][i], a[0][i], a[1][i], a[2][i]), glm::quat(b[3][i], b[0][i], b[1][i], b[2][i]), alpha);
+        result[0][i] = rot.x;
+        result[1][i] = rot.y;
+        result[2][i] = rot.z;
+        result[3][i] = rot.w;
+    }
+}
+
+#endif
+
+void AnimPoseBuffer::resize(size_t size) {
+    size_t paddedSize = (size + MAX_LANES - 1) / MAX_LANES * MAX_LANES;
+    for (int i = 0; i < NumComponents; i++) {
+        // the padding is kept as identity poses
+        _components[i].resize(size, IDENTITY_COMPONENTS[i]);
+        _components[i].resize(paddedSize, IDENTITY_COMPONENTS[i]);
+    }
+    _size = size;
+}
+
+void AnimPoseBuffer::fromPoses(const AnimPoseVec& poses) {
+    resize(poses.size());
+    for (size_t i = 0; i < _size; i++) {
+        setPose(i, poses[i]);
+    }
+}
+
+void AnimPoseBuffer::toPoses(AnimPoseVec& poses) const {
+    poses.resize(_size);
+    for (size_t i = 0; i < _size; i++) {
+        poses[i] = getPose(i);
+    }
+}
+
+AnimPose AnimPoseBuffer::getPose(size_t index) const {
+    return AnimPose(glm::vec3(_components[ScaleX][index], _components[ScaleY][index], _components[ScaleZ][index]),
+                    glm::quat(_components[RotW][index], _components[RotX][index], _components[RotY][index], _components[RotZ][index]),
+                    glm::vec3(_components[TransX][index], _components[TransY][index], _components[TransZ][index]));
+}
+
+void AnimPoseBuffer::setPose(size_t index, const AnimPose& pose) {
+    _components[ScaleX][index] = pose.scale().x;
+    _components[ScaleY][index] = pose.scale().y;
+    _components[ScaleZ][index] = pose.scale().z;
+    _components[RotX][index] = pose.rot().x;
+    _components[RotY][index] = pose.rot().y;
+    _components[RotZ][index] = pose.rot().z;
+    _components[RotW][index] = pose.rot().w;
+    _components[TransX][index] = pose.trans().x;
+    _components[TransY][index] = pose.trans().y;
+    _components[TransZ][index] = pose.trans().z;
+}
+
+void AnimPoseBuffer::blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+
+    size_t paddedSize = a._components[0].size();
+    for (int i : { ScaleX, ScaleY, ScaleZ, TransX, TransY, TransZ }) {
+        lerpComponents(a._components[i].data(), b._components[i].data(), alpha, result._components[i].data(), paddedSize);
+    }
+    nlerp(a, b, alpha, result);
+}
+
+void AnimPoseBuffer::nlerp(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result) {
+    assert(a.size() == b.size());
+    result.resize(a.size());
+
+    const float* aRotations[4] = { a.data(RotX), a.data(RotY), a.data(RotZ), a.data(RotW) };
+    const float* bRotations[4] = { b.data(RotX), b.data(RotY), b.data(RotZ), b.data(RotW) };
+    float* resultRotations[4] = { result.data(RotX), result.data(RotY), result.data(RotZ), result.data(RotW) };
+    nlerpRotations(aRotations, bRotations, alpha, resultRotations, a._components[0].size());
+}
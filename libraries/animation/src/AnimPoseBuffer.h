@@ -0,0 +1,68 @@
+//
+//  AnimPoseBuffer.h
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBuffer
+#define hifi_AnimPoseBuffer
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "AnimPose.h"
+
+// Joint poses stored as a structure of arrays, one array of floats per pose component, so that the pose math can be done
+// on several joints at once with SSE or AVX2. The arrays are padded to a multiple of MAX_LANES joints with identity poses.
+//
+// AnimNodes keep passing AnimPoseVecs to each other, AnimClip keeps its frames in AnimPoseBuffers and copies the blend
+// out, which still beats blending AnimPoseVecs (see AnimPoseBufferTests::benchmarkSample).
+class AnimPoseBuffer {
+public:
+    enum Component {
+        ScaleX = 0,
+        ScaleY,
+        ScaleZ,
+        RotX,
+        RotY,
+        RotZ,
+        RotW,
+        TransX,
+        TransY,
+        TransZ,
+        NumComponents
+    };
+
+    static const size_t MAX_LANES = 8;
+
+    AnimPoseBuffer() {}
+    explicit AnimPoseBuffer(const AnimPoseVec& poses) { fromPoses(poses); }
+
+    size_t size() const { return _size; }
+    void resize(size_t size);
+
+    void fromPoses(const AnimPoseVec& poses);
+    void toPoses(AnimPoseVec& poses) const;
+
+    AnimPose getPose(size_t index) const;
+    void setPose(size_t index, const AnimPose& pose);
+
+    float* data(Component component) { return _components[component].data(); }
+    const float* data(Component component) const { return _components[component].data(); }
+
+    // same as ::blend(), scale and translation are lerped and rotations are nlerped.
+    // The buffers must be the same size, result may be a or b.
+    static void blend(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+    // same as safeLerp() on each rotation, the scales and translations of result are left as they are
+    static void nlerp(const AnimPoseBuffer& a, const AnimPoseBuffer& b, float alpha, AnimPoseBuffer& result);
+
+private:
+    size_t _size { 0 };
+    std::vector<float> _components[NumComponents];
+};
+
+#endif
@@ -42,6 +42,24 @@ int AnimSkeleton::getNumJoints() const {
     return _jointsSize;
 }
 
+bool AnimSkeleton::isRetargetedLike(const AnimSkeleton& other) const {
+    if (&other == this) {
+        return true;
+    }
+    if (other._hash != _hash || other._jointsSize != _jointsSize) {
+        return false;
+    }
+    for (int i = 0; i < _jointsSize; i++) {
+        const AnimPose& pose = _relativeDefaultPoses[i];
+        const AnimPose& otherPose = other._relativeDefaultPoses[i];
+        if (other._joints[i].name != _joints[i].name || other._joints[i].parentIndex != _joints[i].parentIndex ||
+            otherPose.scale() != pose.scale() || otherPose.rot() != pose.rot() || otherPose.trans() != pose.trans()) {
+            return false;
+        }
+    }
+    return true;
+}
+
 int AnimSkeleton::getChainDepth(int jointIndex) const {
     if (jointIndex >= 0) {
         int chainDepth = 0;
@@ -137,26 +155,27 @@ void AnimSkeleton::convertAbsoluteRotationsToRelative(std::vector<glm::quat>& ro
     }
 }
 
-void AnimSkeleton::saveNonMirroredPoses(const AnimPoseVec& poses) const {
-    _nonMirroredPoses.clear();
+void AnimSkeleton::saveNonMirroredPoses(const AnimPoseVec& poses, AnimPoseVec& nonMirroredPoses) const {
+    nonMirroredPoses.clear();
     for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
-        _nonMirroredPoses.push_back(poses[_nonMirroredIndices[i]]);
+        nonMirroredPoses.push_back(poses[_nonMirroredIndices[i]]);
     }
 }
 
-void AnimSkeleton::restoreNonMirroredPoses(AnimPoseVec& poses) const {
+void AnimSkeleton::restoreNonMirroredPoses(AnimPoseVec& poses, const AnimPoseVec& nonMirroredPoses) const {
     for (int i = 0; i < (int)_nonMirroredIndices.size(); ++i) {
         int index = _nonMirroredIndices[i];
-        poses[index] = _nonMirroredPoses[i];
+        poses[index] = nonMirroredPoses[i];
     }
 }
 
 void AnimSkeleton::mirrorRelativePoses(AnimPoseVec& poses) const {
-    saveNonMirroredPoses(poses);
+    AnimPoseVec nonMirroredPoses;
+    saveNonMirroredPoses(poses, nonMirroredPoses);
     convertRelativePosesToAbsolute(poses);
     mirrorAbsolutePoses(poses);
     convertAbsolutePosesToRelative(poses);
-    restoreNonMirroredPoses(poses);
+    restoreNonMirroredPoses(poses, nonMirroredPoses);
 }
 
 void AnimSkeleton::mirrorAbsolutePoses(AnimPoseVec& poses) const {
@@ -198,8 +217,17 @@ void AnimSkeleton::buildSkeletonFromJoints(const std::vector<FBXJoint>& joints)
         }
     }
 
+    _hash = qHash(_jointsSize);
     for (int i = 0; i < _jointsSize; i++) {
         _jointIndicesByName[_joints[i].name] = i;
+
+        // everything that retargeting an animation onto this skeleton depends on
+        const AnimPose& relDefaultPose = _relativeDefaultPoses[i];
+        _hash = qHash(_joints[i].name, _hash);
+        _hash = qHash(_joints[i].parentIndex, _hash);
+        _hash = qHashBits(&relDefaultPose.scale(), sizeof(glm::vec3), _hash);
+        _hash = qHashBits(&relDefaultPose.rot(), sizeof(glm::quat), _hash);
+        _hash = qHashBits(&relDefaultPose.trans(), sizeof(glm::vec3), _hash);
     }
 
     // build mirror map.
@@ -30,6 +30,12 @@ public:
     int getNumJoints() const;
     int getChainDepth(int jointIndex) const;
 
+    // the same for skeletons that animations are retargeted onto the same way
+    uint getHash() const { return _hash; }
+
+    // true if animations are retargeted onto other the same way, compares everything getHash covers
+    bool isRetargetedLike(const AnimSkeleton& other) const;
+
     // the default poses are the orientations of the joints on frame 0.
     const AnimPose& getRelativeDefaultPose(int jointIndex) const;
     const AnimPoseVec& getRelativeDefaultPoses() const { return _relativeDefaultPoses; }
@@ -52,8 +58,10 @@ public:
 
     void convertAbsoluteRotationsToRelative(std::vector<glm::quat>& rotations) const;
 
-    void saveNonMirroredPoses(const AnimPoseVec& poses) const;
-    void restoreNonMirroredPoses(AnimPoseVec& poses) const;
+    // the poses of the joints that aren't mirrored are kept in the caller's nonMirroredPoses, so that skeletons shared
+    // between threads can mirror at the same time
+    void saveNonMirroredPoses(const AnimPoseVec& poses, AnimPoseVec& nonMirroredPoses) const;
+    void restoreNonMirroredPoses(AnimPoseVec& poses, const AnimPoseVec& nonMirroredPoses) const;
 
     void mirrorRelativePoses(AnimPoseVec& poses) const;
     void mirrorAbsolutePoses(AnimPoseVec& poses) const;
@@ -72,10 +80,10 @@ protected:
     AnimPoseVec _absoluteDefaultPoses;
     AnimPoseVec _relativePreRotationPoses;
     AnimPoseVec _relativePostRotationPoses;
-    mutable AnimPoseVec _nonMirroredPoses;
     std::vector<int> _nonMirroredIndices;
     std::vector<int> _mirrorMap;
     QHash<QString, int> _jointIndicesByName;
+    uint _hash { 0 };
 
     // no copies
     AnimSkeleton(const AnimSkeleton&) = delete;
@@ -0,0 +1,77 @@
+//
+//  AnimPoseBuffer_avx2.cpp
+//  libraries/animation/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <immintrin.h>
+
+#include "../AnimPoseBuffer.h"
+
+void lerpComponents_AVX2(const float* a, const float* b, float alpha, float* result, size_t numFloats) {
+    __m256 f = _mm256_set1_ps(alpha);
+
+    for (size_t i = 0; i < numFloats; i += 8) {
+        __m256 x0 = _mm256_loadu_ps(&a[i]);
+        __m256 x1 = _mm256_loadu_ps(&b[i]);
+
+        x0 = _mm256_fmadd_ps(f, _mm256_sub_ps(x1, x0), x0);
+
+        _mm256_storeu_ps(&result[i], x0);
+    }
+
+    _mm256_zeroupper();
+}
+
+// the rotations are given x, y, z, w
+void nlerpRotations_AVX2(const float* const a[4], const float* const b[4], float alpha, float* const result[4],
+                         size_t numRotations) {
+    const __m256 f = _mm256_set1_ps(alpha);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    for (size_t i = 0; i < numRotations; i += 8) {
+        __m256 ax = _mm256_loadu_ps(&a[0][i]);
+        __m256 ay = _mm256_loadu_ps(&a[1][i]);
+        __m256 az = _mm256_loadu_ps(&a[2][i]);
+        __m256 aw = _mm256_loadu_ps(&a[3][i]);
+        __m256 bx = _mm256_loadu_ps(&b[0][i]);
+        __m256 by = _mm256_loadu_ps(&b[1][i]);
+        __m256 bz = _mm256_loadu_ps(&b[2][i]);
+        __m256 bw = _mm256_loadu_ps(&b[3][i]);
+
+        // flip b into the same hemisphere as a
+        __m256 dot = _mm256_fmadd_ps(aw, bw, _mm256_fmadd_ps(az, bz, _mm256_fmadd_ps(ay, by, _mm256_mul_ps(ax, bx))));
+        __m256 sign = _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), signBit);
+        bx = _mm256_xor_ps(bx, sign);
+        by = _mm256_xor_ps(by, sign);
+        bz = _mm256_xor_ps(bz, sign);
+        bw = _mm256_xor_ps(bw, sign);
+
+        // lerp
+        __m256 rx = _mm256_fmadd_ps(f, _mm256_sub_ps(bx, ax), ax);
+        __m256 ry = _mm256_fmadd_ps(f, _mm256_sub_ps(by, ay), ay);
+        __m256 rz = _mm256_fmadd_ps(f, _mm256_sub_ps(bz, az), az);
+        __m256 rw = _mm256_fmadd_ps(f, _mm256_sub_ps(bw, aw), aw);
+
+        // normalize
+        __m256 lengthSquared = _mm256_fmadd_ps(rw, rw, _mm256_fmadd_ps(rz, rz, _mm256_fmadd_ps(ry, ry, _mm256_mul_ps(rx, rx))));
+        __m256 oneOverLength = _mm256_div_ps(one, _mm256_sqrt_ps(lengthSquared));
+
+        _mm256_storeu_ps(&result[0][i], _mm256_mul_ps(rx, oneOverLength));
+        _mm256_storeu_ps(&result[1][i], _mm256_mul_ps(ry, oneOverLength));
+        _mm256_storeu_ps(&result[2][i], _mm256_mul_ps(rz, oneOverLength));
+        _mm256_storeu_ps(&result[3][i], _mm256_mul_ps(rw, oneOverLength));
+    }
+
+    _mm256_zeroupper();
+}
+
+#endif
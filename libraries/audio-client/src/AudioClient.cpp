@@ -85,6 +85,8 @@ Setting::Handle<bool> dynamicJitterBufferEnabled("dynamicJitterBuffersEnabled",
     InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED);
 Setting::Handle<int> staticJitterBufferFrames("staticJitterBufferFrames",
     InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES);
+Setting::Handle<bool> timeStretchingJitterBufferEnabled("timeStretchingJitterBufferEnabled",
+    InboundAudioStream::DEFAULT_TIME_STRETCHING_ENABLED);
 
 // protect the Qt internal device list
 using Mutex = std::mutex;
@@ -2012,6 +2014,7 @@ void AudioClient::stopRecording() {
 void AudioClient::loadSettings() {
     _receivedAudioStream.setDynamicJitterBufferEnabled(dynamicJitterBufferEnabled.get());
     _receivedAudioStream.setStaticJitterBufferFrames(staticJitterBufferFrames.get());
+    _receivedAudioStream.setTimeStretchingEnabled(timeStretchingJitterBufferEnabled.get());
 
     qCDebug(audioclient) << "---- Initializing Audio Client ----";
     auto codecPlugins = PluginManager::getInstance()->getCodecPlugins();
@@ -2024,6 +2027,7 @@ void AudioClient::loadSettings() {
 void AudioClient::saveSettings() {
     dynamicJitterBufferEnabled.set(_receivedAudioStream.dynamicJitterBufferEnabled());
     staticJitterBufferFrames.set(_receivedAudioStream.getStaticJitterBufferFrames());
+    timeStretchingJitterBufferEnabled.set(_receivedAudioStream.timeStretchingEnabled());
 }
 
 void AudioClient::setAvatarBoundingBoxParameters(glm::vec3 corner, glm::vec3 scale) {
@@ -153,6 +153,11 @@ void AudioStreamStatsInterface::updateStream(const AudioStreamStats& stats) {
     timegapMsAvg(stats._timeGapAverage / USECS_PER_MSEC);
     timegapMsMaxWindow(stats._timeGapWindowMax / USECS_PER_MSEC);
     timegapMsAvgWindow(stats._timeGapWindowAverage / USECS_PER_MSEC);
+
+    addedLatencyMs(stats._addedLatencyMs);
+    concealRate(stats.getConcealRate());
+    stretchCount(stats._framesStretched);
+    compressCount(stats._framesCompressed);
 }
 
 AudioStatsInterface::AudioStatsInterface(QObject* parent) :
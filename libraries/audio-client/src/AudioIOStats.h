@@ -61,6 +61,10 @@ class AudioStreamStatsInterface : public QObject {
      * @property {number} timegapMsAvg <em>Read-only.</em>
      * @property {number} timegapMsMaxWindow <em>Read-only.</em>
      * @property {number} timegapMsAvgWindow <em>Read-only.</em>
+     * @property {number} addedLatencyMs <em>Read-only.</em>
+     * @property {number} concealRate <em>Read-only.</em>
+     * @property {number} stretchCount <em>Read-only.</em>
+     * @property {number} compressCount <em>Read-only.</em>
      */
 
     /**jsdoc
@@ -175,6 +179,34 @@ class AudioStreamStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(quint64, timegapMsAvgWindow)
 
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.addedLatencyMsChanged
+     * @param {number} addedLatencyMs
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, addedLatencyMs)
+
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.concealRateChanged
+     * @param {number} concealRate
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, concealRate)
+
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.stretchCountChanged
+     * @param {number} stretchCount
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(int, stretchCount)
+
+    /**jsdoc
+     * @function AudioStats.AudioStreamStats.compressCountChanged
+     * @param {number} compressCount
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(int, compressCount)
+
 public:
     void updateStream(const AudioStreamStats& stats);
 
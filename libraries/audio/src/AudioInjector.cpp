@@ -41,6 +41,7 @@ AudioInjectorState& operator|= (AudioInjectorState& lhs, AudioInjectorState rhs)
 AudioInjector::AudioInjector(const Sound& sound, const AudioInjectorOptions& injectorOptions) :
     AudioInjector(sound.getByteArray(), injectorOptions)
 {
+    _streamSource = sound.getStreamSource();
 }
 
 AudioInjector::AudioInjector(const QByteArray& audioData, const AudioInjectorOptions& injectorOptions) :
@@ -49,6 +50,12 @@ AudioInjector::AudioInjector(const QByteArray& audioData, const AudioInjectorOpt
 {
 }
 
+AudioInjector::AudioInjector(SoundStreamSourcePointer streamSource, const AudioInjectorOptions& injectorOptions) :
+    _streamSource(streamSource),
+    _options(injectorOptions)
+{
+}
+
 AudioInjector::~AudioInjector() {
     deleteLocalBuffer();
 }
@@ -122,6 +129,9 @@ void AudioInjector::restart() {
         if (!inject(&AudioInjectorManager::restartFinishedInjector)) {
             qWarning() << "AudioInjector::restart failed to thread injector";
         }
+    } else if (_stream) {
+        // a stream can't seek back, so start a new one from the beginning
+        _stream = startStream();
     }
 }
 
@@ -136,6 +146,10 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
     }
     _currentSendOffset = byteOffset;
 
+    if (_streamSource && !_options.localOnly) {
+        _stream = startStream();
+    }
+
     if (!injectLocally()) {
         finishLocalInjection();
     }
@@ -154,9 +168,13 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
 bool AudioInjector::injectLocally() {
     bool success = false;
     if (_localAudioInterface) {
-        if (_audioData.size() > 0) {
+        if (hasAudio()) {
 
-            _localBuffer = new AudioInjectorLocalBuffer(_audioData);
+            if (_streamSource) {
+                _localBuffer = new AudioInjectorLocalBuffer(startStream());
+            } else {
+                _localBuffer = new AudioInjectorLocalBuffer(_audioData);
+            }
 
             _localBuffer->open(QIODevice::ReadOnly);
             _localBuffer->setShouldLoop(_options.loop);
@@ -179,6 +197,12 @@ bool AudioInjector::injectLocally() {
     return success;
 }
 
+SoundStreamPointer AudioInjector::startStream() const {
+    auto stream = std::make_shared<SoundStream>(_streamSource, _options.loop, _options.pitch);
+    stream->start(_currentSendOffset / (stream->getNumChannels() * AudioConstants::SAMPLE_SIZE));
+    return stream;
+}
+
 void AudioInjector::deleteLocalBuffer() {
     if (_localBuffer) {
         _localBuffer->stop();
@@ -225,7 +249,7 @@ int64_t AudioInjector::injectNextFrame() {
         }
 
         // make sure we actually have samples downloaded to inject
-        if (_audioData.size()) {
+        if (hasAudio()) {
 
             int sampleSize = (_options.stereo ? 2 : 1) * sizeof(AudioConstants::AudioSample);
             auto numSamples = static_cast<int>(_audioData.size() / sampleSize);
@@ -245,7 +269,8 @@ int64_t AudioInjector::injectNextFrame() {
 
             _frameTimer->restart();
 
-            _currentPacket = NLPacket::create(PacketType::InjectAudio);
+            // reuse the packet of an injector that has finished, if there is one
+            _currentPacket = DependencyManager::get<AudioInjectorManager>()->takePacket();
 
             // setup the packet for injected audio
             QDataStream audioPacketStream(_currentPacket.get());
@@ -308,19 +333,11 @@ int64_t AudioInjector::injectNextFrame() {
     }
 
     int totalBytesLeftToCopy = (_options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
-    if (!_options.loop) {
+    if (!_options.loop && !_stream) {
         // If we aren't looping, let's make sure we don't read past the end
         totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
     }
 
-    //  Measure the loudness of this frame
-    _loudness = 0.0f;
-    for (int i = 0; i < totalBytesLeftToCopy; i += sizeof(int16_t)) {
-        _loudness += abs(*reinterpret_cast<int16_t*>(_audioData.data() + ((_currentSendOffset + i) % _audioData.size()))) /
-            (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
-    }
-    _loudness /= (float)(totalBytesLeftToCopy/ sizeof(int16_t));
-
     _currentPacket->seek(0);
 
     // pack the sequence number
@@ -342,16 +359,42 @@ int64_t AudioInjector::injectNextFrame() {
     // This code is copying bytes from the _audioData directly into the packet, handling looping appropriately.
     // Might be a reasonable place to do the encode step here.
     QByteArray decodedAudio;
-    while (totalBytesLeftToCopy > 0) {
-        int bytesToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
-
-        decodedAudio.append(_audioData.data() + _currentSendOffset, bytesToCopy);
-        _currentSendOffset += bytesToCopy;
-        totalBytesLeftToCopy -= bytesToCopy;
-        if (_options.loop && _currentSendOffset >= _audioData.size()) {
-            _currentSendOffset = 0;
+    if (_stream) {
+        decodedAudio.resize(totalBytesLeftToCopy);
+        int bytesRead = _stream->read(reinterpret_cast<int16_t*>(decodedAudio.data()),
+                                      totalBytesLeftToCopy / sizeof(int16_t)) * sizeof(int16_t);
+        if (_stream->isFinished()) {
+            decodedAudio.resize(bytesRead);
+        } else {
+            // the decoder fell behind, pad the frame with silence so the mixer doesn't starve
+            memset(decodedAudio.data() + bytesRead, 0, totalBytesLeftToCopy - bytesRead);
+        }
+    } else {
+        while (totalBytesLeftToCopy > 0) {
+            int bytesToCopy = std::min(totalBytesLeftToCopy, _audioData.size() - _currentSendOffset);
+
+            decodedAudio.append(_audioData.data() + _currentSendOffset, bytesToCopy);
+            _currentSendOffset += bytesToCopy;
+            totalBytesLeftToCopy -= bytesToCopy;
+            if (_options.loop && _currentSendOffset >= _audioData.size()) {
+                _currentSendOffset = 0;
+            }
         }
     }
+
+    if (decodedAudio.isEmpty()) {
+        // the stream finished on the previous frame boundary, so there is nothing left to measure or send
+        finishNetworkInjection();
+        return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
+    }
+
+    //  Measure the loudness of this frame
+    _loudness = 0.0f;
+    for (int i = 0; i < decodedAudio.size(); i += sizeof(int16_t)) {
+        _loudness += abs(*reinterpret_cast<int16_t*>(decodedAudio.data() + i)) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+    }
+    _loudness /= (float)(decodedAudio.size() / sizeof(int16_t));
+
     // FIXME -- good place to call codec encode here. We need to figure out how to tell the AudioInjector which
     // codec to use... possible through AbstractAudioInterface.
     QByteArray encodedAudio = decodedAudio;
@@ -370,7 +413,8 @@ int64_t AudioInjector::injectNextFrame() {
         _outgoingSequenceNumber++;
     }
 
-    if (_currentSendOffset >= _audioData.size() && !_options.loop) {
+    bool isAtEnd = _stream ? _stream->isFinished() : (_currentSendOffset >= _audioData.size() && !_options.loop);
+    if (isAtEnd) {
         finishNetworkInjection();
         return NEXT_FRAME_DELTA_ERROR_OR_FINISHED;
     }
@@ -390,7 +434,10 @@ int64_t AudioInjector::injectNextFrame() {
         // If we are falling behind by more frames than our threshold, let's skip the frames ahead
         qCDebug(audio)  << this << "injectNextFrame() skipping ahead, fell behind by " << (currentFrameBasedOnElapsedTime - _nextFrame) << " frames";
         _nextFrame = currentFrameBasedOnElapsedTime;
-        _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (_options.stereo ? 2 : 1) % _audioData.size();
+        if (!_stream) {
+            // a stream can't jump ahead, so it carries on from where it was
+            _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (_options.stereo ? 2 : 1) % _audioData.size();
+        }
     }
 
     int64_t playNextFrameAt = ++_nextFrame * AudioConstants::NETWORK_FRAME_USECS;
@@ -429,6 +476,14 @@ AudioInjectorPointer AudioInjector::playSound(SharedSoundPointer sound, const fl
     options.volume = volume;
     options.pitch = 1.0f / stretchFactor;
 
+    if (sound->isStreaming()) {
+        AudioInjectorPointer injector = playSound(sound, options);
+        if (injector) {
+            injector->_state |= AudioInjectorState::PendingDelete;
+        }
+        return injector;
+    }
+
     QByteArray samples = sound->getByteArray();
 
     return playSoundAndDelete(samples, options);
@@ -444,6 +499,20 @@ AudioInjectorPointer AudioInjector::playSoundAndDelete(const QByteArray& buffer,
     return sound;
 }
 
+AudioInjectorPointer AudioInjector::playSound(SharedSoundPointer sound, const AudioInjectorOptions options) {
+    if (!sound->isStreaming()) {
+        return playSound(sound->getByteArray(), options);
+    }
+
+    // the stream applies the pitch as it resamples
+    AudioInjectorPointer injector = AudioInjectorPointer::create(sound->getStreamSource(), options);
+
+    if (!injector->inject(&AudioInjectorManager::threadInjector)) {
+        qWarning() << "AudioInjector::playSound failed to thread streaming injector";
+    }
+    return injector;
+}
+
 AudioInjectorPointer AudioInjector::playSound(const QByteArray& buffer, const AudioInjectorOptions options) {
 
     if (options.pitch == 1.0f) {
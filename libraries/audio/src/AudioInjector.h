@@ -54,6 +54,7 @@ class AudioInjector : public QObject, public QEnableSharedFromThis<AudioInjector
 public:
     AudioInjector(const Sound& sound, const AudioInjectorOptions& injectorOptions);
     AudioInjector(const QByteArray& audioData, const AudioInjectorOptions& injectorOptions);
+    AudioInjector(SoundStreamSourcePointer streamSource, const AudioInjectorOptions& injectorOptions);
     ~AudioInjector();
 
     bool isFinished() const { return (stateHas(AudioInjectorState::Finished)); }
@@ -76,6 +77,7 @@ public:
     static void setLocalAudioInterface(AbstractAudioInterface* audioInterface) { _localAudioInterface = audioInterface; }
     static AudioInjectorPointer playSoundAndDelete(const QByteArray& buffer, const AudioInjectorOptions options);
     static AudioInjectorPointer playSound(const QByteArray& buffer, const AudioInjectorOptions options);
+    static AudioInjectorPointer playSound(SharedSoundPointer sound, const AudioInjectorOptions options);
     static AudioInjectorPointer playSound(SharedSoundPointer sound, const float volume,
                                           const float stretchFactor, const glm::vec3 position);
 
@@ -102,11 +104,19 @@ private:
     int64_t injectNextFrame();
     bool inject(bool(AudioInjectorManager::*injection)(const AudioInjectorPointer&));
     bool injectLocally();
+    bool hasAudio() const { return _streamSource || _audioData.size() > 0; }
+    SoundStreamPointer startStream() const;
+    uint64_t getNumStreamUnderrunSamples() const { return _stream ? _stream->getNumUnderrunSamples() : 0; }
     void deleteLocalBuffer();
 
     static AbstractAudioInterface* _localAudioInterface;
 
     QByteArray _audioData;
+
+    // long sounds are decoded as they play, with separate streams for the network and the local buffer
+    SoundStreamSourcePointer _streamSource;
+    SoundStreamPointer _stream;
+
     AudioInjectorOptions _options;
     AudioInjectorState _state { AudioInjectorState::NotFinished };
     bool _hasSentFirstFrame { false };
@@ -20,6 +20,15 @@ AudioInjectorLocalBuffer::AudioInjectorLocalBuffer(const QByteArray& rawAudioArr
     
 }
 
+AudioInjectorLocalBuffer::AudioInjectorLocalBuffer(SoundStreamPointer stream) :
+    _stream(stream),
+    _shouldLoop(false),
+    _isStopped(false),
+    _currentOffset(0)
+{
+
+}
+
 void AudioInjectorLocalBuffer::stop() {
     _isStopped = true;
     
@@ -36,7 +45,18 @@ bool AudioInjectorLocalBuffer::seek(qint64 pos) {
 
 
 qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
-    if (!_isStopped) {
+    if (!_isStopped && _stream) {
+
+        // the stream loops on its own; if its decoder has fallen behind, pad with silence rather than ending
+        int samplesRead = _stream->read(reinterpret_cast<int16_t*>(data), (int)(maxSize / sizeof(int16_t)));
+        qint64 bytesRead = samplesRead * sizeof(int16_t);
+        if (bytesRead < maxSize && !_stream->isFinished()) {
+            memset(data + bytesRead, 0, maxSize - bytesRead);
+            bytesRead = maxSize;
+        }
+        return bytesRead;
+
+    } else if (!_isStopped) {
         
         // first copy to the end of the raw audio
         int bytesToEnd = _rawAudioArray.size() - _currentOffset;
@@ -16,10 +16,13 @@
 
 #include <glm/detail/func_common.hpp>
 
+#include "SoundStream.h"
+
 class AudioInjectorLocalBuffer : public QIODevice {
     Q_OBJECT
 public:
     AudioInjectorLocalBuffer(const QByteArray& rawAudioArray);
+    AudioInjectorLocalBuffer(SoundStreamPointer stream);
 
     void stop();
 
@@ -35,6 +38,7 @@ private:
     qint64 recursiveReadFromFront(char* data, qint64 maxSize);
 
     QByteArray _rawAudioArray;
+    SoundStreamPointer _stream; // reads come from here instead of _rawAudioArray when set
     bool _shouldLoop;
     bool _isStopped;
 
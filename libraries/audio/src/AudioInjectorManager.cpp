@@ -19,27 +19,18 @@
 #include "AudioInjector.h"
 #include "AudioLogging.h"
 
-AudioInjectorManager::~AudioInjectorManager() {
-    _shouldStop = true;
-
-    Lock lock(_injectorsMutex);
+// injectors due within this much of each other are sent in the same tick, so that hundreds of injectors wake the thread
+// a few times per network frame instead of once each; sending a little early is absorbed by the mixer's jitter buffer
+static const uint64_t TICK_SLACK_USECS = AudioConstants::NETWORK_FRAME_USECS / 4;
 
-    // make sure any still living injectors are stopped and deleted
-    while (!_injectors.empty()) {
-        // grab the injector at the front
-        auto& timePointerPair = _injectors.top();
-
-        // ask it to stop and be deleted
-        timePointerPair.second->stop();
-
-        _injectors.pop();
-    }
+// a frame sent this long after it was due is counted as late
+static const uint64_t LATE_FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
 
-    // get rid of the lock now that we've stopped all living injectors
-    lock.unlock();
+AudioInjectorManager::~AudioInjectorManager() {
+    _shouldStop = true;
 
-    // in case the thread is waiting for injectors wake it up now
-    _injectorReady.notify_one();
+    // wake the thread so it stops any still living injectors and returns from run
+    notifyInjectorReadyCondition();
 
     // quit and wait on the manager thread, if we ever created it
     if (_thread) {
@@ -48,6 +39,16 @@ AudioInjectorManager::~AudioInjectorManager() {
     }
 }
 
+AudioInjectorManager::Stats AudioInjectorManager::getAndResetStats() {
+    Stats stats;
+    stats.numInjectors = _numInjectors;
+    stats.numTicks = _numTicks.exchange(0);
+    stats.numFramesSent = _numFramesSent.exchange(0);
+    stats.numLateFrames = _numLateFrames.exchange(0);
+    stats.numUnderrunSamples = _numUnderrunSamples.exchange(0);
+    return stats;
+}
+
 void AudioInjectorManager::createThread() {
     _thread = new QThread;
     _thread->setObjectName("Audio Injector Thread");
@@ -59,79 +60,127 @@ void AudioInjectorManager::createThread() {
     _thread->start();
 }
 
+void AudioInjectorManager::notifyInjectorReadyCondition() {
+    _wakeRequested = true;
+
+    // take the lock so the notify can't slip in between the thread checking _wakeRequested and going to sleep
+    { Lock lock(_wakeMutex); }
+    _injectorReady.notify_one();
+}
+
 void AudioInjectorManager::run() {
     while (!_shouldStop) {
-        // wait until the next injector is ready, or until we get a new injector given to us
-        Lock lock(_injectorsMutex);
+        _wakeRequested = false;
+
+        takeNewInjectors();
+
+        auto shouldWake = [&] { return _shouldStop || _wakeRequested; };
 
         if (_injectors.size() > 0) {
             // when does the next injector need to send a frame?
             // do we get to wait or should we just go for it now?
+            auto now = usecTimestampNow();
+            auto nextTimestamp = _injectors.top().first;
+
+            if (nextTimestamp <= now + TICK_SLACK_USECS) {
+                sendDueFrames(now);
+            } else {
+                Lock lock(_wakeMutex);
+                _injectorReady.wait_for(lock, std::chrono::microseconds(nextTimestamp - now), shouldWake);
+            }
+        } else {
+            // we have no current injectors, wait until we get at least one before we do anything
+            Lock lock(_wakeMutex);
+            _injectorReady.wait(lock, shouldWake);
+        }
 
-            auto timeInjectorPair = _injectors.top();
+        QCoreApplication::processEvents();
+    }
 
-            auto nextTimestamp = timeInjectorPair.first;
-            int64_t difference = int64_t(nextTimestamp - usecTimestampNow());
+    // make sure any still living injectors are stopped and deleted
+    takeNewInjectors();
+    while (!_injectors.empty()) {
+        _injectors.top().second->stop();
+        _injectors.pop();
+    }
+    QCoreApplication::processEvents();
+}
 
-            if (difference > 0) {
-                _injectorReady.wait_for(lock, std::chrono::microseconds(difference));
-            }
+void AudioInjectorManager::takeNewInjectors() {
+    AudioInjectorPointer injector;
+    while (_newInjectors.try_pop(injector)) {
+        // add the injector to the queue with a send timestamp of now
+        _injectors.emplace(usecTimestampNow(), injector);
+    }
+}
 
-            if (_injectors.size() > 0) {
-                // loop through the injectors in the map and send whatever frames need to go out
-                auto front = _injectors.top();
-
-                // create an InjectorQueue to hold injectors to be queued
-                // this allows us to call processEvents even if a single injector wants to be re-queued immediately
-                std::vector<TimeInjectorPointerPair> heldInjectors;
-                heldInjectors.reserve(_injectors.size());
-
-                while (_injectors.size() > 0 && front.first <= usecTimestampNow()) {
-                    // either way we're popping this injector off - get a copy first
-                    auto injector = front.second;
-                    _injectors.pop();
-
-                    if (!injector.isNull()) {
-                        // this is an injector that's ready to go, have it send a frame now
-                        auto nextCallDelta = injector->injectNextFrame();
-
-                        if (nextCallDelta >= 0 && !injector->isFinished()) {
-                            // enqueue the injector with the correct timing in our holding queue
-                            heldInjectors.emplace(heldInjectors.end(), usecTimestampNow() + nextCallDelta, injector);
-                        }
-                    }
-
-                    if (_injectors.size() > 0) {
-                        front = _injectors.top();
-                    } else {
-                        // no more injectors to look at, break
-                        break;
-                    }
-                }
-
-                // if there are injectors in the holding queue, push them to our persistent queue now
-                while (!heldInjectors.empty()) {
-                    _injectors.push(heldInjectors.back());
-                    heldInjectors.pop_back();
-                }
-            }
+void AudioInjectorManager::sendDueFrames(uint64_t now) {
+    // pull everything due this tick off the queue first, so an injector that wants to go again right away
+    // (the first two frames) waits for the next tick instead of being sent twice in this one
+    _dueInjectors.clear();
+    while (_injectors.size() > 0 && _injectors.top().first <= now + TICK_SLACK_USECS) {
+        _dueInjectors.push_back(_injectors.top());
+        _injectors.pop();
+    }
+
+    for (auto& timeInjectorPair : _dueInjectors) {
+        auto& injector = timeInjectorPair.second;
+        if (injector.isNull()) {
+            continue;
+        }
+
+        if (usecTimestampNow() > timeInjectorPair.first + LATE_FRAME_USECS) {
+            ++_numLateFrames;
+        }
+
+        // this is an injector that's ready to go, have it send a frame now
+        uint64_t numUnderrunSamples = injector->getNumStreamUnderrunSamples();
+        auto nextCallDelta = injector->injectNextFrame();
+        ++_numFramesSent;
+
+        // a restart starts a new stream, with a count of its own
+        if (injector->getNumStreamUnderrunSamples() > numUnderrunSamples) {
+            _numUnderrunSamples += injector->getNumStreamUnderrunSamples() - numUnderrunSamples;
+        }
 
+        if (nextCallDelta >= 0 && !injector->isFinished()) {
+            _injectors.emplace(usecTimestampNow() + nextCallDelta, injector);
         } else {
-            // we have no current injectors, wait until we get at least one before we do anything
-            _injectorReady.wait(lock);
+            // this injector is done with the network, the next one to start can have its packet
+            recyclePacket(std::move(injector->_currentPacket));
+            --_numInjectors;
         }
+    }
 
-        // unlock the lock in case something in process events needs to modify the queue
-        lock.unlock();
+    // let go of the injectors we no longer hold in the queue
+    _dueInjectors.clear();
+    ++_numTicks;
+}
 
-        QCoreApplication::processEvents();
+std::unique_ptr<NLPacket> AudioInjectorManager::takePacket() {
+    if (_packetPool.empty()) {
+        return NLPacket::create(PacketType::InjectAudio);
+    }
+
+    auto packet = std::move(_packetPool.back());
+    _packetPool.pop_back();
+    packet->reset();
+    return packet;
+}
+
+void AudioInjectorManager::recyclePacket(std::unique_ptr<NLPacket> packet) {
+    // the pool never holds more packets than there were injectors running at once
+    if (packet) {
+        _packetPool.push_back(std::move(packet));
     }
 }
 
-static const int MAX_INJECTORS_PER_THREAD = 40; // calculated based on AudioInjector time to send frame, with sufficient padding
+// calculated based on AudioInjector time to send frame, with sufficient padding now that injectors due together
+// share a tick instead of each waking the thread
+static const int MAX_INJECTORS_PER_THREAD = 256;
 
-bool AudioInjectorManager::wouldExceedLimits() { // Should be called inside of a lock.
-    if (_injectors.size() >= MAX_INJECTORS_PER_THREAD) {
+bool AudioInjectorManager::wouldExceedLimits() {
+    if (_numInjectors >= MAX_INJECTORS_PER_THREAD) {
         qCDebug(audio)  << "AudioInjectorManager::threadInjector could not thread AudioInjector - at max of"
             << MAX_INJECTORS_PER_THREAD << "current audio injectors.";
         return true;
@@ -139,33 +188,31 @@ bool AudioInjectorManager::wouldExceedLimits() { // Should be called inside of a
     return false;
 }
 
+void AudioInjectorManager::queueInjector(const AudioInjectorPointer& injector) {
+    ++_numInjectors;
+    _newInjectors.push(injector);
+
+    // notify our wait condition so we can inject two frames for this injector immediately
+    notifyInjectorReadyCondition();
+}
+
 bool AudioInjectorManager::threadInjector(const AudioInjectorPointer& injector) {
     if (_shouldStop) {
         qCDebug(audio)  << "AudioInjectorManager::threadInjector asked to thread injector but is shutting down.";
         return false;
     }
 
-    // guard the injectors vector with a mutex
-    Lock lock(_injectorsMutex);
-
     if (wouldExceedLimits()) {
         return false;
-    } else {
-        if (!_thread) {
-            createThread();
-        }
-
-        // move the injector to the QThread
-        injector->moveToThread(_thread);
+    }
 
-        // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), injector);
+    std::call_once(_createThreadOnce, [this] { createThread(); });
 
-        // notify our wait condition so we can inject two frames for this injector immediately
-        _injectorReady.notify_one();
+    // move the injector to the QThread
+    injector->moveToThread(_thread);
 
-        return true;
-    }
+    queueInjector(injector);
+    return true;
 }
 
 bool AudioInjectorManager::restartFinishedInjector(const AudioInjectorPointer& injector) {
@@ -174,17 +221,10 @@ bool AudioInjectorManager::restartFinishedInjector(const AudioInjectorPointer& i
         return false;
     }
 
-    // guard the injectors vector with a mutex
-    Lock lock(_injectorsMutex);
-
     if (wouldExceedLimits()) {
         return false;
-    } else {
-        // add the injector to the queue with a send timestamp of now
-        _injectors.emplace(usecTimestampNow(), injector);
-
-        // notify our wait condition so we can inject two frames for this injector immediately
-        _injectorReady.notify_one();
     }
+
+    queueInjector(injector);
     return true;
 }
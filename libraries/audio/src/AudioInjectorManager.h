@@ -14,14 +14,17 @@
 #ifndef hifi_AudioInjectorManager_h
 #define hifi_AudioInjectorManager_h
 
+#include <atomic>
 #include <condition_variable>
 #include <queue>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QPointer>
 #include <QtCore/QThread>
 
 #include <DependencyManager.h>
+#include <TBBHelpers.h>
 
 #include "AudioInjector.h"
 
@@ -30,6 +33,18 @@ class AudioInjectorManager : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
 public:
     ~AudioInjectorManager();
+
+    struct Stats {
+        int numInjectors { 0 };
+        uint64_t numTicks { 0 }; // wake ups that sent at least one frame
+        uint64_t numFramesSent { 0 };
+        uint64_t numLateFrames { 0 }; // frames sent more than a network frame after they were due
+        uint64_t numUnderrunSamples { 0 }; // samples of streamed sounds sent as silence because the decoder fell behind
+    };
+
+    // counts since the last call
+    Stats getAndResetStats();
+
 private slots:
     void run();
 private:
@@ -43,15 +58,22 @@ private:
     };
 
     using InjectorQueue = std::priority_queue<TimeInjectorPointerPair,
-                                              std::deque<TimeInjectorPointerPair>,
+                                              std::vector<TimeInjectorPointerPair>,
                                               greaterTime>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
 
     bool threadInjector(const AudioInjectorPointer& injector);
     bool restartFinishedInjector(const AudioInjectorPointer& injector);
-    void notifyInjectorReadyCondition() { _injectorReady.notify_one(); }
+    void notifyInjectorReadyCondition();
     bool wouldExceedLimits();
+    void queueInjector(const AudioInjectorPointer& injector);
+
+    // called on the injector thread only
+    void takeNewInjectors();
+    void sendDueFrames(uint64_t now);
+    std::unique_ptr<NLPacket> takePacket();
+    void recyclePacket(std::unique_ptr<NLPacket> packet);
 
     AudioInjectorManager() {};
     AudioInjectorManager(const AudioInjectorManager&) = delete;
@@ -60,10 +82,29 @@ private:
     void createThread();
 
     QThread* _thread { nullptr };
-    bool _shouldStop { false };
+    std::once_flag _createThreadOnce;
+    std::atomic<bool> _shouldStop { false };
+
+    // injectors handed to us from other threads, moved into _injectors by the injector thread
+    tbb::concurrent_queue<AudioInjectorPointer> _newInjectors;
+    std::atomic<int> _numInjectors { 0 };
+
+    // owned by the injector thread, ordered by when each injector's next frame is due
     InjectorQueue _injectors;
-    Mutex _injectorsMutex;
+    std::vector<TimeInjectorPointerPair> _dueInjectors;
+
+    // InjectAudio packets of injectors that finished, reused by the next injectors to start
+    std::vector<std::unique_ptr<NLPacket>> _packetPool;
+
+    // only used to sleep the injector thread until the next frame is due or something changes
+    Mutex _wakeMutex;
     std::condition_variable _injectorReady;
+    std::atomic<bool> _wakeRequested { false };
+
+    std::atomic<uint64_t> _numTicks { 0 };
+    std::atomic<uint64_t> _numFramesSent { 0 };
+    std::atomic<uint64_t> _numLateFrames { 0 };
+    std::atomic<uint64_t> _numUnderrunSamples { 0 };
 
     friend class AudioInjector;
 };
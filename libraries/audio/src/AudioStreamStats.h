@@ -39,6 +39,10 @@ public:
         _consecutiveNotMixedCount(0),
         _overflowCount(0),
         _framesDropped(0),
+        _addedLatencyMs(0),
+        _framesConcealed(0),
+        _framesStretched(0),
+        _framesCompressed(0),
         _packetStreamStats(),
         _packetStreamWindowStats()
     {}
@@ -62,6 +66,17 @@ public:
     quint32 _overflowCount;
     quint32 _framesDropped;
 
+    // time-stretching jitter buffer
+    quint16 _addedLatencyMs; // average time audio waits in the buffer
+    quint32 _framesConcealed; // frames made up for lost packets
+    quint32 _framesStretched;
+    quint32 _framesCompressed;
+
+    float getConcealRate() const {
+        return _packetStreamStats._expectedReceived == 0 ? 0.0f :
+            (float)_framesConcealed / (float)_packetStreamStats._expectedReceived;
+    }
+
     PacketStreamStats _packetStreamStats;
     PacketStreamStats _packetStreamWindowStats;
 };
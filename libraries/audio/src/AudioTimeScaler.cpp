@@ -0,0 +1,174 @@
+//
+//  AudioTimeScaler.cpp
+//  libraries/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioTimeScaler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "AudioConstants.h"
+
+const int AudioTimeScaler::MIN_PERIOD = AudioConstants::SAMPLE_RATE / 500;
+const int AudioTimeScaler::MAX_PERIOD = AudioConstants::SAMPLE_RATE / 200;
+
+// how alike two consecutive periods must be (normalized cross-correlation) before one is removed or repeated
+static const float MIN_PERIOD_CORRELATION = 0.7f;
+
+// frames quieter than this RMS can be cut or repeated anywhere, since the cross-fade hides the splice
+static const float QUIET_RMS = 0.01f * AudioConstants::MAX_SAMPLE_VALUE;
+
+AudioTimeScaler::AudioTimeScaler(int numChannels) :
+    _numChannels(numChannels),
+    _history(2 * MAX_PERIOD * numChannels)
+{
+}
+
+void AudioTimeScaler::reset() {
+    _historyFrames = 0;
+    _concealPeriod = 0;
+    _concealPosition = 0;
+}
+
+int AudioTimeScaler::findPeriod(const int16_t* samples, int numFrames, bool& isQuiet) {
+    _mono.resize(numFrames);
+
+    float energy = 0.0f;
+    for (int i = 0; i < numFrames; i++) {
+        float sum = 0.0f;
+        for (int c = 0; c < _numChannels; c++) {
+            sum += samples[i * _numChannels + c];
+        }
+        _mono[i] = sum / _numChannels;
+        energy += _mono[i] * _mono[i];
+    }
+    isQuiet = sqrtf(energy / numFrames) < QUIET_RMS;
+
+    // compare each candidate period with the one that follows it
+    int bestPeriod = 0;
+    float bestCorrelation = MIN_PERIOD_CORRELATION;
+    for (int period = MIN_PERIOD; period <= MAX_PERIOD && 2 * period <= numFrames; period++) {
+        float xy = 0.0f;
+        float xx = 0.0f;
+        float yy = 0.0f;
+        for (int i = 0; i < period; i++) {
+            float x = _mono[i];
+            float y = _mono[i + period];
+            xy += x * y;
+            xx += x * x;
+            yy += y * y;
+        }
+        if (xx > 0.0f && yy > 0.0f) {
+            float correlation = xy / sqrtf(xx * yy);
+            if (correlation > bestCorrelation) {
+                bestCorrelation = correlation;
+                bestPeriod = period;
+            }
+        }
+    }
+    return bestPeriod;
+}
+
+int AudioTimeScaler::compress(const int16_t* input, int numFrames, int16_t* output) {
+    bool isQuiet = false;
+    int period = (numFrames >= 2 * MIN_PERIOD) ? findPeriod(input, numFrames, isQuiet) : 0;
+    if (period == 0 && isQuiet) {
+        period = std::min(MAX_PERIOD, numFrames / 2);
+    }
+    if (period == 0) {
+        memcpy(output, input, numFrames * _numChannels * sizeof(int16_t));
+        return numFrames;
+    }
+
+    // fade from the first period into the second, then carry on after the second
+    for (int i = 0; i < period; i++) {
+        float fadeIn = (i + 0.5f) / period;
+        for (int c = 0; c < _numChannels; c++) {
+            float first = input[i * _numChannels + c];
+            float second = input[(i + period) * _numChannels + c];
+            output[i * _numChannels + c] = (int16_t)(first * (1.0f - fadeIn) + second * fadeIn);
+        }
+    }
+    memcpy(output + period * _numChannels, input + 2 * period * _numChannels,
+           (numFrames - 2 * period) * _numChannels * sizeof(int16_t));
+
+    return numFrames - period;
+}
+
+int AudioTimeScaler::expand(const int16_t* input, int numFrames, int16_t* output) {
+    bool isQuiet = false;
+    int period = (numFrames >= 2 * MIN_PERIOD) ? findPeriod(input, numFrames, isQuiet) : 0;
+    if (period == 0 && isQuiet) {
+        period = std::min(MAX_PERIOD, numFrames / 2);
+    }
+    if (period == 0) {
+        memcpy(output, input, numFrames * _numChannels * sizeof(int16_t));
+        return numFrames;
+    }
+
+    // play the first two periods, fading from the second back into the first, then play on from the second
+    memcpy(output, input, period * _numChannels * sizeof(int16_t));
+    for (int i = 0; i < period; i++) {
+        float fadeIn = (i + 0.5f) / period;
+        for (int c = 0; c < _numChannels; c++) {
+            float second = input[(i + period) * _numChannels + c];
+            float first = input[i * _numChannels + c];
+            output[(i + period) * _numChannels + c] = (int16_t)(second * (1.0f - fadeIn) + first * fadeIn);
+        }
+    }
+    memcpy(output + 2 * period * _numChannels, input + period * _numChannels,
+           (numFrames - period) * _numChannels * sizeof(int16_t));
+
+    return numFrames + period;
+}
+
+void AudioTimeScaler::remember(const int16_t* samples, int numFrames) {
+    const int capacity = 2 * MAX_PERIOD;
+    if (numFrames >= capacity) {
+        memcpy(_history.data(), samples + (numFrames - capacity) * _numChannels, capacity * _numChannels * sizeof(int16_t));
+        _historyFrames = capacity;
+    } else {
+        int keptFrames = std::min(_historyFrames, capacity - numFrames);
+        memmove(_history.data(), _history.data() + (_historyFrames - keptFrames) * _numChannels,
+                keptFrames * _numChannels * sizeof(int16_t));
+        memcpy(_history.data() + keptFrames * _numChannels, samples, numFrames * _numChannels * sizeof(int16_t));
+        _historyFrames = keptFrames + numFrames;
+    }
+
+    // the next loss starts over from this audio
+    _concealPeriod = 0;
+    _concealPosition = 0;
+}
+
+void AudioTimeScaler::conceal(int16_t* output, int numFrames, float gain) {
+    if (_historyFrames < 2 * MIN_PERIOD) {
+        memset(output, 0, numFrames * _numChannels * sizeof(int16_t));
+        return;
+    }
+
+    if (_concealPeriod == 0) {
+        bool isQuiet = false;
+        _concealPeriod = findPeriod(_history.data(), _historyFrames, isQuiet);
+        if (_concealPeriod == 0) {
+            // nothing periodic to continue, so repeat as long a stretch as we have
+            _concealPeriod = std::min(MAX_PERIOD, _historyFrames / 2);
+        }
+        _concealPosition = 0;
+    }
+
+    // loop over the last period of the good audio
+    const int16_t* period = _history.data() + (_historyFrames - _concealPeriod) * _numChannels;
+    for (int i = 0; i < numFrames; i++) {
+        for (int c = 0; c < _numChannels; c++) {
+            output[i * _numChannels + c] = (int16_t)(period[_concealPosition * _numChannels + c] * gain);
+        }
+        _concealPosition = (_concealPosition + 1) % _concealPeriod;
+    }
+}
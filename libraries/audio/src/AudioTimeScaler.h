@@ -0,0 +1,60 @@
+//
+//  AudioTimeScaler.h
+//  libraries/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioTimeScaler_h
+#define hifi_AudioTimeScaler_h
+
+#include <stdint.h>
+#include <vector>
+
+// Changes the length of network audio frames without changing their pitch, so that a jitter buffer can shrink or grow
+// without dropping frames or inserting silence, and synthesizes frames for lost packets.
+//
+// compress() and expand() are a single-step WSOLA: they find the pitch period with the best waveform similarity in the
+// frame and remove or repeat one period of it, cross-fading across the splice. Frames with no clear period are left
+// alone unless they are quiet. conceal() keeps repeating the last period of the good audio that came before.
+class AudioTimeScaler {
+public:
+    // search range for the pitch period, in frames at AudioConstants::SAMPLE_RATE (500Hz down to 200Hz)
+    static const int MIN_PERIOD;
+    static const int MAX_PERIOD;
+
+    AudioTimeScaler(int numChannels);
+
+    void reset();
+
+    // shortens the input by about one pitch period, returns the number of frames written to output
+    // (numFrames if the input can't be shortened cleanly). output must hold numFrames frames.
+    int compress(const int16_t* input, int numFrames, int16_t* output);
+
+    // lengthens the input by about one pitch period, returns the number of frames written to output
+    // (numFrames if the input can't be lengthened cleanly). output must hold numFrames + MAX_PERIOD frames.
+    int expand(const int16_t* input, int numFrames, int16_t* output);
+
+    // keeps the tail of good audio that conceal() continues from
+    void remember(const int16_t* samples, int numFrames);
+
+    // writes numFrames frames continuing the remembered audio, scaled by gain
+    void conceal(int16_t* output, int numFrames, float gain);
+
+private:
+    // returns the lag in [MIN_PERIOD, MAX_PERIOD] where samples look most like themselves, 0 if nothing is close enough
+    int findPeriod(const int16_t* samples, int numFrames, bool& isQuiet);
+
+    const int _numChannels;
+    std::vector<float> _mono; // scratch for findPeriod
+
+    std::vector<int16_t> _history; // the last 2 * MAX_PERIOD frames of good audio, interleaved
+    int _historyFrames { 0 };
+    int _concealPeriod { 0 };
+    int _concealPosition { 0 };
+};
+
+#endif // hifi_AudioTimeScaler_h
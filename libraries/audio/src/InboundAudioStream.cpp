@@ -11,6 +11,8 @@
 
 #include "InboundAudioStream.h"
 
+#include <algorithm>
+
 #include <glm/glm.hpp>
 
 #include <NLPacket.h>
@@ -27,6 +29,8 @@ const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVE
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_REDUCTION = 10;
 const bool InboundAudioStream::USE_STDEV_FOR_JITTER = false;
 const bool InboundAudioStream::REPETITION_WITH_FADE = true;
+const bool InboundAudioStream::DEFAULT_TIME_STRETCHING_ENABLED = false;
+const float InboundAudioStream::TIME_STRETCHING_JITTER_PERCENTILE = 0.98f;
 
 static const int STARVE_HISTORY_CAPACITY = 50;
 
@@ -47,6 +51,10 @@ static const int STATS_FOR_STATS_PACKET_WINDOW_SECONDS = 30;
 // _currentJitterBufferFrames is updated with the time-weighted avg and the running time-weighted avg is reset.
 static const quint64 FRAMES_AVAILABLE_STAT_WINDOW_USECS = 10 * USECS_PER_SECOND;
 
+// With time-stretching, the desired frames follow a percentile of this many recent packet time gaps (about 10s),
+// and only come down once there have been no starves for WINDOW_SECONDS_FOR_DESIRED_REDUCTION.
+static const size_t TIME_STRETCHING_TIME_GAPS_WINDOW = 1000;
+
 // When the audio codec is switched, temporary codec mismatch is expected due to packets in-flight.
 // A SelectedAudioFormat packet is not sent until this threshold is exceeded.
 static const int MAX_MISMATCHED_AUDIO_CODEC_COUNT = 10;
@@ -59,6 +67,7 @@ InboundAudioStream::InboundAudioStream(int numChannels, int numFrames, int numBl
     _desiredJitterBufferFrames(_dynamicJitterBufferEnabled ? 1 : _staticJitterBufferFrames),
     _incomingSequenceNumberStats(STATS_FOR_STATS_PACKET_WINDOW_SECONDS),
     _starveHistory(STARVE_HISTORY_CAPACITY),
+    _timeScaler(numChannels),
     _unplayedMs(0, UNPLAYED_MS_WINDOW_SECS),
     _timeGapStatsForStatsPacket(0, STATS_FOR_STATS_PACKET_WINDOW_SECONDS) {}
 
@@ -86,6 +95,14 @@ void InboundAudioStream::resetStats() {
     _starveCount = 0;
     _silentFramesDropped = 0;
     _oldFramesDropped = 0;
+    _framesConcealed = 0;
+    _framesStretched = 0;
+    _framesCompressed = 0;
+    _consecutiveFramesConcealed = 0;
+    _recentTimeGaps.clear();
+    _nextTimeGapIndex = 0;
+    _lastStarveTime = 0;
+    _timeScaler.reset();
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
@@ -115,6 +132,31 @@ void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _timeGapStatsForDesiredReduction.currentIntervalComplete();
     _timeGapStatsForStatsPacket.currentIntervalComplete();
     _unplayedMs.currentIntervalComplete();
+
+    if (_timeStretchingEnabled && _dynamicJitterBufferEnabled) {
+        updateDesiredJitterBufferFramesFromPercentile();
+    }
+}
+
+void InboundAudioStream::updateDesiredJitterBufferFramesFromPercentile() {
+    if (_recentTimeGaps.size() < TIME_STRETCHING_TIME_GAPS_WINDOW) {
+        return;
+    }
+
+    std::vector<quint64> timeGaps = _recentTimeGaps;
+    auto percentile = timeGaps.begin() + (size_t)(TIME_STRETCHING_JITTER_PERCENTILE * (timeGaps.size() - 1));
+    std::nth_element(timeGaps.begin(), percentile, timeGaps.end());
+    int percentileFrames = std::max(1, (int)ceilf((float)*percentile / (float)AudioConstants::NETWORK_FRAME_USECS));
+
+    // starves still push the desired frames up right away (see setToStarved), but we only come back down
+    // to the percentile once things have settled
+    quint64 now = usecTimestampNow();
+    bool recentlyStarved = now - _lastStarveTime < WINDOW_SECONDS_FOR_DESIRED_REDUCTION * USECS_PER_SECOND;
+    if (percentileFrames > _desiredJitterBufferFrames ||
+        (percentileFrames < _desiredJitterBufferFrames && !recentlyStarved)) {
+        _desiredJitterBufferFrames = percentileFrames;
+        qCInfo(audiostream, "Set desired jitter frames to %d (percentile)", _desiredJitterBufferFrames);
+    }
 }
 
 int InboundAudioStream::parseData(ReceivedMessage& message) {
@@ -248,17 +290,60 @@ int InboundAudioStream::lostAudioData(int numPackets) {
     QByteArray decodedBuffer;
 
     while (numPackets--) {
-        if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
-        } else {
-            decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-            memset(decodedBuffer.data(), 0, decodedBuffer.size());
-        }
+        concealLostFrame(decodedBuffer);
         _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
     }
     return 0;
 }
 
+void InboundAudioStream::concealLostFrame(QByteArray& decodedBuffer) {
+    if (_decoder) {
+        _decoder->lostFrame(decodedBuffer);
+    } else if (_timeStretchingEnabled) {
+        // keep repeating the last period we got, fading out the longer the loss goes on
+        float gain = calculateRepeatedFrameFadeFactor(++_consecutiveFramesConcealed);
+        decodedBuffer.resize(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * _numChannels * sizeof(int16_t));
+        _timeScaler.conceal(reinterpret_cast<int16_t*>(decodedBuffer.data()), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, gain);
+    } else {
+        decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+        memset(decodedBuffer.data(), 0, decodedBuffer.size());
+    }
+    _framesConcealed++;
+}
+
+void InboundAudioStream::timeScaleDecodedAudio(QByteArray& decodedBuffer) {
+    if (!_timeStretchingEnabled) {
+        return;
+    }
+
+    const int frameSize = _numChannels * sizeof(int16_t);
+    const int numFrames = decodedBuffer.size() / frameSize;
+    const int16_t* input = reinterpret_cast<const int16_t*>(decodedBuffer.constData());
+    _consecutiveFramesConcealed = 0;
+
+    // only move the buffer once it's playing, and leave the padding around the desired size alone
+    int framesAvailable = _ringBuffer.framesAvailable();
+    bool shouldCompress = !_isStarved && framesAvailable > _desiredJitterBufferFrames + DESIRED_JITTER_BUFFER_FRAMES_PADDING;
+    bool shouldExpand = !_isStarved && framesAvailable + DESIRED_JITTER_BUFFER_FRAMES_PADDING < _desiredJitterBufferFrames;
+
+    if (shouldCompress || shouldExpand) {
+        _timeScaledBuffer.resize((numFrames + AudioTimeScaler::MAX_PERIOD) * frameSize);
+        int16_t* output = reinterpret_cast<int16_t*>(_timeScaledBuffer.data());
+
+        int numOutputFrames = shouldCompress ? _timeScaler.compress(input, numFrames, output) :
+                                               _timeScaler.expand(input, numFrames, output);
+        if (numOutputFrames < numFrames) {
+            _framesCompressed++;
+        } else if (numOutputFrames > numFrames) {
+            _framesStretched++;
+        }
+        _timeScaledBuffer.resize(numOutputFrames * frameSize);
+        decodedBuffer.swap(_timeScaledBuffer);
+    }
+
+    _timeScaler.remember(reinterpret_cast<const int16_t*>(decodedBuffer.constData()), decodedBuffer.size() / frameSize);
+}
+
 int InboundAudioStream::parseAudioData(PacketType type, const QByteArray& packetAfterStreamProperties) {
     QByteArray decodedBuffer;
     if (_decoder) {
@@ -266,6 +351,7 @@ int InboundAudioStream::parseAudioData(PacketType type, const QByteArray& packet
     } else {
         decodedBuffer = packetAfterStreamProperties;
     }
+    timeScaleDecodedAudio(decodedBuffer);
     auto actualSize = decodedBuffer.size();
     return _ringBuffer.writeData(decodedBuffer.data(), actualSize);
 }
@@ -391,6 +477,7 @@ void InboundAudioStream::setToStarved() {
     // record the time of this starve in the starve history
     quint64 now = usecTimestampNow();
     _starveHistory.insert(now);
+    _lastStarveTime = now;
 
     if (_dynamicJitterBufferEnabled) {
         // dynamic jitter buffers are enabled. check if this starve put us over the window
@@ -438,6 +525,15 @@ void InboundAudioStream::setDynamicJitterBufferEnabled(bool enable) {
     _dynamicJitterBufferEnabled = enable;
 }
 
+void InboundAudioStream::setTimeStretchingEnabled(bool enable) {
+    if (enable != _timeStretchingEnabled) {
+        _timeScaler.reset();
+        _recentTimeGaps.clear();
+        _nextTimeGapIndex = 0;
+    }
+    _timeStretchingEnabled = enable;
+}
+
 void InboundAudioStream::setStaticJitterBufferFrames(int staticJitterBufferFrames) {
     _staticJitterBufferFrames = staticJitterBufferFrames;
     if (!_dynamicJitterBufferEnabled) {
@@ -459,13 +555,23 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
         _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
         _timeGapStatsForDesiredReduction.update(gap);
 
+        if (_timeStretchingEnabled) {
+            if (_recentTimeGaps.size() < TIME_STRETCHING_TIME_GAPS_WINDOW) {
+                _recentTimeGaps.push_back(gap);
+            } else {
+                _recentTimeGaps[_nextTimeGapIndex] = gap;
+            }
+            _nextTimeGapIndex = (_nextTimeGapIndex + 1) % TIME_STRETCHING_TIME_GAPS_WINDOW;
+        }
+
         if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
             _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
                                                              / (float) AudioConstants::NETWORK_FRAME_USECS);
             _timeGapStatsForDesiredCalcOnTooManyStarves.clearNewStatsAvailableFlag();
         }
 
-        if (_dynamicJitterBufferEnabled) {
+        // with time-stretching, reductions follow the percentile instead (see updateDesiredJitterBufferFramesFromPercentile)
+        if (_dynamicJitterBufferEnabled && !_timeStretchingEnabled) {
             // if the max gap in window B (_timeGapStatsForDesiredReduction) corresponds to a smaller number of frames than _desiredJitterBufferFrames,
             // then reduce _desiredJitterBufferFrames to that number of frames.
             if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
@@ -502,6 +608,11 @@ AudioStreamStats InboundAudioStream::getAudioStreamStats() const {
     streamStats._overflowCount = _ringBuffer.getOverflowCount();
     streamStats._framesDropped = _silentFramesDropped + _oldFramesDropped;    // TODO: add separate stat for old frames dropped
 
+    streamStats._addedLatencyMs = (quint16)(_framesAvailableStat.getAverage() * AudioConstants::NETWORK_FRAME_MSECS);
+    streamStats._framesConcealed = _framesConcealed;
+    streamStats._framesStretched = _framesStretched;
+    streamStats._framesCompressed = _framesCompressed;
+
     streamStats._packetStreamStats = _incomingSequenceNumberStats.getStats();
     streamStats._packetStreamWindowStats = _incomingSequenceNumberStats.getStatsForHistoryWindow();
 
@@ -22,6 +22,7 @@
 #include <plugins/CodecPlugin.h>
 
 #include "AudioRingBuffer.h"
+#include "AudioTimeScaler.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
 #include "AudioStreamStats.h"
@@ -37,6 +38,8 @@ public:
     // settings
     static const bool DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED;
     static const int DEFAULT_STATIC_JITTER_FRAMES;
+    static const bool DEFAULT_TIME_STRETCHING_ENABLED;
+    static const float TIME_STRETCHING_JITTER_PERCENTILE;
     // legacy (now static) settings
     static const int MAX_FRAMES_OVER_DESIRED;
     static const int WINDOW_STARVE_THRESHOLD;
@@ -69,6 +72,10 @@ public:
     void setDynamicJitterBufferEnabled(bool enable);
     void setStaticJitterBufferFrames(int staticJitterBufferFrames);
 
+    /// with time-stretching, the buffer is moved toward its desired size by shortening or lengthening frames instead of
+    /// dropping them, lost packets are concealed, and a dynamic desired size follows a percentile of the packet time gaps
+    void setTimeStretchingEnabled(bool enable);
+
     virtual AudioStreamStats getAudioStreamStats() const;
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
@@ -77,6 +84,7 @@ public:
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
     int getDesiredJitterBufferFrames() { return _desiredJitterBufferFrames; }
+    bool timeStretchingEnabled() const { return _timeStretchingEnabled; }
 
     int getNumFrameSamples() const { return _ringBuffer.getNumFrameSamples(); }
     int getFrameCapacity() const { return _ringBuffer.getFrameCapacity(); }
@@ -90,6 +98,7 @@ public:
     int getConsecutiveNotMixedCount() const { return _consecutiveNotMixedCount; }
     int getStarveCount() const { return _starveCount; }
     int getSilentFramesDropped() const { return _silentFramesDropped; }
+    int getFramesConcealed() const { return _framesConcealed; }
     int getOverflowCount() const { return _ringBuffer.getOverflowCount(); }
 
     int getPacketsReceived() const { return _incomingSequenceNumberStats.getReceived(); }
@@ -117,6 +126,7 @@ private:
 
     void popSamplesNoCheck(int samples);
     void framesAvailableChanged();
+    void updateDesiredJitterBufferFramesFromPercentile();
 
 protected:
     // disallow copying of InboundAudioStream objects
@@ -137,6 +147,13 @@ protected:
 
     /// writes silent frames to the buffer that may be dropped to reduce latency caused by the buffer
     virtual int writeDroppableSilentFrames(int silentFrames);
+
+    /// when time-stretching, shortens or lengthens decoded audio to move the buffer toward its desired size
+    void timeScaleDecodedAudio(QByteArray& decodedBuffer);
+
+    /// produces one frame for a lost packet: the codec's concealment if there is one, otherwise the time scaler's
+    /// when time-stretching, otherwise silence
+    void concealLostFrame(QByteArray& decodedBuffer);
     
 protected:
 
@@ -159,6 +176,9 @@ protected:
     int _starveCount { 0 };
     int _silentFramesDropped { 0 };
     int _oldFramesDropped { 0 };
+    int _framesConcealed { 0 };
+    int _framesStretched { 0 };
+    int _framesCompressed { 0 };
 
     SequenceNumberStats _incomingSequenceNumberStats;
 
@@ -178,6 +198,15 @@ protected:
 
     MovingMinMaxAvg<quint64> _timeGapStatsForStatsPacket;
 
+    // time-stretching
+    bool _timeStretchingEnabled { DEFAULT_TIME_STRETCHING_ENABLED };
+    AudioTimeScaler _timeScaler;
+    QByteArray _timeScaledBuffer;
+    int _consecutiveFramesConcealed { 0 };
+    std::vector<quint64> _recentTimeGaps; // circular, for the percentile
+    size_t _nextTimeGapIndex { 0 };
+    quint64 _lastStarveTime { 0 };
+
     // Reverb properties
     bool _hasReverb { false };
     float _reverbTime { 0.0f };
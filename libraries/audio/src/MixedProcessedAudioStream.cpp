@@ -36,12 +36,7 @@ int MixedProcessedAudioStream::lostAudioData(int numPackets) {
     QByteArray outputBuffer;
 
     while (numPackets--) {
-        if (_decoder) {
-            _decoder->lostFrame(decodedBuffer);
-        } else {
-            decodedBuffer.resize(AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-            memset(decodedBuffer.data(), 0, decodedBuffer.size());
-        }
+        concealLostFrame(decodedBuffer);
 
         emit addedStereoSamples(decodedBuffer);
 
@@ -60,6 +55,7 @@ int MixedProcessedAudioStream::parseAudioData(PacketType type, const QByteArray&
     } else {
         decodedBuffer = packetAfterStreamProperties;
     }
+    timeScaleDecodedAudio(decodedBuffer);
 
     emit addedStereoSamples(decodedBuffer);
 
@@ -53,6 +53,10 @@ public:
 
     bool hasValidPosition() const { return _hasValidPosition; }
 
+    // bit i is set when the stream is inside the mixer's i-th audio zone, resolved by the mixer once per frame
+    uint64_t getAudioZones() const { return _audioZones; }
+    void setAudioZones(uint64_t audioZones) { _audioZones = audioZones; }
+
 protected:
     // disallow copying of PositionalAudioStream objects
     PositionalAudioStream(const PositionalAudioStream&);
@@ -80,6 +84,7 @@ protected:
     int _frameCounter;
 
     bool _hasValidPosition { false };
+    uint64_t _audioZones { 0 };
 };
 
 #endif // hifi_PositionalAudioStream_h
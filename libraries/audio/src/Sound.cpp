@@ -33,6 +33,10 @@
 
 #include "flump3dec.h"
 
+static int soundStreamSourcePointerMetaTypeId = qRegisterMetaType<SoundStreamSourcePointer>();
+
+const float Sound::STREAMING_MIN_DURATION_SECS = 30.0f;
+
 QScriptValue soundSharedPointerToScriptValue(QScriptEngine* engine, const SharedSoundPointer& in) {
     return engine->newQObject(new SoundScriptingInterface(in), QScriptEngine::ScriptOwnership);
 }
@@ -59,6 +63,7 @@ void Sound::downloadFinished(const QByteArray& data) {
     // this is a QRunnable, will delete itself after it has finished running
     SoundProcessor* soundProcessor = new SoundProcessor(_url, data, _isStereo, _isAmbisonic);
     connect(soundProcessor, &SoundProcessor::onSuccess, this, &Sound::soundProcessSuccess);
+    connect(soundProcessor, &SoundProcessor::onStreamSuccess, this, &Sound::soundProcessStreamSuccess);
     connect(soundProcessor, &SoundProcessor::onError, this, &Sound::soundProcessError);
     QThreadPool::globalInstance()->start(soundProcessor);
 }
@@ -77,6 +82,20 @@ void Sound::soundProcessSuccess(QByteArray data, bool stereo, bool ambisonic, fl
     emit ready();
 }
 
+void Sound::soundProcessStreamSuccess(SoundStreamSourcePointer source, bool stereo, bool ambisonic, float duration) {
+
+    qCDebug(audio) << "Setting ready state for streaming sound file" << _url.toDisplayString();
+
+    _streamSource = source;
+    _isStereo = stereo;
+    _isAmbisonic = ambisonic;
+    _duration = duration;
+    _isReady = true;
+    finishedLoading(true);
+
+    emit ready();
+}
+
 void Sound::soundProcessError(int error, QString str) {
     qCCritical(audio) << "Failed to process sound file" << _url.toDisplayString() << "code =" << error << str;
     emit failed(QNetworkReply::UnknownContentError);
@@ -110,6 +129,14 @@ void SoundProcessor::run() {
 
     } else if (fileName.endsWith(MP3_EXTENSION)) {
 
+        // only the frame headers are read here, decoding is left to whichever path plays it
+        int probedSampleRate = 0;
+        int probedNumChannels = 0;
+        int64_t numFrames = SoundStreamSource::probeMP3(rawAudioByteArray, probedSampleRate, probedNumChannels);
+        if (numFrames > 0 && streamIfLong(probedSampleRate, probedNumChannels, numFrames)) {
+            return;
+        }
+
         QByteArray outputAudioByteArray;
 
         int sampleRate = interpretAsMP3(rawAudioByteArray, outputAudioByteArray);
@@ -141,6 +168,27 @@ void SoundProcessor::run() {
     emit onSuccess(_data, _isStereo, _isAmbisonic, _duration);
 }
 
+bool SoundProcessor::streamIfLong(int sampleRate, int numChannels, int64_t numFrames) {
+    float duration = (float)numFrames / sampleRate;
+    if (duration < Sound::STREAMING_MIN_DURATION_SECS) {
+        return false;
+    }
+
+    // keep the file as it was downloaded, each SoundStream decodes and resamples it just ahead of playback
+    auto source = std::make_shared<SoundStreamSource>();
+    source->data = _data;
+    source->sampleRate = sampleRate;
+    source->numChannels = numChannels;
+
+    _isStereo = (numChannels == AudioConstants::STEREO);
+    _isAmbisonic = (numChannels == AudioConstants::AMBISONIC);
+    _duration = duration;
+
+    qCDebug(audio) << "Streaming" << duration << "second sound file" << _url.toDisplayString();
+    emit onStreamSuccess(source, _isStereo, _isAmbisonic, _duration);
+    return true;
+}
+
 void SoundProcessor::downSample(const QByteArray& rawAudioByteArray, int sampleRate) {
 
     // we want to convert it to the format that the audio-mixer wants
@@ -19,10 +19,16 @@
 
 #include <ResourceCache.h>
 
+#include "SoundStream.h"
+
 class Sound : public Resource {
     Q_OBJECT
 
 public:
+    // MP3s at least this long are decoded while they play instead of all at once. WAV and RAW sounds are always decoded
+    // up front: their 24kHz PCM is smaller than the 44.1 or 48kHz file a stream would have to keep.
+    static const float STREAMING_MIN_DURATION_SECS;
+
     Sound(const QUrl& url, bool isStereo = false, bool isAmbisonic = false);
     
     bool isStereo() const { return _isStereo; }    
@@ -30,17 +36,23 @@ public:
     bool isReady() const { return _isReady; }
     float getDuration() const { return _duration; }
  
+    // empty for streaming sounds, play those through a SoundStream on getStreamSource() instead
     const QByteArray& getByteArray() const { return _byteArray; }
 
+    bool isStreaming() const { return (bool)_streamSource; }
+    SoundStreamSourcePointer getStreamSource() const { return _streamSource; }
+
 signals:
     void ready();
 
 protected slots:
     void soundProcessSuccess(QByteArray data, bool stereo, bool ambisonic, float duration);
+    void soundProcessStreamSuccess(SoundStreamSourcePointer source, bool stereo, bool ambisonic, float duration);
     void soundProcessError(int error, QString str);
     
 private:
     QByteArray _byteArray;
+    SoundStreamSourcePointer _streamSource;
     bool _isStereo;
     bool _isAmbisonic;
     bool _isReady;
@@ -66,9 +78,13 @@ public:
 
 signals:
     void onSuccess(QByteArray data, bool stereo, bool ambisonic, float duration);
+    void onStreamSuccess(SoundStreamSourcePointer source, bool stereo, bool ambisonic, float duration);
     void onError(int error, QString str);
 
 private:
+    // returns true, after emitting onStreamSuccess, if the MP3 being processed is long enough to be streamed
+    bool streamIfLong(int sampleRate, int numChannels, int64_t numFrames);
+
     QUrl _url;
     QByteArray _data;
     bool _isStereo;
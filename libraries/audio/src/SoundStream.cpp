@@ -0,0 +1,329 @@
+//
+//  SoundStream.cpp
+//  libraries/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SoundStream.h"
+
+#include <algorithm>
+#include <limits>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+#include <glm/glm.hpp>
+
+#include "AudioConstants.h"
+#include "AudioSRC.h"
+
+#include "flump3dec.h"
+
+static const int MP3_SAMPLES_MAX = 1152;
+static const int DECODE_BLOCK_FRAMES = MP3_SAMPLES_MAX; // a block must hold a whole MP3 frame
+
+const float SoundStream::RING_SECONDS = 1.0f;
+const float SoundStream::PRIME_SECONDS = 0.1f;
+
+// decodes one MP3 frame per call with the same flump3dec loop SoundProcessor::interpretAsMP3 runs over the whole file
+class MP3SoundDecoder {
+public:
+    MP3SoundDecoder(const QByteArray& data, int numChannels = 0) : _data(data), _numChannels(numChannels) { open(); }
+    ~MP3SoundDecoder() { close(); }
+
+    int getSampleRate() const { return _sampleRate; }
+    int getNumChannels() const { return _numChannels; }
+
+    // decodes the next frames of the source, at its own rate, returns how many (0 at the end of the source)
+    int decode(int16_t* samples, int maxFrames) {
+        using namespace flump3dec;
+
+        while (!isAtEnd()) {
+            const fr_header* header = nullptr;
+            if (!decodeHeader(header)) {
+                continue;
+            }
+
+            // copy what we need out of the header before the decoder moves on to the next one
+            int numFrames = header->frame_samples;
+            int numChannels = header->channels;
+            _result = mp3tl_decode_frame(_decoder, (uint8_t*)samples, maxFrames * _numChannels * sizeof(int16_t));
+
+            if (numChannels != _numChannels) {
+                // the stream was set up for the channel count of the first frame, drop anything else
+                continue;
+            }
+
+            // fill bad frames with silence
+            if (_result == MP3TL_ERR_BAD_FRAME) {
+                memset(samples, 0, numFrames * numChannels * sizeof(int16_t));
+            }
+
+            if (_result == MP3TL_ERR_OK || _result == MP3TL_ERR_BAD_FRAME) {
+                return numFrames;
+            }
+        }
+        return 0;
+    }
+
+    // moves ahead without decoding, returns the number of frames skipped
+    int64_t skip(int64_t numFrames) {
+        using namespace flump3dec;
+
+        int64_t numSkipped = 0;
+        while (numSkipped < numFrames && !isAtEnd()) {
+            const fr_header* header = nullptr;
+            if (decodeHeader(header)) {
+                int frameSamples = header->frame_samples;
+                _result = mp3tl_skip_frame(_decoder);
+                if (_result == MP3TL_ERR_OK) {
+                    numSkipped += frameSamples;
+                }
+            }
+        }
+        return numSkipped;
+    }
+
+    void rewind() {
+        close();
+        open();
+    }
+
+private:
+    void open() {
+        using namespace flump3dec;
+
+        _result = MP3TL_ERR_NO_SYNC;
+        _hasDecodedHeader = false;
+
+        _bitstream = bs_new();
+        if (!_bitstream) {
+            return;
+        }
+        _decoder = mp3tl_new(_bitstream, MP3TL_MODE_16BIT);
+        if (!_decoder) {
+            return;
+        }
+        bs_set_data(_bitstream, (uint8_t*)_data.constData(), _data.size());
+
+        // skip ID3 tag, if present
+        _result = mp3tl_skip_id3(_decoder);
+    }
+
+    void close() {
+        using namespace flump3dec;
+
+        if (_decoder) {
+            mp3tl_free(_decoder);
+            _decoder = nullptr;
+        }
+        if (_bitstream) {
+            bs_free(_bitstream);
+            _bitstream = nullptr;
+        }
+    }
+
+    bool isAtEnd() const {
+        using namespace flump3dec;
+        return !_decoder || _result == MP3TL_ERR_NO_SYNC || _result == MP3TL_ERR_NEED_DATA;
+    }
+
+    bool decodeHeader(const flump3dec::fr_header*& header) {
+        using namespace flump3dec;
+
+        mp3tl_sync(_decoder);
+        _result = mp3tl_decode_header(_decoder, &header);
+
+        if (_result == MP3TL_ERR_OK && !_hasDecodedHeader) {
+            _hasDecodedHeader = true;
+            _sampleRate = header->sample_rate;
+            if (_numChannels == 0) {
+                _numChannels = header->channels;
+            }
+
+            // skip Xing header, if present
+            _result = mp3tl_skip_xing(_decoder, header);
+        }
+        return _result == MP3TL_ERR_OK;
+    }
+
+    QByteArray _data;
+    int _sampleRate { 0 };
+    int _numChannels { 0 };
+
+    flump3dec::Bit_stream_struc* _bitstream { nullptr };
+    flump3dec::mp3tl* _decoder { nullptr };
+    flump3dec::Mp3TlRetcode _result;
+    bool _hasDecodedHeader { false };
+};
+
+int64_t SoundStreamSource::probeMP3(const QByteArray& data, int& sampleRate, int& numChannels) {
+    MP3SoundDecoder decoder(data);
+    int64_t numFrames = decoder.skip(std::numeric_limits<int64_t>::max());
+    sampleRate = decoder.getSampleRate();
+    numChannels = decoder.getNumChannels();
+    return sampleRate > 0 ? numFrames : 0;
+}
+
+// Refills are short and frequent, with at most one pending per stream. flump3dec decodes a second of 24 kHz mono in
+// about 0.65 ms on one core, so even a second of 44.1 kHz stereo, resampled, takes only a few ms, and a refill decodes
+// at most a ring (a second) and usually half of one. Two threads keep hundreds of streams ahead of their readers, the
+// second so that a new stream filling its whole ring doesn't hold up the others; more would only compete with the mixer
+// and script threads.
+static QThreadPool* getRefillThreadPool() {
+    static const int MAX_REFILL_THREADS = 2;
+    static QThreadPool* pool = [] {
+        QThreadPool* pool = new QThreadPool();
+        pool->setMaxThreadCount(MAX_REFILL_THREADS);
+        return pool;
+    }();
+    return pool;
+}
+
+class SoundStreamRefill : public QRunnable {
+public:
+    SoundStreamRefill(std::weak_ptr<SoundStream> stream) : _stream(stream) {}
+
+    void run() override {
+        if (auto stream = _stream.lock()) {
+            stream->refill();
+        }
+    }
+
+private:
+    std::weak_ptr<SoundStream> _stream;
+};
+
+SoundStream::SoundStream(SoundStreamSourcePointer source, bool loop, float pitch) :
+    _source(source),
+    _loop(loop),
+    _numChannels(source->numChannels)
+{
+    _decoder.reset(new MP3SoundDecoder(_source->data, _numChannels));
+    _decodeBuffer.resize(DECODE_BLOCK_FRAMES * _numChannels);
+    _maxBlockSamples = DECODE_BLOCK_FRAMES * _numChannels;
+
+    // resample to the mixer rate and apply the pitch in the same pass, limited to 4 octaves like AudioInjector::playSound
+    const int outputRate = AudioConstants::SAMPLE_RATE / glm::clamp(pitch, 1 / 16.0f, 16.0f);
+    if (_source->sampleRate != outputRate) {
+        _resampler.reset(new AudioSRC(_source->sampleRate, outputRate, _numChannels));
+        _maxBlockSamples = _resampler->getMaxOutput(DECODE_BLOCK_FRAMES) * _numChannels;
+        _resampleBuffer.resize(_maxBlockSamples);
+    }
+
+    int ringSamples = (int)(RING_SECONDS * AudioConstants::SAMPLE_RATE) * _numChannels;
+    _ring.resize(std::max(ringSamples, 4 * _maxBlockSamples));
+}
+
+SoundStream::~SoundStream() {
+}
+
+void SoundStream::start(int startFrame) {
+    {
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+
+        if (startFrame > 0) {
+            int64_t sourceFrame = (int64_t)startFrame * _source->sampleRate / AudioConstants::SAMPLE_RATE;
+            if (_decoder->skip(sourceFrame) < sourceFrame && !_loop) {
+                _isDecoderFinished = true;
+            }
+        }
+
+        const int primeSamples = (int)(PRIME_SECONDS * AudioConstants::SAMPLE_RATE) * _numChannels;
+        while (!_isDecoderFinished && getNumAvailableSamples() < primeSamples) {
+            if (!decodeBlock()) {
+                _isDecoderFinished = true;
+            }
+        }
+    }
+
+    scheduleRefill();
+}
+
+int SoundStream::read(int16_t* samples, int numSamples) {
+    const uint64_t readIndex = _readIndex.load(std::memory_order_relaxed);
+    const uint64_t writeIndex = _writeIndex.load(std::memory_order_acquire);
+    const int numAvailable = (int)(writeIndex - readIndex);
+
+    const int numRead = std::min(numSamples, numAvailable);
+    const size_t capacity = _ring.size();
+    const size_t offset = readIndex % capacity;
+    const size_t firstPart = std::min((size_t)numRead, capacity - offset);
+    memcpy(samples, &_ring[offset], firstPart * sizeof(int16_t));
+    memcpy(samples + firstPart, &_ring[0], (numRead - firstPart) * sizeof(int16_t));
+    _readIndex.store(readIndex + numRead, std::memory_order_release);
+
+    if (!_isDecoderFinished) {
+        if (numRead < numSamples) {
+            _numUnderrunSamples += numSamples - numRead;
+        }
+
+        // keep the ring at least half full
+        if ((size_t)(numAvailable - numRead) < capacity / 2) {
+            scheduleRefill();
+        }
+    }
+
+    return numRead;
+}
+
+bool SoundStream::isFinished() const {
+    return _isDecoderFinished && getNumAvailableSamples() == 0;
+}
+
+int SoundStream::getNumAvailableSamples() const {
+    return (int)(_writeIndex.load(std::memory_order_acquire) - _readIndex.load(std::memory_order_acquire));
+}
+
+void SoundStream::scheduleRefill() {
+    if (!_isRefillPending.exchange(true)) {
+        getRefillThreadPool()->start(new SoundStreamRefill(shared_from_this()));
+    }
+}
+
+void SoundStream::refill() {
+    {
+        std::lock_guard<std::mutex> lock(_decodeMutex);
+        while (!_isDecoderFinished && (int)_ring.size() - getNumAvailableSamples() >= _maxBlockSamples) {
+            if (!decodeBlock()) {
+                _isDecoderFinished = true;
+            }
+        }
+    }
+
+    _isRefillPending = false;
+}
+
+bool SoundStream::decodeBlock() {
+    int numFrames = _decoder->decode(_decodeBuffer.data(), DECODE_BLOCK_FRAMES);
+    if (numFrames == 0 && _loop) {
+        _decoder->rewind();
+        numFrames = _decoder->decode(_decodeBuffer.data(), DECODE_BLOCK_FRAMES);
+    }
+    if (numFrames == 0) {
+        return false;
+    }
+
+    const int16_t* output = _decodeBuffer.data();
+    int numOutputFrames = numFrames;
+    if (_resampler) {
+        numOutputFrames = _resampler->render(_decodeBuffer.data(), _resampleBuffer.data(), numFrames);
+        output = _resampleBuffer.data();
+    }
+
+    // callers have made sure there is room for a whole block
+    const int numSamples = numOutputFrames * _numChannels;
+    const uint64_t writeIndex = _writeIndex.load(std::memory_order_relaxed);
+    const size_t capacity = _ring.size();
+    const size_t offset = writeIndex % capacity;
+    const size_t firstPart = std::min((size_t)numSamples, capacity - offset);
+    memcpy(&_ring[offset], output, firstPart * sizeof(int16_t));
+    memcpy(&_ring[0], output + firstPart, (numSamples - firstPart) * sizeof(int16_t));
+    _writeIndex.store(writeIndex + numSamples, std::memory_order_release);
+
+    return true;
+}
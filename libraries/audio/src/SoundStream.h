@@ -0,0 +1,97 @@
+//
+//  SoundStream.h
+//  libraries/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SoundStream_h
+#define hifi_SoundStream_h
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMetaType>
+
+class AudioSRC;
+class MP3SoundDecoder;
+
+// The still encoded data of a long MP3. Long MP3s keep this instead of their decoded PCM, and every
+// SoundStream playing them decodes its own copy a little at a time.
+class SoundStreamSource {
+public:
+    // scans an MP3 without decoding it, returns the number of frames (0 if it isn't a valid MP3)
+    static int64_t probeMP3(const QByteArray& data, int& sampleRate, int& numChannels);
+
+    QByteArray data; // the downloaded file, implicitly shared with every stream
+    int sampleRate { 0 };
+    int numChannels { 1 };
+};
+
+using SoundStreamSourcePointer = std::shared_ptr<const SoundStreamSource>;
+Q_DECLARE_METATYPE(SoundStreamSourcePointer)
+
+// Decodes and resamples a SoundStreamSource to AudioConstants::SAMPLE_RATE into a bounded ring, staying about a second
+// ahead of the reader. Refills run on a small pool of their own, so readers (the injector and local audio threads) only
+// ever copy out of the ring, and refills don't queue behind resource processing on the global thread pool. There is a single reader and a single writer at a time.
+class SoundStream : public std::enable_shared_from_this<SoundStream> {
+public:
+    static const float RING_SECONDS; // how far ahead of the reader the stream decodes
+    static const float PRIME_SECONDS; // how much start() decodes before returning
+
+    SoundStream(SoundStreamSourcePointer source, bool loop, float pitch = 1.0f);
+    ~SoundStream();
+
+    // skips to the given output frame and decodes the first blocks on the calling thread, so that playback can
+    // start as soon as this returns; the rest of the ring is filled in the background
+    void start(int startFrame = 0);
+
+    // copies up to numSamples interleaved samples out of the ring, returns the number copied
+    int read(int16_t* samples, int numSamples);
+
+    int getNumChannels() const { return _numChannels; }
+
+    // true once the whole source has been decoded and read, never for looping streams
+    bool isFinished() const;
+
+    // samples a reader asked for while the decoder had fallen behind
+    uint64_t getNumUnderrunSamples() const { return _numUnderrunSamples; }
+
+private:
+    friend class SoundStreamRefill;
+
+    int getNumAvailableSamples() const;
+    void scheduleRefill();
+    void refill();
+    bool decodeBlock(); // requires _decodeMutex, returns false at the end of the source
+
+    SoundStreamSourcePointer _source;
+    const bool _loop;
+    const int _numChannels;
+
+    std::mutex _decodeMutex;
+    std::unique_ptr<MP3SoundDecoder> _decoder;
+    std::unique_ptr<AudioSRC> _resampler; // null when the source is already at the output rate
+    std::vector<int16_t> _decodeBuffer;
+    std::vector<int16_t> _resampleBuffer;
+    int _maxBlockSamples { 0 };
+
+    // single producer / single consumer ring, indices only ever grow
+    std::vector<int16_t> _ring;
+    std::atomic<uint64_t> _writeIndex { 0 };
+    std::atomic<uint64_t> _readIndex { 0 };
+
+    std::atomic<bool> _isDecoderFinished { false };
+    std::atomic<bool> _isRefillPending { false };
+    std::atomic<uint64_t> _numUnderrunSamples { 0 };
+};
+
+using SoundStreamPointer = std::shared_ptr<SoundStream>;
+
+#endif // hifi_SoundStream_h
@@ -448,6 +448,40 @@ void Avatar::relayJointDataToChildren() {
 }
 
 void Avatar::simulate(float deltaTime, bool inView) {
+    simulateJoints(deltaTime, inView);
+    finishSimulate(deltaTime, inView);
+}
+
+void Avatar::simulateJoints(float deltaTime, bool inView) {
+    // the first full update of a model sets up its rig and render state, which is left to the main thread
+    if (inView && _hasNewJointData && _skeletonModel->isLoaded() && !_skeletonModel->getRig().jointStatesEmpty()) {
+        updateJointsFromJointData(deltaTime);
+    }
+}
+
+void Avatar::updateJointsFromJointData(float deltaTime) {
+    PROFILE_RANGE(simulation, "updateJoints");
+    {
+        QReadLocker readLock(&_jointDataLock);
+        _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    }
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _jointDataSimulationRate.increment();
+
+    _skeletonModel->simulate(deltaTime, true);
+
+    _hasNewJointData = false;
+    _jointsUpdated = true;
+
+    glm::vec3 headPosition = getWorldPosition();
+    if (!_skeletonModel->getHeadPosition(headPosition)) {
+        headPosition = getWorldPosition();
+    }
+    getHead()->setPosition(headPosition);
+}
+
+void Avatar::finishSimulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
     _simulationRate.increment();
@@ -461,21 +495,12 @@ void Avatar::simulate(float deltaTime, bool inView) {
         if (inView) {
             Head* head = getHead();
             if (_hasNewJointData) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
-                _jointDataSimulationRate.increment();
-
-                _skeletonModel->simulate(deltaTime, true);
-
+                // not done by simulateJoints()
+                updateJointsFromJointData(deltaTime);
+            }
+            if (_jointsUpdated) {
                 locationChanged(); // joints changed, so if there are any children, update them.
-                _hasNewJointData = false;
-
-                glm::vec3 headPosition = getWorldPosition();
-                if (!_skeletonModel->getHeadPosition(headPosition)) {
-                    headPosition = getWorldPosition();
-                }
-                head->setPosition(headPosition);
+                _jointsUpdated = false;
             }
             head->setScale(getModelScale());
             head->simulate(deltaTime);
@@ -75,6 +75,12 @@ public:
     void updateAvatarEntities();
     void removeAvatarEntitiesFromTree();
     void simulate(float deltaTime, bool inView);
+
+    // simulate() in two parts: simulateJoints() only touches this avatar's own rig and skeleton model, so it can be run
+    // for many avatars at once on worker threads, and finishSimulate() does the rest on the main thread afterwards.
+    void simulateJoints(float deltaTime, bool inView);
+    void finishSimulate(float deltaTime, bool inView);
+
     virtual void simulateAttachments(float deltaTime);
 
     virtual void render(RenderArgs* renderArgs);
@@ -473,6 +479,7 @@ protected:
     // protected methods...
     bool isLookingAtMe(AvatarSharedPointer avatar) const;
     void relayJointDataToChildren();
+    void updateJointsFromJointData(float deltaTime);
 
     void fade(render::Transaction& transaction, render::Transition::Type type);
 
@@ -526,6 +533,7 @@ protected:
     bool _mustFadeIn { false };
     bool _isFading { false };
     bool _reconstructSoftEntitiesJointMap { false };
+    bool _jointsUpdated { false }; // by simulateJoints(), for finishSimulate() to tell the children
     float _modelScale { 1.0f };
 
     static int _jointConesID;
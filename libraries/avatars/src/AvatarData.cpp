@@ -44,6 +44,7 @@
 #include "AvatarLogging.h"
 #include "AvatarTraits.h"
 #include "ClientTraitsHandler.h"
+#include "PredictedJointData.h"
 
 //#define WANT_DEBUG
 
@@ -58,6 +59,9 @@ static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
 static const float DEFAULT_AVATAR_DENSITY = 1000.0f; // density of water
 
+// about the largest change in a quaternion component that AVATAR_MIN_ROTATION_DOT culls
+static const float PREDICTED_ROTATION_DEAD_ZONE = sqrtf(2.0f * (1.0f - AVATAR_MIN_ROTATION_DOT)) / 2.0f;
+
 #define ASSERT(COND)  do { if (!(COND)) { abort(); } } while(0)
 
 size_t AvatarDataPacket::maxFaceTrackerInfoSize(size_t numBlendshapeCoefficients) {
@@ -225,15 +229,30 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
     AvatarDataPacket::HasFlags hasFlagsOut;
     auto lastSentTime = _lastToByteArray;
     _lastToByteArray = usecTimestampNow();
+
+    // the joints go as the next predicted frame, which the mixer will have once doneEncoding() is called
+    QByteArray predictedJointData;
+    _pendingJointHistory = _sentJointHistory;
+    if (dataDetail == CullSmallData || dataDetail == IncludeSmallData || dataDetail == SendAllData) {
+        bool cullSmallChanges = (dataDetail == CullSmallData);
+        QReadLocker readLock(&_jointDataLock);
+        predictedJointData.resize((int)PredictedJointData::maxSize(_jointData.size()));
+        size_t size = PredictedJointData::encode(_jointData, dataDetail == SendAllData || _jointKeyFrameRequested,
+            cullSmallChanges ? PREDICTED_ROTATION_DEAD_ZONE : 0.0f, cullSmallChanges ? AVATAR_MIN_TRANSLATION : 0.0f,
+            _pendingJointHistory, reinterpret_cast<uint8_t*>(predictedJointData.data()));
+        predictedJointData.resize((int)size);
+    }
+
     return AvatarData::toByteArray(dataDetail, lastSentTime, getLastSentJointData(),
                         hasFlagsOut, dropFaceTracking, false, glm::vec3(0), nullptr,
-                        &_outboundDataRate);
+                        &_outboundDataRate, &predictedJointData);
 }
 
 QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime,
                                    const QVector<JointData>& lastSentJointData,
     AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust,
-    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut) const {
+    glm::vec3 viewerPosition, QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut,
+    const QByteArray* predictedJointData) const {
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
@@ -246,6 +265,7 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     if (dataDetail == NoData) {
         AvatarDataPacket::HasFlags packetStateFlags = 0;
         QByteArray avatarDataByteArray(reinterpret_cast<char*>(&packetStateFlags), sizeof(packetStateFlags));
+        hasFlagsOut = packetStateFlags;
         return avatarDataByteArray;
     }
 
@@ -333,10 +353,15 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         }
     }
 
+    // if we were given predicted joint data, it replaces the joint rotations and translations
+    bool hasPredictedJointData = hasJointData && predictedJointData && !predictedJointData->isEmpty();
+    size_t jointDataSize = hasPredictedJointData ?
+        AvatarDataPacket::maxJointDataSize(0, hasGrabJoints) + predictedJointData->size() :
+        AvatarDataPacket::maxJointDataSize(_jointData.size(), hasGrabJoints);
 
     const size_t byteArraySize = AvatarDataPacket::MAX_CONSTANT_HEADER_SIZE +
         (hasFaceTrackerInfo ? AvatarDataPacket::maxFaceTrackerInfoSize(_headData->getBlendshapeCoefficients().size()) : 0) +
-        (hasJointData ? AvatarDataPacket::maxJointDataSize(_jointData.size(), hasGrabJoints) : 0) +
+        (hasJointData ? jointDataSize : 0) +
         (hasJointDefaultPoseFlags ? AvatarDataPacket::maxJointDefaultPoseFlagsSize(_jointData.size()) : 0);
 
     QByteArray avatarDataByteArray((int)byteArraySize, 0);
@@ -358,10 +383,12 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
         | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
         | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-        | (hasGrabJoints ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+        | (hasGrabJoints ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0)
+        | (hasPredictedJointData ? AvatarDataPacket::PACKET_HAS_PREDICTED_JOINT_DATA : 0);
 
     memcpy(destinationBuffer, &packetStateFlags, sizeof(packetStateFlags));
     destinationBuffer += sizeof(packetStateFlags);
+    hasFlagsOut = packetStateFlags;
 
 #define AVATAR_MEMCPY(src)                          \
     memcpy(destinationBuffer, &(src), sizeof(src)); \
@@ -558,115 +585,137 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     if (hasJointData) {
         auto startSection = destinationBuffer;
 
-        // joint rotation data
-        int numJoints = jointData.size();
-        *destinationBuffer++ = (uint8_t)numJoints;
+        if (hasPredictedJointData) {
+            memcpy(destinationBuffer, predictedJointData->constData(), predictedJointData->size());
+            destinationBuffer += predictedJointData->size();
 
-        unsigned char* validityPosition = destinationBuffer;
-        unsigned char validity = 0;
-        int validityBit = 0;
-        int numValidityBytes = calcBitVectorSize(numJoints);
+            if (sentJointDataOut) {
+                *sentJointDataOut = jointData;
+            }
+        } else {
+            // joint rotation data
+            int numJoints = jointData.size();
+            *destinationBuffer++ = (uint8_t)numJoints;
+
+            unsigned char* validityPosition = destinationBuffer;
+            unsigned char validity = 0;
+            int validityBit = 0;
+            int numValidityBytes = calcBitVectorSize(numJoints);
 
 #ifdef WANT_DEBUG
-        int rotationSentCount = 0;
-        unsigned char* beforeRotations = destinationBuffer;
+            int rotationSentCount = 0;
+            unsigned char* beforeRotations = destinationBuffer;
 #endif
 
-        destinationBuffer += numValidityBytes; // Move pointer past the validity bytes
+            destinationBuffer += numValidityBytes; // Move pointer past the validity bytes
 
-        // sentJointDataOut and lastSentJointData might be the same vector
-        if (sentJointDataOut) {
-            sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
-        }
+            // sentJointDataOut and lastSentJointData might be the same vector
+            if (sentJointDataOut) {
+                sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
+            }
 
-        float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
+            float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
-        for (int i = 0; i < jointData.size(); i++) {
-            const JointData& data = jointData[i];
-            const JointData& last = lastSentJointData[i];
+            for (int i = 0; i < jointData.size(); i++) {
+                const JointData& data = jointData[i];
+                const JointData& last = lastSentJointData[i];
 
-            if (!data.rotationIsDefaultPose) {
-                // The dot product for larger rotations is a lower number.
-                // So if the dot() is less than the value, then the rotation is a larger angle of rotation
-                if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
-                    || (cullSmallChanges && glm::dot(last.rotation, data.rotation) < minRotationDOT) ) {
-                    validity |= (1 << validityBit);
+                if (!data.rotationIsDefaultPose) {
+                    // The dot product for larger rotations is a lower number.
+                    // So if the dot() is less than the value, then the rotation is a larger angle of rotation
+                    if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
+                        || (cullSmallChanges && glm::dot(last.rotation, data.rotation) < minRotationDOT) ) {
+                        validity |= (1 << validityBit);
 #ifdef WANT_DEBUG
-                    rotationSentCount++;
+                        rotationSentCount++;
 #endif
-                    destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
 
-                    if (sentJointDataOut) {
-                        (*sentJointDataOut)[i].rotation = data.rotation;
+                        if (sentJointDataOut) {
+                            (*sentJointDataOut)[i].rotation = data.rotation;
+                        }
                     }
                 }
-            }
 
-            if (sentJointDataOut) {
-                (*sentJointDataOut)[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
-            }
+                if (sentJointDataOut) {
+                    (*sentJointDataOut)[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
+                }
 
-            if (++validityBit == BITS_IN_BYTE) {
+                if (++validityBit == BITS_IN_BYTE) {
+                    *validityPosition++ = validity;
+                    validityBit = validity = 0;
+                }
+            }
+            if (validityBit != 0) {
                 *validityPosition++ = validity;
-                validityBit = validity = 0;
             }
-        }
-        if (validityBit != 0) {
-            *validityPosition++ = validity;
-        }
 
-        // joint translation data
-        validityPosition = destinationBuffer;
-        validity = 0;
-        validityBit = 0;
+            // joint translation data
+            validityPosition = destinationBuffer;
+            validity = 0;
+            validityBit = 0;
 
 #ifdef WANT_DEBUG
-        int translationSentCount = 0;
-        unsigned char* beforeTranslations = destinationBuffer;
+            int translationSentCount = 0;
+            unsigned char* beforeTranslations = destinationBuffer;
 #endif
 
-        destinationBuffer += numValidityBytes; // Move pointer past the validity bytes
+            destinationBuffer += numValidityBytes; // Move pointer past the validity bytes
 
-        float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
+            float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
-        float maxTranslationDimension = 0.0;
-        for (int i = 0; i < jointData.size(); i++) {
-            const JointData& data = jointData[i];
-            const JointData& last = lastSentJointData[i];
+            float maxTranslationDimension = 0.0;
+            for (int i = 0; i < jointData.size(); i++) {
+                const JointData& data = jointData[i];
+                const JointData& last = lastSentJointData[i];
 
-            if (!data.translationIsDefaultPose) {
-                if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
-                    || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
+                if (!data.translationIsDefaultPose) {
+                    if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
+                        || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
                    
-                    validity |= (1 << validityBit);
+                        validity |= (1 << validityBit);
 #ifdef WANT_DEBUG
-                    translationSentCount++;
+                        translationSentCount++;
 #endif
-                    maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
-                    maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
-                    maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
+                        maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
+                        maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
+                        maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
 
-                    destinationBuffer +=
-                        packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                        destinationBuffer +=
+                            packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
 
-                    if (sentJointDataOut) {
-                        (*sentJointDataOut)[i].translation = data.translation;
+                        if (sentJointDataOut) {
+                            (*sentJointDataOut)[i].translation = data.translation;
+                        }
                     }
                 }
-            }
 
-            if (sentJointDataOut) {
-                (*sentJointDataOut)[i].translationIsDefaultPose = data.translationIsDefaultPose;
+                if (sentJointDataOut) {
+                    (*sentJointDataOut)[i].translationIsDefaultPose = data.translationIsDefaultPose;
+                }
+
+                if (++validityBit == BITS_IN_BYTE) {
+                    *validityPosition++ = validity;
+                    validityBit = validity = 0;
+                }
             }
 
-            if (++validityBit == BITS_IN_BYTE) {
+            if (validityBit != 0) {
                 *validityPosition++ = validity;
-                validityBit = validity = 0;
             }
-        }
 
-        if (validityBit != 0) {
-            *validityPosition++ = validity;
+#ifdef WANT_DEBUG
+            if (sendAll) {
+                qCDebug(avatars) << "AvatarData::toByteArray" << cullSmallChanges << sendAll
+                    << "rotations:" << rotationSentCount << "translations:" << translationSentCount
+                    << "largest:" << maxTranslationDimension
+                    << "size:"
+                    << (beforeRotations - startPosition) << "+"
+                    << (beforeTranslations - beforeRotations) << "+"
+                    << (destinationBuffer - beforeTranslations) << "="
+                    << (destinationBuffer - startPosition);
+            }
+#endif
         }
 
         // faux joints
@@ -720,19 +769,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
             }
         }
 
-#ifdef WANT_DEBUG
-        if (sendAll) {
-            qCDebug(avatars) << "AvatarData::toByteArray" << cullSmallChanges << sendAll
-                << "rotations:" << rotationSentCount << "translations:" << translationSentCount
-                << "largest:" << maxTranslationDimension
-                << "size:"
-                << (beforeRotations - startPosition) << "+"
-                << (beforeTranslations - beforeRotations) << "+"
-                << (destinationBuffer - beforeTranslations) << "="
-                << (destinationBuffer - startPosition);
-        }
-#endif
-
         int numBytes = destinationBuffer - startSection;
         if (outboundDataRateOut) {
             outboundDataRateOut->jointDataRate.increment(numBytes);
@@ -776,6 +812,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 // NOTE: This is never used in a "distanceAdjust" mode, so it's ok that it doesn't use a variable minimum rotation/translation
 void AvatarData::doneEncoding(bool cullSmallChanges) {
     // The server has finished sending this version of the joint-data to other nodes.  Update _lastSentJointData.
+    if (_pendingJointHistory.frame != _sentJointHistory.frame && _pendingJointHistory.framesSinceKeyFrame == 0) {
+        _jointKeyFrameRequested = false;
+    }
+    _sentJointHistory = _pendingJointHistory;
+
     QReadLocker readLock(&_jointDataLock);
     _lastSentJointData.resize(_jointData.size());
     for (int i = 0; i < _jointData.size(); i ++) {
@@ -799,6 +840,44 @@ void AvatarData::doneEncoding(bool cullSmallChanges) {
     }
 }
 
+QByteArray AvatarData::getPredictedJointDataToForward(int lastFrameSent, int& frameOut) const {
+    QReadLocker readLock(&_jointDataLock);
+    if (!_receivedJointHistory.isValid()) {
+        return QByteArray();
+    }
+    frameOut = _receivedJointHistory.frame;
+
+    QByteArray predictedJointData((int)PredictedJointData::maxSize((int)_receivedJointHistory.pose.size()), 0);
+    size_t size = PredictedJointData::encodeForReceiver(
+        reinterpret_cast<const uint8_t*>(_lastReceivedPredictedJointData.constData()), _receivedJointHistory,
+        _recentJointFrames, lastFrameSent, reinterpret_cast<uint8_t*>(predictedJointData.data()));
+    predictedJointData.resize((int)size);
+    return predictedJointData;
+}
+
+void AvatarData::setKeepsRecentJointFrames(bool keepsRecentJointFrames) {
+    QWriteLocker writeLock(&_jointDataLock);
+    _recentJointFrames.setEnabled(keepsRecentJointFrames);
+}
+
+void AvatarData::sendJointResyncRequestIfBehind(const SharedNodePointer& node) {
+    qint32 frame;
+    {
+        QWriteLocker writeLock(&_jointDataLock);
+        quint64 now = usecTimestampNow();
+        if (!_isMissingJointFrames || now - _lastJointResyncRequest < AVATAR_JOINT_RESYNC_REQUEST_INTERVAL) {
+            return;
+        }
+        _lastJointResyncRequest = now;
+        frame = _receivedJointHistory.frame;
+    }
+
+    auto packet = NLPacket::create(PacketType::AvatarJointResyncRequest, NUM_BYTES_RFC4122_UUID + sizeof(frame), true);
+    packet->write(getSessionUUID().toRfc4122());
+    packet->writePrimitive(frame);
+    DependencyManager::get<NodeList>()->sendPacket(std::move(packet), *node);
+}
+
 bool AvatarData::shouldLogError(const quint64& now) {
 #ifdef WANT_DEBUG
     if (now > 0) {
@@ -868,6 +947,7 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     bool hasJointData             = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
     bool hasJointDefaultPoseFlags = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS);
     bool hasGrabJoints            = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_GRAB_JOINTS);
+    bool hasPredictedJointData    = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_PREDICTED_JOINT_DATA);
 
     quint64 now = usecTimestampNow();
 
@@ -1150,87 +1230,117 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     if (hasJointData) {
         auto startSection = sourceBuffer;
 
-        PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
-        int numJoints = *sourceBuffer++;
-        const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
-        PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
+        if (hasPredictedJointData) {
+            PACKET_READ_CHECK(PredictedJointDataHeader, PredictedJointData::HEADER_SIZE);
+            int encodedSize = PredictedJointData::getEncodedSize(sourceBuffer);
+            PACKET_READ_CHECK(PredictedJointData, encodedSize);
 
-        int numValidJointRotations = 0;
-        QVector<bool> validRotations;
-        validRotations.resize(numJoints);
-        { // rotation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointRotations;
-                }
-                validRotations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        }
+            QWriteLocker writeLock(&_jointDataLock);
 
-        // each joint rotation is stored in 6 bytes.
-        QWriteLocker writeLock(&_jointDataLock);
-        _jointData.resize(numJoints);
+            // rather than wait for the next key frame, the sender is asked to catch us up, see sendJointResyncRequestIfBehind()
+            _isMissingJointFrames = PredictedJointData::isBehind(sourceBuffer, _receivedJointHistory);
 
-        const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+            bool decoded;
+            PredictedJointData::decode(sourceBuffer, _receivedJointHistory, decoded);
+            if (decoded) {
+                PredictedJointData::toJointData(_receivedJointHistory, _jointData);
                 _hasNewJointData = true;
-                data.rotationIsDefaultPose = false;
+
+                // kept for the avatar mixer to pass on
+                _lastReceivedPredictedJointData = QByteArray(reinterpret_cast<const char*>(sourceBuffer), encodedSize);
+                _recentJointFrames.push(_receivedJointHistory);
+            }
+            sourceBuffer += encodedSize;
+        } else {
+            PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
+            int numJoints = *sourceBuffer++;
+            const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
+            PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
+
+            int numValidJointRotations = 0;
+            QVector<bool> validRotations;
+            validRotations.resize(numJoints);
+            { // rotation validity bits
+                unsigned char validity = 0;
+                int validityBit = 0;
+                for (int i = 0; i < numJoints; i++) {
+                    if (validityBit == 0) {
+                        validity = *sourceBuffer++;
+                    }
+                    bool valid = (bool)(validity & (1 << validityBit));
+                    if (valid) {
+                        ++numValidJointRotations;
+                    }
+                    validRotations[i] = valid;
+                    validityBit = (validityBit + 1) % BITS_IN_BYTE;
+                }
             }
-        }
 
-        PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
+            // each joint rotation is stored in 6 bytes.
+            QWriteLocker writeLock(&_jointDataLock);
+            _jointData.resize(numJoints);
 
-        // get translation validity bits -- these indicate which translations were packed
-        int numValidJointTranslations = 0;
-        QVector<bool> validTranslations;
-        validTranslations.resize(numJoints);
-        { // translation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
+            const int COMPRESSED_QUATERNION_SIZE = 6;
+            PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
             for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointTranslations;
+                JointData& data = _jointData[i];
+                if (validRotations[i]) {
+                    sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+                    _hasNewJointData = true;
+                    data.rotationIsDefaultPose = false;
                 }
-                validTranslations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
             }
-        } // 1 + bytesOfValidity bytes
 
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
-        PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
+            PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
+
+            // get translation validity bits -- these indicate which translations were packed
+            int numValidJointTranslations = 0;
+            QVector<bool> validTranslations;
+            validTranslations.resize(numJoints);
+            { // translation validity bits
+                unsigned char validity = 0;
+                int validityBit = 0;
+                for (int i = 0; i < numJoints; i++) {
+                    if (validityBit == 0) {
+                        validity = *sourceBuffer++;
+                    }
+                    bool valid = (bool)(validity & (1 << validityBit));
+                    if (valid) {
+                        ++numValidJointTranslations;
+                    }
+                    validTranslations[i] = valid;
+                    validityBit = (validityBit + 1) % BITS_IN_BYTE;
+                }
+            } // 1 + bytesOfValidity bytes
+
+            // each joint translation component is stored in 6 bytes.
+            const int COMPRESSED_TRANSLATION_SIZE = 6;
+            PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
 
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                _hasNewJointData = true;
-                data.translationIsDefaultPose = false;
+            for (int i = 0; i < numJoints; i++) {
+                JointData& data = _jointData[i];
+                if (validTranslations[i]) {
+                    sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+                    _hasNewJointData = true;
+                    data.translationIsDefaultPose = false;
+                }
             }
-        }
 
 #ifdef WANT_DEBUG
-        if (numValidJointRotations > 15) {
-            qCDebug(avatars) << "RECEIVING -- rotations:" << numValidJointRotations
-                << "translations:" << numValidJointTranslations
-                << "size:" << (int)(sourceBuffer - startPosition);
-        }
+            if (numValidJointRotations > 15) {
+                qCDebug(avatars) << "RECEIVING -- rotations:" << numValidJointRotations
+                    << "translations:" << numValidJointTranslations
+                    << "size:" << (int)(sourceBuffer - startPosition);
+            }
 #endif
+
+            // the frames that come after this one won't be predicted
+            _receivedJointHistory.reset();
+            _recentJointFrames.reset();
+            _lastReceivedPredictedJointData.clear();
+            _isMissingJointFrames = false;
+        }
+
         // faux joints
         sourceBuffer = unpackFauxJoint(sourceBuffer, _controllerLeftHandMatrixCache);
         sourceBuffer = unpackFauxJoint(sourceBuffer, _controllerRightHandMatrixCache);
@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarData_h
 #define hifi_AvatarData_h
 
+#include <atomic>
 #include <string>
 #include <memory>
 #include <queue>
@@ -54,6 +55,7 @@
 #include "AvatarTraits.h"
 #include "HeadData.h"
 #include "PathUtils.h"
+#include "PredictedJointData.h"
 
 #include <graphics/Material.h>
 
@@ -140,6 +142,7 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_JOINT_DATA               = 1U << 11;
     const HasFlags PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS = 1U << 12;
     const HasFlags PACKET_HAS_GRAB_JOINTS              = 1U << 13;
+    const HasFlags PACKET_HAS_PREDICTED_JOINT_DATA     = 1U << 14;
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
@@ -277,6 +280,19 @@ namespace AvatarDataPacket {
     */
     size_t maxJointDataSize(size_t numJoints, bool hasGrabJoints);
 
+    /*
+    // replaces the rotations and translations of JointData if PACKET_HAS_PREDICTED_JOINT_DATA is set,
+    // the faux joints follow it as they do the translations
+    struct PredictedJointData {
+        uint8_t numJoints;
+        uint16_t frame;
+        uint8_t flags;                                         // PredictedJointData::KEY_FRAME etc
+        uint16_t numResidualBytes;
+        uint8_t residuals[numResidualBytes];                   // encoded by PredictedJointData::encode(), or
+                                                               // encodeCatchUp() after the uint16_t frame it's from
+    };
+    */
+
     /*
     struct JointDefaultPoseFlags {
        uint8_t numJoints;
@@ -308,6 +324,8 @@ const float AVATAR_SEND_FULL_UPDATE_RATIO = 0.02f;
 // this controls how large a change in joint-rotation must be before the interface sends it to the avatar mixer
 const float AVATAR_MIN_ROTATION_DOT = 0.9999999f;
 const float AVATAR_MIN_TRANSLATION = 0.0001f;
+// how long to wait for a catch up to a missed joint frame before asking for it again
+const quint64 AVATAR_JOINT_RESYNC_REQUEST_INTERVAL = 100 * USECS_PER_MSEC;
 
 const float ROTATION_CHANGE_15D = 0.9914449f;
 const float ROTATION_CHANGE_45D = 0.9238795f;
@@ -450,10 +468,18 @@ public:
 
     virtual QByteArray toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime, const QVector<JointData>& lastSentJointData,
         AvatarDataPacket::HasFlags& hasFlagsOut, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
-        QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut = nullptr) const;
+        QVector<JointData>* sentJointDataOut, AvatarDataRate* outboundDataRateOut = nullptr,
+        const QByteArray* predictedJointData = nullptr) const;
 
     virtual void doneEncoding(bool cullSmallChanges);
 
+    // Sends the next joints as a key frame, for an avatar mixer that missed one of the frames sent to it.
+    void requestJointKeyFrame() { _jointKeyFrameRequested = true; }
+
+    // Asks node, which sends us these joints, to catch us up if we've seen that a joint frame was missed, see
+    // PacketType::AvatarJointResyncRequest. Asks again every AVATAR_JOINT_RESYNC_REQUEST_INTERVAL while it's behind.
+    void sendJointResyncRequestIfBehind(const SharedNodePointer& node);
+
     /// \return true if an error should be logged
     bool shouldLogError(const quint64& now);
 
@@ -1166,6 +1192,13 @@ public:
         return _lastSentJointData;
     }
 
+    // The predicted joint data to pass on to a receiver that has lastFrameSent, or -1 for none, see
+    // PredictedJointData::encodeForReceiver(). Empty if the joints last received weren't predicted.
+    QByteArray getPredictedJointDataToForward(int lastFrameSent, int& frameOut) const;
+
+    // keeps the last few joint frames received, for getPredictedJointDataToForward() to catch receivers up from
+    void setKeepsRecentJointFrames(bool keepsRecentJointFrames);
+
     // A method intended to be overriden by MyAvatar for polling orientation for network transmission.
     virtual glm::quat getOrientationOutbound() const;
 
@@ -1334,6 +1367,15 @@ protected:
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
 
+    PredictedJointData::History _sentJointHistory; ///< the joint frames the mixer has from us
+    PredictedJointData::History _pendingJointHistory; ///< _sentJointHistory once the packet being encoded is sent
+    std::atomic<bool> _jointKeyFrameRequested { false };
+    PredictedJointData::History _receivedJointHistory;
+    PredictedJointData::RecentFrames _recentJointFrames; ///< _receivedJointHistory after each of the last few frames
+    QByteArray _lastReceivedPredictedJointData; ///< the frame that brought _receivedJointHistory up to date
+    bool _isMissingJointFrames { false };
+    quint64 _lastJointResyncRequest { 0 };
+
     // key state
     KeyState _keyState;
 
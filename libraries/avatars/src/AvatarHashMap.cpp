@@ -253,6 +253,7 @@ AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessag
         // have the matching (or new) avatar parse the data from the packet
         int bytesRead = avatar->parseDataFromBuffer(byteArray);
         message->seek(positionBeforeRead + bytesRead);
+        avatar->sendJointResyncRequestIfBehind(sendingNode);
         _replicas.parseDataFromBuffer(sessionUUID, byteArray);
 
         return avatar;
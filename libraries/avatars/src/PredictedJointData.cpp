@@ -0,0 +1,579 @@
+//
+//  PredictedJointData.cpp
+//  libraries/avatars/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PredictedJointData.h"
+
+#include <algorithm>
+#include <assert.h>
+#include <cmath>
+#include <cstdlib>
+#include <string.h>
+
+#include <NumericalConstants.h>
+
+static const float ROTATION_SCALE = 32767.0f;
+static const float TRANSLATION_SCALE = 4096.0f; // the same as the six byte translations, TRANSLATION_COMPRESSION_RADIX
+static const int32_t MAX_QUANTIZED_VALUE = 32767;
+
+static const int RESIDUAL_WIDTH_BITS = 5;
+static const int MAX_RESIDUAL_BITS = 17; // the difference of two quantized values, with a sign bit
+
+static const int MAX_FRAME = 0xffff;
+static const int BASE_FRAME_SIZE = sizeof(uint16_t); // the frame a catch up is predicted from, after the header
+
+namespace {
+
+class BitWriter {
+public:
+    BitWriter(uint8_t* destination) : _destination(destination) {}
+
+    void write(uint32_t value, int numBits) {
+        _bits |= (uint64_t)value << _numBits;
+        _numBits += numBits;
+        while (_numBits >= BITS_IN_BYTE) {
+            _destination[_size++] = (uint8_t)_bits;
+            _bits >>= BITS_IN_BYTE;
+            _numBits -= BITS_IN_BYTE;
+        }
+    }
+
+    size_t finish() {
+        if (_numBits > 0) {
+            _destination[_size++] = (uint8_t)_bits;
+            _bits = 0;
+            _numBits = 0;
+        }
+        return _size;
+    }
+
+private:
+    uint8_t* _destination;
+    size_t _size { 0 };
+    uint64_t _bits { 0 };
+    int _numBits { 0 };
+};
+
+class BitReader {
+public:
+    BitReader(const uint8_t* source, size_t size) : _source(source), _size(size) {}
+
+    uint32_t read(int numBits) {
+        while (_numBits < numBits) {
+            if (_size == 0) {
+                _overrun = true;
+                return 0;
+            }
+            _bits |= (uint64_t)*_source++ << _numBits;
+            _numBits += BITS_IN_BYTE;
+            _size--;
+        }
+        uint32_t value = (uint32_t)(_bits & ((1ULL << numBits) - 1));
+        _bits >>= numBits;
+        _numBits -= numBits;
+        return value;
+    }
+
+    bool hasOverrun() const { return _overrun; }
+
+private:
+    const uint8_t* _source;
+    size_t _size;
+    uint64_t _bits { 0 };
+    int _numBits { 0 };
+    bool _overrun { false };
+};
+
+}
+
+// small residuals of either sign become small unsigned numbers
+static uint32_t zigZagEncode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t zigZagDecode(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static int numBitsFor(uint32_t value) {
+    int numBits = 0;
+    while (value) {
+        numBits++;
+        value >>= 1;
+    }
+    return numBits;
+}
+
+static int32_t clampQuantized(int64_t value) {
+    return (int32_t)std::min(std::max(value, (int64_t)-MAX_QUANTIZED_VALUE), (int64_t)MAX_QUANTIZED_VALUE);
+}
+
+static int32_t quantize(float value, float scale) {
+    return clampQuantized((int32_t)roundf(value * scale));
+}
+
+static int nextFrame(int frame) {
+    return (frame + 1) & MAX_FRAME;
+}
+
+// the number of frames from one frame to another, across the wrap around
+static int framesBetween(int from, int to) {
+    return (to - from) & MAX_FRAME;
+}
+
+// The rotation is put in the same hemisphere as the reference, so that it doesn't flip sign from one frame to the next.
+// Key frames put it in the w >= 0 hemisphere.
+static void quantizeJoint(const JointData& joint, const PredictedJointData::QuantizedJoint* reference,
+                          PredictedJointData::QuantizedJoint& result) {
+    glm::quat rotation = joint.rotation;
+    if (reference) {
+        float dot = rotation.x * reference->values[0] + rotation.y * reference->values[1] +
+            rotation.z * reference->values[2] + rotation.w * reference->values[3];
+        if (dot < 0.0f) {
+            rotation = -rotation;
+        }
+    } else if (rotation.w < 0.0f) {
+        rotation = -rotation;
+    }
+    result.values[0] = quantize(rotation.x, ROTATION_SCALE);
+    result.values[1] = quantize(rotation.y, ROTATION_SCALE);
+    result.values[2] = quantize(rotation.z, ROTATION_SCALE);
+    result.values[3] = quantize(rotation.w, ROTATION_SCALE);
+    result.values[4] = quantize(joint.translation.x, TRANSLATION_SCALE);
+    result.values[5] = quantize(joint.translation.y, TRANSLATION_SCALE);
+    result.values[6] = quantize(joint.translation.z, TRANSLATION_SCALE);
+}
+
+// each joint carries on for numFrames at the velocity it had between the last two frames
+static void predict(const PredictedJointData::History& history, int numFrames,
+                    PredictedJointData::QuantizedPose& prediction) {
+    prediction.resize(history.pose.size());
+    for (size_t i = 0; i < history.pose.size(); i++) {
+        for (int j = 0; j < PredictedJointData::NUM_VALUES; j++) {
+            int64_t value = history.pose[i].values[j];
+            prediction[i].values[j] = clampQuantized(value + numFrames * (value - history.previousPose[i].values[j]));
+        }
+    }
+}
+
+// The frame before the one caught up to is predicted to be as far from it as the joint moved on average each of the
+// numFrames since from. A resync has no from, and predicts it to be the same.
+static int32_t predictPrevious(const PredictedJointData::History* from, const PredictedJointData::QuantizedPose& pose,
+                               int numFrames, size_t joint, int value) {
+    int64_t prediction = pose[joint].values[value];
+    if (from) {
+        prediction -= (prediction - from->pose[joint].values[value]) / numFrames;
+    }
+    return clampQuantized(prediction);
+}
+
+// A group is the width of its largest residual, then a bit for each joint that has a residual that isn't zero and the
+// residuals of those joints. Joints that move as predicted cost a bit, and a group of them costs just the width.
+static void writeResidualGroup(BitWriter& writer, const PredictedJointData::QuantizedPose& residuals,
+                               int firstJoint, int endJoint, int firstValue, int endValue) {
+    uint32_t bits = 0;
+    uint32_t movedJoints = 0;
+    for (int i = firstJoint; i < endJoint; i++) {
+        uint32_t jointBits = 0;
+        for (int j = firstValue; j < endValue; j++) {
+            jointBits |= zigZagEncode(residuals[i].values[j]);
+        }
+        if (jointBits) {
+            movedJoints |= 1U << (i - firstJoint);
+        }
+        bits |= jointBits;
+    }
+
+    int width = numBitsFor(bits);
+    writer.write(width, RESIDUAL_WIDTH_BITS);
+    if (width > 0) {
+        writer.write(movedJoints, endJoint - firstJoint);
+        for (int i = firstJoint; i < endJoint; i++) {
+            if (movedJoints & (1U << (i - firstJoint))) {
+                for (int j = firstValue; j < endValue; j++) {
+                    writer.write(zigZagEncode(residuals[i].values[j]), width);
+                }
+            }
+        }
+    }
+}
+
+static bool readResidualGroup(BitReader& reader, PredictedJointData::QuantizedPose& residuals,
+                              int firstJoint, int endJoint, int firstValue, int endValue) {
+    int width = (int)reader.read(RESIDUAL_WIDTH_BITS);
+    if (width > MAX_RESIDUAL_BITS) {
+        return false;
+    }
+    uint32_t movedJoints = width > 0 ? reader.read(endJoint - firstJoint) : 0;
+    for (int i = firstJoint; i < endJoint; i++) {
+        bool moved = (movedJoints & (1U << (i - firstJoint))) != 0;
+        for (int j = firstValue; j < endValue; j++) {
+            residuals[i].values[j] = moved ? zigZagDecode(reader.read(width)) : 0;
+        }
+    }
+    return !reader.hasOverrun();
+}
+
+// rotations and translations get a width each, for every group of joints
+static void writeResiduals(BitWriter& writer, const PredictedJointData::QuantizedPose& residuals) {
+    int numJoints = (int)residuals.size();
+    for (int firstJoint = 0; firstJoint < numJoints; firstJoint += PredictedJointData::JOINTS_PER_GROUP) {
+        int endJoint = std::min(firstJoint + PredictedJointData::JOINTS_PER_GROUP, numJoints);
+        writeResidualGroup(writer, residuals, firstJoint, endJoint, 0, PredictedJointData::NUM_ROTATION_VALUES);
+        writeResidualGroup(writer, residuals, firstJoint, endJoint,
+                           PredictedJointData::NUM_ROTATION_VALUES, PredictedJointData::NUM_VALUES);
+    }
+}
+
+static bool readResiduals(BitReader& reader, PredictedJointData::QuantizedPose& residuals) {
+    int numJoints = (int)residuals.size();
+    for (int firstJoint = 0; firstJoint < numJoints; firstJoint += PredictedJointData::JOINTS_PER_GROUP) {
+        int endJoint = std::min(firstJoint + PredictedJointData::JOINTS_PER_GROUP, numJoints);
+        if (!readResidualGroup(reader, residuals, firstJoint, endJoint, 0, PredictedJointData::NUM_ROTATION_VALUES) ||
+            !readResidualGroup(reader, residuals, firstJoint, endJoint,
+                               PredictedJointData::NUM_ROTATION_VALUES, PredictedJointData::NUM_VALUES)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static size_t writeHeader(uint8_t* destination, int numJoints, int frame, uint8_t flags, size_t numResidualBytes) {
+    uint16_t frameValue = (uint16_t)frame;
+    uint16_t numResidualBytesValue = (uint16_t)numResidualBytes;
+    destination[0] = (uint8_t)numJoints;
+    memcpy(destination + 1, &frameValue, sizeof(frameValue));
+    destination[3] = flags;
+    memcpy(destination + 4, &numResidualBytesValue, sizeof(numResidualBytesValue));
+    return PredictedJointData::HEADER_SIZE;
+}
+
+void PredictedJointData::History::reset() {
+    frame = -1;
+    framesSinceKeyFrame = 0;
+    pose.clear();
+    previousPose.clear();
+}
+
+void PredictedJointData::RecentFrames::setEnabled(bool enabled) {
+    _frames.clear();
+    if (enabled) {
+        _frames.resize(NUM_FRAMES);
+    }
+}
+
+void PredictedJointData::RecentFrames::reset() {
+    for (auto& history : _frames) {
+        history.reset();
+    }
+}
+
+void PredictedJointData::RecentFrames::push(const History& history) {
+    if (!_frames.empty() && history.isValid()) {
+        _frames[history.frame % NUM_FRAMES] = history;
+    }
+}
+
+const PredictedJointData::History* PredictedJointData::RecentFrames::find(int frame) const {
+    if (_frames.empty() || frame < 0) {
+        return nullptr;
+    }
+    const History& history = _frames[frame % NUM_FRAMES];
+    return (history.isValid() && history.frame == frame) ? &history : nullptr;
+}
+
+size_t PredictedJointData::maxSize(int numJoints) {
+    numJoints = std::min(numJoints, (int)MAX_JOINTS);
+    int numGroups = (numJoints + JOINTS_PER_GROUP - 1) / JOINTS_PER_GROUP;
+    size_t numBitsPerFrame = numGroups * 2 * RESIDUAL_WIDTH_BITS + 2 * numJoints + numJoints * NUM_VALUES * MAX_RESIDUAL_BITS;
+
+    // a catch up carries two frames and the frame it's predicted from
+    return HEADER_SIZE + BASE_FRAME_SIZE + 2 * ((numBitsPerFrame + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+}
+
+int PredictedJointData::getEncodedSize(const uint8_t* source) {
+    uint16_t numResidualBytes;
+    memcpy(&numResidualBytes, source + 4, sizeof(numResidualBytes));
+    return HEADER_SIZE + numResidualBytes;
+}
+
+bool PredictedJointData::canFollow(const uint8_t* source, int frame) {
+    uint16_t encodedFrame;
+    memcpy(&encodedFrame, source + 1, sizeof(encodedFrame));
+    uint8_t flags = source[3];
+    if (flags & KEY_FRAME) {
+        return true;
+    }
+    if (frame < 0 || (flags & REPEAT_FRAME)) {
+        return false;
+    }
+    if (flags & CATCH_UP_FRAME) {
+        if (getEncodedSize(source) < HEADER_SIZE + BASE_FRAME_SIZE) {
+            return false;
+        }
+        uint16_t baseFrame;
+        memcpy(&baseFrame, source + HEADER_SIZE, sizeof(baseFrame));
+        return baseFrame == frame;
+    }
+    return nextFrame(frame) == encodedFrame;
+}
+
+bool PredictedJointData::isBehind(const uint8_t* source, const History& history) {
+    uint16_t frame;
+    memcpy(&frame, source + 1, sizeof(frame));
+    uint8_t flags = source[3];
+
+    if (flags & KEY_FRAME) {
+        return false;
+    }
+    if (!history.isValid()) {
+        return true;
+    }
+
+    // the frame we have again, or one that arrived after the frames that followed it
+    int framesAhead = framesBetween(history.frame, frame);
+    if (framesAhead == 0 || framesAhead > MAX_FRAME / 2) {
+        return false;
+    }
+
+    // a repeat of a frame we don't have
+    if (flags & REPEAT_FRAME) {
+        return true;
+    }
+    return source[0] != (int)history.pose.size() || !canFollow(source, history.frame);
+}
+
+bool PredictedJointData::isCatchUp(const uint8_t* source) {
+    uint8_t flags = source[3];
+    return (flags & (KEY_FRAME | CATCH_UP_FRAME)) != 0;
+}
+
+size_t PredictedJointData::encode(const QVector<JointData>& joints, bool keyFrame, float rotationDeadZone,
+                                  float translationDeadZone, History& history, uint8_t* destination) {
+    int numJoints = std::min(joints.size(), (int)MAX_JOINTS);
+    keyFrame = keyFrame || !history.isValid() || (int)history.pose.size() != numJoints ||
+        history.framesSinceKeyFrame >= KEY_FRAME_INTERVAL;
+
+    QuantizedPose prediction;
+    if (!keyFrame) {
+        predict(history, 1, prediction);
+    }
+
+    const int32_t rotationDeadZoneValue = (int32_t)(rotationDeadZone * ROTATION_SCALE);
+    const int32_t translationDeadZoneValue = (int32_t)(translationDeadZone * TRANSLATION_SCALE);
+
+    QuantizedPose pose(numJoints);
+    QuantizedPose residuals(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        quantizeJoint(joints[i], keyFrame ? nullptr : &history.pose[i], pose[i]);
+
+        for (int j = 0; j < NUM_VALUES; j++) {
+            if (keyFrame) {
+                residuals[i].values[j] = pose[i].values[j];
+                continue;
+            }
+
+            int32_t residual = pose[i].values[j] - prediction[i].values[j];
+            int32_t deadZone = j < NUM_ROTATION_VALUES ? rotationDeadZoneValue : translationDeadZoneValue;
+            if (std::abs(residual) <= deadZone) {
+                // the receiver will have the prediction, so that's what the next frame is predicted from
+                residual = 0;
+                pose[i].values[j] = prediction[i].values[j];
+            }
+            residuals[i].values[j] = residual;
+        }
+    }
+
+    int frame = history.isValid() ? nextFrame(history.frame) : 0;
+
+    BitWriter writer(destination + HEADER_SIZE);
+    writeResiduals(writer, residuals);
+    size_t numResidualBytes = writer.finish();
+    uint8_t flags = 0;
+    if (keyFrame) {
+        flags |= KEY_FRAME;
+    }
+    writeHeader(destination, numJoints, frame, flags, numResidualBytes);
+
+    if (keyFrame) {
+        history.previousPose = pose;
+        history.framesSinceKeyFrame = 0;
+    } else {
+        history.previousPose.swap(history.pose);
+        history.framesSinceKeyFrame++;
+    }
+    history.pose.swap(pose);
+    history.frame = frame;
+
+    return HEADER_SIZE + numResidualBytes;
+}
+
+// the frame before the last one of history, as residuals from predictPrevious()
+static void writePreviousResiduals(BitWriter& writer, const PredictedJointData::History* from,
+                                   const PredictedJointData::History& history) {
+    size_t numJoints = history.pose.size();
+    int numFrames = from ? framesBetween(from->frame, history.frame) : 1;
+    PredictedJointData::QuantizedPose previousResiduals(numJoints);
+    for (size_t i = 0; i < numJoints; i++) {
+        for (int j = 0; j < PredictedJointData::NUM_VALUES; j++) {
+            previousResiduals[i].values[j] =
+                history.previousPose[i].values[j] - predictPrevious(from, history.pose, numFrames, i, j);
+        }
+    }
+    writeResiduals(writer, previousResiduals);
+}
+
+size_t PredictedJointData::encodeResync(const History& history, uint8_t* destination) {
+    assert(history.isValid());
+
+    BitWriter writer(destination + HEADER_SIZE);
+    writeResiduals(writer, history.pose);
+    writePreviousResiduals(writer, nullptr, history);
+    size_t numResidualBytes = writer.finish();
+    writeHeader(destination, (int)history.pose.size(), history.frame, KEY_FRAME | HAS_PREVIOUS_FRAME, numResidualBytes);
+
+    return HEADER_SIZE + numResidualBytes;
+}
+
+size_t PredictedJointData::encodeRepeat(const History& history, uint8_t* destination) {
+    assert(history.isValid());
+    return writeHeader(destination, (int)history.pose.size(), history.frame, REPEAT_FRAME, 0);
+}
+
+size_t PredictedJointData::encodeCatchUp(const History& from, const History& history, uint8_t* destination) {
+    assert(from.isValid() && history.isValid() && from.pose.size() == history.pose.size());
+    int numJoints = (int)history.pose.size();
+
+    QuantizedPose residuals;
+    predict(from, framesBetween(from.frame, history.frame), residuals);
+    for (int i = 0; i < numJoints; i++) {
+        for (int j = 0; j < NUM_VALUES; j++) {
+            residuals[i].values[j] = history.pose[i].values[j] - residuals[i].values[j];
+        }
+    }
+
+    uint16_t baseFrame = (uint16_t)from.frame;
+    memcpy(destination + HEADER_SIZE, &baseFrame, sizeof(baseFrame));
+
+    BitWriter writer(destination + HEADER_SIZE + BASE_FRAME_SIZE);
+    writeResiduals(writer, residuals);
+    writePreviousResiduals(writer, &from, history);
+    size_t numResidualBytes = BASE_FRAME_SIZE + writer.finish();
+    writeHeader(destination, numJoints, history.frame, CATCH_UP_FRAME | HAS_PREVIOUS_FRAME, numResidualBytes);
+
+    return HEADER_SIZE + numResidualBytes;
+}
+
+size_t PredictedJointData::encodeForReceiver(const uint8_t* lastReceived, const History& history,
+                                             const RecentFrames& recentFrames, int receiverFrame, uint8_t* destination) {
+    assert(history.isValid());
+    if (receiverFrame == history.frame) {
+        return encodeRepeat(history, destination);
+    }
+
+    // a key frame costs about what a resync does, so the receiver is caught up to it if that costs less
+    bool isKeyFrame = (lastReceived[3] & KEY_FRAME) != 0;
+    bool canPassOn = canFollow(lastReceived, receiverFrame);
+    const History* from = recentFrames.find(receiverFrame);
+    if (from && from->pose.size() == history.pose.size() && (isKeyFrame || !canPassOn)) {
+        size_t size = encodeCatchUp(*from, history, destination);
+        if (!canPassOn || (int)size < getEncodedSize(lastReceived)) {
+            return size;
+        }
+    }
+    if (canPassOn) {
+        int size = getEncodedSize(lastReceived);
+        memcpy(destination, lastReceived, size);
+        return size;
+    }
+    return encodeResync(history, destination);
+}
+
+int PredictedJointData::decode(const uint8_t* source, History& history, bool& decoded) {
+    decoded = false;
+
+    int numJoints = source[0];
+    uint16_t frame;
+    memcpy(&frame, source + 1, sizeof(frame));
+    uint8_t flags = source[3];
+    int encodedSize = getEncodedSize(source);
+
+    if (flags & REPEAT_FRAME) {
+        return encodedSize;
+    }
+
+    bool keyFrame = (flags & KEY_FRAME) != 0;
+    bool catchUp = !keyFrame && (flags & CATCH_UP_FRAME);
+    if (!keyFrame && (!canFollow(source, history.frame) || (int)history.pose.size() != numJoints)) {
+        // a frame in between was missed
+        return encodedSize;
+    }
+
+    int residualsOffset = HEADER_SIZE + (catchUp ? BASE_FRAME_SIZE : 0);
+    BitReader reader(source + residualsOffset, encodedSize - residualsOffset);
+    QuantizedPose residuals(numJoints);
+    if (!readResiduals(reader, residuals)) {
+        return encodedSize;
+    }
+
+    // one for a frame that follows the one history has, more for a catch up
+    int numFrames = framesBetween(history.frame, frame);
+
+    QuantizedPose pose(numJoints);
+    if (keyFrame) {
+        pose.swap(residuals);
+    } else {
+        predict(history, numFrames, pose);
+        for (int i = 0; i < numJoints; i++) {
+            for (int j = 0; j < NUM_VALUES; j++) {
+                pose[i].values[j] = clampQuantized(pose[i].values[j] + residuals[i].values[j]);
+            }
+        }
+    }
+
+    if (flags & HAS_PREVIOUS_FRAME) {
+        QuantizedPose previousPose(numJoints);
+        if (!readResiduals(reader, previousPose)) {
+            return encodedSize;
+        }
+        const History* from = catchUp ? &history : nullptr;
+        for (int i = 0; i < numJoints; i++) {
+            for (int j = 0; j < NUM_VALUES; j++) {
+                previousPose[i].values[j] =
+                    clampQuantized(predictPrevious(from, pose, numFrames, i, j) + previousPose[i].values[j]);
+            }
+        }
+        history.previousPose.swap(previousPose);
+        history.framesSinceKeyFrame = 0;
+    } else if (keyFrame) {
+        history.previousPose = pose;
+        history.framesSinceKeyFrame = 0;
+    } else {
+        history.previousPose.swap(history.pose);
+        history.framesSinceKeyFrame++;
+    }
+    history.pose.swap(pose);
+    history.frame = frame;
+
+    decoded = true;
+    return encodedSize;
+}
+
+void PredictedJointData::toJointData(const History& history, QVector<JointData>& joints) {
+    joints.resize((int)history.pose.size());
+    for (int i = 0; i < joints.size(); i++) {
+        const int32_t* values = history.pose[i].values;
+        glm::quat rotation(values[3] / ROTATION_SCALE, values[0] / ROTATION_SCALE, values[1] / ROTATION_SCALE,
+                           values[2] / ROTATION_SCALE);
+        float length = glm::length(rotation);
+        const float MIN_LENGTH = 1.0e-4f;
+        joints[i].rotation = length > MIN_LENGTH ? rotation / length : glm::quat();
+        joints[i].translation = glm::vec3(values[4], values[5], values[6]) / TRANSLATION_SCALE;
+    }
+}
@@ -0,0 +1,127 @@
+//
+//  PredictedJointData.h
+//  libraries/avatars/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PredictedJointData_h
+#define hifi_PredictedJointData_h
+
+#include <stdint.h>
+#include <vector>
+
+#include <QtCore/QVector>
+
+#include <JointData.h>
+
+// Packs the rotations and translations of an avatar's joints as residuals from a prediction made with the two frames sent
+// before them, see AvatarDataPacket::PredictedJointData. The joints are quantized before they are predicted, so a receiver
+// that has the same two frames reconstructs exactly what the sender did. Each group of joints is written with just enough
+// bits for its largest residual, which is a few bits for joints that move smoothly and one for joints that don't move.
+//
+// A stream of frames starts with a key frame, which isn't predicted, and each frame after it is predicted from the one
+// before. A receiver that misses a frame can't decode the ones after it, so it asks to be caught up as soon as it sees the
+// gap, see isBehind(). The sender also starts over with a key frame every KEY_FRAME_INTERVAL frames, in case it isn't told.
+class PredictedJointData {
+public:
+    static const int NUM_ROTATION_VALUES = 4;
+    static const int NUM_TRANSLATION_VALUES = 3;
+    static const int NUM_VALUES = NUM_ROTATION_VALUES + NUM_TRANSLATION_VALUES;
+    static const int JOINTS_PER_GROUP = 8;
+    static const int MAX_JOINTS = 255;
+    static const int KEY_FRAME_INTERVAL = 45; // about as often as AVATAR_SEND_FULL_UPDATE_RATIO sends all the joints
+
+    static const uint8_t KEY_FRAME = 1U << 0;
+    static const uint8_t HAS_PREVIOUS_FRAME = 1U << 1;
+    static const uint8_t REPEAT_FRAME = 1U << 2;
+    static const uint8_t CATCH_UP_FRAME = 1U << 3;
+
+    // numJoints, frame, flags and numResidualBytes
+    static const int HEADER_SIZE = 6;
+
+    struct QuantizedJoint {
+        int32_t values[NUM_VALUES]; // rotation x, y, z, w then translation x, y, z
+    };
+    using QuantizedPose = std::vector<QuantizedJoint>;
+
+    // The last two frames of a stream, which both ends of it predict the next frame from.
+    struct History {
+        int frame { -1 }; // -1 until the first key frame
+        int framesSinceKeyFrame { 0 };
+        QuantizedPose pose; // at frame
+        QuantizedPose previousPose; // at frame - 1
+
+        bool isValid() const { return frame >= 0; }
+        void reset();
+    };
+
+    // The history as it was after each of the last few frames a receiver decoded, for it to catch up the receivers it passes
+    // the frames on to from whichever of them they have, see encodeForReceiver(). Holds nothing until it's enabled.
+    class RecentFrames {
+    public:
+        static const int NUM_FRAMES = 8; // divides the number of frame numbers, so they wrap around onto the same slots
+
+        void setEnabled(bool enabled);
+        void reset();
+        void push(const History& history);
+
+        // null if frame isn't one of the last NUM_FRAMES
+        const History* find(int frame) const;
+
+    private:
+        std::vector<History> _frames; // indexed by frame % NUM_FRAMES
+    };
+
+    static size_t maxSize(int numJoints);
+
+    // the size of the encoded frame at source, which must have at least HEADER_SIZE bytes
+    static int getEncodedSize(const uint8_t* source);
+
+    // whether a receiver that has frame can decode the encoded frame at source
+    static bool canFollow(const uint8_t* source, int frame);
+
+    // Whether the encoded frame at source is ahead of history and can't be decoded with it, meaning that frames were
+    // missed. The receiver should ask to be caught up rather than wait for the next key frame.
+    static bool isBehind(const uint8_t* source, const History& history);
+
+    // Whether the encoded frame at source is a key frame, resync or catch up, which cost more than a frame that follows
+    // the one before it and pay off when the receiver is sent the frames after it.
+    static bool isCatchUp(const uint8_t* source);
+
+    // Writes joints as the next frame of the stream, as a key frame if keyFrame is set or it's time for one. Residuals
+    // within the dead zones, in quaternion components and meters, are sent as zero. Returns the number of bytes written,
+    // history is moved on to the new frame.
+    static size_t encode(const QVector<JointData>& joints, bool keyFrame, float rotationDeadZone, float translationDeadZone,
+                         History& history, uint8_t* destination);
+
+    // Writes the last frame of history as a key frame that carries the frame before it too, for a receiver to carry on
+    // predicting the frames after it from.
+    static size_t encodeResync(const History& history, uint8_t* destination);
+
+    // Writes just a header for the last frame of history, for a receiver that already has it.
+    static size_t encodeRepeat(const History& history, uint8_t* destination);
+
+    // Writes the last frame of history predicted from the last frame of from, which can be any number of frames before it,
+    // with the frame before it too. Costs about what two predicted frames do when from is a frame or two behind, and more
+    // the further behind it is. A resync costs about what a key frame does.
+    static size_t encodeCatchUp(const History& from, const History& history, uint8_t* destination);
+
+    // Writes what brings a receiver that has receiverFrame, or -1 for none, up to the last frame of history: lastReceived,
+    // the frame that brought history up to date, as it is if it's predicted from receiverFrame, a repeat if the receiver is
+    // up to date, a catch up if receiverFrame is one of recentFrames, or else a resync.
+    static size_t encodeForReceiver(const uint8_t* lastReceived, const History& history, const RecentFrames& recentFrames,
+                                    int receiverFrame, uint8_t* destination);
+
+    // Reads the frame at source, which must have getEncodedSize() bytes, and returns the number of bytes read. decoded is
+    // false when the frame is a repeat or can't be predicted from history, which is then left as it was.
+    static int decode(const uint8_t* source, History& history, bool& decoded);
+
+    // copies the rotations and translations of the last frame of history into joints
+    static void toJointData(const History& history, QVector<JointData>& joints);
+};
+
+#endif // hifi_PredictedJointData_h
@@ -41,6 +41,7 @@ void Baker::handleErrors(const QStringList& errors) {
 
 void Baker::handleWarning(const QString& warning) {
     qCWarning(model_baking).noquote() << warning;
+    std::lock_guard<std::mutex> lock(_warningListMutex);
     _warningList.append(warning);
 }
 
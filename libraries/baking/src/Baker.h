@@ -12,6 +12,8 @@
 #ifndef hifi_Baker_h
 #define hifi_Baker_h
 
+#include <mutex>
+
 #include <QtCore/QObject>
 
 class Baker : public QObject {
@@ -57,6 +59,7 @@ protected:
 
     QStringList _errorList;
     QStringList _warningList;
+    std::mutex _warningListMutex; // warnings can be raised by the threads a baker splits its work across
 
     std::atomic<bool> _isFinished { false };
 
@@ -39,6 +39,7 @@
 
 void FBXBaker::bake() {    
     qDebug() << "FBXBaker" << _modelURL << "bake starting";
+    _bakeStartTime = usecTimestampNow();
 
     // setup the output folder for the results of this bake
     setupOutputFolder();
@@ -54,12 +55,16 @@ void FBXBaker::bake() {
 }
 
 void FBXBaker::bakeSourceCopy() {
+    auto parseStartTime = usecTimestampNow();
+    _stageTimings.load = parseStartTime - _bakeStartTime;
+
     // load the scene from the FBX file
     importScene();
 
     if (shouldStop()) {
         return;
     }
+    _stageTimings.parse = usecTimestampNow() - parseStartTime;
 
     // enumerate the models and textures found in the scene and start a bake for them
     rewriteAndBakeSceneTextures();
@@ -68,11 +73,13 @@ void FBXBaker::bakeSourceCopy() {
         return;
     }
 
+    auto meshCompressionStartTime = usecTimestampNow();
     rewriteAndBakeSceneModels();
 
     if (shouldStop()) {
         return;
     }
+    _stageTimings.meshCompression = usecTimestampNow() - meshCompressionStartTime;
 
     // check if we're already done with textures (in case we had none to re-write)
     checkIfTexturesFinished();
@@ -226,64 +233,85 @@ void FBXBaker::rewriteAndBakeSceneModels() {
             break;
         }
     }
+
+    // each mesh is extracted and draco compressed on its own, so spread them across the global thread pool,
+    // then swap the compressed meshes into the node tree in their original order
+    struct MeshCompressionJob {
+        FBXNode* geometryNode;
+        unsigned int meshIndex;
+        bool wasCompressed { false };
+        bool success { false };
+        FBXNode dracoMeshNode;
+    };
+    std::vector<MeshCompressionJob> jobs;
     for (FBXNode& rootChild : _rootNode.children) {
         if (rootChild.name == "Objects") {
             for (FBXNode& objectChild : rootChild.children) {
                 if (objectChild.name == "Geometry") {
+                    jobs.push_back({ &objectChild, meshIndex++ });
+                }
+            }
+        }
+    }
 
-                    // TODO Pull this out of _geometry instead so we don't have to reprocess it
-                    auto extractedMesh = FBXReader::extractMesh(objectChild, meshIndex, false);
-                    
-                    // Callback to get MaterialID
-                    GetMaterialIDCallback materialIDcallback = [&extractedMesh](int partIndex) {
-                        return extractedMesh.partMaterialTextures[partIndex].first;
-                    };
-                    
-                    // Compress mesh information and store in dracoMeshNode
-                    FBXNode dracoMeshNode;
-                    bool success = compressMesh(extractedMesh.mesh, hasDeformers, dracoMeshNode, materialIDcallback);
-                    
-                    // if bake fails - return, if there were errors and continue, if there were warnings.
-                    if (!success) {
-                        if (hasErrors()) {
-                            return;
-                        } else if (hasWarnings()) {
-                            continue;
-                        }
-                    } else {
-                        objectChild.children.push_back(dracoMeshNode);
-
-                        static const std::vector<QString> nodeNamesToDelete {
-                            // Node data that is packed into the draco mesh
-                            "Vertices",
-                            "PolygonVertexIndex",
-                            "LayerElementNormal",
-                            "LayerElementColor",
-                            "LayerElementUV",
-                            "LayerElementMaterial",
-                            "LayerElementTexture",
-
-                            // Node data that we don't support
-                            "Edges",
-                            "LayerElementTangent",
-                            "LayerElementBinormal",
-                            "LayerElementSmoothing"
-                        };
-                        auto& children = objectChild.children;
-                        auto it = children.begin();
-                        while (it != children.end()) {
-                            auto begin = nodeNamesToDelete.begin();
-                            auto end = nodeNamesToDelete.end();
-                            if (find(begin, end, it->name) != end) {
-                                it = children.erase(it);
-                            } else {
-                                ++it;
-                            }
-                        }
-                    }
-                }  // Geometry Object
+    QtConcurrent::blockingMap(jobs, [this, hasDeformers](MeshCompressionJob& job) {
+        // TODO Pull this out of _geometry instead so we don't have to reprocess it
+        auto meshIndex = job.meshIndex;
+        auto extractedMesh = FBXReader::extractMesh(*job.geometryNode, meshIndex, false);
 
-            } // foreach root child
+        // re-baking a compressed mesh is an error, report it from the baker's thread below
+        if (extractedMesh.mesh.wasCompressed) {
+            job.wasCompressed = true;
+            return;
+        }
+
+        // Callback to get MaterialID
+        GetMaterialIDCallback materialIDcallback = [&extractedMesh](int partIndex) {
+            return extractedMesh.partMaterialTextures[partIndex].first;
+        };
+
+        // Compress mesh information and store in dracoMeshNode
+        job.success = compressMesh(extractedMesh.mesh, hasDeformers, job.dracoMeshNode, materialIDcallback);
+    });
+
+    for (auto& job : jobs) {
+        if (job.wasCompressed) {
+            handleError("Cannot re-bake a file that contains compressed mesh");
+            return;
+        }
+
+        // if compression fails the mesh is left as it is, compressMesh has added a warning if there was a problem
+        if (job.success) {
+            FBXNode& objectChild = *job.geometryNode;
+            objectChild.children.push_back(job.dracoMeshNode);
+
+            static const std::vector<QString> nodeNamesToDelete {
+                // Node data that is packed into the draco mesh
+                "Vertices",
+                "PolygonVertexIndex",
+                "LayerElementNormal",
+                "LayerElementColor",
+                "LayerElementUV",
+                "LayerElementMaterial",
+                "LayerElementTexture",
+
+                // Node data that we don't support
+                "Edges",
+                "LayerElementTangent",
+                "LayerElementBinormal",
+                "LayerElementSmoothing"
+            };
+            auto& children = objectChild.children;
+            auto it = children.begin();
+            while (it != children.end()) {
+                auto begin = nodeNamesToDelete.begin();
+                auto end = nodeNamesToDelete.end();
+                if (find(begin, end, it->name) != end) {
+                    it = children.erase(it);
+                } else {
+                    ++it;
+                }
+            }
         }
     }
 }
@@ -12,6 +12,7 @@
 #include "ModelBaker.h"
 
 #include <PathUtils.h>
+#include <SharedUtil.h>
 
 #include <FBXReader.h>
 #include <FBXWriter.h>
@@ -321,9 +322,16 @@ void ModelBaker::bakeTexture(const QUrl& textureURL, image::TextureUsage::Type t
     connect(bakingTexture.data(), &Baker::finished, this, &ModelBaker::handleBakedTexture);
     connect(bakingTexture.data(), &TextureBaker::aborted, this, &ModelBaker::handleAbortedTexture);
 
+    // textures with the same content as one another model already baked are copied rather than baked again
+    bakingTexture->setBakeCache(_textureBakeCache);
+
     // keep a shared pointer to the baking texture
     _bakingTextures.insert(textureURL, bakingTexture);
 
+    if (_texturesStartTime == 0) {
+        _texturesStartTime = usecTimestampNow();
+    }
+
     // start baking the texture on one of our available worker threads
     bakingTexture->moveToThread(_textureThreadGetter());
     QMetaObject::invokeMethod(bakingTexture.data(), "bake");
@@ -373,6 +381,8 @@ void ModelBaker::handleBakedTexture() {
                 }
 
 
+                _stageTimings.slowestTexture = std::max(_stageTimings.slowestTexture, bakedTexture->getProcessingTime());
+
                 // now that this texture has been baked and handled, we can remove that TextureBaker from our hash
                 _bakingTextures.remove(bakedTexture->getTextureURL());
 
@@ -488,8 +498,15 @@ void ModelBaker::checkIfTexturesFinished() {
         } else {
             qCDebug(model_baking) << "Finished baking, emitting finished" << _modelURL;
 
+            auto now = usecTimestampNow();
+            if (_texturesStartTime != 0) {
+                _stageTimings.textures = now - _texturesStartTime;
+            }
+
             texturesFinished();
 
+            _stageTimings.total = usecTimestampNow() - _bakeStartTime;
+
             setIsFinished(true);
         }
     }
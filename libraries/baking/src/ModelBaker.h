@@ -18,6 +18,7 @@
 #include <QtNetwork/QNetworkReply>
 
 #include "Baker.h"
+#include "TextureBakeCache.h"
 #include "TextureBaker.h"
 
 #include "ModelBakingLoggingCategory.h"
@@ -35,6 +36,16 @@ class ModelBaker : public Baker {
     Q_OBJECT
 
 public:
+    // time spent in each stage of the bake, in usecs
+    struct StageTimings {
+        quint64 load { 0 }; // copying or downloading the source model
+        quint64 parse { 0 };
+        quint64 meshCompression { 0 };
+        quint64 textures { 0 }; // from the first texture bake starting to the last one finishing
+        quint64 slowestTexture { 0 }; // the longest time a single texture spent processing
+        quint64 total { 0 };
+    };
+
     ModelBaker(const QUrl& inputModelURL, TextureBakerThreadGetter inputTextureThreadGetter,
                const QString& bakedOutputDirectory, const QString& originalOutputDirectory = "");
     virtual ~ModelBaker();
@@ -46,6 +57,12 @@ public:
     QUrl getModelURL() const { return _modelURL; }
     QString getBakedModelFilePath() const { return _bakedModelFilePath; }
 
+    // share texture bakes with other bakers, by texture content, see TextureBakeCache
+    void setTextureBakeCache(std::shared_ptr<TextureBakeCache> textureBakeCache) { _textureBakeCache = textureBakeCache; }
+
+    // only complete once the bake has finished without errors
+    const StageTimings& getStageTimings() const { return _stageTimings; }
+
 public slots:
     virtual void abort() override;
 
@@ -64,6 +81,9 @@ protected:
     QDir _modelTempDir;
     QString _originalModelFilePath;
 
+    quint64 _bakeStartTime { 0 };
+    StageTimings _stageTimings;
+
 private slots:
     void handleBakedTexture();
     void handleAbortedTexture();
@@ -80,6 +100,9 @@ private:
     QHash<QString, int> _textureNameMatchCount;
     QHash<QUrl, QString> _remappedTexturePaths;
     bool _pendingErrorEmission{ false };
+
+    std::shared_ptr<TextureBakeCache> _textureBakeCache;
+    quint64 _texturesStartTime { 0 };
 };
 
 #endif // hifi_ModelBaker_h
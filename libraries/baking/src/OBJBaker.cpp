@@ -13,6 +13,7 @@
 
 #include <PathUtils.h>
 #include <NetworkAccessManager.h>
+#include <SharedUtil.h>
 
 #include "OBJReader.h"
 #include "FBXWriter.h"
@@ -37,6 +38,7 @@ const QByteArray MESH = "Mesh";
 
 void OBJBaker::bake() {
     qDebug() << "OBJBaker" << _modelURL << "bake starting";
+    _bakeStartTime = usecTimestampNow();
 
     // trigger bakeOBJ once OBJ is loaded
     connect(this, &OBJBaker::OBJLoaded, this, &OBJBaker::bakeOBJ);
@@ -134,6 +136,9 @@ void OBJBaker::handleOBJNetworkReply() {
 }
 
 void OBJBaker::bakeOBJ() {
+    auto parseStartTime = usecTimestampNow();
+    _stageTimings.load = parseStartTime - _bakeStartTime;
+
     // Read the OBJ file
     QFile objFile(_originalModelFilePath);
     if (!objFile.open(QIODevice::ReadOnly)) {
@@ -147,6 +152,8 @@ void OBJBaker::bakeOBJ() {
     OBJReader reader;
     auto geometry = reader.readOBJ(objData, QVariantHash(), combineParts, _modelURL);
 
+    _stageTimings.parse = usecTimestampNow() - parseStartTime;
+
     // Write OBJ Data as FBX tree nodes
     createFBXNodeTree(_rootNode, *geometry);
 
@@ -199,7 +206,9 @@ void OBJBaker::createFBXNodeTree(FBXNode& rootNode, FBXGeometry& geometry) {
     // Compress the mesh information and store in dracoNode
     bool hasDeformers = false; // No concept of deformers for an OBJ
     FBXNode dracoNode;
+    auto meshCompressionStartTime = usecTimestampNow();
     compressMesh(geometry.meshes[0], hasDeformers, dracoNode);
+    _stageTimings.meshCompression = usecTimestampNow() - meshCompressionStartTime;
     geometryNode.children.append(dracoNode);
 
     // Generating Object node's child - Model node
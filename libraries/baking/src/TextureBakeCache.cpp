@@ -0,0 +1,45 @@
+//
+//  TextureBakeCache.cpp
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureBakeCache.h"
+
+TextureBakeCache::Key TextureBakeCache::computeKey(const QByteArray& contentHash, image::TextureUsage::Type textureType,
+                                                   bool compressed) {
+    return contentHash + ":" + QByteArray::number((int)textureType) + (compressed ? ":c" : ":u");
+}
+
+TextureBakeCache::Reservation TextureBakeCache::reserve(const Key& key, Result& result) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(key);
+    if (it == _entries.end()) {
+        _entries.insert(key, Entry());
+        ++_misses;
+        return Reservation::Reserved;
+    }
+
+    if (!it->isReady) {
+        return Reservation::Pending;
+    }
+
+    result = it->result;
+    ++_hits;
+    return Reservation::Ready;
+}
+
+void TextureBakeCache::publish(const Key& key, const Result& result) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& entry = _entries[key];
+        entry.isReady = true;
+        entry.result = result;
+    }
+    emit resultPublished(key);
+}
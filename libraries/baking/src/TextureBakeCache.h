@@ -0,0 +1,73 @@
+//
+//  TextureBakeCache.h
+//  libraries/baking/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureBakeCache_h
+#define hifi_TextureBakeCache_h
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QString>
+
+#include <image/Image.h>
+#include <TextureMeta.h>
+
+// TextureBakeCache lets the texture bakers of a whole bake (a domain, for instance) share their results, keyed by
+// the content and usage of the texture rather than its URL, so that a texture used by several models is only
+// compressed once. The first baker to reserve a key bakes the texture, later ones wait for resultPublished and
+// copy its files.
+class TextureBakeCache : public QObject {
+    Q_OBJECT
+
+public:
+    using Key = QByteArray;
+
+    struct Result {
+        bool succeeded { false };
+        std::unordered_map<khronos::gl::texture::InternalFormat, QString> compressedFiles; // absolute file paths
+        QString uncompressedFile;
+    };
+
+    enum class Reservation {
+        Reserved, // the caller is the first to bake this key, it must call publish() once done, even if the bake failed
+        Ready, // the result of the first baker was copied to result
+        Pending // the first baker is still baking, reserve again once resultPublished is emitted for this key
+    };
+
+    static Key computeKey(const QByteArray& contentHash, image::TextureUsage::Type textureType, bool compressed);
+
+    // never blocks, bakers that get Pending should be connected to resultPublished before they reserve
+    Reservation reserve(const Key& key, Result& result);
+    void publish(const Key& key, const Result& result);
+
+    int getHits() const { return _hits; }
+    int getMisses() const { return _misses; }
+
+signals:
+    void resultPublished(QByteArray key);
+
+private:
+    struct Entry {
+        bool isReady { false };
+        Result result;
+    };
+
+    std::mutex _mutex;
+    QHash<Key, Entry> _entries;
+
+    std::atomic<int> _hits { 0 };
+    std::atomic<int> _misses { 0 };
+};
+
+#endif // hifi_TextureBakeCache_h
@@ -18,6 +18,7 @@
 
 #include <image/Image.h>
 #include <ktx/KTX.h>
+#include <Finally.h>
 #include <NetworkAccessManager.h>
 #include <SharedUtil.h>
 #include <TextureMeta.h>
@@ -123,10 +124,8 @@ void TextureBaker::handleTextureNetworkReply() {
 void TextureBaker::processTexture() {
     // the baked textures need to have the source hash added for cache checks in Interface
     // so we add that to the processed texture before handling it off to be serialized
-    auto hashData = QCryptographicHash::hash(_originalTexture, QCryptographicHash::Md5);
-    std::string hash = hashData.toHex().toStdString();
-
-    TextureMeta meta;
+    _originalTextureHash = QCryptographicHash::hash(_originalTexture, QCryptographicHash::Md5);
+    _processingStartTime = usecTimestampNow();
 
     auto originalCopyFilePath = _outputDirectory.absoluteFilePath(_textureURL.fileName());
     {
@@ -138,9 +137,73 @@ void TextureBaker::processTexture() {
         // IMPORTANT: _originalTexture is empty past this point
         _originalTexture.clear();
         _outputFiles.push_back(originalCopyFilePath);
-        meta.original = _metaTexturePathPrefix + _textureURL.fileName();
+        _meta.original = _metaTexturePathPrefix + _textureURL.fileName();
+    }
+
+    if (_bakeCache) {
+        // if another baker is baking the same content, copy its files instead of compressing the texture again,
+        // listen for its result before reserving so that it can't be published in between
+        _bakeCacheKey = TextureBakeCache::computeKey(_originalTextureHash, _textureType, _compressionEnabled);
+        connect(_bakeCache.get(), &TextureBakeCache::resultPublished, this,
+                &TextureBaker::handleBakeCacheResultPublished, Qt::QueuedConnection);
+        reserveInBakeCache();
+    } else {
+        compressTexture();
+    }
+}
+
+void TextureBaker::handleBakeCacheResultPublished(QByteArray key) {
+    if (key != _bakeCacheKey) {
+        return;
+    }
+
+    if (shouldStop()) {
+        disconnect(_bakeCache.get(), nullptr, this, nullptr);
+        return;
     }
 
+    reserveInBakeCache();
+}
+
+void TextureBaker::reserveInBakeCache() {
+    TextureBakeCache::Result cacheResult;
+    auto reservation = _bakeCache->reserve(_bakeCacheKey, cacheResult);
+    if (reservation == TextureBakeCache::Reservation::Pending) {
+        // handleBakeCacheResultPublished calls back once the first baker of this content is done
+        return;
+    }
+
+    disconnect(_bakeCache.get(), nullptr, this, nullptr);
+
+    if (reservation == TextureBakeCache::Reservation::Ready && cacheResult.succeeded &&
+        copyCachedResult(cacheResult, _meta)) {
+        qCDebug(model_baking) << "Re-used baked texture with the same content for" << _textureURL;
+        _processingTime = usecTimestampNow() - _processingStartTime;
+        writeMetaTexture(_meta);
+        return;
+    }
+
+    // the first baker of this content publishes its result, others that couldn't re-use it bake the texture themselves
+    _isReservedInBakeCache = (reservation == TextureBakeCache::Reservation::Reserved);
+    compressTexture();
+}
+
+void TextureBaker::compressTexture() {
+    std::string hash = _originalTextureHash.toHex().toStdString();
+
+    Finally recordProcessingTime([&] {
+        _processingTime = usecTimestampNow() - _processingStartTime;
+    });
+
+    // whether or not this bake succeeds, let the bakers waiting on the same content know it is done
+    TextureBakeCache::Result cacheResult;
+    Finally publishCacheResult([&] {
+        if (_isReservedInBakeCache) {
+            _bakeCache->publish(_bakeCacheKey, cacheResult);
+        }
+    });
+
+    auto originalCopyFilePath = _outputDirectory.absoluteFilePath(_textureURL.fileName());
     auto buffer = std::static_pointer_cast<QIODevice>(std::make_shared<QFile>(originalCopyFilePath));
     if (!buffer->open(QIODevice::ReadOnly)) {
         handleError("Could not open original file at " + originalCopyFilePath);
@@ -190,7 +253,8 @@ void TextureBaker::processTexture() {
                 return;
             }
             _outputFiles.push_back(filePath);
-            meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = _metaTexturePathPrefix + fileName;
+            _meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = _metaTexturePathPrefix + fileName;
+            cacheResult.compressedFiles[memKTX->_header.getGLInternaFormat()] = filePath;
         }
     }
 
@@ -226,21 +290,61 @@ void TextureBaker::processTexture() {
             return;
         }
         _outputFiles.push_back(filePath);
-        meta.uncompressed = _metaTexturePathPrefix + fileName;
+        _meta.uncompressed = _metaTexturePathPrefix + fileName;
+        cacheResult.uncompressedFile = filePath;
     } else {
         buffer.reset();
     }
 
-    {
-        auto data = meta.serialize();
-        _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
-        QFile file { _metaTextureFileName };
-        if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
-            handleError("Could not write meta texture for " + _textureURL.toString());
-        } else {
-            _outputFiles.push_back(_metaTextureFileName);
+    cacheResult.succeeded = true;
+    writeMetaTexture(_meta);
+}
+
+bool TextureBaker::copyCachedResult(const TextureBakeCache::Result& result, TextureMeta& meta) {
+    // the files are named after this baker's texture, the same way processTexture names them
+    std::vector<std::pair<QString, QString>> copies;
+    for (const auto& compressedFile : result.compressedFiles) {
+        const char* name = khronos::gl::texture::toString(compressedFile.first);
+        auto fileName = _baseFilename + "_" + name + ".ktx";
+        copies.emplace_back(compressedFile.second, fileName);
+    }
+    if (!result.uncompressedFile.isEmpty()) {
+        copies.emplace_back(result.uncompressedFile, _baseFilename + ".ktx");
+    }
+
+    std::vector<QString> copiedFiles;
+    for (const auto& copy : copies) {
+        auto filePath = _outputDirectory.absoluteFilePath(copy.second);
+        if (filePath != copy.first) {
+            QFile::remove(filePath);
+            if (!QFile::copy(copy.first, filePath)) {
+                qCWarning(model_baking) << "Could not copy baked texture" << copy.first << "to" << filePath;
+                return false;
+            }
         }
+        copiedFiles.push_back(filePath);
+    }
+
+    _outputFiles.insert(_outputFiles.end(), copiedFiles.begin(), copiedFiles.end());
+    for (const auto& compressedFile : result.compressedFiles) {
+        const char* name = khronos::gl::texture::toString(compressedFile.first);
+        meta.availableTextureTypes[compressedFile.first] = _metaTexturePathPrefix + _baseFilename + "_" + name + ".ktx";
+    }
+    if (!result.uncompressedFile.isEmpty()) {
+        meta.uncompressed = _metaTexturePathPrefix + _baseFilename + ".ktx";
+    }
+    return true;
+}
+
+void TextureBaker::writeMetaTexture(TextureMeta& meta) {
+    auto data = meta.serialize();
+    _metaTextureFileName = _outputDirectory.absoluteFilePath(_baseFilename + BAKED_META_TEXTURE_SUFFIX);
+    QFile file { _metaTextureFileName };
+    if (!file.open(QIODevice::WriteOnly) || file.write(data) == -1) {
+        handleError("Could not write meta texture for " + _textureURL.toString());
+        return;
     }
+    _outputFiles.push_back(_metaTextureFileName);
 
     qCDebug(model_baking) << "Baked texture" << _textureURL;
     setIsFinished(true);
@@ -21,6 +21,7 @@
 #include <image/Image.h>
 
 #include "Baker.h"
+#include "TextureBakeCache.h"
 
 extern const QString BAKED_TEXTURE_KTX_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
@@ -43,6 +44,12 @@ public:
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
 
+    // share the results of this bake with the other bakers using the same cache, see TextureBakeCache
+    void setBakeCache(std::shared_ptr<TextureBakeCache> bakeCache) { _bakeCache = bakeCache; }
+
+    // time spent processing the loaded texture, in usecs, including waiting for another baker of the same content
+    quint64 getProcessingTime() const { return _processingTime; }
+
 public slots:
     virtual void bake() override;
     virtual void abort() override; 
@@ -52,22 +59,36 @@ signals:
 
 private slots:
     void processTexture();
+    void handleBakeCacheResultPublished(QByteArray key);
 
 private:
     void loadTexture();
     void handleTextureNetworkReply();
 
+    void reserveInBakeCache();
+    void compressTexture();
+    bool copyCachedResult(const TextureBakeCache::Result& result, TextureMeta& meta);
+    void writeMetaTexture(TextureMeta& meta);
+
     QUrl _textureURL;
     QByteArray _originalTexture;
+    QByteArray _originalTextureHash;
     image::TextureUsage::Type _textureType;
 
     QString _baseFilename;
     QDir _outputDirectory;
     QString _metaTextureFileName;
     QString _metaTexturePathPrefix;
+    TextureMeta _meta;
 
     std::atomic<bool> _abortProcessing { false };
 
+    std::shared_ptr<TextureBakeCache> _bakeCache;
+    TextureBakeCache::Key _bakeCacheKey;
+    bool _isReservedInBakeCache { false };
+    quint64 _processingStartTime { 0 };
+    quint64 _processingTime { 0 };
+
     static bool _compressionEnabled;
 };
 
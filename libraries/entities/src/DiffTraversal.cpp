@@ -11,7 +11,10 @@
 
 #include "DiffTraversal.h"
 
+#include <algorithm>
+
 #include <OctreeUtils.h>
+#include <TBBHelpers.h>
 
 #include "EntityPriorityQueue.h"
 
@@ -234,6 +237,7 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     }
 
     _path.clear();
+    _parallelSubtrees.clear();
     _path.push_back(DiffTraversal::Waypoint(root));
     // set root fork's index such that root element returned at getNextElement()
     _path.back().initRootNextIndex();
@@ -296,3 +300,106 @@ void DiffTraversal::traverse(uint64_t timeBudget) {
         getNextVisibleElement(next);
     }
 }
+
+// Scans a subtree depth first until expiry, and leaves whatever it didn't get to in unscanned. The root of the subtree is
+// scanned whatever the time, when mustStart is set, so that a pass always makes progress.
+static void scanSubtreeFirstTime(const EntityTreeElementPointer& subtree, const DiffTraversal::View& view, uint64_t expiry,
+        bool mustStart, const DiffTraversal::FragmentScanCallback& scanCallback, EntityPriorityQueue& fragment,
+        std::vector<EntityTreeElementPointer>& unscanned) {
+    std::vector<EntityTreeElementPointer> stack { subtree };
+    bool started = false;
+    while (!stack.empty()) {
+        if ((started || !mustStart) && usecTimestampNow() > expiry) {
+            unscanned.insert(unscanned.end(), stack.begin(), stack.end());
+            return;
+        }
+        started = true;
+
+        EntityTreeElementPointer element = std::move(stack.back());
+        stack.pop_back();
+        if (element->hasContent()) {
+            DiffTraversal::VisibleElement next;
+            next.element = element;
+            scanCallback(next, fragment);
+        }
+        for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+            EntityTreeElementPointer child = element->getChildAtIndex(i);
+            if (child && view.shouldTraverseElement(*child)) {
+                stack.push_back(child);
+            }
+        }
+    }
+}
+
+void DiffTraversal::traverseFirstInParallel(uint64_t timeBudget, const FragmentScanCallback& scanCallback,
+                                            EntityPriorityQueue& sendQueue) {
+    if (_path.empty()) {
+        return;
+    }
+
+    if (_parallelSubtrees.empty()) {
+        // only valid on a First traversal that hasn't started yet: the path holds just the root waypoint
+        assert(_path.size() == 1 && _path.back().getNextIndex() == -1);
+        EntityTreeElementPointer root = _path.back().getElement();
+        if (!root) {
+            _path.clear();
+            return;
+        }
+
+        // expand the top of the tree breadth-first on this thread until there are enough subtrees to keep the workers
+        // busy (the root is always visited, exactly like getNextVisibleElementFirstTime)
+        const size_t MIN_PARALLEL_SUBTREES = 64;
+        const int32_t MAX_SERIAL_DEPTH = 3;
+        std::vector<EntityTreeElementPointer> subtrees { root };
+        for (int32_t depth = 0; depth < MAX_SERIAL_DEPTH && !subtrees.empty() && subtrees.size() < MIN_PARALLEL_SUBTREES; ++depth) {
+            std::vector<EntityTreeElementPointer> nextLevel;
+            nextLevel.reserve(subtrees.size() * NUMBER_OF_CHILDREN);
+            for (const auto& element : subtrees) {
+                if (element->hasContent()) {
+                    VisibleElement next;
+                    next.element = element;
+                    scanCallback(next, sendQueue);
+                }
+                for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+                    EntityTreeElementPointer child = element->getChildAtIndex(i);
+                    if (child && _currentView.shouldTraverseElement(*child)) {
+                        nextLevel.push_back(child);
+                    }
+                }
+            }
+            subtrees.swap(nextLevel);
+        }
+
+        _parallelSubtrees.assign(subtrees.begin(), subtrees.end());
+    }
+
+    // Every pending subtree is handed to the worker pool at once, and each worker stops at the first element it reaches
+    // after the time budget runs out, so a pass overruns the budget by about one element scan. What wasn't scanned is
+    // picked up on the next pass. The tree lock is released between passes, so the tree can change under the pending
+    // subtrees, which is why they are held weakly.
+    uint64_t expiry = usecTimestampNow() + timeBudget;
+    const View& view = _currentView;
+    size_t numSubtrees = _parallelSubtrees.size();
+    std::vector<EntityPriorityQueue> fragments(numSubtrees);
+    std::vector<std::vector<EntityTreeElementPointer>> unscanned(numSubtrees);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, numSubtrees, 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            EntityTreeElementPointer subtree = _parallelSubtrees[i].lock();
+            if (subtree) {
+                scanSubtreeFirstTime(subtree, view, expiry, i == 0, scanCallback, fragments[i], unscanned[i]);
+            }
+        }
+    });
+
+    _parallelSubtrees.clear();
+    for (size_t i = 0; i < numSubtrees; ++i) {
+        sendQueue.merge(fragments[i]);
+        _parallelSubtrees.insert(_parallelSubtrees.end(), unscanned[i].begin(), unscanned[i].end());
+    }
+
+    if (_parallelSubtrees.empty()) {
+        // we've traversed the entire tree
+        _path.clear();
+        _completedView = _currentView;
+    }
+}
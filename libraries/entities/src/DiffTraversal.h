@@ -16,6 +16,8 @@
 
 #include "EntityTreeElement.h"
 
+class EntityPriorityQueue;
+
 // DiffTraversal traverses the tree and applies _scanElementCallback on elements it finds
 class DiffTraversal {
 public:
@@ -49,6 +51,7 @@ public:
         void getNextVisibleElementRepeat(VisibleElement& next, const View& view, uint64_t lastTime);
         void getNextVisibleElementDifferential(VisibleElement& next, const View& view, const View& lastView);
 
+        EntityTreeElementPointer getElement() const { return _weakElement.lock(); }
         int8_t getNextIndex() const { return _nextIndex; }
         void initRootNextIndex() { _nextIndex = -1; }
 
@@ -59,6 +62,9 @@ public:
 
     typedef enum { First, Repeat, Differential } Type;
 
+    // scans one element into a queue fragment owned by the calling worker thread
+    using FragmentScanCallback = std::function<void (VisibleElement&, EntityPriorityQueue&)>;
+
     DiffTraversal();
 
     Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root);
@@ -71,7 +77,14 @@ public:
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
-    void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
+    // Runs a freshly prepared First traversal for up to timeBudget usecs, and picks it up again on the next call.
+    // The subtrees below the top levels of the tree are fanned out across the worker pool, each worker scans into its
+    // own EntityPriorityQueue fragment until the budget runs out, and the fragments are then merged into sendQueue.
+    // The caller must hold the tree read lock for the duration of each call.
+    void traverseFirstInParallel(uint64_t timeBudget, const FragmentScanCallback& scanCallback, EntityPriorityQueue& sendQueue);
+
+    // resets our state to force a new "First" traversal
+    void reset() { _path.clear(); _parallelSubtrees.clear(); _completedView.startTime = 0; }
 
 private:
     void getNextVisibleElement(VisibleElement& next);
@@ -79,8 +92,9 @@ private:
     View _currentView;
     View _completedView;
     std::vector<Waypoint> _path;
+    std::vector<EntityTreeElementWeakPointer> _parallelSubtrees; // subtrees a parallel First traversal has yet to scan
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
 };
 
-#endif // hifi_EntityPriorityQueue_h
+#endif // hifi_DiffTraversal_h
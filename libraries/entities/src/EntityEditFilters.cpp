@@ -14,6 +14,52 @@
 #include <QUrl>
 
 #include <ResourceManager.h>
+#include <SharedUtil.h>
+
+// true if any of the properties in flags are also in otherFlags
+static bool hasAnyProperty(const EntityPropertyFlags& flags, const EntityPropertyFlags& otherFlags) {
+    for (int flag = (int)flags.firstFlag(); flag <= (int)flags.lastFlag(); flag++) {
+        if (flags.getHasProperty((EntityPropertyList)flag) && otherFlags.getHasProperty((EntityPropertyList)flag)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// true if all of the properties in flags are also in otherFlags
+static bool hasOnlyProperties(const EntityPropertyFlags& flags, const EntityPropertyFlags& otherFlags) {
+    for (int flag = (int)flags.firstFlag(); flag <= (int)flags.lastFlag(); flag++) {
+        if (flags.getHasProperty((EntityPropertyList)flag) && !otherFlags.getHasProperty((EntityPropertyList)flag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EntityEditFilters::EditRateLimiter::allowEdit(const EntityItemID& entityID, float maxEditsPerSecond, quint64 now) {
+    const quint64 WINDOW_USECS = USECS_PER_SECOND;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // forget entities that have not been edited recently, so the table doesn't grow without bound. Windows are queued
+    // in the order they started, so only the expired ones at the front are ever looked at.
+    while (!_windowStarts.empty() && now - _windowStarts.front().first > WINDOW_USECS) {
+        auto itr = _windows.find(_windowStarts.front().second);
+        if (itr != _windows.end() && itr.value().start == _windowStarts.front().first) {
+            _windows.erase(itr);
+        }
+        _windowStarts.pop_front();
+    }
+
+    Window& window = _windows[entityID];
+    if (now - window.start > WINDOW_USECS) {
+        window.start = now;
+        window.edits = 0;
+        _windowStarts.emplace_back(now, entityID);
+    }
+    window.edits++;
+    return window.edits <= maxEditsPerSecond;
+}
 
 QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
     QList<EntityItemID> zones;
@@ -43,7 +89,69 @@ QList<EntityItemID> EntityEditFilters::getZonesByPosition(glm::vec3& position) {
 
 bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
         bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, EntityItemPointer& existingEntity) {
-    
+    quint64 startTime = usecTimestampNow();
+    bool calledScript = false;
+    bool accepted = runFilters(position, propertiesIn, propertiesOut, wasChanged, filterType, itemID, existingEntity, calledScript);
+    quint64 elapsed = usecTimestampNow() - startTime;
+    if (calledScript) {
+        _editsWithScript++;
+        _editsWithScriptTime += elapsed;
+    } else {
+        _editsWithoutScript++;
+        _editsWithoutScriptTime += elapsed;
+    }
+    return accepted;
+}
+
+EntityEditFilters::Stats EntityEditFilters::getStats() const {
+    Stats stats;
+    stats.editsWithoutScript = _editsWithoutScript;
+    stats.editsWithoutScriptTime = _editsWithoutScriptTime;
+    stats.editsWithScript = _editsWithScript;
+    stats.editsWithScriptTime = _editsWithScriptTime;
+    stats.skippedScriptCalls = _skippedScriptCalls;
+    stats.scriptCalls = _scriptCalls;
+    stats.rejectedByRules = _rejectedByRules;
+    return stats;
+}
+
+bool EntityEditFilters::applyRules(FilterData& filterData, EntityItemProperties& propertiesIn,
+        EntityItemProperties& propertiesOut, bool& wasChanged, EntityTree::FilterType filterType,
+        const EntityItemID& itemID) {
+    if (filterType == EntityTree::FilterType::Delete) {
+        return true;
+    }
+
+    // adds set up a whole new entity, and physics edits come from the simulation, so only edits are restricted
+    if (filterData.wantsAllowedProperties && filterType == EntityTree::FilterType::Edit &&
+            !hasOnlyProperties(propertiesIn.getChangedProperties(), filterData.allowedProperties)) {
+        return false;
+    }
+
+    // only edits are rate limited: adds have no entity ID yet, and physics edits carry the simulation owner's updates,
+    // which would leave the entity out of sync with the simulation if they were dropped
+    if (filterData.maxEditsPerSecond > 0.0f && filterData.rateLimiter && filterType == EntityTree::FilterType::Edit &&
+            !filterData.rateLimiter->allowEdit(itemID, filterData.maxEditsPerSecond, usecTimestampNow())) {
+        return false;
+    }
+
+    if (filterData.wantsPositionClamp && propertiesIn.containsPositionChange()) {
+        glm::vec3 position = propertiesIn.getPosition();
+        glm::vec3 clampedPosition = glm::clamp(position, filterData.positionClamp.getMinimumPoint(),
+                                               filterData.positionClamp.getMaximumPoint());
+        if (clampedPosition != position) {
+            propertiesIn.setPosition(clampedPosition);
+            propertiesOut.setPosition(clampedPosition);
+            wasChanged = true;
+        }
+    }
+    return true;
+}
+
+bool EntityEditFilters::runFilters(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
+        bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& itemID, EntityItemPointer& existingEntity,
+        bool& calledScript) {
+
     // get the ids of all the zones (plus the global entity edit filter) that the position
     // lies within
     auto zoneIDs = getZonesByPosition(position);
@@ -72,8 +180,22 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return true; // accept the message
             }
 
-            auto oldProperties = propertiesIn.getDesiredProperties();
+            if (!applyRules(filterData, propertiesIn, propertiesOut, wasChanged, filterType, itemID)) {
+                _rejectedByRules++;
+                return false;
+            }
+
             auto specifiedProperties = propertiesIn.getChangedProperties();
+
+            // edits that don't touch any of the properties the filter inspects never need to reach the script
+            if (!filterData.wantsAllProperties &&
+                (filterType == EntityTree::FilterType::Edit || filterType == EntityTree::FilterType::Physics) &&
+                !hasAnyProperty(specifiedProperties, filterData.includedInputProperties)) {
+                _skippedScriptCalls++;
+                continue;
+            }
+
+            auto oldProperties = propertiesIn.getDesiredProperties();
             propertiesIn.setDesiredProperties(specifiedProperties);
             QScriptValue inputValues = propertiesIn.copyToScriptValue(filterData.engine, false, true, true);
             propertiesIn.setDesiredProperties(oldProperties);
@@ -129,6 +251,8 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
             }
 
             QScriptValue result = filterData.filterFn.call(_nullObjectForFilter, args);
+            calledScript = true;
+            _scriptCalls++;
 
             if (filterData.uncaughtExceptions()) {
                 return false;
@@ -150,9 +274,8 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                     return false;
                 }
 
-                // otherwise, assume it wants to pass all properties
+                // otherwise, assume it wants to pass all properties (as already changed by any earlier filters or rules)
                 propertiesOut = propertiesIn;
-                wasChanged = false;
                 
             } else {
                 return false;
@@ -300,6 +423,38 @@ void EntityEditFilters::scriptRequestFinished(EntityItemID entityID) {
                 QScriptValue wantsToFilterDeleteValue = filterData.filterFn.property("wantsToFilterDelete");
                 filterData.wantsToFilterDelete = wantsToFilterDeleteValue.isBool() ? wantsToFilterDeleteValue.toBool() : false;
 
+                // check to see if the filterFn lists the properties it inspects. If it does, edits that don't change
+                // any of those properties are accepted without calling the filter function.
+                QScriptValue wantsPropertiesValue = filterData.filterFn.property("wantsProperties");
+                if (wantsPropertiesValue.isString() || wantsPropertiesValue.isArray()) {
+                    EntityPropertyFlagsFromScriptValue(wantsPropertiesValue, filterData.includedInputProperties);
+                    filterData.wantsAllProperties = false;
+                }
+
+                // declarative rules that are evaluated natively, before the filter function is called:
+                //   - clampPosition - { min: vec3, max: vec3 } - positions outside the box are clamped to it
+                //   - allowedProperties - string or list of strings - edits (not adds) changing any other property are rejected
+                //   - maxEditsPerSecond - number - edits (not adds or physics updates) of an entity beyond this rate are rejected
+                QScriptValue clampPositionValue = filterData.filterFn.property("clampPosition");
+                if (clampPositionValue.isObject()) {
+                    glm::vec3 minimum;
+                    glm::vec3 maximum;
+                    vec3FromScriptValue(clampPositionValue.property("min"), minimum);
+                    vec3FromScriptValue(clampPositionValue.property("max"), maximum);
+                    filterData.positionClamp = AABox(glm::min(minimum, maximum), glm::abs(maximum - minimum));
+                    filterData.wantsPositionClamp = true;
+                }
+                QScriptValue allowedPropertiesValue = filterData.filterFn.property("allowedProperties");
+                if (allowedPropertiesValue.isString() || allowedPropertiesValue.isArray()) {
+                    EntityPropertyFlagsFromScriptValue(allowedPropertiesValue, filterData.allowedProperties);
+                    filterData.wantsAllowedProperties = true;
+                }
+                QScriptValue maxEditsPerSecondValue = filterData.filterFn.property("maxEditsPerSecond");
+                if (maxEditsPerSecondValue.isNumber() && maxEditsPerSecondValue.toNumber() > 0.0) {
+                    filterData.maxEditsPerSecond = (float)maxEditsPerSecondValue.toNumber();
+                    filterData.rateLimiter = std::make_shared<EditRateLimiter>();
+                }
+
                 // check to see if the filterFn has properties asking for Original props
                 QScriptValue wantsOriginalPropertiesValue = filterData.filterFn.property("wantsOriginalProperties");
                 // if the wantsOriginalProperties is a boolean, or a string, or list of strings, then evaluate as follows:
@@ -12,12 +12,17 @@
 #define hifi_EntityEditFilters_h
 
 #include <QObject>
+#include <QHash>
 #include <QMap>
 #include <QScriptValue>
 #include <QScriptEngine>
 #include <glm/glm.hpp>
 
+#include <atomic>
+#include <deque>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -26,6 +31,22 @@
 class EntityEditFilters : public QObject, public Dependency {
     Q_OBJECT
 public:
+    // counts edits per entity over one second windows, for filters that set maxEditsPerSecond
+    class EditRateLimiter {
+    public:
+        bool allowEdit(const EntityItemID& entityID, float maxEditsPerSecond, quint64 now);
+
+    private:
+        struct Window {
+            quint64 start { 0 };
+            int edits { 0 };
+        };
+
+        std::mutex _mutex;
+        QHash<EntityItemID, Window> _windows;
+        std::deque<std::pair<quint64, EntityItemID>> _windowStarts; // oldest first
+    };
+
     struct FilterData {
         QScriptValue filterFn;
         bool wantsOriginalProperties { false };
@@ -40,6 +61,18 @@ public:
         EntityPropertyFlags includedZoneProperties;
         bool wantsZoneBoundingBox { false };
 
+        // when false, only edits that change one of the includedInputProperties are passed to the filter function
+        bool wantsAllProperties { true };
+        EntityPropertyFlags includedInputProperties;
+
+        // declarative rules, evaluated natively before the filter function is called
+        bool wantsPositionClamp { false };
+        AABox positionClamp;
+        bool wantsAllowedProperties { false };
+        EntityPropertyFlags allowedProperties;
+        float maxEditsPerSecond { 0.0f }; // 0 means no rate limit
+        std::shared_ptr<EditRateLimiter> rateLimiter;
+
         std::function<bool()> uncaughtExceptions;
         QScriptEngine* engine;
         bool rejectAll;
@@ -48,6 +81,17 @@ public:
         bool valid() { return (rejectAll || (engine != nullptr && filterFn.isFunction() && uncaughtExceptions)); }
     };
 
+    // edit throughput, split by whether the edit had to be run through a filter script
+    struct Stats {
+        quint64 editsWithoutScript { 0 };
+        quint64 editsWithoutScriptTime { 0 }; // usecs
+        quint64 editsWithScript { 0 };
+        quint64 editsWithScriptTime { 0 }; // usecs
+        quint64 skippedScriptCalls { 0 };
+        quint64 scriptCalls { 0 };
+        quint64 rejectedByRules { 0 };
+    };
+
     EntityEditFilters() {};
     EntityEditFilters(EntityTreePointer tree ): _tree(tree) {};
 
@@ -57,6 +101,13 @@ public:
     bool filter(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, 
                 EntityTree::FilterType filterType, EntityItemID& entityID, EntityItemPointer& existingEntity);
 
+    Stats getStats() const;
+
+    // the declarative rules of filterData, evaluated natively before the filter function is called. Returns false to
+    // reject the edit, propertiesIn and propertiesOut are changed in place by the position clamp.
+    static bool applyRules(FilterData& filterData, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
+                           bool& wasChanged, EntityTree::FilterType filterType, const EntityItemID& entityID);
+
 signals:
     void filterAdded(EntityItemID id, bool success);
 
@@ -65,6 +116,9 @@ private slots:
     
 private:
     QList<EntityItemID> getZonesByPosition(glm::vec3& position);
+    bool runFilters(glm::vec3& position, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut,
+                    bool& wasChanged, EntityTree::FilterType filterType, EntityItemID& entityID,
+                    EntityItemPointer& existingEntity, bool& calledScript);
 
     EntityTreePointer _tree {};
     bool _rejectAll {false};
@@ -72,6 +126,14 @@ private:
     
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
+
+    std::atomic<quint64> _editsWithoutScript { 0 };
+    std::atomic<quint64> _editsWithoutScriptTime { 0 };
+    std::atomic<quint64> _editsWithScript { 0 };
+    std::atomic<quint64> _editsWithScriptTime { 0 };
+    std::atomic<quint64> _skippedScriptCalls { 0 };
+    std::atomic<quint64> _scriptCalls { 0 };
+    std::atomic<quint64> _rejectedByRules { 0 };
 };
 
 #endif //hifi_EntityEditFilters_h
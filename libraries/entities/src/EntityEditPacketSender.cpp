@@ -80,10 +80,8 @@ void EntityEditPacketSender::queueEditAvatarEntityMessage(PacketType type,
 }
 
 
-void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
-                                                    EntityTreePointer entityTree,
-                                                    EntityItemID entityItemID,
-                                                    const EntityItemProperties& properties) {
+bool EntityEditPacketSender::shouldSendToEntityServer(PacketType type, EntityTreePointer entityTree,
+                                                      EntityItemID entityItemID, const EntityItemProperties& properties) {
     if (properties.getClientOnly()) {
         if (!_myAvatar) {
             qCWarning(entities) << "Suppressing entity edit message: cannot send clientOnly edit with no myAvatar";
@@ -93,14 +91,20 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         } else {
             qCWarning(entities) << "Suppressing entity edit message: cannot send clientOnly edit for another avatar";
         }
-        return;
+        return false;
     }
 
     if (entityTree && entityTree->isServerlessMode()) {
         // if we are in a serverless domain, don't send edit packets
-        return;
+        return false;
     }
 
+    return true;
+}
+
+void EntityEditPacketSender::encodeEditEntityMessage(PacketType type, EntityItemID entityItemID,
+                                                     const EntityItemProperties& properties,
+                                                     std::vector<EditMessagePair>& editMessages) {
     QByteArray bufferOut(NLPacket::maxPayloadSize(type), 0);
 
     if (type == PacketType::EntityAdd) {
@@ -131,10 +135,7 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
                 qCDebug(entities) << "    properties:" << properties;
             #endif
 
-            queueOctreeEditMessage(type, bufferOut);
-            if (type == PacketType::EntityAdd && !properties.getCertificateID().isEmpty()) {
-                emit addingEntityWithCertificate(properties.getCertificateID(), DependencyManager::get<AddressManager>()->getPlaceName());
-            }
+            editMessages.emplace_back(type, bufferOut);
         }
 
         // if we still have properties to send, switch the message type to edit, and request only the packets that didn't fit
@@ -147,6 +148,39 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
     }
 }
 
+void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
+                                                    EntityTreePointer entityTree,
+                                                    EntityItemID entityItemID,
+                                                    const EntityItemProperties& properties) {
+    if (!shouldSendToEntityServer(type, entityTree, entityItemID, properties)) {
+        return;
+    }
+
+    std::vector<EditMessagePair> editMessages;
+    encodeEditEntityMessage(type, entityItemID, properties, editMessages);
+
+    for (auto& editMessage : editMessages) {
+        queueOctreeEditMessage(editMessage.first, editMessage.second);
+        if (editMessage.first == PacketType::EntityAdd && !properties.getCertificateID().isEmpty()) {
+            emit addingEntityWithCertificate(properties.getCertificateID(), DependencyManager::get<AddressManager>()->getPlaceName());
+        }
+    }
+}
+
+void EntityEditPacketSender::queueEditEntityMessages(EntityTreePointer entityTree, const EntityEdits& edits) {
+    std::vector<EditMessagePair> editMessages;
+    editMessages.reserve(edits.size());
+    for (auto& edit : edits) {
+        if (shouldSendToEntityServer(PacketType::EntityEdit, entityTree, edit.first, edit.second)) {
+            encodeEditEntityMessage(PacketType::EntityEdit, edit.first, edit.second, editMessages);
+        }
+    }
+
+    if (!editMessages.empty()) {
+        queueOctreeEditMessages(editMessages);
+    }
+}
+
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
@@ -15,6 +15,7 @@
 #include <OctreeEditPacketSender.h>
 
 #include <mutex>
+#include <vector>
 
 #include "EntityItem.h"
 #include "AvatarData.h"
@@ -35,6 +36,10 @@ public:
     void queueEditEntityMessage(PacketType type, EntityTreePointer entityTree,
                                 EntityItemID entityItemID, const EntityItemProperties& properties);
 
+    /// Queues the edit messages for several entities at once, they are packed together under a single lock.
+    using EntityEdits = std::vector<std::pair<EntityItemID, EntityItemProperties>>;
+    void queueEditEntityMessages(EntityTreePointer entityTree, const EntityEdits& edits);
+
 
     void queueEraseEntityMessage(const EntityItemID& entityItemID);
     void queueCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID);
@@ -50,6 +55,11 @@ public slots:
     void processEntityEditNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
 private:
+    // handles the edits of avatar entities and serverless domains, which don't go to the entity server
+    bool shouldSendToEntityServer(PacketType type, EntityTreePointer entityTree,
+                                  EntityItemID entityItemID, const EntityItemProperties& properties);
+    void encodeEditEntityMessage(PacketType type, EntityItemID entityItemID, const EntityItemProperties& properties,
+                                 std::vector<EditMessagePair>& editMessages);
     void queueEditAvatarEntityMessage(PacketType type, EntityTreePointer entityTree,
                                       EntityItemID entityItemID, const EntityItemProperties& properties);
 
@@ -73,6 +73,18 @@ public:
         assert(_queue.size() == _entities.size());
     }
 
+    // moves every entry of other into this queue, keeping the existing entry for entities already queued here
+    inline void merge(EntityPriorityQueue& other) {
+        while (!other.empty()) {
+            const PrioritizedEntity& entry = other.top();
+            EntityItemPointer entity = entry.getEntity();
+            if (entity && !contains(entity.get())) {
+                emplace(entity, entry.getPriority(), entry.shouldForceRemove());
+            }
+            other.pop();
+        }
+    }
+
     inline void swap(EntityPriorityQueue& other) {
         std::swap(_queue, other._queue);
         std::swap(_entities, other._entities);
@@ -29,6 +29,7 @@
 #include "EntityDynamicInterface.h"
 #include "EntitySimulation.h"
 #include "EntityTree.h"
+#include "LazyEntityPropertiesClass.h"
 #include "LightEntityItem.h"
 #include "ModelEntityItem.h"
 #include "QVariantGLM.h"
@@ -399,6 +400,20 @@ EntityItemProperties EntityScriptingInterface::getEntityProperties(QUuid identit
     return convertPropertiesToScriptSemantics(results, scalesWithParent);
 }
 
+QScriptValue EntityScriptingInterface::getLazyEntityProperties(QScriptContext* context, QScriptEngine* engine) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QUuid entityID(context->argument(0).toString());
+    EntityPropertyFlags desiredProperties;
+    if (context->argumentCount() > 1) {
+        EntityItemProperties::entityPropertyFlagsFromScriptValue(context->argument(1), desiredProperties);
+    }
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    EntityItemProperties properties = entityScriptingInterface->getEntityProperties(entityID, desiredProperties);
+    return LazyEntityPropertiesClass::getForEngine(engine)->newInstance(properties);
+}
+
 QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties& scriptSideProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
@@ -419,40 +434,7 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
 
     bool updatedEntity = false;
     _entityTree->withWriteLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
-        }
-
-        if (entity->getClientOnly() && entity->getOwningAvatarID() != nodeList->getSessionUUID()) {
-            // don't edit other avatar's avatarEntities
-            return;
-        }
-
-        if (scriptSideProperties.parentRelatedPropertyChanged()) {
-            // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
-            // If any of these changed, pull any missing properties from the entity.
-
-            if (!scriptSideProperties.parentIDChanged()) {
-                properties.setParentID(entity->getParentID());
-            }
-            if (!scriptSideProperties.parentJointIndexChanged()) {
-                properties.setParentJointIndex(entity->getParentJointIndex());
-            }
-            if (!scriptSideProperties.localPositionChanged() && !scriptSideProperties.positionChanged()) {
-                properties.setPosition(entity->getWorldPosition());
-            }
-            if (!scriptSideProperties.localRotationChanged() && !scriptSideProperties.rotationChanged()) {
-                properties.setRotation(entity->getWorldOrientation());
-            }
-            if (!scriptSideProperties.localDimensionsChanged() && !scriptSideProperties.dimensionsChanged()) {
-                properties.setDimensions(entity->getScaledDimensions());
-            }
-        }
-        properties.setClientOnly(entity->getClientOnly());
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
-        properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
-        updatedEntity = _entityTree->updateEntity(entityID, properties);
+        updatedEntity = updateLocalEntity(entityID, scriptSideProperties, properties);
     });
 
     // FIXME: We need to figure out a better way to handle this. Allowing these edits to go through potentially
@@ -465,107 +447,228 @@ QUuid EntityScriptingInterface::editEntity(QUuid id, const EntityItemProperties&
     // }
 
     bool entityFound { false };
+    EntityEditPacketSender::EntityEdits edits;
     _entityTree->withReadLock([&] {
-        EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            entityFound = true;
-            // make sure the properties has a type, so that the encode can know which properties to include
-            properties.setType(entity->getType());
-            bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
-            bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
-            if (_bidOnSimulationOwnership && hasPhysicsChanges) {
-                auto nodeList = DependencyManager::get<NodeList>();
-                const QUuid myNodeID = nodeList->getSessionUUID();
+        entityFound = prepareEntityEdit(entityID, properties, edits);
+    });
+    if (!entityFound && isNonEntityID(id)) {
+        // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
+        // print a warning and don't send an edit packet to the entity-server.
+        return QUuid(); // null script value to indicate failure
+    }
+    // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
+    // to edit entities they know only by ID.
+    edits.emplace_back(entityID, properties);
+    getEntityPacketSender()->queueEditEntityMessages(_entityTree, edits);
+    return id;
+}
 
-                if (entity->getSimulatorID() == myNodeID) {
-                    // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
-                    if (hasTerseUpdateChanges) {
-                        entity->getAllTerseUpdateProperties(properties);
-                    }
-                    // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
-                    // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
-                    // and instead let the physics simulation decide when to send a terse update.  This would remove
-                    // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
-                    // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
-                    // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
-                    // simulation.
-
-                    if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
-                        // we re-assert our simulation ownership at a higher priority
-                        properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    }
-                } else {
-                    // we make a bid for simulation ownership
+QVector<QUuid> EntityScriptingInterface::editEntities(const QVector<QUuid>& ids, const QScriptValue& scriptSideProperties) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVector<QUuid> results(ids.size());
+
+    bool isPropertiesArray = scriptSideProperties.isArray();
+    if (isPropertiesArray && scriptSideProperties.property("length").toInt32() != ids.size()) {
+        qCWarning(entities) << "editEntities: the number of properties doesn't match the number of entities";
+        return results;
+    }
+
+    _activityTracking.editedEntityCount += ids.size();
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto sessionID = nodeList->getSessionUUID();
+
+    std::vector<EntityItemProperties> editProperties(ids.size());
+    for (int i = 0; i < ids.size(); ++i) {
+        if (isPropertiesArray) {
+            EntityItemPropertiesFromScriptValueHonorReadOnly(scriptSideProperties.property(i), editProperties[i]);
+        } else if (i == 0) {
+            EntityItemPropertiesFromScriptValueHonorReadOnly(scriptSideProperties, editProperties[i]);
+        } else {
+            editProperties[i] = editProperties[0];
+        }
+    }
+
+    EntityEditPacketSender::EntityEdits edits;
+    edits.reserve(ids.size());
+
+    if (!_entityTree) {
+        for (int i = 0; i < ids.size(); ++i) {
+            editProperties[i].setLastEditedBy(sessionID);
+            edits.emplace_back(ids[i], editProperties[i]);
+            results[i] = ids[i];
+        }
+        getEntityPacketSender()->queueEditEntityMessages(_entityTree, edits);
+        return results;
+    }
+
+    // the whole batch is applied to the local tree under a single lock, same as a series of editEntity calls
+    std::vector<int> entitiesNotFound;
+    _entityTree->withWriteLock([&] {
+        for (int i = 0; i < ids.size(); ++i) {
+            EntityItemID entityID(ids[i]);
+            EntityItemProperties properties = editProperties[i];
+            properties.setLastEditedBy(sessionID);
+
+            updateLocalEntity(entityID, editProperties[i], properties);
+            if (prepareEntityEdit(entityID, properties, edits)) {
+                edits.emplace_back(entityID, properties);
+                results[i] = ids[i];
+            } else {
+                editProperties[i] = properties;
+                entitiesNotFound.push_back(i);
+            }
+        }
+    });
+
+    for (auto i : entitiesNotFound) {
+        if (!isNonEntityID(ids[i])) {
+            edits.emplace_back(ids[i], editProperties[i]);
+            results[i] = ids[i];
+        }
+    }
+
+    getEntityPacketSender()->queueEditEntityMessages(_entityTree, edits);
+    return results;
+}
+
+bool EntityScriptingInterface::updateLocalEntity(const EntityItemID& entityID, const EntityItemProperties& scriptSideProperties,
+                                                 EntityItemProperties& properties) {
+    EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+    if (!entity) {
+        return false;
+    }
+
+    if (entity->getClientOnly() && entity->getOwningAvatarID() != DependencyManager::get<NodeList>()->getSessionUUID()) {
+        // don't edit other avatar's avatarEntities
+        return false;
+    }
+
+    if (scriptSideProperties.parentRelatedPropertyChanged()) {
+        // All of parentID, parentJointIndex, position, rotation are needed to make sense of any of them.
+        // If any of these changed, pull any missing properties from the entity.
+
+        if (!scriptSideProperties.parentIDChanged()) {
+            properties.setParentID(entity->getParentID());
+        }
+        if (!scriptSideProperties.parentJointIndexChanged()) {
+            properties.setParentJointIndex(entity->getParentJointIndex());
+        }
+        if (!scriptSideProperties.localPositionChanged() && !scriptSideProperties.positionChanged()) {
+            properties.setPosition(entity->getWorldPosition());
+        }
+        if (!scriptSideProperties.localRotationChanged() && !scriptSideProperties.rotationChanged()) {
+            properties.setRotation(entity->getWorldOrientation());
+        }
+        if (!scriptSideProperties.localDimensionsChanged() && !scriptSideProperties.dimensionsChanged()) {
+            properties.setDimensions(entity->getScaledDimensions());
+        }
+    }
+    properties.setClientOnly(entity->getClientOnly());
+    properties.setOwningAvatarID(entity->getOwningAvatarID());
+    properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
+    return _entityTree->updateEntity(entityID, properties);
+}
+
+bool EntityScriptingInterface::prepareEntityEdit(const EntityItemID& entityID, EntityItemProperties& properties,
+                                                 EntityEditPacketSender::EntityEdits& descendantEdits) {
+    EntityItemPointer entity = _entityTree->findEntityByEntityItemID(entityID);
+    if (entity) {
+        // make sure the properties has a type, so that the encode can know which properties to include
+        properties.setType(entity->getType());
+        bool hasTerseUpdateChanges = properties.hasTerseUpdateChanges();
+        bool hasPhysicsChanges = properties.hasMiscPhysicsChanges() || hasTerseUpdateChanges;
+        if (_bidOnSimulationOwnership && hasPhysicsChanges) {
+            auto nodeList = DependencyManager::get<NodeList>();
+            const QUuid myNodeID = nodeList->getSessionUUID();
+
+            if (entity->getSimulatorID() == myNodeID) {
+                // we think we already own the simulation, so make sure to send ALL TerseUpdate properties
+                if (hasTerseUpdateChanges) {
+                    entity->getAllTerseUpdateProperties(properties);
+                }
+                // TODO: if we knew that ONLY TerseUpdate properties have changed in properties AND the object
+                // is dynamic AND it is active in the physics simulation then we could chose to NOT queue an update
+                // and instead let the physics simulation decide when to send a terse update.  This would remove
+                // the "slide-no-rotate" glitch (and typical double-update) that we see during the "poke rolling
+                // balls" test.  However, even if we solve this problem we still need to provide a "slerp the visible
+                // proxy toward the true physical position" feature to hide the final glitches in the remote watcher's
+                // simulation.
+
+                if (entity->getSimulationPriority() < SCRIPT_POKE_SIMULATION_PRIORITY) {
+                    // we re-assert our simulation ownership at a higher priority
                     properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
-                    entity->setScriptSimulationPriority(SCRIPT_POKE_SIMULATION_PRIORITY);
                 }
+            } else {
+                // we make a bid for simulation ownership
+                properties.setSimulationOwner(myNodeID, SCRIPT_POKE_SIMULATION_PRIORITY);
+                entity->setScriptSimulationPriority(SCRIPT_POKE_SIMULATION_PRIORITY);
             }
-            if (properties.queryAACubeRelatedPropertyChanged()) {
-                properties.setQueryAACube(entity->getQueryAACube());
-            }
-            entity->setLastBroadcast(usecTimestampNow());
-            properties.setLastEdited(entity->getLastEdited());
-
-            // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-            // if they've changed.
-            entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                if (descendant->getNestableType() == NestableType::Entity) {
-                    if (descendant->updateQueryAACube()) {
-                        EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                        EntityItemProperties newQueryCubeProperties;
-                        newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                        newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                        queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                        entityDescendant->setLastBroadcast(usecTimestampNow());
-                    }
+        }
+        if (properties.queryAACubeRelatedPropertyChanged()) {
+            properties.setQueryAACube(entity->getQueryAACube());
+        }
+        entity->setLastBroadcast(usecTimestampNow());
+        properties.setLastEdited(entity->getLastEdited());
+
+        // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+        // if they've changed.
+        entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+            if (descendant->getNestableType() == NestableType::Entity) {
+                if (descendant->updateQueryAACube()) {
+                    EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                    EntityItemProperties newQueryCubeProperties;
+                    newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                    newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                    descendantEdits.emplace_back(descendant->getID(), newQueryCubeProperties);
+                    entityDescendant->setLastBroadcast(usecTimestampNow());
                 }
-            });
-        } else {
-            // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
-            // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
-            // This is because, on the script side, "position" is in world frame, but in the network
-            // protocol and in the internal data-structures, "position" is "relative to parent".
-            // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
-            if (properties.localPositionChanged()) {
-                properties.setPosition(properties.getLocalPosition());
-            }
-            if (properties.localRotationChanged()) {
-                properties.setRotation(properties.getLocalRotation());
-            }
-            if (properties.localVelocityChanged()) {
-                properties.setVelocity(properties.getLocalVelocity());
-            }
-            if (properties.localAngularVelocityChanged()) {
-                properties.setAngularVelocity(properties.getLocalAngularVelocity());
-            }
-            if (properties.localDimensionsChanged()) {
-                properties.setDimensions(properties.getLocalDimensions());
             }
+        });
+        return true;
+    } else {
+        // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
+        // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
+        // This is because, on the script side, "position" is in world frame, but in the network
+        // protocol and in the internal data-structures, "position" is "relative to parent".
+        // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
+        if (properties.localPositionChanged()) {
+            properties.setPosition(properties.getLocalPosition());
         }
-    });
-    if (!entityFound) {
-        // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
-        // print a warning and don't send an edit packet to the entity-server.
-        QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
-        if (parentFinder) {
-            bool success;
-            auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
-            if (success) {
-                auto nestable = nestableWP.lock();
-                if (nestable) {
-                    NestableType nestableType = nestable->getNestableType();
-                    if (nestableType == NestableType::Overlay || nestableType == NestableType::Avatar) {
-                        qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
-                        return QUuid(); // null script value to indicate failure
-                    }
+        if (properties.localRotationChanged()) {
+            properties.setRotation(properties.getLocalRotation());
+        }
+        if (properties.localVelocityChanged()) {
+            properties.setVelocity(properties.getLocalVelocity());
+        }
+        if (properties.localAngularVelocityChanged()) {
+            properties.setAngularVelocity(properties.getLocalAngularVelocity());
+        }
+        if (properties.localDimensionsChanged()) {
+            properties.setDimensions(properties.getLocalDimensions());
+        }
+    }
+    return false;
+}
+
+bool EntityScriptingInterface::isNonEntityID(const QUuid& id) {
+    QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
+    if (parentFinder) {
+        bool success;
+        auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
+        if (success) {
+            auto nestable = nestableWP.lock();
+            if (nestable) {
+                NestableType nestableType = nestable->getNestableType();
+                if (nestableType == NestableType::Overlay || nestableType == NestableType::Avatar) {
+                    qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
+                    return true;
                 }
             }
         }
     }
-    // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
-    // to edit entities they know only by ID.
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    return false;
 }
 
 void EntityScriptingInterface::deleteEntity(QUuid id) {
@@ -722,6 +825,33 @@ QVector<QUuid> EntityScriptingInterface::findEntities(const glm::vec3& center, f
     return result;
 }
 
+QVariantList EntityScriptingInterface::findEntitiesInSpheres(const QVector<glm::vec3>& centers, const QVector<float>& radii) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVariantList result;
+    if (_entityTree) {
+        if (centers.size() != radii.size()) {
+            qCWarning(entities) << "Entities.findEntitiesInSpheres() requires one radius per center";
+            return result;
+        }
+
+        QVector<QVector<EntityItemPointer>> entities;
+        _entityTree->withReadLock([&] {
+            _entityTree->findEntities(centers, radii, entities);
+        });
+
+        for (const auto& sphereEntities : entities) {
+            QVariantList sphereResult;
+            sphereResult.reserve(sphereEntities.size());
+            foreach (EntityItemPointer entity, sphereEntities) {
+                sphereResult << entity->getEntityItemID().toString();
+            }
+            result << QVariant(sphereResult);
+        }
+    }
+    return result;
+}
+
 QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corner, const glm::vec3& dimensions) const {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
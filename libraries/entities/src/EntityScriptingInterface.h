@@ -272,6 +272,22 @@ public slots:
     Q_INVOKABLE EntityItemProperties getEntityProperties(QUuid entityID);
     Q_INVOKABLE EntityItemProperties getEntityProperties(QUuid identity, EntityPropertyFlags desiredProperties);
 
+    /**jsdoc
+     * Get the properties of an entity, like {@link Entities.getEntityProperties|getEntityProperties}, but each property is
+     * only converted for the script when it is first read. Scripts that read a few properties of many entities every frame
+     * should use this. Enumerating the properties, e.g., with <code>JSON.stringify()</code>, converts all of them.
+     * @function Entities.getLazyEntityProperties
+     * @param {Uuid} entityID - The ID of the entity to get the properties of.
+     * @param {string[]} [desiredProperties=[]] - Array of the names of the properties to get. If the array is empty,
+     *     all properties are available.
+     * @returns {Entities.EntityProperties} The properties of the entity if the entity can be found, otherwise an empty object.
+     * @example <caption>Report the position of an entity.</caption>
+     * var properties = Entities.getLazyEntityProperties(entityID);
+     * print("Entity position: " + JSON.stringify(properties.position));
+     */
+    // registered with each script engine by ScriptEngine, because the lazy object belongs to the calling engine
+    static QScriptValue getLazyEntityProperties(QScriptContext* context, QScriptEngine* engine);
+
     /**jsdoc
      * Update an entity with specified properties.
      * @function Entities.editEntity
@@ -296,6 +312,28 @@ public slots:
      */
     Q_INVOKABLE QUuid editEntity(QUuid entityID, const EntityItemProperties& properties);
 
+    /**jsdoc
+     * Update several entities at once. This is the same as calling {@link Entities.editEntity|editEntity} for each of them,
+     * but the local entity tree is only locked once and the edits are packed together for the entity server, so it is much
+     * cheaper for scripts that animate many entities every frame.
+     * @function Entities.editEntities
+     * @param {Uuid[]} entityIDs - The IDs of the entities to edit.
+     * @param {Entities.EntityProperties|Entities.EntityProperties[]} properties - The properties to update each entity with,
+     *     in the same order as <code>entityIDs</code>, or a single set of properties to update all of them with.
+     * @returns {Uuid[]} The ID of each entity that was successfully edited, and <code>null</code> for those that weren't.
+     * @example <caption>Spin a row of boxes.</caption>
+     * var entityIDs = [];
+     * for (var i = 0; i < 10; i++) {
+     *     entityIDs.push(Entities.addEntity({
+     *         type: "Box",
+     *         position: Vec3.sum(MyAvatar.position, { x: i - 5, y: 0, z: -5 }),
+     *         dimensions: { x: 0.5, y: 0.5, z: 0.5 }
+     *     }));
+     * }
+     * Entities.editEntities(entityIDs, { angularVelocity: { x: 0, y: 1, z: 0 }, angularDamping: 0 });
+     */
+    Q_INVOKABLE QVector<QUuid> editEntities(const QVector<QUuid>& entityIDs, const QScriptValue& properties);
+
     /**jsdoc
      * Delete an entity.
      * @function Entities.deleteEntity
@@ -380,6 +418,22 @@ public slots:
     /// this function will not find any models in script engine contexts which don't have access to models
     Q_INVOKABLE QVector<QUuid> findEntities(const glm::vec3& center, float radius) const;
 
+    /**jsdoc
+     * Find all entities that intersect each of several spheres, in a single pass over the entity tree. This is much cheaper 
+     * than calling {@link Entities.findEntities|findEntities} once per sphere.
+     * @function Entities.findEntitiesInSpheres
+     * @param {Vec3[]} centers - The points about which to search.
+     * @param {number[]} radii - The radii within which to search, one per center.
+     * @returns {Uuid[][]} One array of entity IDs per sphere, in the same order as <code>centers</code>.
+     * @example <caption>Count the entities near each of two points.</caption>
+     * var left = Vec3.sum(MyAvatar.position, { x: -5, y: 0, z: 0 });
+     * var right = Vec3.sum(MyAvatar.position, { x: 5, y: 0, z: 0 });
+     * var results = Entities.findEntitiesInSpheres([left, right], [2, 2]);
+     * print("Left: " + results[0].length + ", right: " + results[1].length);
+     */
+    /// this function will not find any models in script engine contexts which don't have access to models
+    Q_INVOKABLE QVariantList findEntitiesInSpheres(const QVector<glm::vec3>& centers, const QVector<float>& radii) const;
+
     /**jsdoc
      * Find all entities whose axis-aligned boxes intersect a search axis-aligned box defined by its minimum coordinates corner
      * and dimensions.
@@ -1902,6 +1956,14 @@ private:
     bool polyVoxWorker(QUuid entityID, std::function<bool(PolyVoxEntityItem&)> actor);
     bool setPoints(QUuid entityID, std::function<bool(LineEntityItem&)> actor);
     void queueEntityMessage(PacketType packetType, EntityItemID entityID, const EntityItemProperties& properties);
+
+    // the steps of editEntity and editEntities, with the tree locked
+    bool updateLocalEntity(const EntityItemID& entityID, const EntityItemProperties& scriptSideProperties,
+                           EntityItemProperties& properties);
+    bool prepareEntityEdit(const EntityItemID& entityID, EntityItemProperties& properties,
+                           EntityEditPacketSender::EntityEdits& descendantEdits); // returns whether the entity was found
+    bool isNonEntityID(const QUuid& id); // overlays and avatars, which aren't sent to the entity server
+
     bool addLocalEntityCopy(EntityItemProperties& propertiesWithSimID, EntityItemID& id, bool isClone = false);
 
     EntityItemPointer checkForTreeEntityAndTypeMatch(const QUuid& entityID,
@@ -0,0 +1,123 @@
+//
+//  EntitySpatialIndex.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndex.h"
+
+#include <glm/gtc/type_precision.hpp>
+
+#include <OctreeConstants.h>
+
+#include "EntityTreeElement.h"
+
+// cell coordinates are packed 21 bits per axis, which covers octree depths up to 21
+const int MAX_INDEXED_DEPTH = 21;
+const int64_t COORDINATE_MASK = (1LL << MAX_INDEXED_DEPTH) - 1;
+
+int EntitySpatialIndex::computeDepth(float scale) {
+    return (int)roundf(log2f((float)TREE_SCALE / scale));
+}
+
+EntitySpatialIndex::CellKey EntitySpatialIndex::computeKey(int64_t x, int64_t y, int64_t z) {
+    return ((CellKey)(x & COORDINATE_MASK) << (2 * MAX_INDEXED_DEPTH)) |
+           ((CellKey)(y & COORDINATE_MASK) << MAX_INDEXED_DEPTH) |
+           (CellKey)(z & COORDINATE_MASK);
+}
+
+static glm::i64vec3 cellOf(const glm::vec3& point, float scale) {
+    glm::vec3 cell = glm::floor((point + glm::vec3((float)HALF_TREE_SCALE)) / scale);
+    return glm::i64vec3(cell);
+}
+
+void EntitySpatialIndex::addElement(const EntityTreeElementPointer& element) {
+    const AACube& cube = element->getAACube();
+    int depth = computeDepth(cube.getScale());
+    if (depth < 0 || depth > MAX_INDEXED_DEPTH) {
+        return;
+    }
+    // use the cell of the element's center so that rounding at the corner can't put it in a neighbour
+    glm::i64vec3 cell = cellOf(cube.calcCenter(), cube.getScale());
+
+    QWriteLocker locker(&_lock);
+    if ((int)_depths.size() <= depth) {
+        _depths.resize(depth + 1);
+    }
+    Depth& level = _depths[depth];
+    level.scale = cube.getScale();
+    auto result = level.cells.emplace(computeKey(cell.x, cell.y, cell.z), element);
+    if (result.second) {
+        ++_numElements;
+    } else {
+        result.first->second = element;
+    }
+}
+
+void EntitySpatialIndex::removeElement(const EntityTreeElement* element) {
+    const AACube& cube = element->getAACube();
+    int depth = computeDepth(cube.getScale());
+    glm::i64vec3 cell = cellOf(cube.calcCenter(), cube.getScale());
+
+    QWriteLocker locker(&_lock);
+    if (depth < 0 || depth >= (int)_depths.size()) {
+        return;
+    }
+    if (_depths[depth].cells.erase(computeKey(cell.x, cell.y, cell.z)) > 0) {
+        --_numElements;
+    }
+}
+
+void EntitySpatialIndex::clear() {
+    QWriteLocker locker(&_lock);
+    _depths.clear();
+    _numElements = 0;
+}
+
+size_t EntitySpatialIndex::getNumElements() const {
+    QReadLocker locker(&_lock);
+    return _numElements;
+}
+
+void EntitySpatialIndex::forEachElementTouching(const AABox& box, const ElementFunctor& functor) const {
+    QReadLocker locker(&_lock);
+    for (const auto& level : _depths) {
+        if (level.cells.empty()) {
+            continue;
+        }
+
+        glm::i64vec3 minCell = cellOf(box.getMinimumPoint(), level.scale);
+        glm::i64vec3 maxCell = cellOf(box.getMaximumPoint(), level.scale);
+        glm::i64vec3 extent = maxCell - minCell + glm::i64vec3(1);
+        double numOverlappedCells = (double)extent.x * (double)extent.y * (double)extent.z;
+
+        if (numOverlappedCells <= (double)level.cells.size()) {
+            // small query at this depth: look up the cells it overlaps
+            for (int64_t x = minCell.x; x <= maxCell.x; ++x) {
+                for (int64_t y = minCell.y; y <= maxCell.y; ++y) {
+                    for (int64_t z = minCell.z; z <= maxCell.z; ++z) {
+                        auto itr = level.cells.find(computeKey(x, y, z));
+                        if (itr != level.cells.end()) {
+                            EntityTreeElementPointer element = itr->second.lock();
+                            if (element && element->getAACube().touches(box)) {
+                                functor(element);
+                            }
+                        }
+                    }
+                }
+            }
+        } else {
+            // large query at this depth: cheaper to test every occupied cell
+            for (const auto& cell : level.cells) {
+                EntityTreeElementPointer element = cell.second.lock();
+                if (element && element->getAACube().touches(box)) {
+                    functor(element);
+                }
+            }
+        }
+    }
+}
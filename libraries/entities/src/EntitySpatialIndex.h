@@ -0,0 +1,65 @@
+//
+//  EntitySpatialIndex.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySpatialIndex_h
+#define hifi_EntitySpatialIndex_h
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QReadWriteLock>
+
+#include <AABox.h>
+
+class EntityTreeElement;
+using EntityTreeElementPointer = std::shared_ptr<EntityTreeElement>;
+using EntityTreeElementWeakPointer = std::weak_ptr<EntityTreeElement>;
+
+// EntitySpatialIndex is a flat, multi-level hashed grid of the octree elements that currently hold entities.
+//
+// Every octree element at a given depth is a cell of a regular grid, and an entity always lies inside the element
+// that holds it, so spatial queries only need to visit the occupied cells overlapping the query volume. Each depth
+// is a hash map from cell coordinate to element: a query either looks up the handful of cells it overlaps or, when it
+// overlaps more cells than are occupied, scans that depth's occupied cells. Elements register themselves when they
+// gain their first entity and unregister when they lose their last one, so the index never needs a refit when
+// entities move; moving between elements is an add and a remove.
+class EntitySpatialIndex {
+public:
+    using ElementFunctor = std::function<void(const EntityTreeElementPointer&)>;
+
+    void addElement(const EntityTreeElementPointer& element);
+    void removeElement(const EntityTreeElement* element);
+    void clear();
+
+    // calls functor for every occupied element whose cube touches the box
+    void forEachElementTouching(const AABox& box, const ElementFunctor& functor) const;
+
+    size_t getNumElements() const;
+
+private:
+    using CellKey = uint64_t;
+
+    class Depth {
+    public:
+        float scale { 0.0f };
+        std::unordered_map<CellKey, EntityTreeElementWeakPointer> cells;
+    };
+
+    static int computeDepth(float scale);
+    static CellKey computeKey(int64_t x, int64_t y, int64_t z);
+
+    mutable QReadWriteLock _lock;
+    std::vector<Depth> _depths;
+    size_t _numElements { 0 };
+};
+
+#endif // hifi_EntitySpatialIndex_h
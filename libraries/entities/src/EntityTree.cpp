@@ -132,6 +132,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
+    _spatialIndex.clear();
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -954,96 +955,60 @@ EntityItemPointer EntityTree::findClosestEntity(const glm::vec3& position, float
     return args.closestEntity;
 }
 
-class FindAllNearPointArgs {
-public:
-    glm::vec3 position;
-    float targetRadius;
-    QVector<EntityItemPointer> entities;
-};
-
-
-bool EntityTree::findInSphereOperation(const OctreeElementPointer& element, void* extraData) {
-    FindAllNearPointArgs* args = static_cast<FindAllNearPointArgs*>(extraData);
-    glm::vec3 penetration;
-    bool sphereIntersection = element->getAACube().findSpherePenetration(args->position, args->targetRadius, penetration);
-
-    // If this element contains the point, then search it...
-    if (sphereIntersection) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->getEntities(args->position, args->targetRadius, args->entities);
-        return true; // keep searching in case children have closer entities
-    }
-
-    // if this element doesn't contain the point, then none of it's children can contain the point, so stop searching
-    return false;
-}
-
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const glm::vec3& center, float radius, QVector<EntityItemPointer>& foundEntities) {
-    FindAllNearPointArgs args = { center, radius, QVector<EntityItemPointer>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInSphereOperation, &args);
+    QVector<EntityItemPointer> entities;
+    AABox searchBox(center - glm::vec3(radius), 2.0f * radius);
+    _spatialIndex.forEachElementTouching(searchBox, [&](const EntityTreeElementPointer& element) {
+        glm::vec3 penetration;
+        if (element->getAACube().findSpherePenetration(center, radius, penetration)) {
+            element->getEntities(center, radius, entities);
+        }
+    });
 
     // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    foundEntities.swap(entities);
 }
 
-class FindEntitiesInCubeArgs {
-public:
-    FindEntitiesInCubeArgs(const AACube& cube)
-        : _cube(cube), _foundEntities() {
-    }
-
-    AACube _cube;
-    QVector<EntityItemPointer> _foundEntities;
-};
-
-bool EntityTree::findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInCubeArgs* args = static_cast<FindEntitiesInCubeArgs*>(extraData);
-    if (element->getAACube().touches(args->_cube)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->getEntities(args->_cube, args->_foundEntities);
-        return true;
+// NOTE: assumes caller has handled locking
+void EntityTree::findEntities(const QVector<glm::vec3>& centers, const QVector<float>& radii,
+                              QVector<QVector<EntityItemPointer>>& foundEntities) {
+    assert(centers.size() == radii.size());
+    int numSpheres = std::min(centers.size(), radii.size());
+    foundEntities.resize(numSpheres);
+    for (int i = 0; i < numSpheres; ++i) {
+        QVector<EntityItemPointer>& entities = foundEntities[i];
+        entities.resize(0); // keeps the capacity from any previous batch
+        const glm::vec3& center = centers[i];
+        float radius = radii[i];
+        AABox searchBox(center - glm::vec3(radius), 2.0f * radius);
+        _spatialIndex.forEachElementTouching(searchBox, [&](const EntityTreeElementPointer& element) {
+            glm::vec3 penetration;
+            if (element->getAACube().findSpherePenetration(center, radius, penetration)) {
+                element->getEntities(center, radius, entities);
+            }
+        });
     }
-    return false;
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AACube& cube, QVector<EntityItemPointer>& foundEntities) {
-    FindEntitiesInCubeArgs args(cube);
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInCubeOperation, &args);
+    QVector<EntityItemPointer> entities;
+    _spatialIndex.forEachElementTouching(AABox(cube), [&](const EntityTreeElementPointer& element) {
+        element->getEntities(cube, entities);
+    });
     // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args._foundEntities);
-}
-
-class FindEntitiesInBoxArgs {
-public:
-    FindEntitiesInBoxArgs(const AABox& box)
-    : _box(box), _foundEntities() {
-    }
-
-    AABox _box;
-    QVector<EntityItemPointer> _foundEntities;
-};
-
-bool EntityTree::findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
-    FindEntitiesInBoxArgs* args = static_cast<FindEntitiesInBoxArgs*>(extraData);
-    if (element->getAACube().touches(args->_box)) {
-        EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
-        entityTreeElement->getEntities(args->_box, args->_foundEntities);
-        return true;
-    }
-    return false;
+    foundEntities.swap(entities);
 }
 
 // NOTE: assumes caller has handled locking
 void EntityTree::findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities) {
-    FindEntitiesInBoxArgs args(box);
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
+    QVector<EntityItemPointer> entities;
+    _spatialIndex.forEachElementTouching(box, [&](const EntityTreeElementPointer& element) {
+        element->getEntities(box, entities);
+    });
     // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args._foundEntities);
+    foundEntities.swap(entities);
 }
 
 class FindInFrustumArgs {
@@ -21,6 +21,7 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntitySpatialIndex.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
@@ -157,6 +158,15 @@ public:
     /// \remark Side effect: any initial contents in entities will be lost
     void findEntities(const AABox& box, QVector<EntityItemPointer>& foundEntities);
 
+    /// finds all entities that touch each of a batch of spheres
+    /// \param centers the centers of the spheres in world-frame (meters)
+    /// \param radii the radii of the spheres in world-frame (meters), one per center
+    /// \param foundEntities[out] one vector of EntityItemPointer per sphere
+    /// \remark the result vectors are emptied but keep their capacity, so callers that reuse them
+    ///         across batches don't reallocate
+    void findEntities(const QVector<glm::vec3>& centers, const QVector<float>& radii,
+                      QVector<QVector<EntityItemPointer>>& foundEntities);
+
     /// finds all entities within a frustum
     /// \parameter frustum the query frustum
     /// \param foundEntities[out] vector of EntityItemPointer
@@ -198,6 +208,7 @@ public:
     EntityTreeElementPointer getContainingElement(const EntityItemID& entityItemID)  /*const*/;
     void addEntityMapEntry(EntityItemPointer entity);
     void clearEntityMapEntry(const EntityItemID& id);
+    EntitySpatialIndex& getSpatialIndex() { return _spatialIndex; }
     void debugDumpMap();
     virtual void dumpTree() override;
     virtual void pruneTree() override;
@@ -320,9 +331,6 @@ protected:
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
             const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
     static bool findNearPointOperation(const OctreeElementPointer& element, void* extraData);
-    static bool findInSphereOperation(const OctreeElementPointer& element, void* extraData);
-    static bool findInCubeOperation(const OctreeElementPointer& element, void* extraData);
-    static bool findInBoxOperation(const OctreeElementPointer& element, void* extraData);
     static bool findInFrustumOperation(const OctreeElementPointer& element, void* extraData);
     static bool sendEntitiesOperation(const OctreeElementPointer& element, void* extraData);
     static void bumpTimestamp(EntityItemProperties& properties);
@@ -353,6 +361,9 @@ protected:
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
+    // flat index of the elements that hold entities, used instead of recursing the octree for spatial queries
+    EntitySpatialIndex _spatialIndex;
+
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, EntityItemID> _entityCertificateIDMap;
 
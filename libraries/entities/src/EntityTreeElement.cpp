@@ -554,6 +554,10 @@ EntityItemPointer EntityTreeElement::getEntityWithEntityItemID(const EntityItemI
 }
 
 void EntityTreeElement::cleanupEntities() {
+    // NOTE: the spatial index is updated outside of our lock, since queries lock the index before locking elements
+    if (_myTree) {
+        _myTree->getSpatialIndex().removeElement(this);
+    }
     withWriteLock([&] {
         foreach(EntityItemPointer entity, _entityItems) {
             entity->preDelete();
@@ -573,9 +577,14 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion
         entity->preDelete();
     }
     int numEntries = 0;
+    bool becameEmpty = false;
     withWriteLock([&] {
         numEntries = _entityItems.removeAll(entity);
+        becameEmpty = numEntries > 0 && _entityItems.isEmpty();
     });
+    if (becameEmpty && _myTree) {
+        _myTree->getSpatialIndex().removeElement(this);
+    }
     if (numEntries > 0) {
         // NOTE: only EntityTreeElement should ever be changing the value of entity->_element
         assert(entity->_element.get() == this);
@@ -595,9 +604,14 @@ int EntityTreeElement::readElementDataFromBuffer(const unsigned char* data, int
 void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     assert(entity);
     assert(entity->_element == nullptr);
+    bool wasEmpty = false;
     withWriteLock([&] {
+        wasEmpty = _entityItems.isEmpty();
         _entityItems.push_back(entity);
     });
+    if (wasEmpty && _myTree) {
+        _myTree->getSpatialIndex().addElement(getThisPointer());
+    }
     bumpChangedContent();
     entity->_element = getThisPointer();
 }
@@ -0,0 +1,142 @@
+//
+//  LazyEntityPropertiesClass.cpp
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LazyEntityPropertiesClass.h"
+
+#include <QtScript/QScriptValueIterator>
+
+#include <SharedUtil.h>
+
+static const QString CLASS_NAME = "EntityProperties";
+
+// copyToScriptValue always emits these, even with strict semantics, but they have no property flag of their own
+static const QSet<QString> ALWAYS_CONVERTED_NAMES { "id", "type", "created", "lastEdited" };
+// and emits these only when it converts everything, so they are computed here instead
+static const QString AGE_NAME = "age";
+static const QString AGE_AS_TEXT_NAME = "ageAsText";
+
+LazyEntityPropertiesClass* LazyEntityPropertiesClass::getForEngine(QScriptEngine* engine) {
+    auto scriptClass = engine->findChild<LazyEntityPropertiesClass*>(QString(), Qt::FindDirectChildrenOnly);
+    if (!scriptClass) {
+        scriptClass = new LazyEntityPropertiesClass(engine);
+    }
+    return scriptClass;
+}
+
+LazyEntityPropertiesClass::LazyEntityPropertiesClass(QScriptEngine* engine) :
+    QObject(engine),
+    QScriptClass(engine)
+{
+    qRegisterMetaType<LazyProperties>();
+    qRegisterMetaType<LazyProperties*>();
+}
+
+QScriptValue LazyEntityPropertiesClass::newInstance(const EntityItemProperties& properties) {
+    LazyProperties lazyProperties;
+    lazyProperties.properties = properties;
+    return engine()->newObject(this, engine()->newVariant(QVariant::fromValue(lazyProperties)));
+}
+
+QScriptClass::QueryFlags LazyEntityPropertiesClass::queryProperty(const QScriptValue& object, const QScriptString& name,
+                                                                  QueryFlags flags, uint* id) {
+    // converted properties are plain properties of the object, so this never handles the access itself
+    LazyProperties* lazyProperties = qscriptvalue_cast<LazyProperties*>(object.data());
+    if (!lazyProperties || lazyProperties->isComplete || lazyProperties->isConverting) {
+        return 0;
+    }
+
+    QString propertyName = name.toString();
+    if (lazyProperties->convertedNames.contains(propertyName)) {
+        return 0;
+    }
+
+    if (flags & HandlesWriteAccess) {
+        // the script's value wins over the entity's
+        lazyProperties->convertedNames.insert(propertyName);
+    } else {
+        convertProperty(object, lazyProperties, propertyName);
+    }
+    return 0;
+}
+
+QScriptClassPropertyIterator* LazyEntityPropertiesClass::newIterator(const QScriptValue& object) {
+    LazyProperties* lazyProperties = qscriptvalue_cast<LazyProperties*>(object.data());
+    if (lazyProperties && !lazyProperties->isComplete) {
+        convertAllProperties(object, lazyProperties);
+    }
+    return nullptr; // they're all plain properties now
+}
+
+QString LazyEntityPropertiesClass::name() const {
+    return CLASS_NAME;
+}
+
+void LazyEntityPropertiesClass::convertProperty(QScriptValue object, LazyProperties* lazyProperties, const QString& name) {
+    if ((name == AGE_NAME || name == AGE_AS_TEXT_NAME) && lazyProperties->properties.hasCreatedTime()) {
+        float age = lazyProperties->properties.getAge();
+        QScriptValue converted = engine()->newObject();
+        converted.setProperty(AGE_NAME, age);
+        converted.setProperty(AGE_AS_TEXT_NAME, formatSecondsElapsed(age));
+        copyConvertedProperties(object, lazyProperties, converted);
+        return;
+    }
+
+    EntityPropertyFlags propertyFlags;
+    bool isAlwaysConverted = ALWAYS_CONVERTED_NAMES.contains(name);
+    EntityPropertyFlags desiredProperties = lazyProperties->properties.getDesiredProperties();
+    if (isAlwaysConverted) {
+        // any single property will do, as long as the desired set isn't empty, which would mean all of them
+        propertyFlags = EntityPropertyFlags(PROP_LAST_EDITED_BY);
+    } else {
+        EntityItemProperties::entityPropertyFlagsFromScriptValue(QScriptValue(name), propertyFlags);
+        if (propertyFlags.isEmpty() ||
+            (!desiredProperties.isEmpty() && !desiredProperties.getHasProperty(propertyFlags.firstFlag()))) {
+            // not an entity property, or one that wasn't asked for
+            convertAllProperties(object, lazyProperties);
+            return;
+        }
+    }
+
+    // strict semantics leaves out the derived properties, which are only converted with everything else
+    lazyProperties->properties.setDesiredProperties(propertyFlags);
+    QScriptValue converted = lazyProperties->properties.copyToScriptValue(engine(), false, false, true);
+    lazyProperties->properties.setDesiredProperties(desiredProperties);
+
+    copyConvertedProperties(object, lazyProperties, converted);
+    if (!lazyProperties->convertedNames.contains(name)) {
+        if (isAlwaysConverted) {
+            // an id that isn't set, converting everything wouldn't find it either
+            lazyProperties->convertedNames.insert(name);
+        } else {
+            // not present on this type of entity
+            convertAllProperties(object, lazyProperties);
+        }
+    }
+}
+
+void LazyEntityPropertiesClass::convertAllProperties(QScriptValue object, LazyProperties* lazyProperties) {
+    QScriptValue converted = lazyProperties->properties.copyToScriptValue(engine(), false);
+    copyConvertedProperties(object, lazyProperties, converted);
+    lazyProperties->isComplete = true;
+}
+
+void LazyEntityPropertiesClass::copyConvertedProperties(QScriptValue& object, LazyProperties* lazyProperties,
+                                                        const QScriptValue& converted) {
+    lazyProperties->isConverting = true;
+    QScriptValueIterator it(converted);
+    while (it.hasNext()) {
+        it.next();
+        if (!lazyProperties->convertedNames.contains(it.name())) {
+            lazyProperties->convertedNames.insert(it.name());
+            object.setProperty(it.name(), it.value());
+        }
+    }
+    lazyProperties->isConverting = false;
+}
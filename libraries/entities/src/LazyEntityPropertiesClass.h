@@ -0,0 +1,57 @@
+//
+//  LazyEntityPropertiesClass.h
+//  libraries/entities/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LazyEntityPropertiesClass_h
+#define hifi_LazyEntityPropertiesClass_h
+
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+#include <QtScript/QScriptClass>
+#include <QtScript/QScriptEngine>
+#include <QtScript/QScriptString>
+#include <QtScript/QScriptValue>
+
+#include "EntityItemProperties.h"
+
+// Script objects for Entities.getLazyEntityProperties(). They hold the entity's properties and only convert a property
+// to a script value the first time it is read, after which it is a plain property of the object. Names that aren't
+// entity properties (derived values such as boundingBox, property groups, Object.prototype methods) and enumerating
+// the object convert everything at once, so the object looks the same as one from Entities.getEntityProperties().
+class LazyEntityPropertiesClass : public QObject, public QScriptClass {
+    Q_OBJECT
+public:
+    struct LazyProperties {
+        EntityItemProperties properties;
+        QSet<QString> convertedNames; // including those the script has written
+        bool isComplete { false };
+        bool isConverting { false };
+    };
+
+    // one per script engine, which owns it
+    static LazyEntityPropertiesClass* getForEngine(QScriptEngine* engine);
+
+    LazyEntityPropertiesClass(QScriptEngine* engine);
+
+    QScriptValue newInstance(const EntityItemProperties& properties);
+
+    QueryFlags queryProperty(const QScriptValue& object, const QScriptString& name, QueryFlags flags, uint* id) override;
+    QScriptClassPropertyIterator* newIterator(const QScriptValue& object) override;
+    QString name() const override;
+
+private:
+    void convertProperty(QScriptValue object, LazyProperties* lazyProperties, const QString& name);
+    void convertAllProperties(QScriptValue object, LazyProperties* lazyProperties);
+    void copyConvertedProperties(QScriptValue& object, LazyProperties* lazyProperties, const QScriptValue& converted);
+};
+
+Q_DECLARE_METATYPE(LazyEntityPropertiesClass::LazyProperties)
+Q_DECLARE_METATYPE(LazyEntityPropertiesClass::LazyProperties*)
+
+#endif // hifi_LazyEntityPropertiesClass_h
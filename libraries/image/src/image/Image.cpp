@@ -13,7 +13,12 @@
 
 #include <glm/gtc/packing.hpp>
 
+#include <condition_variable>
+#include <mutex>
+
 #include <QtCore/QtGlobal>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QUrl>
 #include <QImage>
 #include <QBuffer>
@@ -69,6 +74,29 @@ glm::uvec2 rectifySize(const glm::uvec2& size) {
 
 namespace image {
 
+static std::atomic<int> maxTextureCompressionThreads { std::max(1, QThread::idealThreadCount()) };
+
+// Helper threads for compressing mips, shared by all the textures being processed. The thread that processes a
+// texture always compresses too, so the pool only ever needs the threads beyond that one.
+static QThreadPool& getCompressionThreadPool() {
+    static QThreadPool* pool = [] {
+        auto pool = new QThreadPool();
+        pool->setMaxThreadCount(std::max(1, maxTextureCompressionThreads.load() - 1));
+        return pool;
+    }();
+    return *pool;
+}
+
+void setMaxTextureCompressionThreads(int maxThreads) {
+    maxThreads = std::max(1, maxThreads);
+    maxTextureCompressionThreads.store(maxThreads);
+    getCompressionThreadPool().setMaxThreadCount(std::max(1, maxThreads - 1));
+}
+
+int getMaxTextureCompressionThreads() {
+    return maxTextureCompressionThreads.load();
+}
+
 const QStringList getSupportedFormats() {
     auto formats = QImageReader::supportedImageFormats();
     QStringList stringFormats;
@@ -404,6 +432,84 @@ public:
     }
 };
 
+// Runs the tasks of a dispatch on the calling thread and on up to getMaxTextureCompressionThreads() - 1 helpers from
+// the compression thread pool. Each thread claims the next task index until they are all taken, so a dispatch never
+// waits for a helper to be scheduled, it only waits for the tasks that helpers have already started.
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
+public:
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing) : _abortProcessing(abortProcessing) {};
+
+    const std::atomic<bool>& _abortProcessing;
+
+    virtual void dispatch(nvtt::Task* task, void* context, int count) override {
+        int numHelpers = std::min(getMaxTextureCompressionThreads(), count) - 1;
+        if (numHelpers <= 0) {
+            SequentialTaskDispatcher(_abortProcessing).dispatch(task, context, count);
+            return;
+        }
+
+        // helpers can start after the dispatch has returned, so they share ownership of the batch
+        auto batch = std::make_shared<Batch>(task, context, count, _abortProcessing);
+        auto& pool = getCompressionThreadPool();
+        for (int i = 0; i < numHelpers; i++) {
+            pool.start(new BatchRunnable(batch));
+        }
+
+        batch->run();
+        batch->wait();
+    }
+
+private:
+    class Batch {
+    public:
+        Batch(nvtt::Task* task, void* context, int count, const std::atomic<bool>& abortProcessing) :
+            _task(task), _context(context), _count(count), _abortProcessing(abortProcessing) {}
+
+        void run() {
+            int numRun = 0;
+            int index;
+            while ((index = _nextIndex++) < _count) {
+                if (!_abortProcessing.load()) {
+                    _task(_context, index);
+                }
+                ++numRun;
+            }
+
+            if (numRun > 0) {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _numFinished += numRun;
+                if (_numFinished == _count) {
+                    _finished.notify_all();
+                }
+            }
+        }
+
+        void wait() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finished.wait(lock, [this] { return _numFinished == _count; });
+        }
+
+    private:
+        nvtt::Task* _task;
+        void* _context;
+        const int _count;
+        const std::atomic<bool>& _abortProcessing; // only read while a task is left, so the dispatch is still waiting
+        std::atomic<int> _nextIndex { 0 };
+        std::mutex _mutex;
+        std::condition_variable _finished;
+        int _numFinished { 0 };
+    };
+
+    class BatchRunnable : public QRunnable {
+    public:
+        BatchRunnable(std::shared_ptr<Batch> batch) : _batch(batch) {}
+        void run() override { _batch->run(); }
+
+    private:
+        std::shared_ptr<Batch> _batch;
+    };
+};
+
 void generateHDRMips(gpu::Texture* texture, QImage&& image, BackendTarget target, const std::atomic<bool>& abortProcessing, int face) {
     // Take a local copy to force move construction
     // https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#f18-for-consume-parameters-pass-by-x-and-stdmove-the-parameter
@@ -490,7 +596,7 @@ void generateHDRMips(gpu::Texture* texture, QImage&& image, BackendTarget target
     surface.setAlphaMode(alphaMode);
     surface.setWrapMode(wrapMode);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     nvtt::Compressor compressor;
     context.setTaskDispatcher(&dispatcher);
 
@@ -623,7 +729,7 @@ void generateLDRMips(gpu::Texture* texture, QImage&& image, BackendTarget target
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
+        ParallelTaskDispatcher dispatcher(abortProcessing);
         nvtt::Compressor compressor;
         compressor.setTaskDispatcher(&dispatcher);
         compressor.process(inputOptions, compressionOptions, outputOptions);
@@ -660,7 +766,8 @@ void generateLDRMips(gpu::Texture* texture, QImage&& image, BackendTarget target
 
         const Etc::ErrorMetric errorMetric = Etc::ErrorMetric::RGBA;
         const float effort = 1.0f;
-        const int numEncodeThreads = 4;
+        // Etc2Comp splits the blocks of each mip into this many jobs and encodes them in parallel
+        const int numEncodeThreads = getMaxTextureCompressionThreads();
         int encodingTime;
         const float MAX_COLOR = 255.0f;
 
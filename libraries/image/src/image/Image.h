@@ -81,6 +81,11 @@ gpu::TexturePointer processCubeTextureColorFromImage(QImage&& srcImage, const st
 
 const QStringList getSupportedFormats();
 
+// Maximum number of threads used to compress the mips of a texture, defaults to the number of cores.
+// Processes that compress several textures at once, or that share the machine with other bakers, can lower it.
+void setMaxTextureCompressionThreads(int maxThreads);
+int getMaxTextureCompressionThreads();
+
 gpu::TexturePointer processImage(std::shared_ptr<QIODevice> content, const std::string& url,
                                  int maxNumPixels, TextureUsage::Type textureType,
                                  bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
@@ -11,6 +11,7 @@
 
 #include "AssetClient.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include <QtCore/QBuffer>
@@ -393,7 +394,7 @@ AssetUpload* AssetClient::createUpload(const QByteArray& data) {
     return upload;
 }
 
-MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
+MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end, bool isChunk,
                                 ReceivedAssetCallback callback, ProgressCallback progressCallback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -409,7 +410,7 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
 
         auto messageID = ++_currentID;
 
-        auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(start) + sizeof(end);
+        auto payloadSize = sizeof(messageID) + AssetUtils::SHA256_HASH_LENGTH + sizeof(start) + sizeof(end) + sizeof(isChunk);
         auto packet = NLPacket::create(PacketType::AssetGet, payloadSize, true);
 
         qCDebug(asset_client) << "Requesting data from" << start << "to" << end << "of" << hash << "from asset-server.";
@@ -420,6 +421,7 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
 
         packet->writePrimitive(start);
         packet->writePrimitive(end);
+        packet->writePrimitive(isChunk);
 
         if (nodeList->sendPacket(std::move(packet), *assetServer) != -1) {
             _pendingRequests[assetServer][messageID] = { QSharedPointer<ReceivedMessage>(), callback, progressCallback };
@@ -428,7 +430,7 @@ MessageID AssetClient::getAsset(const QString& hash, AssetUtils::DataOffset star
         }
     }
 
-    callback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+    callback(false, AssetUtils::AssetServerError::NoError, QByteArray(), 0);
     return INVALID_MESSAGE_ID;
 }
 
@@ -507,8 +509,10 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     message->readHeadPrimitive(&error);
 
     AssetUtils::DataOffset length = 0;
+    AssetUtils::DataOffset fileSize = 0;
     if (!error) {
         message->readHeadPrimitive(&length);
+        message->readHeadPrimitive(&fileSize);
     } else {
         qCWarning(asset_client) << "Failure getting asset: " << error;
     }
@@ -540,21 +544,23 @@ void AssetClient::handleAssetGetReply(QSharedPointer<ReceivedMessage> message, S
     connect(message.data(), &ReceivedMessage::progress, this, [this, weakNode, messageID, length](qint64 size) {
         handleProgressCallback(weakNode, messageID, size, length);
     });
-    connect(message.data(), &ReceivedMessage::completed, this, [this, weakNode, messageID, length]() {
-        handleCompleteCallback(weakNode, messageID, length);
+    connect(message.data(), &ReceivedMessage::completed, this, [this, weakNode, messageID, length, fileSize]() {
+        handleCompleteCallback(weakNode, messageID, length, fileSize);
     });
 
     if (message->isComplete()) {
         disconnect(message.data(), nullptr, this, nullptr);
 
+        // the callback can request the next chunk, which inserts into messageCallbackMap,
+        // so the request is taken out of the map before the callback is invoked
+        auto completeCallback = std::move(callbacks.completeCallback);
+        messageCallbackMap.erase(messageID);
+
         if (length != message->getBytesLeftToRead()) {
-            callbacks.completeCallback(false, error, QByteArray());
+            completeCallback(false, error, QByteArray(), 0);
         } else {
-            callbacks.completeCallback(true, error, message->readAll());
+            completeCallback(true, error, message->readAll(), fileSize);
         }
-
-
-        messageCallbackMap.erase(requestIt);
     }
 }
 
@@ -585,7 +591,8 @@ void AssetClient::handleProgressCallback(const QWeakPointer<Node>& node, Message
     callbacks.progressCallback(size, length);
 }
 
-void AssetClient::handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length) {
+void AssetClient::handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length,
+                                         AssetUtils::DataOffset fileSize) {
     auto senderNode = node.toStrongRef();
 
     if (!senderNode) {
@@ -618,17 +625,20 @@ void AssetClient::handleCompleteCallback(const QWeakPointer<Node>& node, Message
         return;
     }
 
-    if (message->failed() || length != message->getBytesLeftToRead()) {
-        callbacks.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray());
-    } else {
-        callbacks.completeCallback(true, AssetUtils::AssetServerError::NoError, message->readAll());
-    }
-
     // We should never get to this point without the associated senderNode and messageID
     // in our list of pending requests. If the senderNode had disconnected or the message
     // had been canceled, we should have been disconnected from the ReceivedMessage
     // signals and thus never had this lambda called.
+    // The callback can request the next chunk, so the request is removed before it is invoked.
+    auto completeCallback = std::move(callbacks.completeCallback);
+    auto completedMessage = message;
     messageCallbackMap.erase(messageID);
+
+    if (completedMessage->failed() || length != completedMessage->getBytesLeftToRead()) {
+        completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray(), 0);
+    } else {
+        completeCallback(true, AssetUtils::AssetServerError::NoError, completedMessage->readAll(), fileSize);
+    }
 }
 
 
@@ -659,7 +669,7 @@ MessageID AssetClient::getAssetMapping(const AssetUtils::AssetPath& path, Mappin
     return INVALID_MESSAGE_ID;
 }
 
-MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
+MessageID AssetClient::getAllAssetMappings(uint32_t offset, uint32_t maxCount, MappingOperationCallback callback) {
     Q_ASSERT(QThread::currentThread() == thread());
 
     auto nodeList = DependencyManager::get<LimitedNodeList>();
@@ -672,6 +682,8 @@ MessageID AssetClient::getAllAssetMappings(MappingOperationCallback callback) {
         packetList->writePrimitive(messageID);
 
         packetList->writePrimitive(AssetUtils::AssetMappingOperationType::GetAll);
+        packetList->writePrimitive(offset);
+        packetList->writePrimitive(maxCount);
 
         if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
             _pendingMappingRequests[assetServer][messageID] = callback;
@@ -847,13 +859,8 @@ bool AssetClient::cancelGetAssetRequest(MessageID id) {
 bool AssetClient::cancelUploadAssetRequest(MessageID id) {
     Q_ASSERT(QThread::currentThread() == thread());
 
-    // Search through each pending mapping request for id `id`
-    for (auto& kv : _pendingUploads) {
-        if (kv.second.erase(id)) {
-            return true;
-        }
-    }
-    return false;
+    // chunks of a cancelled upload that are still in flight are ignored when their replies arrive
+    return _chunkedUploads.erase(id) > 0;
 }
 
 MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback callback) {
@@ -862,25 +869,91 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     auto nodeList = DependencyManager::get<LimitedNodeList>();
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
-    if (assetServer) {
-        auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
+    if (!assetServer) {
+        callback(false, AssetUtils::AssetServerError::NoError, QString());
+        return INVALID_MESSAGE_ID;
+    }
 
-        auto messageID = ++_currentID;
-        packetList->writePrimitive(messageID);
+    // the asset is sent in chunks, each acknowledged by the asset server, with a bounded number of chunks
+    // in flight so the asset server never has to hold more than that much of the upload in memory
+    auto uploadID = ++_currentID;
+    auto& upload = _chunkedUploads[uploadID];
+    upload.data = data;
+    upload.callback = callback;
 
-        uint64_t size = data.length();
-        packetList->writePrimitive(size);
-        packetList->write(data.constData(), size);
+    sendUploadChunks(uploadID);
 
-        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
-            _pendingUploads[assetServer][messageID] = callback;
+    return uploadID;
+}
 
-            return messageID;
+void AssetClient::sendUploadChunks(MessageID uploadID) {
+    auto uploadIt = _chunkedUploads.find(uploadID);
+    if (uploadIt == _chunkedUploads.end()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+
+    while (uploadIt != _chunkedUploads.end() && !uploadIt->second.allChunksSent &&
+           uploadIt->second.pendingChunks < AssetUtils::MAX_PENDING_CHUNKS) {
+        auto& upload = uploadIt->second;
+
+        uint64_t size = upload.data.length();
+        auto offset = upload.nextOffset;
+        auto chunkSize = std::min(AssetUtils::TRANSFER_CHUNK_SIZE, (AssetUtils::DataOffset)size - offset);
+
+        upload.nextOffset += chunkSize;
+        upload.allChunksSent = (upload.nextOffset == (AssetUtils::DataOffset)size);
+        upload.pendingChunks++;
+
+        auto messageID = ++_currentID;
+        auto chunkCallback = [this, uploadID](bool responseReceived, AssetUtils::AssetServerError serverError,
+                                              const QString& hash) {
+            handleUploadChunkReply(uploadID, responseReceived, serverError, hash);
+        };
+
+        if (assetServer) {
+            auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
+
+            packetList->writePrimitive(messageID);
+            packetList->writePrimitive(uploadID);
+            packetList->writePrimitive(size);
+            packetList->writePrimitive((uint64_t)offset);
+            packetList->write(upload.data.constData() + offset, chunkSize);
+
+            if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+                _pendingUploads[assetServer][messageID] = chunkCallback;
+                continue;
+            }
         }
+
+        chunkCallback(false, AssetUtils::AssetServerError::NoError, QString());
+
+        // a failed chunk ends the upload
+        uploadIt = _chunkedUploads.find(uploadID);
     }
+}
 
-    callback(false, AssetUtils::AssetServerError::NoError, QString());
-    return INVALID_MESSAGE_ID;
+void AssetClient::handleUploadChunkReply(MessageID uploadID, bool responseReceived,
+                                         AssetUtils::AssetServerError serverError, const QString& hash) {
+    auto uploadIt = _chunkedUploads.find(uploadID);
+    if (uploadIt == _chunkedUploads.end()) {
+        // another chunk of this upload already failed
+        return;
+    }
+
+    auto& upload = uploadIt->second;
+    upload.pendingChunks--;
+
+    if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError || !hash.isEmpty()) {
+        // the upload failed, or this was the chunk that completed it
+        auto callback = upload.callback;
+        _chunkedUploads.erase(uploadIt);
+        callback(responseReceived, serverError, hash);
+    } else {
+        sendUploadChunks(uploadID);
+    }
 }
 
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -897,10 +970,13 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     if (error) {
         qCWarning(asset_client) << "Error uploading file to asset server";
     } else {
+        // only the reply to the chunk that completes an upload carries the hash
         auto hash = message->read(AssetUtils::SHA256_HASH_LENGTH);
         hashString = hash.toHex();
 
-        qCDebug(asset_client) << "Successfully uploaded asset to asset-server - SHA256 hash is " << hashString;
+        if (!hashString.isEmpty()) {
+            qCDebug(asset_client) << "Successfully uploaded asset to asset-server - SHA256 hash is " << hashString;
+        }
     }
 
     // Check if we have any pending requests for this node
@@ -913,9 +989,10 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
         // Check if we have this pending request
         auto requestIt = messageCallbackMap.find(messageID);
         if (requestIt != messageCallbackMap.end()) {
-            auto callback = requestIt->second;
-            callback(true, error, hashString);
+            // the callback can send the next chunks, which inserts into messageCallbackMap
+            auto callback = std::move(requestIt->second);
             messageCallbackMap.erase(requestIt);
+            callback(true, error, hashString);
         }
 
         // Although the messageCallbackMap may now be empty, we won't delete the node until we have disconnected from
@@ -968,7 +1045,7 @@ void AssetClient::forceFailureOfPendingRequests(SharedNodePointer node) {
                     disconnect(message.data(), nullptr, this, nullptr);
                 }
 
-                value.second.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray());
+                value.second.completeCallback(false, AssetUtils::AssetServerError::NoError, QByteArray(), 0);
             }
             messageMapIt->second.clear();
         }
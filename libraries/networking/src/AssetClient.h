@@ -43,7 +43,8 @@ struct AssetInfo {
 };
 
 using MappingOperationCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, QSharedPointer<ReceivedMessage> message)>;
-using ReceivedAssetCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data)>;
+using ReceivedAssetCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError,
+                                                 const QByteArray& data, AssetUtils::DataOffset fileSize)>;
 using GetInfoCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info)>;
 using UploadResultCallback = std::function<void(bool responseReceived, AssetUtils::AssetServerError serverError, const QString& hash)>;
 using ProgressCallback = std::function<void(qint64 totalReceived, qint64 total)>;
@@ -84,14 +85,15 @@ private slots:
 
 private:
     MessageID getAssetMapping(const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
-    MessageID getAllAssetMappings(MappingOperationCallback callback);
+    MessageID getAllAssetMappings(uint32_t offset, uint32_t maxCount, MappingOperationCallback callback);
     MessageID setAssetMapping(const QString& path, const AssetUtils::AssetHash& hash, MappingOperationCallback callback);
     MessageID deleteAssetMappings(const AssetUtils::AssetPathList& paths, MappingOperationCallback callback);
     MessageID renameAssetMapping(const AssetUtils::AssetPath& oldPath, const AssetUtils::AssetPath& newPath, MappingOperationCallback callback);
     MessageID setBakingEnabled(const AssetUtils::AssetPathList& paths, bool enabled, MappingOperationCallback callback);
 
     MessageID getAssetInfo(const QString& hash, GetInfoCallback callback);
-    MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
+    // a chunk request may have an end past the end of the asset, the asset server stops the reply at the end of the file
+    MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end, bool isChunk,
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
 
@@ -101,10 +103,15 @@ private:
     bool cancelUploadAssetRequest(MessageID id);
 
     void handleProgressCallback(const QWeakPointer<Node>& node, MessageID messageID, qint64 size, AssetUtils::DataOffset length);
-    void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length);
+    void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length,
+                                AssetUtils::DataOffset fileSize);
 
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    void sendUploadChunks(MessageID uploadID);
+    void handleUploadChunkReply(MessageID uploadID, bool responseReceived, AssetUtils::AssetServerError serverError,
+                                const QString& hash);
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
@@ -117,6 +124,15 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
 
+    struct ChunkedUpload {
+        QByteArray data;
+        AssetUtils::DataOffset nextOffset { 0 };
+        bool allChunksSent { false };
+        int pendingChunks { 0 };
+        UploadResultCallback callback;
+    };
+    std::unordered_map<MessageID, ChunkedUpload> _chunkedUploads;
+
     QString _cacheDir;
 
     friend class AssetRequest;
@@ -34,10 +34,7 @@ AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
 }
 
 AssetRequest::~AssetRequest() {
-    auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
-    }
+    cancelPendingRequests();
 }
 
 void AssetRequest::start() {
@@ -75,66 +72,162 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestRange(_byteRange.fromInclusive, _byteRange.toExclusive, false);
+    } else {
+        // whole assets are downloaded in chunks, so neither side ever has to hold more than a few chunks of the
+        // transfer in flight, the reply to the first chunk tells us how large the asset is
+        requestRange(0, AssetUtils::TRANSFER_CHUNK_SIZE, true);
+    }
+}
+
+void AssetRequest::requestRange(AssetUtils::DataOffset start, AssetUtils::DataOffset end, bool isChunk) {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
 
-    _assetRequestID = assetClient->getAsset(_hash, _byteRange.fromInclusive, _byteRange.toExclusive,
-        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+    auto messageID = assetClient->getAsset(_hash, start, end, isChunk,
+        [this, that, hash, start](bool responseReceived, AssetUtils::AssetServerError serverError,
+                                  const QByteArray& data, AssetUtils::DataOffset fileSize) {
 
         if (!that) {
             qCWarning(asset_client) << "Got reply for dead asset request " << hash << "- error code" << _error;
             // If the request is dead, return
             return;
         }
-        _assetRequestID = INVALID_MESSAGE_ID;
-
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
-        } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
-            }
-
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
-
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
-                }
-            }
-        }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
-        }
-        
-        _state = Finished;
-        emit finished(this);
+        handleRangeReply(start, responseReceived, serverError, data, fileSize);
     }, [this, that](qint64 totalReceived, qint64 total) {
         if (!that) {
             // If the request is dead, return
             return;
         }
-        emit progress(totalReceived, total);
+        if (_byteRange.isSet()) {
+            emit progress(totalReceived, total);
+        } else {
+            emit progress(_totalReceived + totalReceived, _fileSize > 0 ? _fileSize : total);
+        }
     });
+
+    // the request can fail before getAsset returns, in which case we're already finished
+    if (messageID != INVALID_MESSAGE_ID && _state != Finished) {
+        _pendingRequests[start] = messageID;
+    }
 }
 
+void AssetRequest::handleRangeReply(AssetUtils::DataOffset start, bool responseReceived,
+                                    AssetUtils::AssetServerError serverError, const QByteArray& data,
+                                    AssetUtils::DataOffset fileSize) {
+    _pendingRequests.erase(start);
+
+    if (_state == Finished) {
+        // another chunk of this asset already failed
+        return;
+    }
+
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else if (serverError != AssetUtils::AssetServerError::NoError) {
+        switch (serverError) {
+            case AssetUtils::AssetServerError::AssetNotFound:
+                _error = NotFound;
+                break;
+            case AssetUtils::AssetServerError::InvalidByteRange:
+                _error = InvalidByteRange;
+                break;
+            default:
+                _error = UnknownError;
+                break;
+        }
+    } else if (_byteRange.isSet()) {
+        _data = data;
+        _totalReceived += data.size();
+        emit progress(_totalReceived, data.size());
+        finish();
+        return;
+    } else {
+        handleChunk(start, data, fileSize);
+        return;
+    }
+
+    finish();
+}
+
+void AssetRequest::handleChunk(AssetUtils::DataOffset start, const QByteArray& data, AssetUtils::DataOffset fileSize) {
+    if (_fileSize < 0) {
+        _fileSize = fileSize;
+    }
+
+    auto expectedSize = std::min(AssetUtils::TRANSFER_CHUNK_SIZE, _fileSize - start);
+    if (fileSize != _fileSize || data.size() != expectedSize) {
+        _error = SizeVerificationFailed;
+        finish();
+        return;
+    }
+
+    if (start == 0 && data.size() == _fileSize) {
+        // the whole asset fit in one chunk
+        _data = data;
+    } else {
+        if (_data.size() != _fileSize) {
+            _data.resize(_fileSize);
+        }
+        memcpy(_data.data() + start, data.constData(), data.size());
+    }
+    _totalReceived += data.size();
+    emit progress(_totalReceived, _fileSize);
+
+    // chunks can complete out of order, hash everything we have contiguously from the start of the asset
+    _receivedChunks.insert(start);
+    while (!_receivedChunks.empty() && *_receivedChunks.begin() == _hashedOffset) {
+        auto chunkSize = std::min(AssetUtils::TRANSFER_CHUNK_SIZE, _fileSize - _hashedOffset);
+        _hasher.addData(_data.constData() + _hashedOffset, chunkSize);
+        _hashedOffset += chunkSize;
+        _receivedChunks.erase(_receivedChunks.begin());
+    }
+
+    if (_hashedOffset == _fileSize) {
+        if (_hasher.result().toHex() != _hash) {
+            // the hash of the received data does not match what we expect, so we return an error
+            _error = HashVerificationFailed;
+        } else {
+            AssetUtils::saveToCache(getUrl(), _data);
+        }
+        finish();
+        return;
+    }
+
+    // keep a bounded window of chunk requests in flight, so that the next chunk is only asked
+    // for once the asset server has delivered one of the earlier ones
+    while (_state != Finished && (int)_pendingRequests.size() < AssetUtils::MAX_PENDING_CHUNKS &&
+           _nextChunkOffset < _fileSize) {
+        auto chunkStart = _nextChunkOffset;
+        _nextChunkOffset += AssetUtils::TRANSFER_CHUNK_SIZE;
+        requestRange(chunkStart, chunkStart + AssetUtils::TRANSFER_CHUNK_SIZE, true);
+    }
+}
+
+void AssetRequest::finish() {
+    cancelPendingRequests();
+
+    if (_error != NoError) {
+        qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelPendingRequests() {
+    if (_pendingRequests.empty()) {
+        return;
+    }
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto& pendingRequest : _pendingRequests) {
+        assetClient->cancelGetAssetRequest(pendingRequest.second);
+    }
+    _pendingRequests.clear();
+}
 
 const QString AssetRequest::getErrorString() const {
     QString result;
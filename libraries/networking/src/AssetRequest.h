@@ -12,7 +12,11 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <map>
+#include <set>
+
 #include <QByteArray>
+#include <QCryptographicHash>
 #include <QObject>
 #include <QString>
 
@@ -62,14 +66,25 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    void requestRange(AssetUtils::DataOffset start, AssetUtils::DataOffset end, bool isChunk);
+    void handleRangeReply(AssetUtils::DataOffset start, bool responseReceived, AssetUtils::AssetServerError serverError,
+                          const QByteArray& data, AssetUtils::DataOffset fileSize);
+    void handleChunk(AssetUtils::DataOffset start, const QByteArray& data, AssetUtils::DataOffset fileSize);
+    void finish();
+    void cancelPendingRequests();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
     uint64_t _totalReceived { 0 };
     QString _hash;
     QByteArray _data;
-    int _numPendingRequests { 0 };
-    MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    std::map<AssetUtils::DataOffset, MessageID> _pendingRequests; // start of the requested range -> message ID
+    AssetUtils::DataOffset _fileSize { -1 };
+    AssetUtils::DataOffset _nextChunkOffset { AssetUtils::TRANSFER_CHUNK_SIZE };
+    AssetUtils::DataOffset _hashedOffset { 0 };
+    std::set<AssetUtils::DataOffset> _receivedChunks; // chunks received but not yet hashed
+    QCryptographicHash _hasher { QCryptographicHash::Sha256 };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
 };
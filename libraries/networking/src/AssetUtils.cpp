@@ -62,6 +62,15 @@ QByteArray hashData(const QByteArray& data) {
     return QCryptographicHash::hash(data, QCryptographicHash::Sha256);
 }
 
+QByteArray hashFile(QIODevice& device) {
+    // QCryptographicHash reads the device in small blocks, so this never holds the whole file in memory
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&device)) {
+        return QByteArray();
+    }
+    return hash.result();
+}
+
 QByteArray loadFromCache(const QUrl& url) {
     if (auto cache = NetworkAccessManager::getInstance().cache()) {
 
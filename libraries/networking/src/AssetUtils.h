@@ -17,6 +17,7 @@
 #include <map>
 
 #include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
 #include <QtCore/QUrl>
 
 namespace AssetUtils {
@@ -31,12 +32,24 @@ const size_t SHA256_HASH_LENGTH = 32;
 const size_t SHA256_HASH_HEX_LENGTH = 64;
 const uint64_t MAX_UPLOAD_SIZE = 1000 * 1000 * 1000; // 1GB
 
+// assets are uploaded and downloaded in chunks of this size, with at most
+// MAX_PENDING_CHUNKS chunks of one transfer in flight at a time
+const DataOffset TRANSFER_CHUNK_SIZE = 1024 * 1024; // 1MB
+const int MAX_PENDING_CHUNKS = 4;
+
+// GetAll mapping operations reply with at most this many mappings, clients ask for the rest a page at a time
+const uint32_t MAX_MAPPINGS_PER_PAGE = 1000;
+
 const QString ASSET_FILE_PATH_REGEX_STRING = "^(\\/[^\\/\\0]+)+$";
 const QString ASSET_PATH_REGEX_STRING = "^\\/([^\\/\\0]+(\\/)?)+$";
 const QString ASSET_HASH_REGEX_STRING = QString("^[a-fA-F0-9]{%1}$").arg(SHA256_HASH_HEX_LENGTH);
 
 const QString HIDDEN_BAKED_CONTENT_FOLDER = "/.baked/";
 
+// the asset server keeps an oven running as a worker, which writes the result of each bake
+// to stdout as this prefix followed by the oven's status code
+const QString OVEN_WORKER_RESULT_PREFIX = "OVEN_RESULT ";
+
 enum AssetServerError : uint8_t {
     NoError = 0,
     AssetNotFound,
@@ -80,6 +93,7 @@ QUrl getATPUrl(const QString& input);
 AssetHash extractAssetHash(const QString& input);
 
 QByteArray hashData(const QByteArray& data);
+QByteArray hashFile(QIODevice& device);
 
 QByteArray loadFromCache(const QUrl& url);
 bool saveToCache(const QUrl& url, const QByteArray& file);
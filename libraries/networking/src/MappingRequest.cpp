@@ -107,8 +107,14 @@ void GetMappingRequest::doStart() {
 };
 
 void GetAllMappingsRequest::doStart() {
+    _mappings.clear();
+    _nextOffset = 0;
+    requestPage();
+}
+
+void GetAllMappingsRequest::requestPage() {
     auto assetClient = DependencyManager::get<AssetClient>();
-    _mappingRequestID = assetClient->getAllAssetMappings(
+    _mappingRequestID = assetClient->getAllAssetMappings(_nextOffset, AssetUtils::MAX_MAPPINGS_PER_PAGE,
             [this, assetClient](bool responseReceived, AssetUtils::AssetServerError error, QSharedPointer<ReceivedMessage> message) {
 
         _mappingRequestID = INVALID_MESSAGE_ID;
@@ -128,7 +134,9 @@ void GetAllMappingsRequest::doStart() {
 
 
         if (!_error) {
+            uint32_t totalNumberOfMappings;
             uint32_t numberOfMappings;
+            message->readPrimitive(&totalNumberOfMappings);
             message->readPrimitive(&numberOfMappings);
             for (uint32_t i = 0; i < numberOfMappings; ++i) {
                 auto path = message->readString();
@@ -141,10 +149,17 @@ void GetAllMappingsRequest::doStart() {
                 }
                 _mappings[path] = { hash, status, lastBakeErrors };
             }
+
+            // keep going until we have them all, or the server has none left to give (mappings deleted meanwhile)
+            _nextOffset += numberOfMappings;
+            if (numberOfMappings > 0 && _nextOffset < totalNumberOfMappings) {
+                requestPage();
+                return;
+            }
         }
         emit finished(this);
     });
-};
+}
 
 SetMappingRequest::SetMappingRequest(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) :
     _path(path.trimmed()),
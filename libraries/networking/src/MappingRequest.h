@@ -128,7 +128,11 @@ signals:
 private:
     virtual void doStart() override;
 
+    // the asset server sends the mappings a page at a time, this asks for the next one
+    void requestPage();
+
     AssetUtils::AssetMappings _mappings;
+    uint32_t _nextOffset { 0 };
 };
 
 class SetBakingEnabledRequest : public MappingRequest {
@@ -134,6 +134,7 @@ public:
         EntityClone,
         EntityQueryInitialResultsComplete,
         BulkAvatarTraits,
+        AvatarJointResyncRequest,
 
         NUM_PACKET_TYPE
     };
@@ -263,7 +264,9 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    ChunkedTransfers,
+    PagedMappings
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -293,7 +296,8 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     ProceduralFaceMovementFlagsAndBlendshapes,
     FarGrabJoints,
     MigrateSkeletonURLToTraits,
-    MigrateAvatarEntitiesToTraits
+    MigrateAvatarEntitiesToTraits,
+    PredictedJointData
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -332,6 +336,7 @@ enum class AudioVersion : PacketVersion {
     SpaceBubbleChanges,
     HasPersonalMute,
     HighDynamicRangeVolume,
+    TimeStretchingStats,
 };
 
 enum class MessageDataVersion : PacketVersion {
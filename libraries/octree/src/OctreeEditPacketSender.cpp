@@ -180,71 +180,96 @@ void OctreeEditPacketSender::queueOctreeEditMessage(PacketType type, QByteArray&
 
     auto node = DependencyManager::get<NodeList>()->soloNodeOfType(getMyNodeType());
     if (node && node->getActiveSocket()) {
-        QUuid nodeUUID = node->getUUID();
+        packEditMessage(node, type, editMessage);
+    }
 
-        // for edit messages, we will attempt to combine multiple edit commands where possible, we
-        // don't do this for add because we send those reliably
-        if (type == PacketType::EntityAdd) {
-            auto newPacket = NLPacketList::create(type, QByteArray(), true, true);
-            auto nodeClockSkew = node->getClockSkewUsec();
+    _packetsQueueLock.unlock();
+}
 
-            // pack sequence number
-            quint16 sequence = _outgoingSequenceNumbers[nodeUUID]++;
-            newPacket->writePrimitive(sequence);
+void OctreeEditPacketSender::queueOctreeEditMessages(std::vector<EditMessagePair>& editMessages) {
+    if (!serversExist()) {
+        for (auto& editMessage : editMessages) {
+            queueOctreeEditMessage(editMessage.first, editMessage.second);
+        }
+        return;
+    }
 
-            // pack in timestamp
-            quint64 now = usecTimestampNow() + nodeClockSkew;
-            newPacket->writePrimitive(now);
+    // the whole batch is packed under a single lock, for a single lookup of the server
+    _packetsQueueLock.lock();
 
+    auto node = DependencyManager::get<NodeList>()->soloNodeOfType(getMyNodeType());
+    if (node && node->getActiveSocket()) {
+        for (auto& editMessage : editMessages) {
+            packEditMessage(node, editMessage.first, editMessage.second);
+        }
+    }
 
-            // We call this virtual function that allows our specific type of EditPacketSender to
-            // fixup the buffer for any clock skew
-            if (nodeClockSkew != 0) {
-                adjustEditPacketForClockSkew(type, editMessage, nodeClockSkew);
-            }
+    _packetsQueueLock.unlock();
+}
 
-            newPacket->write(editMessage);
+// NOTE: must be called with _packetsQueueLock held
+void OctreeEditPacketSender::packEditMessage(const SharedNodePointer& node, PacketType type, QByteArray& editMessage) {
+    QUuid nodeUUID = node->getUUID();
+
+    // for edit messages, we will attempt to combine multiple edit commands where possible, we
+    // don't do this for add because we send those reliably
+    if (type == PacketType::EntityAdd) {
+        auto newPacket = NLPacketList::create(type, QByteArray(), true, true);
+        auto nodeClockSkew = node->getClockSkewUsec();
+
+        // pack sequence number
+        quint16 sequence = _outgoingSequenceNumbers[nodeUUID]++;
+        newPacket->writePrimitive(sequence);
 
-            // release the new packet
-            releaseQueuedPacketList(nodeUUID, std::move(newPacket));
+        // pack in timestamp
+        quint64 now = usecTimestampNow() + nodeClockSkew;
+        newPacket->writePrimitive(now);
 
-            // tell the sent packet history that we used a sequence number for an untracked packet
-            auto& sentPacketHistory = _sentPacketHistories[nodeUUID];
-            sentPacketHistory.untrackedPacketSent(sequence);
+
+        // We call this virtual function that allows our specific type of EditPacketSender to
+        // fixup the buffer for any clock skew
+        if (nodeClockSkew != 0) {
+            adjustEditPacketForClockSkew(type, editMessage, nodeClockSkew);
+        }
+
+        newPacket->write(editMessage);
+
+        // release the new packet
+        releaseQueuedPacketList(nodeUUID, std::move(newPacket));
+
+        // tell the sent packet history that we used a sequence number for an untracked packet
+        auto& sentPacketHistory = _sentPacketHistories[nodeUUID];
+        sentPacketHistory.untrackedPacketSent(sequence);
+    } else {
+        // only a NLPacket for now
+        std::unique_ptr<NLPacket>& bufferedPacket = _pendingEditPackets[nodeUUID].first;
+
+        if (!bufferedPacket) {
+            bufferedPacket = initializePacket(type, node->getClockSkewUsec());
         } else {
-            // only a NLPacket for now
-            std::unique_ptr<NLPacket>& bufferedPacket = _pendingEditPackets[nodeUUID].first;
-
-            if (!bufferedPacket) {
-                bufferedPacket = initializePacket(type, node->getClockSkewUsec());
-            } else {
-                // If we're switching type, then we send the last one and start over
-                if ((type != bufferedPacket->getType() && bufferedPacket->getPayloadSize() > 0) ||
-                    (editMessage.size() >= bufferedPacket->bytesAvailableForWrite())) {
-
-                    // create the new packet and swap it with the packet in _pendingEditPackets
-                    auto packetToRelease = initializePacket(type, node->getClockSkewUsec());
-                    bufferedPacket.swap(packetToRelease);
-
-                    // release the previously buffered packet
-                    releaseQueuedPacket(nodeUUID, std::move(packetToRelease));
-                }
-            }
+            // If we're switching type, then we send the last one and start over
+            if ((type != bufferedPacket->getType() && bufferedPacket->getPayloadSize() > 0) ||
+                (editMessage.size() >= bufferedPacket->bytesAvailableForWrite())) {
 
-            // This is really the first time we know which server/node this particular edit message
-            // is going to, so we couldn't adjust for clock skew till now. But here's our chance.
-            // We call this virtual function that allows our specific type of EditPacketSender to
-            // fixup the buffer for any clock skew
-            if (node->getClockSkewUsec() != 0) {
-                adjustEditPacketForClockSkew(type, editMessage, node->getClockSkewUsec());
-            }
+                // create the new packet and swap it with the packet in _pendingEditPackets
+                auto packetToRelease = initializePacket(type, node->getClockSkewUsec());
+                bufferedPacket.swap(packetToRelease);
 
-            bufferedPacket->write(editMessage);
+                // release the previously buffered packet
+                releaseQueuedPacket(nodeUUID, std::move(packetToRelease));
+            }
         }
-    }
 
-    _packetsQueueLock.unlock();
+        // This is really the first time we know which server/node this particular edit message
+        // is going to, so we couldn't adjust for clock skew till now. But here's our chance.
+        // We call this virtual function that allows our specific type of EditPacketSender to
+        // fixup the buffer for any clock skew
+        if (node->getClockSkewUsec() != 0) {
+            adjustEditPacketForClockSkew(type, editMessage, node->getClockSkewUsec());
+        }
 
+        bufferedPacket->write(editMessage);
+    }
 }
 
 void OctreeEditPacketSender::releaseQueuedMessages() {
@@ -13,6 +13,7 @@
 #define hifi_OctreeEditPacketSender_h
 
 #include <unordered_map>
+#include <vector>
 
 #include <PacketSender.h>
 #include <udt/PacketHeaders.h>
@@ -74,6 +75,10 @@ public slots:
 protected:
     using EditMessagePair = std::pair<PacketType, QByteArray>;
 
+    /// Queues a batch of edit messages, packing them into the pending packets under a single lock when servers are known.
+    void queueOctreeEditMessages(std::vector<EditMessagePair>& editMessages);
+    void packEditMessage(const SharedNodePointer& node, PacketType type, QByteArray& editMessage);
+
     void queuePacketToNode(const QUuid& nodeID, std::unique_ptr<NLPacket> packet);
     void queuePacketListToNode(const QUuid& nodeUUID, std::unique_ptr<NLPacketList> packetList);
 
@@ -15,6 +15,7 @@
 #include <thread>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
 #include <QtCore/QTimer>
@@ -58,6 +59,7 @@
 #include <AnimationObject.h>
 
 #include "ArrayBufferViewClass.h"
+#include "ScriptProfiler.h"
 #include "AssetScriptingInterface.h"
 #include "BatchLoader.h"
 #include "BaseScriptEngine.h"
@@ -89,6 +91,7 @@ const QString ScriptEngine::_SETTINGS_ENABLE_EXTENDED_EXCEPTIONS {
 
 static const int MAX_MODULE_ID_LENGTH { 4096 };
 static const int MAX_DEBUG_VALUE_LENGTH { 80 };
+static const int MAX_ENTITY_SCRIPT_PREFLIGHTS { 256 }; // distinct entity scripts to remember the preflight of
 
 static const QScriptEngine::QObjectWrapOptions DEFAULT_QOBJECT_WRAP_OPTIONS =
                 QScriptEngine::ExcludeDeleteLater | QScriptEngine::ExcludeChildObjects;
@@ -97,6 +100,15 @@ static const QScriptValue::PropertyFlags READONLY_HIDDEN_PROP_FLAGS { READONLY_P
 
 static const bool HIFI_AUTOREFRESH_FILE_SCRIPTS { true };
 
+// the profiler's label for a callback, only looked up while it is sampling
+static QString profileFunctionName(const QScriptValue& function) {
+    if (!ScriptProfiler::getInstance().isEnabled()) {
+        return QString();
+    }
+    auto name = function.property("name").toString();
+    return name.isEmpty() ? "(anonymous)" : name;
+}
+
 Q_DECLARE_METATYPE(QScriptEngine::FunctionSignature)
 int functionSignatureMetaID = qRegisterMetaType<QScriptEngine::FunctionSignature>();
 
@@ -173,8 +185,8 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
     _fileNameString(fileNameString),
+    _profile(ScriptProfiler::getInstance().createProfile(fileNameString)),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
 {
@@ -193,6 +205,12 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
             break;
     }
 
+    _timerClock.start();
+    _timerWheelTimer = new QTimer(this);
+    _timerWheelTimer->setSingleShot(true);
+    _timerWheelTimer->setTimerType(Qt::PreciseTimer);
+    connect(_timerWheelTimer, &QTimer::timeout, this, &ScriptEngine::runDueTimers);
+
     connect(this, &QScriptEngine::signalHandlerException, this, [this](const QScriptValue& exception) {
         if (hasUncaughtException()) {
             // the engine's uncaughtException() seems to produce much better stack traces here
@@ -721,6 +739,7 @@ void ScriptEngine::init() {
     registerGlobalObject("Midi", DependencyManager::get<Midi>().data());
 
     registerGlobalObject("Entities", entityScriptingInterface.data());
+    registerFunction("Entities", "getLazyEntityProperties", EntityScriptingInterface::getLazyEntityProperties, 2);
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
     registerGlobalObject("Mat4", &_mat4Library);
@@ -1077,6 +1096,7 @@ void ScriptEngine::run() {
 
     {
         PROFILE_RANGE(script, _fileNameString);
+        ScriptProfile::Scope profileScope(_profile.get(), "evaluate", _fileNameString, _fileNameString);
         evaluate(_scriptContents, _fileNameString);
         maybeEmitUncaughtException(__FUNCTION__);
     }
@@ -1194,11 +1214,15 @@ void ScriptEngine::run() {
                 auto preUpdate = clock::now();
                 {
                     PROFILE_RANGE(script, "ScriptUpdate");
+                    ScriptProfile::Scope profileScope(_profile.get(), "update", "update", _fileNameString);
+                    ++_environmentDepth; // the update is already timed here
                     emit update(deltaTime);
+                    --_environmentDepth;
                 }
                 auto postUpdate = clock::now();
                 auto elapsed = (postUpdate - preUpdate);
                 totalUpdates += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+                _executionTimeUsecs += std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
             }
         }
         _lastUpdate = now;
@@ -1242,32 +1266,26 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
-        stopTimer(timer);
+    if (!_timers.isEmpty()) {
+        qCDebug(scriptengine) << getFilename() << "stopAllTimers" << _timers.size();
     }
+    _timers.clear();
+    _timerWheel.clear();
+    _timerWheelTimer->stop();
+    _numTimers = 0;
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
-     // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
+     // We could maintain a separate map of entityID => timer, but someone will have to prove to me that it's worth the complexity. -HRS
+    QVector<ScriptTimerWheel::TimerID> toDelete;
+    for (auto it = _timers.cbegin(); it != _timers.cend(); ++it) {
+        if (it.value().callback.definingEntityIdentifier == entityID) {
+            toDelete << it.key(); // don't delete while we're iterating. save it.
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
     }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
+    for (auto timerID : toDelete) { // now reap 'em
+        stopTimer(timerID);
     }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1317,7 +1335,7 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+void ScriptEngine::runDueTimers() {
     {
         auto engine = DependencyManager::get<ScriptEngines>();
         if (!engine || engine->isStopped()) {
@@ -1326,80 +1344,137 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    auto now = (ScriptTimerWheel::Tick)_timerClock.elapsed();
+    std::vector<ScriptTimerWheel::DueTimer> dueTimers;
+    _timerWheel.advance(now, dueTimers);
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+    for (auto& dueTimer : dueTimers) {
+        auto it = _timers.find(dueTimer.id);
+        if (it == _timers.end()) {
+            continue; // cleared by a timer that ran before it
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        CallbackData timerData = it.value().callback;
+        if (it.value().isSingleShot) {
+            // this timer is done, we can kill it
+            _timers.erase(it);
+        } else {
+            // intervals keep their schedule, unless they have fallen more than an interval behind
+            _timerWheel.add(dueTimer.id, std::max(dueTimer.dueTick + it.value().intervalMS, now));
+        }
+
+        quint64 lagMsecs = now - dueTimer.dueTick;
+        ++_numTimersFired;
+        _totalTimerLagMsecs += lagMsecs;
+        quint64 maxLagMsecs = _maxTimerLagMsecs;
+        while (lagMsecs > maxLagMsecs && !_maxTimerLagMsecs.compare_exchange_weak(maxLagMsecs, lagMsecs)) {
+        }
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, "timerFired");
+            ScriptProfile::Scope profileScope(_profile.get(), "timer", profileFunctionName(timerData.function),
+                                              profileScriptURL(timerData.definingSandboxURL), timerData.definingEntityIdentifier);
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
+
+    _numTimers = _timers.size();
+    scheduleTimerWheel();
 }
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
+void ScriptEngine::scheduleTimerWheel() {
+    auto nextWakeTick = _timerWheel.getNextWakeTick();
+    if (nextWakeTick == UINT64_MAX) {
+        _timerWheelTimer->stop();
+        return;
+    }
+
+    auto now = (ScriptTimerWheel::Tick)_timerClock.elapsed();
+    int delayMS = nextWakeTick > now ? (int)(nextWakeTick - now) : 0; // the wheel wakes at least once per turn of its first level
 
-    // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
-    static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+    // only restart the timer when this brings it forward, restarting it is what we're saving on
+    if (!_timerWheelTimer->isActive() || delayMS < _timerWheelTimer->remainingTime()) {
+        _timerWheelTimer->start(delayMS);
     }
+}
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
+QScriptValue ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    auto timerID = _nextTimerID++;
 
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+    if (intervalMS < 0) {
+        // same as a QTimer, which never fires with a negative interval
+        qCWarning(scriptengine) << "Script timers cannot have negative intervals, the timer won't fire" << intervalMS;
+        return QScriptValue((double)timerID);
+    }
 
+    auto now = (ScriptTimerWheel::Tick)_timerClock.elapsed();
+    if (_timerWheel.size() == 0) {
+        // an empty wheel skips ahead to now rather than stepping through the time it sat idle
+        std::vector<ScriptTimerWheel::DueTimer> noTimers;
+        _timerWheel.advance(now, noTimers);
+    }
 
     CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    _timers.insert(timerID, { timerData, intervalMS, isSingleShot });
+    _timerWheel.add(timerID, now + intervalMS);
+    _numTimers = _timers.size();
 
-    newTimer->start(intervalMS);
-    return newTimer;
+    scheduleTimerWheel();
+    return QScriptValue((double)timerID);
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+QScriptValue ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QScriptValue::NullValue; // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+QScriptValue ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     if (DependencyManager::get<ScriptEngines>()->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return QScriptValue::NullValue; // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
+void ScriptEngine::stopTimer(const QScriptValue& timer) {
+    if (!timer.isNumber()) {
+        qCDebug(scriptengine) << "stopTimer -- not a timer" << timer.toString();
+        return;
+    }
+    stopTimer((ScriptTimerWheel::TimerID)timer.toNumber());
+}
+
+void ScriptEngine::stopTimer(ScriptTimerWheel::TimerID timerID) {
+    // the wheel timer isn't touched, it just wakes up for nothing if this was the next timer due
+    if (_timers.remove(timerID) > 0) {
+        _timerWheel.remove(timerID);
+        _numTimers = _timers.size();
     } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+        qCDebug(scriptengine) << "stopTimer -- not a running timer" << timerID;
     }
 }
 
+QJsonObject ScriptEngine::getAndResetTimerStats() {
+    QJsonObject stats;
+    stats["timers"] = _numTimers.load();
+    stats["fired"] = _numTimersFired.exchange(0);
+    stats["total_lag_msecs"] = (double)_totalTimerLagMsecs.exchange(0);
+    stats["max_lag_msecs"] = (double)_maxTimerLagMsecs.exchange(0);
+    return stats;
+}
+
 QUrl ScriptEngine::resolvePath(const QString& include) const {
     QUrl url(include);
     // first lets check to see if it's already a full URL -- or a Windows path like "c:/"
@@ -1871,6 +1946,8 @@ void ScriptEngine::include(const QStringList& includeFiles, QScriptValue callbac
                     // to this script's url during its initial evaluation
                     _parentURL = url.toString();
                     auto operation = [&]() {
+                        ScriptProfile::Scope profileScope(_profile.get(), "include", url.toString(),
+                                                          profileScriptURL(capturedSandboxURL), capturedEntityIdentifier);
                         evaluate(contents, url.toString());
                     };
 
@@ -1887,6 +1964,8 @@ void ScriptEngine::include(const QStringList& includeFiles, QScriptValue callbac
         _parentURL = parentURL;
 
         if (callback.isFunction()) {
+            ScriptProfile::Scope profileScope(_profile.get(), "include", profileFunctionName(callback),
+                                              profileScriptURL(capturedSandboxURL), capturedEntityIdentifier);
             callWithEnvironment(capturedEntityIdentifier, capturedSandboxURL, QScriptValue(callback), QScriptValue(), QScriptValueList());
         }
 
@@ -1968,6 +2047,8 @@ void ScriptEngine::forwardHandlerCall(const EntityItemID& entityID, const QStrin
             // and the entity scripts may be for entities other than the one this is a handler for.
             // Fortunately, the definingEntityIdentifier captured the entity script id (if any) when the handler was added.
             CallbackData& handler = handlersForEvent[i];
+            ScriptProfile::Scope profileScope(_profile.get(), "entity_event", eventName,
+                                              profileScriptURL(handler.definingSandboxURL), handler.definingEntityIdentifier);
             callWithEnvironment(handler.definingEntityIdentifier, handler.definingSandboxURL, handler.function, QScriptValue(), eventHandlerArgs);
         }
     }
@@ -2233,6 +2314,90 @@ void ScriptEngine::loadEntityScript(const EntityItemID& entityID, const QString&
     }, forceRedownload);
 }
 
+EntityScriptPreflight ScriptEngine::preflightEntityScript(const QString& contents, const QString& fileName,
+                                                          const QString& scriptOrURL) {
+    EntityScriptPreflight preflight;
+
+    // SYNTAX ERRORS
+    auto syntaxError = lintScript(contents, fileName);
+    if (syntaxError.isError()) {
+        auto message = syntaxError.property("formatted").toString();
+        if (message.isEmpty()) {
+            message = syntaxError.toString();
+        }
+        preflight.errorInfo = QString("Bad syntax (%1)").arg(message);
+        preflight.exception = syntaxError;
+        return preflight;
+    }
+    preflight.program = QScriptProgram { contents, fileName };
+    if (preflight.program.isNull()) {
+        preflight.errorInfo = "Bad program (isNull)";
+        preflight.exception = makeError("program.isNull");
+        return preflight;
+    }
+
+    // SANITY/PERFORMANCE CHECK USING SANDBOX
+    const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
+    BaseScriptEngine sandbox;
+    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
+    QScriptValue testConstructor, exception;
+    {
+        QTimer timeout;
+        timeout.setSingleShot(true);
+        timeout.start(SANDBOX_TIMEOUT);
+        connect(&timeout, &QTimer::timeout, [=, &sandbox, &preflight]{
+                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout(" << scriptOrURL << ")";
+                preflight.timedOut = true;
+
+                // Guard against infinite loops and non-performant code
+                sandbox.raiseException(
+                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
+                );
+        });
+
+        testConstructor = sandbox.evaluate(preflight.program);
+
+        if (sandbox.hasUncaughtException()) {
+            exception = sandbox.cloneUncaughtException(QString());
+            sandbox.clearExceptions();
+        } else if (testConstructor.isError()) {
+            exception = testConstructor;
+        }
+    }
+
+    if (exception.isError()) {
+        // create a local copy using makeError to decouple from the sandbox engine
+        preflight.exception = makeError(exception);
+        preflight.errorInfo = formatException(preflight.exception, _enableExtendedJSExceptions.get());
+        preflight.exceptionDetail = "(preflight %1)";
+        return preflight;
+    }
+
+    // CONSTRUCTOR VIABILITY
+    if (!testConstructor.isFunction()) {
+        QString testConstructorType = QString(testConstructor.toVariant().typeName());
+        if (testConstructorType == "") {
+            testConstructorType = "empty";
+        }
+        QString testConstructorValue = testConstructor.toString();
+        if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
+            testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
+        }
+        auto message = QString("failed to load entity script -- expected a function, got %1, %2")
+            .arg(testConstructorType).arg(testConstructorValue);
+
+        auto err = makeError(message);
+        err.setProperty("fileName", scriptOrURL);
+
+        preflight.errorInfo = "Could not find constructor (" + testConstructorType + ")";
+        preflight.exception = err;
+        preflight.exceptionDetail = "(constructor %1)";
+        return preflight;
+    }
+
+    return preflight;
+}
+
 /**jsdoc
  * Triggered when the script starts for a user.
  * <p>Note: Can only be connected to via <code>this.preload = function (...) { ... }</code> in the entity script.</p>
@@ -2318,85 +2483,36 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         return;
     }
 
-    // SYNTAX ERRORS
-    auto syntaxError = lintScript(contents, fileName);
-    if (syntaxError.isError()) {
-        auto message = syntaxError.property("formatted").toString();
-        if (message.isEmpty()) {
-            message = syntaxError.toString();
-        }
-        setError(QString("Bad syntax (%1)").arg(message), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        syntaxError.setProperty("detail", entityID.toString());
-        emit unhandledException(syntaxError);
-        return;
-    }
-    QScriptProgram program { contents, fileName };
-    if (program.isNull()) {
-        setError("Bad program (isNull)", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(makeError("program.isNull"));
-        return; // done processing script
-    }
-
-    if (isURL) {
-        setParentURL(scriptOrURL);
-    }
-
-    // SANITY/PERFORMANCE CHECK USING SANDBOX
-    const int SANDBOX_TIMEOUT = 0.25 * MSECS_PER_SECOND;
-    BaseScriptEngine sandbox;
-    sandbox.setProcessEventsInterval(SANDBOX_TIMEOUT);
-    QScriptValue testConstructor, exception;
-    {
-        QTimer timeout;
-        timeout.setSingleShot(true);
-        timeout.start(SANDBOX_TIMEOUT);
-        connect(&timeout, &QTimer::timeout, [=, &sandbox]{
-                qCDebug(scriptengine) << "ScriptEngine::entityScriptContentAvailable timeout(" << scriptOrURL << ")";
-
-                // Guard against infinite loops and non-performant code
-                sandbox.raiseException(
-                    sandbox.makeError(QString("Timed out (entity constructors are limited to %1ms)").arg(SANDBOX_TIMEOUT))
-                );
-        });
-
-        testConstructor = sandbox.evaluate(program);
+    // SYNTAX ERRORS, SANITY/PERFORMANCE CHECK USING SANDBOX AND CONSTRUCTOR VIABILITY
+    // these only depend on the script, so they are done once for all the entities sharing it
+    QByteArray preflightKey = QCryptographicHash::hash(fileName.toUtf8() + '\0' + contents.toUtf8(), QCryptographicHash::Sha1);
+    EntityScriptPreflight preflight;
+    auto preflightIt = _entityScriptPreflights.constFind(preflightKey);
+    if (preflightIt != _entityScriptPreflights.constEnd()) {
+        preflight = preflightIt.value();
+    } else {
+        preflight = preflightEntityScript(contents, fileName, scriptOrURL);
 
-        if (sandbox.hasUncaughtException()) {
-            exception = sandbox.cloneUncaughtException(QString("(preflight %1)").arg(entityID.toString()));
-            sandbox.clearExceptions();
-        } else if (testConstructor.isError()) {
-            exception = testConstructor;
+        // a sandbox timeout can come from how busy the process was rather than from the script, so it is tried again
+        if (!preflight.timedOut) {
+            if (_entityScriptPreflights.size() >= MAX_ENTITY_SCRIPT_PREFLIGHTS) {
+                _entityScriptPreflights.clear();
+            }
+            _entityScriptPreflights.insert(preflightKey, preflight);
         }
     }
 
-    if (exception.isError()) {
-        // create a local copy using makeError to decouple from the sandbox engine
-        exception = makeError(exception);
-        setError(formatException(exception, _enableExtendedJSExceptions.get()), EntityScriptStatus::ERROR_RUNNING_SCRIPT);
+    if (!preflight.errorInfo.isEmpty()) {
+        // the cached error is shared by every entity running this script, so each one reports its own copy
+        auto exception = makeError(preflight.exception, preflight.exception.property("name").toString());
+        exception.setProperty("detail", preflight.exceptionDetail.arg(entityID.toString()));
+        setError(preflight.errorInfo, EntityScriptStatus::ERROR_RUNNING_SCRIPT);
         emit unhandledException(exception);
         return;
     }
 
-    // CONSTRUCTOR VIABILITY
-    if (!testConstructor.isFunction()) {
-        QString testConstructorType = QString(testConstructor.toVariant().typeName());
-        if (testConstructorType == "") {
-            testConstructorType = "empty";
-        }
-        QString testConstructorValue = testConstructor.toString();
-        if (testConstructorValue.size() > MAX_DEBUG_VALUE_LENGTH) {
-            testConstructorValue = testConstructorValue.mid(0, MAX_DEBUG_VALUE_LENGTH) + "...";
-        }
-        auto message = QString("failed to load entity script -- expected a function, got %1, %2")
-            .arg(testConstructorType).arg(testConstructorValue);
-
-        auto err = makeError(message);
-        err.setProperty("fileName", scriptOrURL);
-        err.setProperty("detail", "(constructor " + entityID.toString() + ")");
-
-        setError("Could not find constructor (" + testConstructorType + ")", EntityScriptStatus::ERROR_RUNNING_SCRIPT);
-        emit unhandledException(err);
-        return; // done processing script
+    if (isURL) {
+        setParentURL(scriptOrURL);
     }
 
     // (this feeds into refreshFileScript)
@@ -2410,7 +2526,13 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
     QScriptValue entityScriptConstructor, entityScriptObject;
     QUrl sandboxURL = currentSandboxURL.isEmpty() ? scriptOrURL : currentSandboxURL;
     auto initialization = [&]{
-        entityScriptConstructor = evaluate(contents, fileName);
+        if (DependencyManager::get<ScriptEngines>()->isStopped()) {
+            return;
+        }
+
+        // already linted and compiled by the preflight
+        entityScriptConstructor = BaseScriptEngine::evaluate(preflight.program);
+        maybeEmitUncaughtException("evaluate");
         entityScriptObject = entityScriptConstructor.construct();
 
         if (hasUncaughtException()) {
@@ -2419,7 +2541,10 @@ void ScriptEngine::entityScriptContentAvailable(const EntityItemID& entityID, co
         }
     };
 
-    doWithEnvironment(entityID, sandboxURL, initialization);
+    {
+        ScriptProfile::Scope profileScope(_profile.get(), "entity_construct", fileName, profileScriptURL(sandboxURL), entityID);
+        doWithEnvironment(entityID, sandboxURL, initialization);
+    }
 
     if (entityScriptObject.isError()) {
         auto exception = entityScriptObject;
@@ -2571,6 +2696,13 @@ void ScriptEngine::refreshFileScript(const EntityItemID& entityID) {
     recurseGuard = false;
 }
 
+QString ScriptEngine::profileScriptURL(const QUrl& sandboxURL) const {
+    if (!ScriptProfiler::getInstance().isEnabled()) {
+        return QString();
+    }
+    return sandboxURL.isEmpty() ? _fileNameString : sandboxURL.toString();
+}
+
 // Execute operation in the appropriate context for (the possibly empty) entityID.
 // Even if entityID is supplied as currentEntityIdentifier, this still documents the source
 // of the code being executed (e.g., if we ever sandbox different entity scripts, or provide different
@@ -2581,6 +2713,8 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    auto startTime = (_environmentDepth++ == 0) ? usecTimestampNow() : 0;
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2590,6 +2724,11 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     operation();
 #endif
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
+
+    if (--_environmentDepth == 0) {
+        _executionTimeUsecs += usecTimestampNow() - startTime;
+    }
+
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
 }
@@ -2662,6 +2801,8 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
 
             QScriptValue oldData = this->globalObject().property("Script").property("remoteCallerID");
             this->globalObject().property("Script").setProperty("remoteCallerID", remoteCallerID.toString()); // Make the remoteCallerID available to javascript as a global.
+            ScriptProfile::Scope profileScope(_profile.get(), "entity_method", methodName,
+                                              profileScriptURL(details.definingSandboxURL), entityID);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
             this->globalObject().property("Script").setProperty("remoteCallerID", oldData);
         }
@@ -2700,6 +2841,8 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             QScriptValueList args;
             args << entityID.toScriptValue(this);
             args << event.toScriptValue(this);
+            ScriptProfile::Scope profileScope(_profile.get(), "entity_method", methodName,
+                                              profileScriptURL(details.definingSandboxURL), entityID);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
@@ -2739,6 +2882,8 @@ void ScriptEngine::callEntityScriptMethod(const EntityItemID& entityID, const QS
             args << entityID.toScriptValue(this);
             args << otherID.toScriptValue(this);
             args << collisionToScriptValue(this, collision);
+            ScriptProfile::Scope profileScope(_profile.get(), "entity_method", methodName,
+                                              profileScriptURL(details.definingSandboxURL), entityID);
             callWithEnvironment(entityID, details.definingSandboxURL, entityScript.property(methodName), entityScript, args);
         }
     }
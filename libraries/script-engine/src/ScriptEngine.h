@@ -12,9 +12,12 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QSet>
@@ -22,6 +25,7 @@
 #include <QtCore/QStringList>
 
 #include <QtScript/QScriptEngine>
+#include <QtScript/QScriptProgram>
 
 #include <AnimationCache.h>
 #include <AnimVariant.h>
@@ -40,6 +44,7 @@
 #include "Quat.h"
 #include "Mat4.h"
 #include "ScriptCache.h"
+#include "ScriptTimerWheel.h"
 #include "ScriptUUID.h"
 #include "Vec3.h"
 #include "ConsoleScriptingInterface.h"
@@ -55,6 +60,7 @@ static const int DEFAULT_MAX_ENTITY_PPS = 9000;
 static const int DEFAULT_ENTITY_PPS_PER_SCRIPT = 900;
 
 class ScriptEngines;
+class ScriptProfile;
 
 Q_DECLARE_METATYPE(ScriptEnginePointer)
 
@@ -99,6 +105,19 @@ public:
     QUrl definingSandboxURL { QUrl("about:EntityScript") };
 };
 
+// The outcome of the lint, compile and sandboxed constructor check of an entity script, which only depend on the
+// script's contents, so entities sharing a script only pay for them once
+class EntityScriptPreflight {
+public:
+    QScriptProgram program;
+
+    // if the script can't be used these are reported for every entity that loads it
+    QString errorInfo { "" };
+    QScriptValue exception { QScriptValue() };
+    QString exceptionDetail { "%1" }; // %1 is replaced with the entity ID
+    bool timedOut { false }; // the sandbox run hit its time limit
+};
+
 /**jsdoc
  * @namespace Script
  *
@@ -366,31 +385,31 @@ public:
      * @function Script.setInterval
      * @param {function} function - The function to call. Can be an in-line function or the name of a function.
      * @param {number} interval - The interval at which to call the function, in ms.
-     * @returns {object} A handle to the interval timer. Can be used by {@link Script.clearInterval}.
+     * @returns {number} A handle to the interval timer. Can be used by {@link Script.clearInterval}.
      * @example <caption>Print a message every second.</caption>
      * Script.setInterval(function () {
      *     print("Timer fired");
      * }, 1000);
     */
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE QScriptValue setInterval(const QScriptValue& function, int intervalMS);
 
     /**jsdoc
      * Call a function after a delay.
      * @function Script.setTimeout
      * @param {function} function - The function to call. Can be an in-line function or the name of a function.
      * @param {number} timeout - The delay after which to call the function, in ms.
-     * @returns {object} A handle to the timeout timer. Can be used by {@link Script.clearTimeout}.
+     * @returns {number} A handle to the timeout timer. Can be used by {@link Script.clearTimeout}.
      * @example <caption>Print a message after a second.</caption>
      * Script.setTimeout(function () {
      *     print("Timer fired");
      * }, 1000);
      */
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE QScriptValue setTimeout(const QScriptValue& function, int timeoutMS);
 
     /**jsdoc
      * Stop an interval timer set by {@link Script.setInterval|setInterval}.
      * @function Script.clearInterval
-     * @param {object} timer - The interval timer to clear.
+     * @param {number} timer - The interval timer to clear.
      * @example <caption>Stop an interval timer.</caption>
      * // Print a message every second.
      * var timer = Script.setInterval(function () {
@@ -403,12 +422,12 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(const QScriptValue& timer) { stopTimer(timer); }
 
     /**jsdoc
      * Clear a timeout timer set by {@link Script.setTimeout|setTimeout}.
      * @function Script.clearTimeout
-     * @param {object} timer - The timeout timer to clear.
+     * @param {number} timer - The timeout timer to clear.
      * @example <caption>Stop a timeout timer.</caption>
      * // Print a message after two seconds.
      * var timer = Script.setTimeout(function () {
@@ -418,7 +437,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(const QScriptValue& timer) { stopTimer(timer); }
 
     /**jsdoc
      * @function Script.print
@@ -563,6 +582,12 @@ public:
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
+    // wall clock time this engine has spent running script code (updates, timers and entity script calls)
+    quint64 getExecutionTimeUsecs() const { return _executionTimeUsecs; }
+
+    // pending timers, and the timers fired and how late they were since the last call, safe to call from any thread
+    QJsonObject getAndResetTimerStats();
+
 public slots:
 
     /**jsdoc
@@ -733,7 +758,7 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void runDueTimers();
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
     void refreshFileScript(const EntityItemID& entityID);
@@ -741,9 +766,12 @@ protected:
     void setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details);
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
     void processDeferredEntityLoads(const QString& entityScript, const EntityItemID& leaderID);
+    EntityScriptPreflight preflightEntityScript(const QString& contents, const QString& fileName, const QString& scriptOrURL);
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    QScriptValue setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(const QScriptValue& timer);
+    void stopTimer(ScriptTimerWheel::TimerID timerID);
+    void scheduleTimerWheel();
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -762,6 +790,7 @@ protected:
     EntityItemID currentEntityIdentifier {}; // Contains the defining entity script entity id during execution, if any. Empty for interface script execution.
     QUrl currentSandboxURL {}; // The toplevel url string for the entity script that loaded the code being executed, else empty.
     void doWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, std::function<void()> operation);
+    QString profileScriptURL(const QUrl& sandboxURL) const; // the script a callback is charged to by the profiler
     void callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args);
 
     Context _context;
@@ -772,13 +801,30 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+
+    // script timers are kept in a timer wheel and run by a single QTimer set for the next one due
+    struct ScriptTimer {
+        CallbackData callback;
+        int intervalMS;
+        bool isSingleShot;
+    };
+    QHash<ScriptTimerWheel::TimerID, ScriptTimer> _timers;
+    ScriptTimerWheel _timerWheel; // in msecs of _timerClock
+    ScriptTimerWheel::TimerID _nextTimerID { 1 };
+    QElapsedTimer _timerClock;
+    QTimer* _timerWheelTimer { nullptr };
+
+    std::atomic<int> _numTimers { 0 };
+    std::atomic<int> _numTimersFired { 0 };
+    std::atomic<quint64> _totalTimerLagMsecs { 0 };
+    std::atomic<quint64> _maxTimerLagMsecs { 0 };
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
     QHash<QString, EntityItemID> _occupiedScriptURLs;
     QList<DeferredLoadEntity> _deferredEntityLoads;
     EntityScriptContentAvailableMap _contentAvailableQueue;
+    QHash<QByteArray, EntityScriptPreflight> _entityScriptPreflights; // by hash of file name and contents
 
     bool _isThreaded { false };
     QScriptEngineDebugger* _debugger { nullptr };
@@ -786,6 +832,7 @@ protected:
     qint64 _lastUpdate;
 
     QString _fileNameString;
+    std::shared_ptr<ScriptProfile> _profile;
     Quat _quatLibrary;
     Vec3 _vec3Library;
     Mat4 _mat4Library;
@@ -806,6 +853,9 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    std::atomic<quint64> _executionTimeUsecs { 0 };
+    int _environmentDepth { 0 }; // nested doWithEnvironment calls are only timed once
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
@@ -0,0 +1,209 @@
+//
+//  ScriptProfiler.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfiler.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonArray>
+
+#include <NumericalConstants.h>
+
+const int ScriptProfiler::MAX_SAMPLE_RATE = 1000;
+
+static const int MAX_SUMMARY_ENTRIES = 10;
+
+// folded stacks use ';' between frames and a space before the count
+static QString foldedFrameName(const QString& name) {
+    QString result = name;
+    result.replace(';', ':');
+    result.replace('\n', ' ');
+    return result.trimmed();
+}
+
+ScriptProfiler& ScriptProfiler::getInstance() {
+    static ScriptProfiler instance;
+    return instance;
+}
+
+ScriptProfiler::~ScriptProfiler() {
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        _isStopping = true;
+    }
+    _threadCondition.notify_all();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void ScriptProfiler::setSampleRate(int sampleRate) {
+    sampleRate = std::min(std::max(0, sampleRate), MAX_SAMPLE_RATE);
+    {
+        std::lock_guard<std::mutex> lock(_threadMutex);
+        _sampleRate = sampleRate;
+        if (sampleRate > 0 && !_thread.joinable()) {
+            _thread = std::thread([this] { sampleLoop(); });
+        }
+    }
+    _threadCondition.notify_all();
+}
+
+std::shared_ptr<ScriptProfile> ScriptProfiler::createProfile(const QString& engineName) {
+    auto profile = std::make_shared<ScriptProfile>(engineName);
+
+    std::lock_guard<std::mutex> lock(_profilesMutex);
+    _profiles.erase(std::remove_if(_profiles.begin(), _profiles.end(), [](const std::weak_ptr<ScriptProfile>& profile) {
+        return profile.expired();
+    }), _profiles.end());
+    _profiles.push_back(profile);
+
+    return profile;
+}
+
+void ScriptProfiler::sampleLoop() {
+    std::unique_lock<std::mutex> lock(_threadMutex);
+    while (!_isStopping) {
+        int sampleRate = _sampleRate;
+        if (sampleRate == 0) {
+            _threadCondition.wait(lock);
+            continue;
+        }
+
+        quint64 intervalUsecs = USECS_PER_SECOND / sampleRate;
+        if (_threadCondition.wait_for(lock, std::chrono::microseconds(intervalUsecs)) == std::cv_status::no_timeout) {
+            continue; // the rate changed or we're stopping
+        }
+
+        lock.unlock();
+        sample(intervalUsecs);
+        lock.lock();
+    }
+}
+
+void ScriptProfiler::sample(quint64 intervalUsecs) {
+    std::vector<ScriptProfile::Frame> frames;
+    {
+        std::lock_guard<std::mutex> lock(_profilesMutex);
+        frames.reserve(_profiles.size());
+        for (auto& weakProfile : _profiles) {
+            if (auto profile = weakProfile.lock()) {
+                // only the innermost callback is charged, its stack already has the ones around it
+                std::lock_guard<std::mutex> framesLock(profile->_framesMutex);
+                if (!profile->_frames.empty()) {
+                    frames.push_back(profile->_frames.back());
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    _sampledUsecs += intervalUsecs;
+    for (auto& frame : frames) {
+        ++_stackSamples[frame.stack];
+        _scriptUsecs[frame.scriptURL] += intervalUsecs;
+        if (!frame.entityID.isEmpty()) {
+            _entityUsecs[frame.entityID] += intervalUsecs;
+        }
+        _typeUsecs[frame.type] += intervalUsecs;
+    }
+}
+
+static QJsonArray busiest(const QHash<QString, quint64>& usecs, const QString& nameKey) {
+    std::vector<std::pair<quint64, QString>> entries;
+    entries.reserve(usecs.size());
+    for (auto it = usecs.cbegin(); it != usecs.cend(); ++it) {
+        entries.emplace_back(it.value(), it.key());
+    }
+    auto numEntries = std::min<size_t>(entries.size(), MAX_SUMMARY_ENTRIES);
+    std::partial_sort(entries.begin(), entries.begin() + numEntries, entries.end(),
+                      [](const std::pair<quint64, QString>& a, const std::pair<quint64, QString>& b) {
+        return a.first > b.first;
+    });
+
+    QJsonArray array;
+    for (size_t i = 0; i < numEntries; ++i) {
+        QJsonObject entry;
+        entry[nameKey] = entries[i].second;
+        entry["msecs"] = (double)entries[i].first / USECS_PER_MSEC;
+        array.append(entry);
+    }
+    return array;
+}
+
+QJsonObject ScriptProfiler::getSummary(bool reset) {
+    QJsonObject summary;
+    summary["sample_rate"] = _sampleRate.load();
+
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    summary["sampled_msecs"] = (double)_sampledUsecs / USECS_PER_MSEC;
+
+    QJsonObject types;
+    for (auto it = _typeUsecs.cbegin(); it != _typeUsecs.cend(); ++it) {
+        types[it.key()] = (double)it.value() / USECS_PER_MSEC;
+    }
+    summary["callback_types"] = types;
+    summary["scripts"] = busiest(_scriptUsecs, "url");
+    summary["entities"] = busiest(_entityUsecs, "id");
+
+    if (reset) {
+        clearSamples();
+    }
+
+    return summary;
+}
+
+QString ScriptProfiler::getFoldedStacks() {
+    QString folded;
+
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    for (auto it = _stackSamples.cbegin(); it != _stackSamples.cend(); ++it) {
+        folded += it.key() + ' ' + QString::number(it.value()) + '\n';
+    }
+    return folded;
+}
+
+void ScriptProfiler::reset() {
+    std::lock_guard<std::mutex> lock(_samplesMutex);
+    clearSamples();
+}
+
+void ScriptProfiler::clearSamples() {
+    _stackSamples.clear();
+    _scriptUsecs.clear();
+    _entityUsecs.clear();
+    _typeUsecs.clear();
+    _sampledUsecs = 0;
+}
+
+ScriptProfile::Scope::Scope(ScriptProfile* profile, const char* type, const QString& label,
+                            const QString& scriptURL, const QUuid& entityID) {
+    if (!profile || !ScriptProfiler::getInstance().isEnabled()) {
+        return;
+    }
+    _profile = profile;
+
+    ScriptProfile::Frame frame;
+    frame.scriptURL = scriptURL;
+    frame.entityID = entityID.isNull() ? QString() : entityID.toString();
+    frame.type = type;
+
+    std::lock_guard<std::mutex> lock(_profile->_framesMutex);
+    QString parentStack = _profile->_frames.empty() ? foldedFrameName(_profile->_engineName) : _profile->_frames.back().stack;
+    frame.stack = parentStack + ';' + foldedFrameName(scriptURL) + ';' + type + ':' + foldedFrameName(label);
+    _profile->_frames.push_back(frame);
+}
+
+ScriptProfile::Scope::~Scope() {
+    if (_profile) {
+        std::lock_guard<std::mutex> lock(_profile->_framesMutex);
+        _profile->_frames.pop_back();
+    }
+}
@@ -0,0 +1,115 @@
+//
+//  ScriptProfiler.h
+//  libraries/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProfiler_h
+#define hifi_ScriptProfiler_h
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+class ScriptProfile;
+
+// A sampling profiler for the script engines of the process. Script engines mark the callbacks they run (timers,
+// updates, entity methods and events, evaluations) with a ScriptProfile::Scope, and a sampler thread looks at what
+// each engine is running at the sample rate, so time is attributed per script URL, per entity and per callback type.
+//
+// Script engines can't be inspected from another thread, so the sampled stacks are made of the marked callbacks,
+// not of every script function. Signal handlers connected from scripts are counted as part of whatever emitted them.
+class ScriptProfiler {
+public:
+    static const int MAX_SAMPLE_RATE;
+
+    static ScriptProfiler& getInstance();
+
+    ~ScriptProfiler();
+
+    // samples per second, 0 stops sampling
+    void setSampleRate(int sampleRate);
+    int getSampleRate() const { return _sampleRate; }
+    bool isEnabled() const { return _sampleRate > 0; }
+
+    // each script engine keeps a profile for as long as it lives
+    std::shared_ptr<ScriptProfile> createProfile(const QString& engineName);
+
+    // msecs attributed to each callback type and to the busiest scripts and entities since the last reset
+    QJsonObject getSummary(bool reset = false);
+
+    // the samples since the last reset, in the folded format read by flamegraph.pl and speedscope
+    QString getFoldedStacks();
+
+    void reset();
+
+private:
+    ScriptProfiler() {}
+
+    void sampleLoop();
+    void sample(quint64 intervalUsecs);
+    void clearSamples(); // with _samplesMutex held
+
+    std::atomic<int> _sampleRate { 0 };
+
+    std::mutex _profilesMutex;
+    std::vector<std::weak_ptr<ScriptProfile>> _profiles;
+
+    std::mutex _threadMutex;
+    std::condition_variable _threadCondition;
+    std::thread _thread;
+    bool _isStopping { false };
+
+    // touched by the sampler thread and by readers, under _samplesMutex
+    std::mutex _samplesMutex;
+    QHash<QString, quint64> _stackSamples;
+    QHash<QString, quint64> _scriptUsecs;
+    QHash<QString, quint64> _entityUsecs;
+    QHash<QString, quint64> _typeUsecs;
+    quint64 _sampledUsecs { 0 };
+};
+
+class ScriptProfile {
+public:
+    ScriptProfile(const QString& engineName) : _engineName(engineName) {}
+
+    // marks a callback run by the engine for as long as it is in scope, does nothing if the profiler is off
+    class Scope {
+    public:
+        Scope(ScriptProfile* profile, const char* type, const QString& label,
+              const QString& scriptURL, const QUuid& entityID = QUuid());
+        ~Scope();
+
+    private:
+        ScriptProfile* _profile { nullptr };
+    };
+
+private:
+    friend class ScriptProfiler;
+
+    struct Frame {
+        QString stack; // folded, from the engine down to this callback
+        QString scriptURL;
+        QString entityID;
+        const char* type;
+    };
+
+    const QString _engineName;
+
+    std::mutex _framesMutex;
+    std::vector<Frame> _frames;
+};
+
+#endif // hifi_ScriptProfiler_h
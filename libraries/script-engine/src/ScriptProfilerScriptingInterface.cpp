@@ -0,0 +1,30 @@
+//
+//  ScriptProfilerScriptingInterface.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProfilerScriptingInterface.h"
+
+#include "ScriptProfiler.h"
+
+int ScriptProfilerScriptingInterface::getSampleRate() const {
+    return ScriptProfiler::getInstance().getSampleRate();
+}
+
+void ScriptProfilerScriptingInterface::setSampleRate(int sampleRate) {
+    ScriptProfiler::getInstance().setSampleRate(sampleRate);
+}
+
+QVariantMap ScriptProfilerScriptingInterface::getSummary() const {
+    // the stats packets own resetting the samples, a script reading them mustn't take them from the other readers
+    return ScriptProfiler::getInstance().getSummary().toVariantMap();
+}
+
+QString ScriptProfilerScriptingInterface::getFoldedStacks() const {
+    return ScriptProfiler::getInstance().getFoldedStacks();
+}
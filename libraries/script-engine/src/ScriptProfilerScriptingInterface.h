@@ -0,0 +1,64 @@
+//
+//  ScriptProfilerScriptingInterface.h
+//  libraries/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ScriptProfilerScriptingInterface_h
+#define hifi_ScriptProfilerScriptingInterface_h
+
+#include <QtCore/QObject>
+#include <QtCore/QVariantMap>
+
+/**jsdoc
+ * The ScriptProfiler API controls the sampling profiler shared by all the script engines of the process. It is only
+ * available to assignment client scripts, since it reports on every script the process runs. On the entity script
+ * server the profiler is controlled by the domain's entity script server settings instead.
+ * @namespace ScriptProfiler
+ *
+ * @hifi-assignment-client
+ */
+class ScriptProfilerScriptingInterface : public QObject {
+    Q_OBJECT
+
+public:
+    ScriptProfilerScriptingInterface(QObject* parent = nullptr) : QObject(parent) {}
+
+    /**jsdoc
+     * Get the number of times per second the profiler samples what the script engines of this process are running.
+     * @function ScriptProfiler.getSampleRate
+     * @returns {number} The sample rate, <code>0</code> if the profiler is off.
+     */
+    Q_INVOKABLE int getSampleRate() const;
+
+    /**jsdoc
+     * Start, stop or change the rate of the profiler. It charges each sample to the timer, update, entity method,
+     * entity event or evaluation that was running, and to its script and entity.
+     * @function ScriptProfiler.setSampleRate
+     * @param {number} sampleRate - Samples per second, up to <code>1000</code>. <code>0</code> stops the profiler.
+     */
+    Q_INVOKABLE void setSampleRate(int sampleRate);
+
+    /**jsdoc
+     * Get the time the profiler has charged to each callback type and to the busiest scripts and entities since the
+     * stats were last sent to the domain server.
+     * @function ScriptProfiler.getSummary
+     * @returns {object}
+     */
+    Q_INVOKABLE QVariantMap getSummary() const;
+
+    /**jsdoc
+     * Get the profiler's samples as folded stacks, the format read by flame graph tools such as flamegraph.pl.
+     * @function ScriptProfiler.getFoldedStacks
+     * @returns {string}
+     */
+    Q_INVOKABLE QString getFoldedStacks() const;
+};
+
+#endif // hifi_ScriptProfilerScriptingInterface_h
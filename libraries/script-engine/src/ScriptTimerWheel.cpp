@@ -0,0 +1,120 @@
+//
+//  ScriptTimerWheel.cpp
+//  libraries/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptTimerWheel.h"
+
+#include <algorithm>
+
+ScriptTimerWheel::ScriptTimerWheel() :
+    _slots(LEVEL_0_SLOTS + (NUM_LEVELS - 1) * LEVEL_SLOTS)
+{
+}
+
+int ScriptTimerWheel::slotIndex(int level, Tick tick) const {
+    if (level == 0) {
+        return (int)(tick & (LEVEL_0_SLOTS - 1));
+    }
+    int shift = LEVEL_0_BITS + (level - 1) * LEVEL_BITS;
+    return LEVEL_0_SLOTS + (level - 1) * LEVEL_SLOTS + (int)((tick >> shift) & (LEVEL_SLOTS - 1));
+}
+
+std::vector<ScriptTimerWheel::DueTimer>& ScriptTimerWheel::slotFor(Tick dueTick) {
+    dueTick = std::max(dueTick, _currentTick);
+    Tick delta = dueTick - _currentTick;
+
+    for (int level = 0; level < NUM_LEVELS; ++level) {
+        Tick levelSpan = (Tick)1 << (LEVEL_0_BITS + level * LEVEL_BITS);
+        if (delta < levelSpan) {
+            return _slots[slotIndex(level, dueTick)];
+        }
+    }
+
+    // too far out for the wheel, park it in the farthest slot it reaches and it gets put back in place from there
+    Tick farthestTick = _currentTick + ((Tick)1 << (LEVEL_0_BITS + (NUM_LEVELS - 1) * LEVEL_BITS)) - 1;
+    return _slots[slotIndex(NUM_LEVELS - 1, farthestTick)];
+}
+
+void ScriptTimerWheel::add(TimerID id, Tick dueTick) {
+    _dueTicks[id] = dueTick;
+    slotFor(dueTick).push_back({ id, dueTick });
+}
+
+bool ScriptTimerWheel::remove(TimerID id) {
+    return _dueTicks.erase(id) > 0;
+}
+
+void ScriptTimerWheel::clear() {
+    for (auto& slot : _slots) {
+        slot.clear();
+    }
+    _dueTicks.clear();
+}
+
+int ScriptTimerWheel::cascade(int level) {
+    int index = slotIndex(level, _currentTick);
+
+    std::vector<DueTimer> timers;
+    timers.swap(_slots[index]);
+    for (auto& timer : timers) {
+        auto it = _dueTicks.find(timer.id);
+        if (it != _dueTicks.end() && it->second == timer.dueTick) {
+            slotFor(timer.dueTick).push_back(timer);
+        }
+    }
+
+    return index - (LEVEL_0_SLOTS + (level - 1) * LEVEL_SLOTS);
+}
+
+void ScriptTimerWheel::advance(Tick now, std::vector<DueTimer>& dueTimers) {
+    if (_dueTicks.empty()) {
+        _currentTick = std::max(_currentTick, now + 1);
+        return;
+    }
+
+    while (_currentTick <= now) {
+        // at the start of each turn of a level, the slot of the level above that is now in range comes down
+        if (slotIndex(0, _currentTick) == 0) {
+            for (int level = 1; level < NUM_LEVELS; ++level) {
+                if (cascade(level) != 0) {
+                    break;
+                }
+            }
+        }
+
+        auto& slot = _slots[slotIndex(0, _currentTick)];
+        if (!slot.empty()) {
+            std::vector<DueTimer> timers;
+            timers.swap(slot);
+            for (auto& timer : timers) {
+                auto it = _dueTicks.find(timer.id);
+                if (it != _dueTicks.end() && it->second == timer.dueTick) {
+                    _dueTicks.erase(it);
+                    dueTimers.push_back(timer);
+                }
+            }
+        }
+
+        ++_currentTick;
+    }
+}
+
+ScriptTimerWheel::Tick ScriptTimerWheel::getNextWakeTick() const {
+    if (_dueTicks.empty()) {
+        return UINT64_MAX;
+    }
+
+    // the next occupied slot of the first level, or the start of its next turn when more timers may come down,
+    // which can be the current tick when the last advance stopped on the boundary before cascading
+    for (Tick tick = _currentTick; ; ++tick) {
+        if (!_slots[slotIndex(0, tick)].empty() || slotIndex(0, tick) == 0) {
+            return tick;
+        }
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  ScriptTimerWheel.h
+//  libraries/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptTimerWheel_h
+#define hifi_ScriptTimerWheel_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+// A hierarchical timer wheel with a resolution of one tick (a millisecond for the script engine). The first level has
+// a slot for each of the next 256 ticks and each level above it covers 64 slots of the one below, so adding and
+// removing a timer are O(1) and timers only move down a level when their slot comes around. Timers further out than
+// the top level reaches are kept in its last slot and put back in place when they come around.
+//
+// The wheel only knows timer IDs and the tick they are due at, the callbacks are kept by its owner.
+class ScriptTimerWheel {
+public:
+    using TimerID = int64_t;
+    using Tick = uint64_t;
+
+    struct DueTimer {
+        TimerID id;
+        Tick dueTick;
+    };
+
+    ScriptTimerWheel();
+
+    size_t size() const { return _dueTicks.size(); }
+    bool contains(TimerID id) const { return _dueTicks.find(id) != _dueTicks.end(); }
+
+    // schedules (or reschedules) the timer, a due tick that has already passed comes due on the next advance
+    void add(TimerID id, Tick dueTick);
+    bool remove(TimerID id);
+    void clear();
+
+    // moves the wheel up to now, appending the timers that have come due in the order they came due,
+    // they are no longer in the wheel once returned
+    void advance(Tick now, std::vector<DueTimer>& dueTimers);
+
+    // a tick at or before the one the next timer is due at, or UINT64_MAX if there are no timers
+    Tick getNextWakeTick() const;
+
+private:
+    static const int LEVEL_0_BITS = 8;
+    static const int LEVEL_BITS = 6;
+    static const int NUM_LEVELS = 4;
+    static const int LEVEL_0_SLOTS = 1 << LEVEL_0_BITS;
+    static const int LEVEL_SLOTS = 1 << LEVEL_BITS;
+
+    std::vector<DueTimer>& slotFor(Tick dueTick);
+    int slotIndex(int level, Tick tick) const;
+    int cascade(int level); // returns the index of the slot that was cascaded
+
+    Tick _currentTick { 0 }; // the next tick to be processed
+
+    // level 0 followed by the higher levels, each slot holds the timers due in it. Removed and rescheduled timers are
+    // only dropped from their old slot when it is processed.
+    std::vector<std::vector<DueTimer>> _slots;
+    std::unordered_map<TimerID, Tick> _dueTicks;
+};
+
+#endif // hifi_ScriptTimerWheel_h
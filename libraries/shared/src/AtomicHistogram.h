@@ -0,0 +1,74 @@
+//
+//  AtomicHistogram.h
+//  libraries/shared/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AtomicHistogram_h
+#define hifi_AtomicHistogram_h
+
+#include <array>
+#include <atomic>
+#include <stdint.h>
+
+/// Lock-free histogram with power-of-two bucket widths. Bucket 0 holds samples of 0, bucket N holds
+/// samples in [2^(N-1), 2^N), and the last bucket collects everything larger. Samples can be added
+/// from any number of threads without locking; readers get a (possibly slightly stale) snapshot.
+template <int NUM_BUCKETS = 24>
+class AtomicHistogram {
+public:
+    static_assert(NUM_BUCKETS > 1 && NUM_BUCKETS <= 64, "AtomicHistogram supports between 2 and 64 buckets");
+
+    using Counts = std::array<uint64_t, NUM_BUCKETS>;
+
+    AtomicHistogram() { reset(); }
+
+    void addSample(uint64_t sample) {
+        _buckets[bucketForSample(sample)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void reset() {
+        for (auto& bucket : _buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    Counts getCounts() const {
+        Counts counts;
+        for (int i = 0; i < NUM_BUCKETS; i++) {
+            counts[i] = _buckets[i].load(std::memory_order_relaxed);
+        }
+        return counts;
+    }
+
+    uint64_t getSampleCount() const {
+        uint64_t total = 0;
+        for (auto& bucket : _buckets) {
+            total += bucket.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /// returns the exclusive upper bound of a bucket, or 0 for the open-ended last bucket
+    static uint64_t getBucketUpperBound(int bucket) {
+        return (bucket < NUM_BUCKETS - 1) ? ((uint64_t)1 << bucket) : 0;
+    }
+
+    static int bucketForSample(uint64_t sample) {
+        int bucket = 0;
+        while (sample > 0 && bucket < NUM_BUCKETS - 1) {
+            sample >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+private:
+    std::array<std::atomic<uint64_t>, NUM_BUCKETS> _buckets;
+};
+
+#endif // hifi_AtomicHistogram_h
@@ -65,5 +65,24 @@ ColumnLayout {
         color: "dimgrey"
         source: stream.lossRate.toFixed(2) + "% (" + stream.lossCount + " lost)"
     }
+
+    Label {
+        Layout.alignment: Qt.AlignCenter
+        text: "Time-Stretching"
+        font.italic: true
+    }
+    Value {
+        label: "Added Latency"
+        source: stream.addedLatencyMs + " ms"
+    }
+    Value {
+        label: "Concealed"
+        source: (stream.concealRate * 100.0).toFixed(2) + "%"
+    }
+    Value {
+        label: "Stretched / Compressed"
+        color: "dimgrey"
+        source: stream.stretchCount + " / " + stream.compressCount + " frames"
+    }
 }
 
@@ -0,0 +1,23 @@
+//
+// rules-example.js
+//
+//
+// Copyright 2018 High Fidelity, Inc.
+//
+// This sample entity edit filter script uses only the declarative rules, which the entity server evaluates
+// without running any script: positions are kept inside a box, edits may only change a few properties (adds and
+// physics updates may still set any), and each entity may be edited at most 10 times per second.
+//
+// Distributed under the Apache License, Version 2.0.
+// See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+function filter(properties, type) {
+    return true;
+}
+filter.clampPosition = { min: { x: -100, y: -10, z: -100 }, max: { x: 100, y: 50, z: 100 } };
+filter.allowedProperties = ["position", "rotation", "velocity", "angularVelocity", "color"];
+filter.maxEditsPerSecond = 10;
+/* The filter function itself doesn't look at any properties, so it is never called for edits. */
+filter.wantsProperties = [];
+filter;
@@ -0,0 +1,161 @@
+//
+//  AnimClipCacheTests.cpp
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipCacheTests.h"
+
+#include <AnimClipCache.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimClipCacheTests)
+
+const float TEST_EPSILON = 0.001f;
+const QString TEST_URL = "qrc:///avatar/animations/test.fbx";
+const int NUM_FRAMES = 4;
+
+// an animation that is loaded without a download
+class TestAnimation : public Animation {
+public:
+    TestAnimation(const QUrl& url, FBXGeometry::Pointer geometry) : Animation(url) { animationParseSuccess(geometry); }
+};
+
+static FBXJoint makeJoint(const QString& name, int parentIndex, const glm::vec3& translation) {
+    FBXJoint joint;
+    joint.isFree = false;
+    joint.parentIndex = parentIndex;
+    joint.distanceToParent = glm::length(translation);
+    joint.translation = translation;
+    joint.preTransform = glm::mat4();
+    joint.preRotation = glm::quat();
+    joint.rotation = glm::quat();
+    joint.postRotation = glm::quat();
+    joint.postTransform = glm::mat4();
+    joint.transform = glm::mat4();
+    joint.rotationMin = glm::vec3(-PI);
+    joint.rotationMax = glm::vec3(PI);
+    joint.inverseDefaultRotation = glm::quat();
+    joint.inverseBindRotation = glm::quat();
+    joint.bindTransform = glm::mat4();
+    joint.name = name;
+    joint.isSkeletonJoint = true;
+    return joint;
+}
+
+// hips with a leg on each side, the legs swing the opposite way from each other in the animation
+static FBXGeometry::Pointer makeGeometry(float legLength = 0.5f) {
+    auto geometry = std::make_shared<FBXGeometry>();
+    geometry->joints.push_back(makeJoint("Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f)));
+    geometry->joints.push_back(makeJoint("LeftUpLeg", 0, glm::vec3(0.1f, -legLength, 0.0f)));
+    geometry->joints.push_back(makeJoint("RightUpLeg", 0, glm::vec3(-0.1f, -legLength, 0.0f)));
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        float angle = 0.25f * (float)i;
+        FBXAnimationFrame frame;
+        frame.rotations = { glm::quat(), glm::angleAxis(angle, Vectors::UNIT_X), glm::angleAxis(-angle, Vectors::UNIT_X) };
+        for (const auto& joint : geometry->joints) {
+            frame.translations.push_back(joint.translation);
+        }
+        geometry->animationFrames.push_back(frame);
+    }
+    return geometry;
+}
+
+static AnimationPointer makeAnimation(FBXGeometry::Pointer geometry) {
+    return AnimationPointer(new TestAnimation(QUrl(TEST_URL), geometry));
+}
+
+static AnimSkeleton::ConstPointer makeSkeleton(const FBXGeometry& geometry) {
+    return std::make_shared<AnimSkeleton>(geometry);
+}
+
+void AnimClipCacheTests::testIsRetargetedLike() {
+    auto geometry = makeGeometry();
+    auto skeleton = makeSkeleton(*geometry);
+    QVERIFY(skeleton->isRetargetedLike(*skeleton));
+
+    // the same joints in another skeleton
+    auto sameSkeleton = makeSkeleton(*makeGeometry());
+    QCOMPARE(sameSkeleton->getHash(), skeleton->getHash());
+    QVERIFY(skeleton->isRetargetedLike(*sameSkeleton));
+    QVERIFY(sameSkeleton->isRetargetedLike(*skeleton));
+
+    // longer legs change the default poses the frames are retargeted from
+    auto longerLegs = makeSkeleton(*makeGeometry(0.6f));
+    QVERIFY(!skeleton->isRetargetedLike(*longerLegs));
+
+    // a joint with another name
+    auto renamed = makeGeometry();
+    renamed->joints[2].name = "RightLeg";
+    QVERIFY(!skeleton->isRetargetedLike(*makeSkeleton(*renamed)));
+
+    // a joint with another parent
+    auto reparented = makeGeometry();
+    reparented->joints[2].parentIndex = 1;
+    QVERIFY(!skeleton->isRetargetedLike(*makeSkeleton(*reparented)));
+}
+
+void AnimClipCacheTests::testSharedBetweenClips() {
+    auto geometry = makeGeometry();
+    auto animation = makeAnimation(geometry);
+    auto skeleton = makeSkeleton(*geometry);
+
+    auto clipCache = AnimClipCache::get(TEST_URL, animation, skeleton);
+    QCOMPARE(clipCache->getFrameCount(), NUM_FRAMES);
+    QCOMPARE(AnimClipCache::get(TEST_URL, animation, skeleton), clipCache);
+
+    // a skeleton of its own that is retargeted onto the same way
+    QCOMPARE(AnimClipCache::get(TEST_URL, animation, makeSkeleton(*makeGeometry())), clipCache);
+}
+
+void AnimClipCacheTests::testNotSharedBetweenSkeletons() {
+    auto geometry = makeGeometry();
+    auto animation = makeAnimation(geometry);
+    auto clipCache = AnimClipCache::get(TEST_URL, animation, makeSkeleton(*geometry));
+
+    auto longerLegs = AnimClipCache::get(TEST_URL, animation, makeSkeleton(*makeGeometry(0.6f)));
+    QVERIFY(longerLegs != clipCache);
+    QCOMPARE(AnimClipCache::get(TEST_URL, animation, makeSkeleton(*makeGeometry(0.6f))), longerLegs);
+
+    // the same animation under another url
+    QVERIFY(AnimClipCache::get(TEST_URL + "?other", animation, makeSkeleton(*geometry)) != clipCache);
+}
+
+void AnimClipCacheTests::testNotSharedAfterReload() {
+    auto geometry = makeGeometry();
+    auto skeleton = makeSkeleton(*geometry);
+    auto clipCache = AnimClipCache::get(TEST_URL, makeAnimation(geometry), skeleton);
+
+    // the animation at the same url, loaded again
+    auto reloadedCache = AnimClipCache::get(TEST_URL, makeAnimation(geometry), skeleton);
+    QVERIFY(reloadedCache != clipCache);
+}
+
+void AnimClipCacheTests::testMirror() {
+    auto geometry = makeGeometry();
+    auto skeleton = makeSkeleton(*geometry);
+    auto clipCache = AnimClipCache::get(TEST_URL, makeAnimation(geometry), skeleton);
+
+    AnimPoseBuffer blendedPoses;
+    AnimPoseVec poses;
+    AnimPoseVec mirroredPoses;
+    const float ALPHA = 0.3f;
+    for (int i = 0; i < NUM_FRAMES - 1; i++) {
+        clipCache->sample(i, i + 1, ALPHA, false, blendedPoses, poses);
+        clipCache->sample(i, i + 1, ALPHA, true, blendedPoses, mirroredPoses);
+        QCOMPARE((int)mirroredPoses.size(), skeleton->getNumJoints());
+
+        // the legs swap over, mirrored
+        for (int joint : { 1, 2 }) {
+            int mirrorJoint = 3 - joint;
+            QCOMPARE_QUATS(mirroredPoses[mirrorJoint].rot(), poses[joint].mirror().rot(), TEST_EPSILON);
+        }
+    }
+}
@@ -0,0 +1,25 @@
+//
+//  AnimClipCacheTests.h
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipCacheTests_h
+#define hifi_AnimClipCacheTests_h
+
+#include <QtTest/QtTest>
+
+class AnimClipCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testIsRetargetedLike();
+    void testSharedBetweenClips();
+    void testNotSharedBetweenSkeletons();
+    void testNotSharedAfterReload();
+    void testMirror();
+};
+
+#endif // hifi_AnimClipCacheTests_h
@@ -0,0 +1,143 @@
+//
+//  AnimPoseBufferTests.cpp
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseBufferTests.h"
+
+#include <random>
+
+#include <AnimPoseBuffer.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseBufferTests)
+
+const float TEST_EPSILON = 0.001f;
+const float TEST_ANGLE = 0.001f;
+const int NUM_TEST_JOINTS = 67; // doesn't fill the SIMD lanes
+
+static std::mt19937 generator;
+
+static float randFloat(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(generator);
+}
+
+// uniformly scaled, like the joints of an avatar
+static AnimPoseVec randomPoses(int numJoints) {
+    AnimPoseVec poses;
+    for (int i = 0; i < numJoints; i++) {
+        glm::quat rot = glm::normalize(glm::quat(randFloat(-1.0f, 1.0f), randFloat(-1.0f, 1.0f),
+                                                 randFloat(-1.0f, 1.0f), randFloat(-1.0f, 1.0f)));
+        glm::vec3 trans(randFloat(-0.5f, 0.5f), randFloat(-0.5f, 0.5f), randFloat(-0.5f, 0.5f));
+        poses.push_back(AnimPose(glm::vec3(randFloat(0.8f, 1.2f)), rot, trans));
+    }
+    return poses;
+}
+
+void AnimPoseBufferTests::testConversion() {
+    AnimPoseVec poses = randomPoses(NUM_TEST_JOINTS);
+
+    AnimPoseBuffer buffer(poses);
+    QCOMPARE(buffer.size(), poses.size());
+
+    AnimPoseVec result;
+    buffer.toPoses(result);
+    QCOMPARE(result.size(), poses.size());
+    for (size_t i = 0; i < poses.size(); i++) {
+        QCOMPARE(result[i].scale(), poses[i].scale());
+        QCOMPARE(result[i].rot(), poses[i].rot());
+        QCOMPARE(result[i].trans(), poses[i].trans());
+    }
+}
+
+void AnimPoseBufferTests::testBlend() {
+    AnimPoseVec a = randomPoses(NUM_TEST_JOINTS);
+    AnimPoseVec b = randomPoses(NUM_TEST_JOINTS);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 0.9f, 1.0f }) {
+        AnimPoseVec expected(NUM_TEST_JOINTS);
+        ::blend(NUM_TEST_JOINTS, &a[0], &b[0], alpha, &expected[0]);
+
+        AnimPoseBuffer result;
+        AnimPoseBuffer::blend(AnimPoseBuffer(a), AnimPoseBuffer(b), alpha, result);
+        QCOMPARE(result.size(), (size_t)NUM_TEST_JOINTS);
+
+        for (int i = 0; i < NUM_TEST_JOINTS; i++) {
+            AnimPose pose = result.getPose(i);
+            QCOMPARE_WITH_ABS_ERROR(pose.scale(), expected[i].scale(), TEST_EPSILON);
+            QCOMPARE_QUATS(pose.rot(), expected[i].rot(), TEST_ANGLE);
+            QCOMPARE_WITH_ABS_ERROR(pose.trans(), expected[i].trans(), TEST_EPSILON);
+        }
+    }
+}
+
+static void addBenchmarkRows() {
+    QTest::addColumn<int>("numJoints");
+    QTest::addColumn<bool>("useBuffer");
+
+    for (int numJoints : { 60, 90, 120 }) {
+        QTest::newRow(qPrintable(QString("%1 joints, AnimPoseVec").arg(numJoints))) << numJoints << false;
+        QTest::newRow(qPrintable(QString("%1 joints, AnimPoseBuffer").arg(numJoints))) << numJoints << true;
+    }
+}
+
+void AnimPoseBufferTests::benchmarkBlend_data() {
+    addBenchmarkRows();
+}
+
+void AnimPoseBufferTests::benchmarkBlend() {
+    QFETCH(int, numJoints);
+    QFETCH(bool, useBuffer);
+
+    AnimPoseVec a = randomPoses(numJoints);
+    AnimPoseVec b = randomPoses(numJoints);
+    if (useBuffer) {
+        AnimPoseBuffer aBuffer(a);
+        AnimPoseBuffer bBuffer(b);
+        AnimPoseBuffer result;
+        QBENCHMARK {
+            AnimPoseBuffer::blend(aBuffer, bBuffer, 0.3f, result);
+        }
+    } else {
+        AnimPoseVec result(numJoints);
+        QBENCHMARK {
+            ::blend(numJoints, &a[0], &b[0], 0.3f, &result[0]);
+        }
+    }
+}
+
+void AnimPoseBufferTests::benchmarkSample_data() {
+    addBenchmarkRows();
+}
+
+// AnimClipCache::sample(), with the copy out to the AnimPoseVec the clip hands on, against AnimClip blending its frames
+// as AnimPoseVecs
+void AnimPoseBufferTests::benchmarkSample() {
+    QFETCH(int, numJoints);
+    QFETCH(bool, useBuffer);
+
+    AnimPoseVec a = randomPoses(numJoints);
+    AnimPoseVec b = randomPoses(numJoints);
+    AnimPoseVec poses(numJoints);
+    if (useBuffer) {
+        AnimPoseBuffer aBuffer(a);
+        AnimPoseBuffer bBuffer(b);
+        AnimPoseBuffer blendedPoses;
+        QBENCHMARK {
+            AnimPoseBuffer::blend(aBuffer, bBuffer, 0.3f, blendedPoses);
+            blendedPoses.toPoses(poses);
+        }
+    } else {
+        QBENCHMARK {
+            ::blend(numJoints, &a[0], &b[0], 0.3f, &poses[0]);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+//
+//  AnimPoseBufferTests.h
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseBufferTests_h
+#define hifi_AnimPoseBufferTests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseBufferTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testConversion();
+    void testBlend();
+
+    // AnimPoseVec against AnimPoseBuffer, for typical skeletons
+    void benchmarkBlend_data();
+    void benchmarkBlend();
+    void benchmarkSample_data();
+    void benchmarkSample();
+};
+
+#endif // hifi_AnimPoseBufferTests_h
@@ -0,0 +1,122 @@
+//
+//  AudioTimeScalerTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioTimeScalerTests.h"
+
+#include <cmath>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioTimeScaler.h>
+
+QTEST_MAIN(AudioTimeScalerTests)
+
+static const int NUM_FRAMES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+static const int PERIOD = 80; // 300Hz at 24kHz, inside the scaler's search range
+static const float AMPLITUDE = 10000.0f;
+
+// cross-fades and rounding can be off by a sample value or two
+static const int TOLERANCE = 2;
+
+static int16_t sine(int i, int period = PERIOD) {
+    return (int16_t)(AMPLITUDE * sinf(2.0f * (float)M_PI * i / period));
+}
+
+static std::vector<int16_t> makeSine(int firstFrame, int numFrames) {
+    std::vector<int16_t> samples(numFrames);
+    for (int i = 0; i < numFrames; i++) {
+        samples[i] = sine(firstFrame + i);
+    }
+    return samples;
+}
+
+void AudioTimeScalerTests::compressPeriodic() {
+    AudioTimeScaler scaler(1);
+    std::vector<int16_t> input = makeSine(0, NUM_FRAMES);
+    std::vector<int16_t> output(NUM_FRAMES);
+
+    int numOutputFrames = scaler.compress(input.data(), NUM_FRAMES, output.data());
+
+    // one period is removed, and since the periods are alike the wave carries on without a seam
+    QCOMPARE(numOutputFrames, NUM_FRAMES - PERIOD);
+    for (int i = 0; i < numOutputFrames; i++) {
+        QVERIFY(abs(output[i] - sine(i)) <= TOLERANCE);
+    }
+}
+
+void AudioTimeScalerTests::expandPeriodic() {
+    AudioTimeScaler scaler(1);
+    std::vector<int16_t> input = makeSine(0, NUM_FRAMES);
+    std::vector<int16_t> output(NUM_FRAMES + AudioTimeScaler::MAX_PERIOD);
+
+    int numOutputFrames = scaler.expand(input.data(), NUM_FRAMES, output.data());
+
+    QCOMPARE(numOutputFrames, NUM_FRAMES + PERIOD);
+    for (int i = 0; i < numOutputFrames; i++) {
+        QVERIFY(abs(output[i] - sine(i)) <= TOLERANCE);
+    }
+}
+
+void AudioTimeScalerTests::stereoKeepsChannelsApart() {
+    AudioTimeScaler scaler(2);
+    std::vector<int16_t> input(NUM_FRAMES * 2);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        input[2 * i] = sine(i);
+        input[2 * i + 1] = -sine(i) / 2;
+    }
+    std::vector<int16_t> output(NUM_FRAMES * 2);
+
+    int numOutputFrames = scaler.compress(input.data(), NUM_FRAMES, output.data());
+
+    QVERIFY(numOutputFrames < NUM_FRAMES);
+    for (int i = 0; i < numOutputFrames; i++) {
+        QVERIFY(abs(output[2 * i] - sine(i)) <= TOLERANCE);
+        QVERIFY(abs(output[2 * i + 1] + sine(i) / 2) <= TOLERANCE);
+    }
+}
+
+void AudioTimeScalerTests::leavesNoiseAlone() {
+    AudioTimeScaler scaler(1);
+    std::vector<int16_t> input(NUM_FRAMES);
+    uint32_t seed = 12345;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        seed = seed * 1664525 + 1013904223;
+        input[i] = (int16_t)((int)(seed >> 16) - 32768) / 2;
+    }
+    std::vector<int16_t> output(NUM_FRAMES + AudioTimeScaler::MAX_PERIOD);
+
+    // loud audio with no period can't be spliced cleanly, so it passes through
+    QCOMPARE(scaler.compress(input.data(), NUM_FRAMES, output.data()), NUM_FRAMES);
+    QVERIFY(memcmp(input.data(), output.data(), NUM_FRAMES * sizeof(int16_t)) == 0);
+    QCOMPARE(scaler.expand(input.data(), NUM_FRAMES, output.data()), NUM_FRAMES);
+    QVERIFY(memcmp(input.data(), output.data(), NUM_FRAMES * sizeof(int16_t)) == 0);
+}
+
+void AudioTimeScalerTests::concealContinuesPeriod() {
+    AudioTimeScaler scaler(1);
+    std::vector<int16_t> input = makeSine(0, NUM_FRAMES);
+    scaler.remember(input.data(), NUM_FRAMES);
+
+    // two lost frames in a row carry on from where the audio left off
+    std::vector<int16_t> output(NUM_FRAMES);
+    for (int frame = 1; frame <= 2; frame++) {
+        scaler.conceal(output.data(), NUM_FRAMES, 1.0f);
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            QVERIFY(abs(output[i] - sine(frame * NUM_FRAMES + i)) <= TOLERANCE);
+        }
+    }
+
+    // and the gain is applied
+    scaler.remember(input.data(), NUM_FRAMES);
+    scaler.conceal(output.data(), NUM_FRAMES, 0.5f);
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        QVERIFY(abs(output[i] - sine(NUM_FRAMES + i) / 2) <= TOLERANCE);
+    }
+}
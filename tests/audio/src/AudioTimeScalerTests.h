@@ -0,0 +1,26 @@
+//
+//  AudioTimeScalerTests.h
+//  tests/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioTimeScalerTests_h
+#define hifi_AudioTimeScalerTests_h
+
+#include <QtTest/QtTest>
+
+class AudioTimeScalerTests : public QObject {
+    Q_OBJECT
+private slots:
+    void compressPeriodic();
+    void expandPeriodic();
+    void stereoKeepsChannelsApart();
+    void leavesNoiseAlone();
+    void concealContinuesPeriod();
+};
+
+#endif // hifi_AudioTimeScalerTests_h
@@ -0,0 +1,222 @@
+//
+//  SoundStreamTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SoundStreamTests.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+
+#include <AudioConstants.h>
+#include <Sound.h>
+#include <SoundStream.h>
+
+QTEST_MAIN(SoundStreamTests)
+
+// the test MP3s are at the output rate, so the streams don't resample and their samples can be compared exactly
+static const int MP3_SAMPLE_RATE = 24000;
+static const int MP3_FRAME_SAMPLES = 576;
+static const int MP3_FRAME_BYTES = 72 * 64000 / 24000;
+
+static const int READ_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+static const int READ_TIMEOUT_MSECS = 10000;
+
+class BitWriter {
+public:
+    BitWriter(QByteArray& bytes) : _bytes(bytes) {}
+
+    void write(uint32_t value, int numBits) {
+        for (int i = numBits - 1; i >= 0; i--) {
+            if (_bit == 0) {
+                _bytes.append('\0');
+            }
+            if ((value >> i) & 1) {
+                _bytes.data()[_bytes.size() - 1] |= 0x80 >> _bit;
+            }
+            _bit = (_bit + 1) % 8;
+        }
+    }
+
+private:
+    QByteArray& _bytes;
+    int _bit { 0 };
+};
+
+// MPEG-2 layer III frames, 24 kHz mono at 64 kbps. Each frame has a single quantized spectral line, at a position,
+// sign and gain that change from frame to frame, so that samples decoded out of order don't match.
+static QByteArray makeMP3(int numFrames) {
+    QByteArray data;
+    for (int frame = 0; frame < numFrames; frame++) {
+        int frameStart = data.size();
+        int numZeroQuads = frame % 16;
+        BitWriter bits(data);
+
+        // header: sync, MPEG-2, layer III, no CRC, 64 kbps, 24 kHz, no padding, mono
+        bits.write(0xFFF3, 16);
+        bits.write(8, 4);
+        bits.write(1, 2);
+        bits.write(0, 2);
+        bits.write(3, 2);
+        bits.write(0, 6);
+
+        // side info: no bit reservoir, no scale factors, only a count1 region coded with table B
+        bits.write(0, 8);
+        bits.write(0, 1);
+        bits.write(numZeroQuads * 4 + 5, 12); // part2_3_length
+        bits.write(0, 9); // big_values
+        bits.write(180 + frame % 20, 8); // global_gain
+        bits.write(0, 9); // scalefac_compress
+        bits.write(0, 1); // window_switching_flag
+        bits.write(0, 15); // table_select
+        bits.write(0, 4); // region0_count
+        bits.write(0, 3); // region1_count
+        bits.write(0, 1); // scalefac_scale
+        bits.write(1, 1); // count1table_select
+
+        // main data: zero quadruples, then one with a 1 in its first line, and its sign
+        for (int i = 0; i < numZeroQuads; i++) {
+            bits.write(0xF, 4);
+        }
+        bits.write(0x7, 4);
+        bits.write(frame % 2, 1);
+
+        data.append(QByteArray(frameStart + MP3_FRAME_BYTES - data.size(), '\0'));
+    }
+    return data;
+}
+
+static SoundStreamSourcePointer makeSource(const QByteArray& data) {
+    auto source = std::make_shared<SoundStreamSource>();
+    source->data = data;
+    SoundStreamSource::probeMP3(data, source->sampleRate, source->numChannels);
+    return source;
+}
+
+// the whole MP3, decoded up front the way short sounds are
+static std::vector<int16_t> decodeAll(const QByteArray& data) {
+    QByteArray decoded;
+    SoundProcessor(QUrl(), data, false, false).interpretAsMP3(data, decoded);
+    const int16_t* samples = reinterpret_cast<const int16_t*>(decoded.constData());
+    return std::vector<int16_t>(samples, samples + decoded.size() / sizeof(int16_t));
+}
+
+// reads the way the injectors do, waiting for refills to catch up, until the stream finishes or maxSamples have been read
+static std::vector<int16_t> readAll(SoundStream& stream, size_t maxSamples) {
+    std::vector<int16_t> samples;
+    int16_t buffer[READ_SAMPLES];
+    QElapsedTimer timer;
+    timer.start();
+    while (samples.size() < maxSamples && !stream.isFinished() && timer.elapsed() < READ_TIMEOUT_MSECS) {
+        int numRead = stream.read(buffer, (int)std::min((size_t)READ_SAMPLES, maxSamples - samples.size()));
+        samples.insert(samples.end(), buffer, buffer + numRead);
+        if (numRead == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    return samples;
+}
+
+void SoundStreamTests::testProbe() {
+    const int NUM_FRAMES = 20;
+    int sampleRate = 0;
+    int numChannels = 0;
+    QCOMPARE(SoundStreamSource::probeMP3(makeMP3(NUM_FRAMES), sampleRate, numChannels), (int64_t)NUM_FRAMES * MP3_FRAME_SAMPLES);
+    QCOMPARE(sampleRate, MP3_SAMPLE_RATE);
+    QCOMPARE(numChannels, 1);
+
+    QCOMPARE(SoundStreamSource::probeMP3(QByteArray(1000, 'x'), sampleRate, numChannels), (int64_t)0);
+}
+
+void SoundStreamTests::testWraparound() {
+    // a few times longer than the ring
+    const int NUM_FRAMES = 120;
+    QByteArray data = makeMP3(NUM_FRAMES);
+    std::vector<int16_t> expected = decodeAll(data);
+    QCOMPARE(expected.size(), (size_t)NUM_FRAMES * MP3_FRAME_SAMPLES);
+    QVERIFY(expected.size() > 2 * SoundStream::RING_SECONDS * AudioConstants::SAMPLE_RATE);
+
+    auto stream = std::make_shared<SoundStream>(makeSource(data), false);
+    stream->start();
+    std::vector<int16_t> samples = readAll(*stream, expected.size() + 1);
+
+    QVERIFY(stream->isFinished());
+    QCOMPARE(samples.size(), expected.size());
+    QVERIFY(samples == expected);
+}
+
+void SoundStreamTests::testLoop() {
+    const int NUM_FRAMES = 30;
+    const int NUM_LOOPS = 3;
+    QByteArray data = makeMP3(NUM_FRAMES);
+    std::vector<int16_t> expected = decodeAll(data);
+
+    auto stream = std::make_shared<SoundStream>(makeSource(data), true);
+    stream->start();
+    std::vector<int16_t> samples = readAll(*stream, NUM_LOOPS * expected.size());
+
+    QVERIFY(!stream->isFinished());
+    QCOMPARE(samples.size(), NUM_LOOPS * expected.size());
+
+    // the decoder starts over from scratch each time round
+    for (int loop = 0; loop < NUM_LOOPS; loop++) {
+        QVERIFY(std::equal(expected.begin(), expected.end(), samples.begin() + loop * expected.size()));
+    }
+}
+
+void SoundStreamTests::testStartFrame() {
+    const int NUM_FRAMES = 60;
+    const int START_FRAME = 17 * MP3_FRAME_SAMPLES;
+    QByteArray data = makeMP3(NUM_FRAMES);
+    std::vector<int16_t> expected = decodeAll(data);
+
+    auto stream = std::make_shared<SoundStream>(makeSource(data), false);
+    stream->start(START_FRAME);
+    std::vector<int16_t> samples = readAll(*stream, expected.size() + 1);
+
+    QVERIFY(stream->isFinished());
+    QCOMPARE(samples.size(), expected.size() - START_FRAME);
+
+    // the frames that were skipped aren't there to overlap the first ones decoded, which are only close
+    const int NUM_OVERLAPPED_SAMPLES = 2 * MP3_FRAME_SAMPLES;
+    QVERIFY(std::equal(samples.begin() + NUM_OVERLAPPED_SAMPLES, samples.end(),
+                       expected.begin() + START_FRAME + NUM_OVERLAPPED_SAMPLES));
+}
+
+void SoundStreamTests::testStartPastTheEnd() {
+    const int NUM_FRAMES = 10;
+    auto stream = std::make_shared<SoundStream>(makeSource(makeMP3(NUM_FRAMES)), false);
+    stream->start((NUM_FRAMES + 1) * MP3_FRAME_SAMPLES);
+
+    QVERIFY(stream->isFinished());
+    int16_t buffer[READ_SAMPLES];
+    QCOMPARE(stream->read(buffer, READ_SAMPLES), 0);
+}
+
+void SoundStreamTests::testFinishedOnceDrained() {
+    // short enough for start() to decode all of it
+    const int NUM_FRAMES = 3;
+    const int NUM_SAMPLES = NUM_FRAMES * MP3_FRAME_SAMPLES;
+    QVERIFY(NUM_SAMPLES < SoundStream::PRIME_SECONDS * AudioConstants::SAMPLE_RATE);
+
+    auto stream = std::make_shared<SoundStream>(makeSource(makeMP3(NUM_FRAMES)), false);
+    stream->start();
+    QVERIFY(!stream->isFinished());
+
+    std::vector<int16_t> buffer(NUM_SAMPLES);
+    const int FIRST_READ_SAMPLES = NUM_SAMPLES - 100;
+    QCOMPARE(stream->read(buffer.data(), FIRST_READ_SAMPLES), FIRST_READ_SAMPLES);
+    QVERIFY(!stream->isFinished());
+
+    QCOMPARE(stream->read(buffer.data(), NUM_SAMPLES), NUM_SAMPLES - FIRST_READ_SAMPLES);
+    QVERIFY(stream->isFinished());
+    QCOMPARE(stream->getNumUnderrunSamples(), (uint64_t)0);
+}
@@ -0,0 +1,27 @@
+//
+//  SoundStreamTests.h
+//  tests/audio/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SoundStreamTests_h
+#define hifi_SoundStreamTests_h
+
+#include <QtTest/QtTest>
+
+class SoundStreamTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testProbe();
+    void testWraparound();
+    void testLoop();
+    void testStartFrame();
+    void testStartPastTheEnd();
+    void testFinishedOnceDrained();
+};
+
+#endif // hifi_SoundStreamTests_h
@@ -0,0 +1,577 @@
+//
+//  PredictedJointDataTests.cpp
+//  tests/avatars/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PredictedJointDataTests.h"
+
+#include <random>
+
+#include <AvatarData.h>
+#include <GLMHelpers.h>
+#include <PredictedJointData.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(PredictedJointDataTests)
+
+// PredictedJointData quantizes rotation components to 1/32767 and translations to 1/4096 of a meter. Rounding each
+// rotation component by up to half a step turns the decoded rotation by at most 2 * |error| = 2 * sqrt(4) * 0.5 / 32767.
+const float QUANTIZED_ROTATION_ANGLE = 2.0f / 32767.0f;
+const float QUANTIZED_TRANSLATION_ERROR = 1.0f / 4096.0f;
+
+// eight full groups of joints and a part full one, so the last group is written with fewer than JOINTS_PER_GROUP joints
+const int NUM_TEST_JOINTS = 8 * PredictedJointData::JOINTS_PER_GROUP + 3;
+const int NUM_TEST_FRAMES = 90;
+const float FRAME_PERIOD = 1.0f / 45.0f; // the rate MyAvatar sends at
+
+// Each joint swings about its own axis. Some joints don't move at all, like the fingers of an avatar without hand
+// controllers, and the hips bob up and down. The same seed makes the same skeleton, so failures can be reproduced.
+class TestSkeleton {
+public:
+    TestSkeleton(int numJoints, uint32_t seed = 1) : _random(seed) {
+        for (int i = 0; i < numJoints; i++) {
+            Joint joint;
+            joint.rotation = glm::normalize(glm::quat(random(-1.0f, 1.0f), random(-1.0f, 1.0f),
+                                                      random(-1.0f, 1.0f), random(-1.0f, 1.0f)));
+            joint.axis = glm::normalize(glm::vec3(random(-1.0f, 1.0f), random(-1.0f, 1.0f), random(-1.0f, 1.0f)));
+            joint.amplitude = (i % 3 == 2) ? 0.0f : random(0.02f, 0.3f);
+            joint.frequency = random(0.2f, 1.5f) * TWO_PI;
+            joint.phase = random(0.0f, TWO_PI);
+            joint.translation = glm::vec3(random(-0.2f, 0.2f), random(0.0f, 0.5f), random(-0.2f, 0.2f));
+            _joints.push_back(joint);
+        }
+    }
+
+    float random(float min, float max) {
+        return std::uniform_real_distribution<float>(min, max)(_random);
+    }
+
+    QVector<JointData> getJoints(float time) const {
+        QVector<JointData> joints;
+        for (size_t i = 0; i < _joints.size(); i++) {
+            const Joint& joint = _joints[i];
+            float angle = joint.amplitude * sinf(joint.frequency * time + joint.phase);
+            JointData data;
+            data.rotation = glm::angleAxis(angle, joint.axis) * joint.rotation;
+            data.translation = joint.translation;
+            if (i == 0) {
+                data.translation.y += 0.05f * sinf(joint.frequency * time);
+            }
+            data.rotationIsDefaultPose = false;
+            data.translationIsDefaultPose = false;
+            joints.push_back(data);
+        }
+        return joints;
+    }
+
+private:
+    struct Joint {
+        glm::quat rotation;
+        glm::vec3 axis;
+        float amplitude;
+        float frequency;
+        float phase;
+        glm::vec3 translation;
+    };
+    std::mt19937 _random;
+    std::vector<Joint> _joints;
+};
+
+static QByteArray encode(const QVector<JointData>& joints, bool keyFrame, float rotationDeadZone, float translationDeadZone,
+                         PredictedJointData::History& history) {
+    QByteArray result((int)PredictedJointData::maxSize(joints.size()), 0);
+    size_t size = PredictedJointData::encode(joints, keyFrame, rotationDeadZone, translationDeadZone, history,
+                                             reinterpret_cast<uint8_t*>(result.data()));
+    result.resize((int)size);
+    return result;
+}
+
+static QByteArray encode(const QVector<JointData>& joints, PredictedJointData::History& history) {
+    return encode(joints, false, 0.0f, 0.0f, history);
+}
+
+static bool decode(const QByteArray& encoded, PredictedJointData::History& history) {
+    bool decoded;
+    int size = PredictedJointData::decode(reinterpret_cast<const uint8_t*>(encoded.constData()), history, decoded);
+    return decoded && size == encoded.size();
+}
+
+static uint8_t getFlags(const QByteArray& encoded) {
+    return (uint8_t)encoded[3];
+}
+
+static bool isSameHistory(const PredictedJointData::History& a, const PredictedJointData::History& b) {
+    if (a.frame != b.frame || a.pose.size() != b.pose.size() || a.previousPose.size() != b.previousPose.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.pose.size(); i++) {
+        for (int j = 0; j < PredictedJointData::NUM_VALUES; j++) {
+            if (a.pose[i].values[j] != b.pose[i].values[j] || a.previousPose[i].values[j] != b.previousPose[i].values[j]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void PredictedJointDataTests::testRoundTrip() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    PredictedJointData::History sent;
+    PredictedJointData::History received;
+
+    for (int frame = 0; frame < NUM_TEST_FRAMES; frame++) {
+        QVector<JointData> joints = skeleton.getJoints(frame * FRAME_PERIOD);
+        QByteArray encoded = encode(joints, sent);
+        QCOMPARE(PredictedJointData::getEncodedSize(reinterpret_cast<const uint8_t*>(encoded.constData())), encoded.size());
+
+        QVERIFY(decode(encoded, received));
+        QVERIFY(isSameHistory(received, sent));
+
+        QVector<JointData> result;
+        PredictedJointData::toJointData(received, result);
+        QCOMPARE(result.size(), joints.size());
+        for (int i = 0; i < joints.size(); i++) {
+            QCOMPARE_QUATS(result[i].rotation, joints[i].rotation, QUANTIZED_ROTATION_ANGLE);
+            QCOMPARE_WITH_ABS_ERROR(result[i].translation, joints[i].translation, QUANTIZED_TRANSLATION_ERROR);
+        }
+    }
+}
+
+void PredictedJointDataTests::testKeyFrames() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    PredictedJointData::History history;
+
+    for (int frame = 0; frame < 2 * PredictedJointData::KEY_FRAME_INTERVAL + 2; frame++) {
+        QByteArray encoded = encode(skeleton.getJoints(frame * FRAME_PERIOD), history);
+        bool isKeyFrame = (frame % (PredictedJointData::KEY_FRAME_INTERVAL + 1)) == 0;
+        QCOMPARE((getFlags(encoded) & PredictedJointData::KEY_FRAME) != 0, isKeyFrame);
+    }
+
+    // a key frame can be asked for, and a different number of joints needs one
+    QByteArray encoded = encode(skeleton.getJoints(0.0f), true, 0.0f, 0.0f, history);
+    QVERIFY(getFlags(encoded) & PredictedJointData::KEY_FRAME);
+    encoded = encode(TestSkeleton(NUM_TEST_JOINTS + 1).getJoints(0.0f), history);
+    QVERIFY(getFlags(encoded) & PredictedJointData::KEY_FRAME);
+}
+
+static bool isBehind(const QByteArray& encoded, const PredictedJointData::History& history) {
+    return PredictedJointData::isBehind(reinterpret_cast<const uint8_t*>(encoded.constData()), history);
+}
+
+void PredictedJointDataTests::testMissedFrame() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    PredictedJointData::History sent;
+    PredictedJointData::History received;
+
+    int frame = 0;
+    for (; frame < 3; frame++) {
+        QByteArray encoded = encode(skeleton.getJoints(frame * FRAME_PERIOD), sent);
+        QVERIFY(!isBehind(encoded, received));
+        QVERIFY(decode(encoded, received));
+    }
+
+    // lose a frame, the frames after it can't be decoded and show that one was missed
+    encode(skeleton.getJoints(frame++ * FRAME_PERIOD), sent);
+    PredictedJointData::History before = received;
+    for (int i = 0; i < 3; i++, frame++) {
+        QByteArray encoded = encode(skeleton.getJoints(frame * FRAME_PERIOD), sent);
+        QVERIFY(!PredictedJointData::canFollow(reinterpret_cast<const uint8_t*>(encoded.constData()), received.frame));
+        QVERIFY(isBehind(encoded, received));
+        QVERIFY(!decode(encoded, received));
+        QVERIFY(isSameHistory(received, before));
+    }
+
+    // a frame that arrives after the ones that followed it isn't a gap
+    PredictedJointData::History ahead = sent;
+    QByteArray late = encode(skeleton.getJoints(frame * FRAME_PERIOD), ahead);
+    QVERIFY(decode(encode(skeleton.getJoints(frame * FRAME_PERIOD), true, 0.0f, 0.0f, sent), received));
+    QVERIFY(decode(encode(skeleton.getJoints((frame + 1) * FRAME_PERIOD), sent), received));
+    QVERIFY(!isBehind(late, received));
+
+    // the key frame asked for brings the receiver back
+    frame += 2;
+    encode(skeleton.getJoints(frame++ * FRAME_PERIOD), sent);
+    QByteArray encoded = encode(skeleton.getJoints(frame++ * FRAME_PERIOD), sent);
+    QVERIFY(isBehind(encoded, received));
+    encoded = encode(skeleton.getJoints(frame * FRAME_PERIOD), true, 0.0f, 0.0f, sent);
+    QVERIFY(!isBehind(encoded, received));
+    QVERIFY(decode(encoded, received));
+    QVERIFY(isSameHistory(received, sent));
+}
+
+void PredictedJointDataTests::testResync() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    PredictedJointData::History sent;
+    PredictedJointData::History forwarded;
+
+    int frame = 0;
+    for (; frame < 5; frame++) {
+        QVERIFY(decode(encode(skeleton.getJoints(frame * FRAME_PERIOD), sent), forwarded));
+    }
+
+    // a receiver that joins late is sent the last two frames, and predicts the ones after them
+    QByteArray resync((int)PredictedJointData::maxSize(NUM_TEST_JOINTS), 0);
+    resync.resize((int)PredictedJointData::encodeResync(forwarded, reinterpret_cast<uint8_t*>(resync.data())));
+    QVERIFY(getFlags(resync) & PredictedJointData::KEY_FRAME);
+
+    PredictedJointData::History received;
+    QVERIFY(decode(resync, received));
+    QVERIFY(isSameHistory(received, sent));
+
+    for (; frame < NUM_TEST_FRAMES; frame++) {
+        QByteArray encoded = encode(skeleton.getJoints(frame * FRAME_PERIOD), sent);
+        QVERIFY(decode(encoded, received));
+        QVERIFY(isSameHistory(received, sent));
+    }
+}
+
+static QByteArray encodeForReceiver(const QByteArray& lastReceived, const PredictedJointData::History& history,
+                                    const PredictedJointData::RecentFrames& recentFrames, int receiverFrame) {
+    QByteArray result((int)PredictedJointData::maxSize((int)history.pose.size()), 0);
+    size_t size = PredictedJointData::encodeForReceiver(reinterpret_cast<const uint8_t*>(lastReceived.constData()), history,
+                                                        recentFrames, receiverFrame, reinterpret_cast<uint8_t*>(result.data()));
+    result.resize((int)size);
+    return result;
+}
+
+void PredictedJointDataTests::testCatchUp() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    PredictedJointData::History sent;
+    PredictedJointData::History forwarded;
+    PredictedJointData::RecentFrames recentFrames;
+    recentFrames.setEnabled(true);
+
+    // a receiver that has the frame before the last one is passed the last one
+    int frame = 0;
+    QByteArray lastReceived;
+    PredictedJointData::History received;
+    for (; frame < 5; frame++) {
+        lastReceived = encode(skeleton.getJoints(frame * FRAME_PERIOD), sent);
+        QVERIFY(decode(lastReceived, forwarded));
+        recentFrames.push(forwarded);
+
+        QByteArray encoded = encodeForReceiver(lastReceived, forwarded, recentFrames, received.frame);
+        QVERIFY(decode(encoded, received));
+        QVERIFY(isSameHistory(received, sent));
+    }
+    QCOMPARE(getFlags(encodeForReceiver(lastReceived, forwarded, recentFrames, received.frame)),
+             (uint8_t)PredictedJointData::REPEAT_FRAME);
+
+    // one that has fallen a few frames behind is caught up from the frame it has
+    PredictedJointData::History other;
+    for (int i = 0; i < PredictedJointData::RecentFrames::NUM_FRAMES - 1; i++, frame++) {
+        lastReceived = encode(skeleton.getJoints(frame * FRAME_PERIOD), sent);
+        QVERIFY(decode(lastReceived, forwarded));
+        recentFrames.push(forwarded);
+        if (i == 0) {
+            other = forwarded;
+        }
+    }
+    QByteArray catchUp = encodeForReceiver(lastReceived, forwarded, recentFrames, received.frame);
+    QCOMPARE(getFlags(catchUp), (uint8_t)(PredictedJointData::CATCH_UP_FRAME | PredictedJointData::HAS_PREVIOUS_FRAME));
+    QVERIFY(decode(catchUp, received));
+    QVERIFY(isSameHistory(received, sent));
+
+    // and costs less than a resync
+    QByteArray resync = encodeForReceiver(lastReceived, forwarded, recentFrames, -1);
+    QCOMPARE(getFlags(resync), (uint8_t)(PredictedJointData::KEY_FRAME | PredictedJointData::HAS_PREVIOUS_FRAME));
+    QVERIFY(catchUp.size() < resync.size());
+
+    // a receiver that doesn't have the frame it's caught up from can't decode it, and asks again
+    QVERIFY(isBehind(catchUp, other));
+    QVERIFY(!decode(catchUp, other));
+
+    // the frames after the catch up are predicted from it
+    for (int i = 0; i < 5; i++, frame++) {
+        lastReceived = encode(skeleton.getJoints(frame * FRAME_PERIOD), sent);
+        QVERIFY(decode(lastReceived, forwarded));
+        recentFrames.push(forwarded);
+        QVERIFY(decode(encodeForReceiver(lastReceived, forwarded, recentFrames, received.frame), received));
+        QVERIFY(isSameHistory(received, sent));
+    }
+
+    // a key frame is caught up to rather than passed on, unless that costs more
+    lastReceived = encode(skeleton.getJoints(frame * FRAME_PERIOD), true, 0.0f, 0.0f, sent);
+    QVERIFY(decode(lastReceived, forwarded));
+    recentFrames.push(forwarded);
+    QByteArray encoded = encodeForReceiver(lastReceived, forwarded, recentFrames, received.frame);
+    QVERIFY(encoded.size() <= lastReceived.size());
+    QVERIFY(decode(encoded, received));
+    QVERIFY(isSameHistory(received, sent));
+
+    // and passed on to a receiver that has nothing to catch up from
+    QCOMPARE(encodeForReceiver(lastReceived, forwarded, recentFrames, -1), lastReceived);
+}
+
+void PredictedJointDataTests::testRepeat() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    PredictedJointData::History history;
+    QVERIFY(decode(encode(skeleton.getJoints(0.0f), history), history));
+
+    QByteArray repeat(PredictedJointData::HEADER_SIZE, 0);
+    QCOMPARE((int)PredictedJointData::encodeRepeat(history, reinterpret_cast<uint8_t*>(repeat.data())),
+             (int)PredictedJointData::HEADER_SIZE);
+    QCOMPARE(PredictedJointData::getEncodedSize(reinterpret_cast<const uint8_t*>(repeat.constData())),
+             (int)PredictedJointData::HEADER_SIZE);
+
+    PredictedJointData::History before = history;
+    QVERIFY(!decode(repeat, history));
+    QVERIFY(isSameHistory(history, before));
+}
+
+void PredictedJointDataTests::testDeadZone() {
+    TestSkeleton skeleton(NUM_TEST_JOINTS);
+    QVector<JointData> joints = skeleton.getJoints(0.0f);
+    const float ROTATION_DEAD_ZONE = 0.001f;
+    const float TRANSLATION_DEAD_ZONE = 0.001f;
+
+    PredictedJointData::History sent;
+    PredictedJointData::History received;
+    QVERIFY(decode(encode(joints, false, ROTATION_DEAD_ZONE, TRANSLATION_DEAD_ZONE, sent), received));
+
+    for (int frame = 1; frame < PredictedJointData::KEY_FRAME_INTERVAL; frame++) {
+        // jitter within the dead zones
+        QVector<JointData> jittered = joints;
+        for (auto& joint : jittered) {
+            joint.rotation.x += skeleton.random(-0.2f, 0.2f) * ROTATION_DEAD_ZONE;
+            joint.translation.y += skeleton.random(-0.2f, 0.2f) * TRANSLATION_DEAD_ZONE;
+        }
+
+        // a frame of nothing but zero width groups, the receiver keeps the unjittered joints
+        QByteArray encoded = encode(jittered, false, ROTATION_DEAD_ZONE, TRANSLATION_DEAD_ZONE, sent);
+        const int NUM_GROUPS = (NUM_TEST_JOINTS + PredictedJointData::JOINTS_PER_GROUP - 1) /
+            PredictedJointData::JOINTS_PER_GROUP;
+        const int RESIDUAL_WIDTH_BITS = 5;
+        QCOMPARE(encoded.size(), PredictedJointData::HEADER_SIZE +
+                 (NUM_GROUPS * 2 * RESIDUAL_WIDTH_BITS + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+
+        QVERIFY(decode(encoded, received));
+        QVERIFY(isSameHistory(received, sent));
+
+        QVector<JointData> result;
+        PredictedJointData::toJointData(received, result);
+        for (int i = 0; i < joints.size(); i++) {
+            QCOMPARE_QUATS(result[i].rotation, joints[i].rotation, QUANTIZED_ROTATION_ANGLE);
+            QCOMPARE_WITH_ABS_ERROR(result[i].translation, joints[i].translation, QUANTIZED_TRANSLATION_ERROR);
+        }
+    }
+}
+
+// the same culling as AvatarData::toByteArray() with CullSmallData, keeping what was sent as the avatar mixer does
+static int sixByteJointDataSize(const QVector<JointData>& joints, QVector<JointData>& lastSentJoints, bool sendAll = false) {
+    const int SIX_BYTES = 6;
+    int numJoints = joints.size();
+    int size = 1 + 2 * ((numJoints + BITS_IN_BYTE - 1) / BITS_IN_BYTE);
+
+    sendAll = sendAll || (lastSentJoints.size() != numJoints);
+    lastSentJoints.resize(numJoints);
+    for (int i = 0; i < numJoints; i++) {
+        if (sendAll || glm::dot(lastSentJoints[i].rotation, joints[i].rotation) < AVATAR_MIN_ROTATION_DOT) {
+            lastSentJoints[i].rotation = joints[i].rotation;
+            size += SIX_BYTES;
+        }
+        if (sendAll || glm::distance(joints[i].translation, lastSentJoints[i].translation) > AVATAR_MIN_TRANSLATION) {
+            lastSentJoints[i].translation = joints[i].translation;
+            size += SIX_BYTES;
+        }
+    }
+    return size;
+}
+
+static void addBenchmarkRows() {
+    QTest::addColumn<int>("numJoints");
+
+    for (int numJoints : { 30, 67, 120 }) {
+        QTest::newRow(qPrintable(QString("%1 joints").arg(numJoints))) << numJoints;
+    }
+}
+
+void PredictedJointDataTests::benchmarkBytesPerAvatar_data() {
+    addBenchmarkRows();
+}
+
+void PredictedJointDataTests::benchmarkBytesPerAvatar() {
+    QFETCH(int, numJoints);
+    TestSkeleton skeleton(numJoints);
+    const int NUM_FRAMES = 450;
+    const float ROTATION_DEAD_ZONE = sqrtf(2.0f * (1.0f - AVATAR_MIN_ROTATION_DOT)) / 2.0f;
+
+    // what one avatar sends for its joints, ten seconds of it
+    int predictedBytes = 0;
+    int sixByteBytes = 0;
+    PredictedJointData::History history;
+    QVector<JointData> lastSentJoints;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        QVector<JointData> joints = skeleton.getJoints(frame * FRAME_PERIOD);
+        predictedBytes += encode(joints, false, ROTATION_DEAD_ZONE, AVATAR_MIN_TRANSLATION, history).size();
+        sixByteBytes += sixByteJointDataSize(joints, lastSentJoints);
+    }
+
+    qDebug() << numJoints << "joints, bytes per frame: predicted" << (float)predictedBytes / NUM_FRAMES
+        << "six byte" << (float)sixByteBytes / NUM_FRAMES;
+    QVERIFY(predictedBytes < sixByteBytes);
+}
+
+void PredictedJointDataTests::benchmarkBytesPerViewer_data() {
+    QTest::addColumn<int>("numJoints");
+    QTest::addColumn<int>("sendInterval");
+    QTest::addColumn<float>("lossRatio");
+
+    for (int numJoints : { 30, 67, 120 }) {
+        QTest::newRow(qPrintable(QString("%1 joints, every frame").arg(numJoints))) << numJoints << 1 << 0.0f;
+        QTest::newRow(qPrintable(QString("%1 joints, every frame, 2% lost").arg(numJoints))) << numJoints << 1 << 0.02f;
+        QTest::newRow(qPrintable(QString("%1 joints, every third frame, 2% lost").arg(numJoints))) << numJoints << 3 << 0.02f;
+    }
+}
+
+// What the avatar mixer sends a viewer for one avatar's joints, ten seconds of it, resyncs and catch ups included. The
+// avatar is sent to the viewer every sendInterval frames, as when the viewer's bandwidth is shared by avatars that take
+// turns, and lossRatio of the packets are lost on the way to the mixer and on the way to the viewer. Whoever misses a
+// frame asks to be caught up, which arrives in time for the next frame. A viewer that wasn't sent the frame before gets
+// the six byte joints in place of a catch up that costs more, as AvatarMixerSlave does. The six byte joints rely on full
+// updates to recover instead.
+void PredictedJointDataTests::benchmarkBytesPerViewer() {
+    QFETCH(int, numJoints);
+    QFETCH(int, sendInterval);
+    QFETCH(float, lossRatio);
+    TestSkeleton skeleton(numJoints);
+    const int NUM_FRAMES = 450;
+    const float ROTATION_DEAD_ZONE = sqrtf(2.0f * (1.0f - AVATAR_MIN_ROTATION_DOT)) / 2.0f;
+
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    auto happens = [&](float ratio) { return distribution(random) < ratio; };
+
+    PredictedJointData::History sent;
+    bool keyFrameRequested = false;
+
+    PredictedJointData::History mixer;
+    PredictedJointData::RecentFrames recentFrames;
+    recentFrames.setEnabled(true);
+    QByteArray lastReceived;
+    QVector<JointData> mixerJoints;
+    int viewerFrame = -1; // the frame the mixer last sent the viewer, or the one the viewer asked to be caught up from
+    QVector<JointData> viewerSentJoints; // the six byte joints the mixer last sent the viewer
+    int lastSentFrame = -1;
+
+    PredictedJointData::History viewer;
+    QVector<JointData> lastSentJoints;
+
+    int predictedBytes = 0;
+    int sixByteBytes = 0;
+    int numCatchUps = 0;
+    int numResyncs = 0;
+    int numSixByte = 0;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        QVector<JointData> joints = skeleton.getJoints(frame * FRAME_PERIOD);
+        QByteArray encoded = encode(joints, keyFrameRequested, ROTATION_DEAD_ZONE, AVATAR_MIN_TRANSLATION, sent);
+        keyFrameRequested = false;
+        if (!happens(lossRatio)) {
+            mixerJoints = joints;
+            keyFrameRequested = isBehind(encoded, mixer);
+            if (decode(encoded, mixer)) {
+                lastReceived = encoded;
+                recentFrames.push(mixer);
+            }
+        }
+
+        if (!mixer.isValid() || frame % sendInterval != 0) {
+            continue;
+        }
+
+        bool sendAll = happens(AVATAR_SEND_FULL_UPDATE_RATIO);
+        bool isLost = happens(lossRatio);
+        sixByteBytes += sixByteJointDataSize(mixerJoints, lastSentJoints, sendAll);
+
+        QByteArray forwarded = encodeForReceiver(lastReceived, mixer, recentFrames, viewerFrame);
+        bool wasSentLastFrame = lastSentFrame == frame - 1;
+        lastSentFrame = frame;
+        if (!wasSentLastFrame && PredictedJointData::isCatchUp(reinterpret_cast<const uint8_t*>(forwarded.constData()))) {
+            QVector<JointData> sentJoints = viewerSentJoints;
+            int size = sixByteJointDataSize(mixerJoints, sentJoints, sendAll);
+            if (size <= forwarded.size()) {
+                predictedBytes += size;
+                numSixByte++;
+                viewerSentJoints = sentJoints;
+                viewerFrame = -1;
+                if (!isLost) {
+                    viewer.reset();
+                }
+                continue;
+            }
+        }
+
+        predictedBytes += forwarded.size();
+        if (getFlags(forwarded) & PredictedJointData::CATCH_UP_FRAME) {
+            numCatchUps++;
+        } else if (getFlags(forwarded) & PredictedJointData::HAS_PREVIOUS_FRAME) {
+            numResyncs++;
+        }
+        viewerFrame = mixer.frame;
+        viewerSentJoints = mixerJoints;
+
+        if (!isLost) {
+            if (isBehind(forwarded, viewer)) {
+                viewerFrame = viewer.frame;
+            }
+            if (decode(forwarded, viewer)) {
+                QVERIFY(isSameHistory(viewer, mixer));
+            }
+        }
+    }
+
+    qDebug() << numJoints << "joints, sent every" << sendInterval << "frames, lost" << lossRatio
+        << "bytes per frame: predicted" << (float)predictedBytes / NUM_FRAMES << "six byte"
+        << (float)sixByteBytes / NUM_FRAMES << "catch ups" << numCatchUps << "resyncs" << numResyncs
+        << "six byte in their place" << numSixByte;
+    if (sendInterval == 1) {
+        QVERIFY(predictedBytes < sixByteBytes);
+    } else {
+        // a catch up across a few frames costs more than the six byte joints it mostly gives way to, so it's about even
+        QVERIFY(predictedBytes <= sixByteBytes + sixByteBytes / 100);
+    }
+}
+
+void PredictedJointDataTests::benchmarkEncode_data() {
+    addBenchmarkRows();
+}
+
+void PredictedJointDataTests::benchmarkEncode() {
+    QFETCH(int, numJoints);
+    TestSkeleton skeleton(numJoints);
+    QVector<JointData> joints = skeleton.getJoints(0.0f);
+    PredictedJointData::History history;
+    QByteArray encoded((int)PredictedJointData::maxSize(numJoints), 0);
+    QBENCHMARK {
+        PredictedJointData::encode(joints, false, 0.0f, 0.0f, history, reinterpret_cast<uint8_t*>(encoded.data()));
+    }
+}
+
+void PredictedJointDataTests::benchmarkDecode_data() {
+    addBenchmarkRows();
+}
+
+void PredictedJointDataTests::benchmarkDecode() {
+    QFETCH(int, numJoints);
+    TestSkeleton skeleton(numJoints);
+    PredictedJointData::History sent;
+    encode(skeleton.getJoints(0.0f), sent);
+    PredictedJointData::History start = sent;
+    QByteArray encoded = encode(skeleton.getJoints(FRAME_PERIOD), sent);
+
+    PredictedJointData::History received;
+    QVector<JointData> joints;
+    QBENCHMARK {
+        received = start;
+        bool decoded;
+        PredictedJointData::decode(reinterpret_cast<const uint8_t*>(encoded.constData()), received, decoded);
+        PredictedJointData::toJointData(received, joints);
+    }
+}
@@ -0,0 +1,38 @@
+//
+//  PredictedJointDataTests.h
+//  tests/avatars/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PredictedJointDataTests_h
+#define hifi_PredictedJointDataTests_h
+
+#include <QtTest/QtTest>
+
+class PredictedJointDataTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testRoundTrip();
+    void testKeyFrames();
+    void testMissedFrame();
+    void testResync();
+    void testCatchUp();
+    void testRepeat();
+    void testDeadZone();
+
+    // predicted joint data against the six byte rotations and translations, for typical skeletons
+    void benchmarkBytesPerAvatar_data();
+    void benchmarkBytesPerAvatar();
+    void benchmarkBytesPerViewer_data();
+    void benchmarkBytesPerViewer();
+    void benchmarkEncode_data();
+    void benchmarkEncode();
+    void benchmarkDecode_data();
+    void benchmarkDecode();
+};
+
+#endif // hifi_PredictedJointDataTests_h
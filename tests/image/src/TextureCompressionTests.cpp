@@ -0,0 +1,129 @@
+//
+//  TextureCompressionTests.cpp
+//  tests/image/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureCompressionTests.h"
+
+#include <glm/glm.hpp>
+
+#include <image/Image.h>
+
+QTEST_MAIN(TextureCompressionTests)
+
+static const int TEXTURE_SIZE = 2048;
+static const int SKYBOX_FACE_SIZE = 512;
+
+// noisy colors over a few gradients, so the blocks don't all compress the same way
+static QImage createAlbedoImage(int size) {
+    QImage image(size, size, QImage::Format_ARGB32);
+    quint32 seed = 1;
+    for (int y = 0; y < size; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < size; x++) {
+            seed = seed * 1664525 + 1013904223;
+            int noise = (seed >> 24) & 0x1f;
+            line[x] = qRgba((x * 255 / size + noise) & 0xff, (y * 255 / size + noise) & 0xff, ((x ^ y) + noise) & 0xff, 255);
+        }
+    }
+    return image;
+}
+
+// the normals of a bumpy surface
+static QImage createNormalImage(int size) {
+    QImage image(size, size, QImage::Format_ARGB32);
+    const float FREQUENCY = 0.05f;
+    for (int y = 0; y < size; y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < size; x++) {
+            glm::vec3 normal = glm::normalize(glm::vec3(cosf(x * FREQUENCY), sinf(y * FREQUENCY), 2.0f));
+            glm::ivec3 color = glm::ivec3((normal * 0.5f + 0.5f) * 255.0f);
+            line[x] = qRgba(color.r, color.g, color.b, 255);
+        }
+    }
+    return image;
+}
+
+// a sky in a horizontal cross layout, which is converted to HDR and compressed to BC6
+static QImage createSkyboxImage(int faceSize) {
+    QImage image(4 * faceSize, 3 * faceSize, QImage::Format_RGB32);
+    for (int y = 0; y < image.height(); y++) {
+        QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(y));
+        for (int x = 0; x < image.width(); x++) {
+            int brightness = 255 - y * 128 / image.height();
+            line[x] = qRgb(brightness / 2, brightness * 3 / 4, brightness);
+        }
+    }
+    return image;
+}
+
+void TextureCompressionTests::initTestCase() {
+    _defaultMaxThreads = image::getMaxTextureCompressionThreads();
+    _albedoImage = createAlbedoImage(TEXTURE_SIZE);
+    _normalImage = createNormalImage(TEXTURE_SIZE);
+    _skyboxImage = createSkyboxImage(SKYBOX_FACE_SIZE);
+}
+
+void TextureCompressionTests::cleanupTestCase() {
+    image::setMaxTextureCompressionThreads(_defaultMaxThreads);
+}
+
+void TextureCompressionTests::benchmarkCompression_data() {
+    QTest::addColumn<int>("type");
+    QTest::addColumn<int>("target");
+    QTest::addColumn<int>("maxThreads");
+
+    struct Texture {
+        const char* name;
+        image::TextureUsage::Type type;
+        gpu::BackendTarget target;
+    };
+    const Texture TEXTURES[] = {
+        { "albedo BC1", image::TextureUsage::ALBEDO_TEXTURE, gpu::BackendTarget::GL45 },
+        { "normal BC5", image::TextureUsage::NORMAL_TEXTURE, gpu::BackendTarget::GL45 },
+        { "skybox BC6", image::TextureUsage::CUBE_TEXTURE, gpu::BackendTarget::GL45 },
+        { "albedo ETC2", image::TextureUsage::ALBEDO_TEXTURE, gpu::BackendTarget::GLES32 },
+    };
+
+    const int threadCounts[] = { 1, _defaultMaxThreads };
+    for (const auto& texture : TEXTURES) {
+        for (int maxThreads : threadCounts) {
+            QTest::newRow(QString("%1, %2 threads").arg(texture.name).arg(maxThreads).toLatin1().constData())
+                << (int)texture.type << (int)texture.target << maxThreads;
+            if (_defaultMaxThreads == 1) {
+                break;
+            }
+        }
+    }
+}
+
+void TextureCompressionTests::benchmarkCompression() {
+    QFETCH(int, type);
+    QFETCH(int, target);
+    QFETCH(int, maxThreads);
+
+    auto textureType = (image::TextureUsage::Type)type;
+    const QImage& source = textureType == image::TextureUsage::CUBE_TEXTURE ? _skyboxImage :
+        (textureType == image::TextureUsage::NORMAL_TEXTURE ? _normalImage : _albedoImage);
+
+    QVariantMap options;
+    options["generateIrradiance"] = false;
+    auto loader = image::TextureUsage::getTextureLoaderForType(textureType, options);
+
+    image::setMaxTextureCompressionThreads(maxThreads);
+    std::atomic<bool> abortProcessing { false };
+
+    gpu::TexturePointer texture;
+    QBENCHMARK {
+        QImage image = source.copy();
+        texture = loader(std::move(image), "benchmark", true, (gpu::BackendTarget)target, abortProcessing);
+    }
+
+    QVERIFY(texture);
+    QVERIFY(texture->isStoredMipFaceAvailable(0, 0));
+}
@@ -0,0 +1,33 @@
+//
+//  TextureCompressionTests.h
+//  tests/image/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureCompressionTests_h
+#define hifi_TextureCompressionTests_h
+
+#include <QtTest/QtTest>
+
+// Benchmarks compressing the mips of representative textures with one thread and with all of them
+class TextureCompressionTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void benchmarkCompression_data();
+    void benchmarkCompression();
+
+private:
+    QImage _albedoImage;
+    QImage _normalImage;
+    QImage _skyboxImage;
+    int _defaultMaxThreads { 1 };
+};
+
+#endif // hifi_TextureCompressionTests_h
@@ -0,0 +1,166 @@
+//
+//  DiffTraversalTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DiffTraversalTests.h"
+
+#include <mutex>
+#include <set>
+
+#include <DiffTraversal.h>
+#include <EntityItemProperties.h>
+#include <EntityPriorityQueue.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <ViewFrustum.h>
+
+QTEST_MAIN(DiffTraversalTests)
+
+const uint64_t TRAVERSAL_TIME_BUDGET = 10 * USECS_PER_SECOND; // enough to finish
+
+static DiffTraversal::View makeView(const glm::vec3& position) {
+    const float FIELD_OF_VIEW = 60.0f;
+    const float ASPECT_RATIO = 1.0f;
+    const float NEAR_CLIP = 0.1f;
+    const float FAR_CLIP = 100.0f;
+    const float CENTER_RADIUS = 3.0f;
+
+    // looking down -z
+    ViewFrustum viewFrustum;
+    viewFrustum.setPosition(position);
+    viewFrustum.setOrientation(glm::quat());
+    viewFrustum.setProjection(FIELD_OF_VIEW, ASPECT_RATIO, NEAR_CLIP, FAR_CLIP);
+    viewFrustum.setCenterRadius(CENTER_RADIUS);
+    viewFrustum.calculate();
+
+    ConicalViewFrustum conicalViewFrustum(viewFrustum);
+    conicalViewFrustum.calculate();
+
+    DiffTraversal::View view;
+    view.viewFrustums.push_back(conicalViewFrustum);
+    return view;
+}
+
+// a grid of boxes around the origin, deep enough that the top levels of the tree leave many subtrees below them
+static EntityTreePointer makeTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>(true);
+    tree->setIsServer(true);
+    tree->createRootElement();
+
+    const int GRID_SIZE = 12;
+    const float GRID_SPACING = 4.0f;
+    tree->withWriteLock([&] {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            for (int y = 0; y < GRID_SIZE; y++) {
+                for (int z = 0; z < GRID_SIZE; z++) {
+                    EntityItemProperties properties;
+                    properties.setType(EntityTypes::Box);
+                    properties.setPosition(GRID_SPACING * (glm::vec3(x, y, z) - 0.5f * (float)GRID_SIZE));
+                    properties.setDimensions(glm::vec3(0.1f + 0.1f * (float)((x + y + z) % 5)));
+                    tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+                }
+            }
+        }
+    });
+    return tree;
+}
+
+struct TraversalResult {
+    std::set<EntityTreeElement*> elements;
+    std::set<EntityItem*> entities;
+};
+
+static TraversalResult traverseSerially(const DiffTraversal::View& view, const EntityTreePointer& tree) {
+    TraversalResult result;
+    DiffTraversal traversal;
+    traversal.prepareNewTraversal(view, tree->getRoot());
+    traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+        result.elements.insert(next.element.get());
+        next.element->forEachEntity([&](EntityItemPointer entity) {
+            if (traversal.getCurrentView().computePriority(entity) != PrioritizedEntity::DO_NOT_SEND) {
+                result.entities.insert(entity.get());
+            }
+        });
+    });
+    tree->withReadLock([&] {
+        traversal.traverse(TRAVERSAL_TIME_BUDGET);
+    });
+    return result;
+}
+
+// runs traverseFirstInParallel with timeBudget until it finishes, counting the passes
+static TraversalResult traverseInParallel(const DiffTraversal::View& view, const EntityTreePointer& tree,
+                                          uint64_t timeBudget, int& numPasses) {
+    TraversalResult result;
+    std::mutex elementsMutex;
+    DiffTraversal traversal;
+    traversal.prepareNewTraversal(view, tree->getRoot());
+    auto scanCallback = [&](DiffTraversal::VisibleElement& next, EntityPriorityQueue& queue) {
+        {
+            std::lock_guard<std::mutex> lock(elementsMutex);
+            result.elements.insert(next.element.get());
+        }
+        next.element->forEachEntity([&](EntityItemPointer entity) {
+            float priority = traversal.getCurrentView().computePriority(entity);
+            if (priority != PrioritizedEntity::DO_NOT_SEND && !queue.contains(entity.get())) {
+                queue.emplace(entity, priority);
+            }
+        });
+    };
+
+    EntityPriorityQueue sendQueue;
+    numPasses = 0;
+    while (!traversal.finished()) {
+        tree->withReadLock([&] {
+            traversal.traverseFirstInParallel(timeBudget, scanCallback, sendQueue);
+        });
+        numPasses++;
+    }
+
+    while (!sendQueue.empty()) {
+        result.entities.insert(sendQueue.top().getRawEntityPointer());
+        sendQueue.pop();
+    }
+    return result;
+}
+
+void DiffTraversalTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+void DiffTraversalTests::testParallelFirstMatchesSerial() {
+    EntityTreePointer tree = makeTree();
+
+    // with a view and without, which traverses everything
+    for (const auto& view : { makeView(glm::vec3(0.0f)), DiffTraversal::View() }) {
+        TraversalResult serial = traverseSerially(view, tree);
+        QVERIFY(!serial.entities.empty());
+
+        int numPasses;
+        TraversalResult parallel = traverseInParallel(view, tree, TRAVERSAL_TIME_BUDGET, numPasses);
+        QCOMPARE(numPasses, 1);
+        QVERIFY(parallel.elements == serial.elements);
+        QVERIFY(parallel.entities == serial.entities);
+    }
+}
+
+void DiffTraversalTests::testParallelFirstResumes() {
+    EntityTreePointer tree = makeTree();
+    auto view = makeView(glm::vec3(0.0f));
+    TraversalResult serial = traverseSerially(view, tree);
+
+    // with no time to spare each pass scans about an element per worker, and the next pass picks up from there
+    int numPasses;
+    TraversalResult parallel = traverseInParallel(view, tree, 0, numPasses);
+    QVERIFY(numPasses > 1);
+    QVERIFY(parallel.elements == serial.elements);
+    QVERIFY(parallel.entities == serial.entities);
+}
@@ -0,0 +1,25 @@
+//
+//  DiffTraversalTests.h
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DiffTraversalTests_h
+#define hifi_DiffTraversalTests_h
+
+#include <QtTest/QtTest>
+
+class DiffTraversalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testParallelFirstMatchesSerial();
+    void testParallelFirstResumes();
+};
+
+#endif // hifi_DiffTraversalTests_h
@@ -0,0 +1,141 @@
+//
+//  EntityEditFiltersTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditFiltersTests.h"
+
+#include <EntityEditFilters.h>
+#include <SharedUtil.h>
+
+QTEST_MAIN(EntityEditFiltersTests)
+
+using FilterType = EntityTree::FilterType;
+
+static bool applyRules(EntityEditFilters::FilterData& filterData, EntityItemProperties& properties, FilterType filterType,
+                       const EntityItemID& entityID, bool& wasChanged) {
+    EntityItemProperties propertiesOut;
+    wasChanged = false;
+    return EntityEditFilters::applyRules(filterData, properties, propertiesOut, wasChanged, filterType, entityID);
+}
+
+static bool applyRules(EntityEditFilters::FilterData& filterData, EntityItemProperties& properties, FilterType filterType,
+                       const EntityItemID& entityID) {
+    bool wasChanged;
+    return applyRules(filterData, properties, filterType, entityID, wasChanged);
+}
+
+void EntityEditFiltersTests::testAllowedProperties() {
+    EntityEditFilters::FilterData filterData;
+    filterData.wantsAllowedProperties = true;
+    filterData.allowedProperties += PROP_NAME;
+    EntityItemID entityID = QUuid::createUuid();
+
+    EntityItemProperties rename;
+    rename.setName("renamed");
+    QVERIFY(applyRules(filterData, rename, FilterType::Edit, entityID));
+
+    EntityItemProperties move;
+    move.setName("moved");
+    move.setPosition(glm::vec3(1.0f));
+    QVERIFY(!applyRules(filterData, move, FilterType::Edit, entityID));
+
+    // adds set up the whole entity, physics edits come from the simulation
+    QVERIFY(applyRules(filterData, move, FilterType::Add, EntityItemID()));
+    QVERIFY(applyRules(filterData, move, FilterType::Physics, entityID));
+    QVERIFY(applyRules(filterData, move, FilterType::Delete, entityID));
+}
+
+void EntityEditFiltersTests::testPositionClamp() {
+    EntityEditFilters::FilterData filterData;
+    filterData.wantsPositionClamp = true;
+    filterData.positionClamp = AABox(glm::vec3(-10.0f), glm::vec3(20.0f));
+    EntityItemID entityID = QUuid::createUuid();
+
+    bool wasChanged;
+    EntityItemProperties inside;
+    inside.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    QVERIFY(applyRules(filterData, inside, FilterType::Edit, entityID, wasChanged));
+    QVERIFY(!wasChanged);
+    QCOMPARE(inside.getPosition(), glm::vec3(1.0f, 2.0f, 3.0f));
+
+    EntityItemProperties outside;
+    outside.setPosition(glm::vec3(-20.0f, 2.0f, 30.0f));
+    QVERIFY(applyRules(filterData, outside, FilterType::Edit, entityID, wasChanged));
+    QVERIFY(wasChanged);
+    QCOMPARE(outside.getPosition(), glm::vec3(-10.0f, 2.0f, 10.0f));
+
+    // edits that don't move the entity are left alone
+    EntityItemProperties rename;
+    rename.setName("renamed");
+    QVERIFY(applyRules(filterData, rename, FilterType::Edit, entityID, wasChanged));
+    QVERIFY(!wasChanged);
+    QVERIFY(!rename.containsPositionChange());
+}
+
+void EntityEditFiltersTests::testRateLimit() {
+    const int MAX_EDITS_PER_SECOND = 5;
+    EntityEditFilters::FilterData filterData;
+    filterData.maxEditsPerSecond = MAX_EDITS_PER_SECOND;
+    filterData.rateLimiter = std::make_shared<EntityEditFilters::EditRateLimiter>();
+    EntityItemID entityID = QUuid::createUuid();
+    EntityItemID otherEntityID = QUuid::createUuid();
+
+    EntityItemProperties rename;
+    rename.setName("renamed");
+    for (int i = 0; i < MAX_EDITS_PER_SECOND; i++) {
+        QVERIFY(applyRules(filterData, rename, FilterType::Edit, entityID));
+    }
+    QVERIFY(!applyRules(filterData, rename, FilterType::Edit, entityID));
+
+    // each entity has a limit of its own
+    QVERIFY(applyRules(filterData, rename, FilterType::Edit, otherEntityID));
+}
+
+void EntityEditFiltersTests::testRateLimitOnlyEdits() {
+    EntityEditFilters::FilterData filterData;
+    filterData.maxEditsPerSecond = 1.0f;
+    filterData.rateLimiter = std::make_shared<EntityEditFilters::EditRateLimiter>();
+    EntityItemID entityID = QUuid::createUuid();
+
+    EntityItemProperties move;
+    move.setPosition(glm::vec3(1.0f));
+    QVERIFY(applyRules(filterData, move, FilterType::Edit, entityID));
+    QVERIFY(!applyRules(filterData, move, FilterType::Edit, entityID));
+
+    // the simulation owner keeps updating the entity past the limit
+    for (int i = 0; i < 10; i++) {
+        QVERIFY(applyRules(filterData, move, FilterType::Physics, entityID));
+    }
+    QVERIFY(applyRules(filterData, move, FilterType::Add, EntityItemID()));
+    QVERIFY(applyRules(filterData, move, FilterType::Delete, entityID));
+}
+
+void EntityEditFiltersTests::testRateLimiterWindows() {
+    const float MAX_EDITS_PER_SECOND = 2.0f;
+    EntityEditFilters::EditRateLimiter rateLimiter;
+    EntityItemID entityID = QUuid::createUuid();
+    EntityItemID otherEntityID = QUuid::createUuid();
+    quint64 start = usecTimestampNow();
+
+    QVERIFY(rateLimiter.allowEdit(entityID, MAX_EDITS_PER_SECOND, start));
+    QVERIFY(rateLimiter.allowEdit(otherEntityID, MAX_EDITS_PER_SECOND, start + USECS_PER_SECOND / 2));
+    QVERIFY(rateLimiter.allowEdit(entityID, MAX_EDITS_PER_SECOND, start + USECS_PER_SECOND / 2));
+    QVERIFY(!rateLimiter.allowEdit(entityID, MAX_EDITS_PER_SECOND, start + USECS_PER_SECOND));
+
+    // the first entity's window has ended, the other one's hasn't
+    quint64 later = start + USECS_PER_SECOND + USECS_PER_SECOND / 4;
+    QVERIFY(rateLimiter.allowEdit(entityID, MAX_EDITS_PER_SECOND, later));
+    QVERIFY(rateLimiter.allowEdit(otherEntityID, MAX_EDITS_PER_SECOND, later));
+    QVERIFY(!rateLimiter.allowEdit(otherEntityID, MAX_EDITS_PER_SECOND, later));
+
+    // and again once both have ended, after the expired windows were forgotten
+    quint64 muchLater = later + 2 * USECS_PER_SECOND;
+    QVERIFY(rateLimiter.allowEdit(entityID, MAX_EDITS_PER_SECOND, muchLater));
+    QVERIFY(rateLimiter.allowEdit(otherEntityID, MAX_EDITS_PER_SECOND, muchLater));
+}
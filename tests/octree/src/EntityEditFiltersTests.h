@@ -0,0 +1,27 @@
+//
+//  EntityEditFiltersTests.h
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditFiltersTests_h
+#define hifi_EntityEditFiltersTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditFiltersTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAllowedProperties();
+    void testPositionClamp();
+    void testRateLimit();
+    void testRateLimitOnlyEdits();
+    void testRateLimiterWindows();
+};
+
+#endif // hifi_EntityEditFiltersTests_h
@@ -0,0 +1,211 @@
+//
+//  EntitySpatialIndexTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySpatialIndexTests.h"
+
+#include <random>
+#include <set>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <NodeList.h>
+
+QTEST_MAIN(EntitySpatialIndexTests)
+
+// entities are spread over a region a few levels deep in the octree, with some large enough to sit high up in it
+const int NUM_TEST_ENTITIES = 200;
+const int NUM_TEST_QUERIES = 100;
+const float REGION_SIZE = 200.0f;
+
+using EntitySet = std::set<EntityItem*>;
+
+static EntitySet toSet(const QVector<EntityItemPointer>& entities) {
+    EntitySet result;
+    for (const auto& entity : entities) {
+        result.insert(entity.get());
+    }
+    return result;
+}
+
+class TestScene {
+public:
+    TestScene() : _random(1) {
+        _tree = std::make_shared<EntityTree>(true);
+        _tree->setIsServer(true);
+        _tree->createRootElement();
+    }
+
+    float random(float min, float max) {
+        return std::uniform_real_distribution<float>(min, max)(_random);
+    }
+
+    glm::vec3 randomPosition() {
+        float halfSize = 0.5f * REGION_SIZE;
+        return glm::vec3(random(-halfSize, halfSize), random(-halfSize, halfSize), random(-halfSize, halfSize));
+    }
+
+    glm::vec3 randomDimensions() {
+        // mostly small props, and a few buildings
+        return glm::vec3(random(0.0f, 1.0f) < 0.9f ? random(0.1f, 2.0f) : random(10.0f, 60.0f));
+    }
+
+    void addEntities(int numEntities) {
+        for (int i = 0; i < numEntities; i++) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(randomPosition());
+            properties.setDimensions(randomDimensions());
+            EntityItemID entityID(QUuid::createUuid());
+            _tree->withWriteLock([&] {
+                if (_tree->addEntity(entityID, properties)) {
+                    _entityIDs.push_back(entityID);
+                }
+            });
+        }
+    }
+
+    // the results of the octree recursion the index replaced, which looks at every element
+    template <typename Shape>
+    EntitySet findByRecursion(const Shape& shape) {
+        QVector<EntityItemPointer> entities;
+        _tree->withReadLock([&] {
+            _tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+                std::static_pointer_cast<EntityTreeElement>(element)->getEntities(shape, entities);
+                return true;
+            });
+        });
+        return toSet(entities);
+    }
+
+    EntitySet findInSphereByRecursion(const glm::vec3& center, float radius) {
+        QVector<EntityItemPointer> entities;
+        _tree->withReadLock([&] {
+            _tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+                std::static_pointer_cast<EntityTreeElement>(element)->getEntities(center, radius, entities);
+                return true;
+            });
+        });
+        return toSet(entities);
+    }
+
+    size_t countOccupiedElements() {
+        size_t numElements = 0;
+        _tree->withReadLock([&] {
+            _tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+                if (std::static_pointer_cast<EntityTreeElement>(element)->hasEntities()) {
+                    ++numElements;
+                }
+                return true;
+            });
+        });
+        return numElements;
+    }
+
+    // compares the indexed sphere, cube and box queries with the recursion, for queries of all sizes
+    void verifyQueries() {
+        QCOMPARE(_tree->getSpatialIndex().getNumElements(), countOccupiedElements());
+
+        for (int i = 0; i < NUM_TEST_QUERIES; i++) {
+            glm::vec3 center = randomPosition();
+            float size = i % 10 == 0 ? random(50.0f, REGION_SIZE) : random(0.5f, 20.0f);
+
+            QVector<EntityItemPointer> found;
+            _tree->withReadLock([&] {
+                _tree->findEntities(center, size, found);
+            });
+            QCOMPARE(toSet(found), findInSphereByRecursion(center, size));
+
+            AACube cube(center - glm::vec3(0.5f * size), size);
+            _tree->withReadLock([&] {
+                _tree->findEntities(cube, found);
+            });
+            QCOMPARE(toSet(found), findByRecursion(cube));
+
+            AABox box(center - glm::vec3(size, 0.25f * size, 0.5f * size), glm::vec3(2.0f * size, 0.5f * size, size));
+            _tree->withReadLock([&] {
+                _tree->findEntities(box, found);
+            });
+            QCOMPARE(toSet(found), findByRecursion(box));
+        }
+    }
+
+    EntityTreePointer _tree;
+    std::vector<EntityItemID> _entityIDs;
+
+private:
+    std::mt19937 _random;
+};
+
+void EntitySpatialIndexTests::initTestCase() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer);
+}
+
+void EntitySpatialIndexTests::testAdd() {
+    TestScene scene;
+    QCOMPARE(scene._tree->getSpatialIndex().getNumElements(), (size_t)0);
+
+    scene.addEntities(NUM_TEST_ENTITIES);
+    QCOMPARE((int)scene._entityIDs.size(), NUM_TEST_ENTITIES);
+    scene.verifyQueries();
+}
+
+void EntitySpatialIndexTests::testMove() {
+    TestScene scene;
+    scene.addEntities(NUM_TEST_ENTITIES);
+
+    // far enough that most entities change elements, and some change size so they move up or down the tree
+    for (size_t i = 0; i < scene._entityIDs.size(); i++) {
+        EntityItemProperties properties;
+        properties.setPosition(scene.randomPosition());
+        if (i % 4 == 0) {
+            properties.setDimensions(scene.randomDimensions());
+        }
+        scene._tree->withWriteLock([&] {
+            QVERIFY(scene._tree->updateEntity(scene._entityIDs[i], properties));
+        });
+    }
+    scene.verifyQueries();
+}
+
+void EntitySpatialIndexTests::testDelete() {
+    TestScene scene;
+    scene.addEntities(NUM_TEST_ENTITIES);
+
+    // delete every other entity, then the elements they leave empty are pruned
+    for (size_t i = 0; i < scene._entityIDs.size(); i += 2) {
+        scene._tree->withWriteLock([&] {
+            scene._tree->deleteEntity(scene._entityIDs[i], true);
+        });
+    }
+    scene.verifyQueries();
+
+    scene._tree->withWriteLock([&] {
+        scene._tree->pruneTree();
+    });
+    scene.verifyQueries();
+
+    // and adding to a pruned tree registers its new elements
+    scene.addEntities(NUM_TEST_ENTITIES / 2);
+    scene.verifyQueries();
+}
+
+void EntitySpatialIndexTests::testEraseAll() {
+    TestScene scene;
+    scene.addEntities(NUM_TEST_ENTITIES);
+
+    scene._tree->eraseAllOctreeElements();
+    QCOMPARE(scene._tree->getSpatialIndex().getNumElements(), (size_t)0);
+
+    scene._entityIDs.clear();
+    scene.addEntities(NUM_TEST_ENTITIES);
+    scene.verifyQueries();
+}
@@ -0,0 +1,168 @@
+//
+//  ScriptTimerWheelTests.cpp
+//  tests/script-engine/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptTimerWheelTests.h"
+
+#include <map>
+
+#include <ScriptTimerWheel.h>
+
+QTEST_MAIN(ScriptTimerWheelTests)
+
+using TimerID = ScriptTimerWheel::TimerID;
+using Tick = ScriptTimerWheel::Tick;
+
+struct FiredTimer {
+    TimerID id;
+    Tick tick;
+};
+
+// runs the wheel the way the script engine does, only advancing it to the ticks it asks to be woken at,
+// and puts intervals back in the wheel one interval after they were due
+static std::vector<FiredTimer> runUntil(ScriptTimerWheel& wheel, Tick endTick, const std::map<TimerID, Tick>& intervals = {}) {
+    std::vector<FiredTimer> fired;
+    for (Tick wakeTick = wheel.getNextWakeTick(); wakeTick <= endTick; wakeTick = wheel.getNextWakeTick()) {
+        std::vector<ScriptTimerWheel::DueTimer> dueTimers;
+        wheel.advance(wakeTick, dueTimers);
+        for (auto& dueTimer : dueTimers) {
+            fired.push_back({ dueTimer.id, wakeTick });
+            auto interval = intervals.find(dueTimer.id);
+            if (interval != intervals.end()) {
+                wheel.add(dueTimer.id, dueTimer.dueTick + interval->second);
+            }
+        }
+    }
+    return fired;
+}
+
+void ScriptTimerWheelTests::testEmpty() {
+    ScriptTimerWheel wheel;
+    QCOMPARE(wheel.size(), (size_t)0);
+    QCOMPARE(wheel.getNextWakeTick(), (Tick)UINT64_MAX);
+
+    wheel.add(1, 10);
+    wheel.clear();
+    QCOMPARE(wheel.size(), (size_t)0);
+    QCOMPARE(wheel.getNextWakeTick(), (Tick)UINT64_MAX);
+    QCOMPARE(runUntil(wheel, 1000).size(), (size_t)0);
+}
+
+void ScriptTimerWheelTests::testDueOrder() {
+    ScriptTimerWheel wheel;
+    wheel.add(1, 5);
+    wheel.add(2, 3);
+    wheel.add(3, 255);
+    wheel.add(4, 5);
+    QCOMPARE(wheel.size(), (size_t)4);
+    QVERIFY(wheel.getNextWakeTick() <= 3);
+
+    auto fired = runUntil(wheel, 1000);
+    QCOMPARE(fired.size(), (size_t)4);
+    QCOMPARE(fired[0].id, (TimerID)2);
+    QCOMPARE(fired[0].tick, (Tick)3);
+    QCOMPARE(fired[1].id, (TimerID)1);
+    QCOMPARE(fired[1].tick, (Tick)5);
+    QCOMPARE(fired[2].id, (TimerID)4);
+    QCOMPARE(fired[2].tick, (Tick)5);
+    QCOMPARE(fired[3].id, (TimerID)3);
+    QCOMPARE(fired[3].tick, (Tick)255);
+    QCOMPARE(wheel.size(), (size_t)0);
+}
+
+void ScriptTimerWheelTests::testRemove() {
+    ScriptTimerWheel wheel;
+    wheel.add(1, 10);
+    wheel.add(2, 20);
+    wheel.add(3, 5000);
+
+    QVERIFY(wheel.remove(1));
+    QVERIFY(!wheel.remove(1));
+    QVERIFY(wheel.remove(3));
+    QVERIFY(!wheel.contains(1));
+    QVERIFY(wheel.contains(2));
+    QCOMPARE(wheel.size(), (size_t)1);
+
+    auto fired = runUntil(wheel, 10000);
+    QCOMPARE(fired.size(), (size_t)1);
+    QCOMPARE(fired[0].id, (TimerID)2);
+    QCOMPARE(fired[0].tick, (Tick)20);
+}
+
+void ScriptTimerWheelTests::testReschedule() {
+    ScriptTimerWheel wheel;
+    wheel.add(1, 30);
+    wheel.add(2, 20);
+
+    // the old slots are left behind, only the new due ticks count
+    wheel.add(1, 15);
+    wheel.add(2, 600);
+    QCOMPARE(wheel.size(), (size_t)2);
+
+    auto fired = runUntil(wheel, 1000);
+    QCOMPARE(fired.size(), (size_t)2);
+    QCOMPARE(fired[0].id, (TimerID)1);
+    QCOMPARE(fired[0].tick, (Tick)15);
+    QCOMPARE(fired[1].id, (TimerID)2);
+    QCOMPARE(fired[1].tick, (Tick)600);
+}
+
+void ScriptTimerWheelTests::testPastDue() {
+    ScriptTimerWheel wheel;
+    std::vector<ScriptTimerWheel::DueTimer> dueTimers;
+    wheel.advance(100, dueTimers);
+    QCOMPARE(dueTimers.size(), (size_t)0);
+
+    // a timer added behind the wheel comes due on the next advance
+    wheel.add(1, 50);
+    QVERIFY(wheel.getNextWakeTick() <= 101);
+
+    wheel.advance(101, dueTimers);
+    QCOMPARE(dueTimers.size(), (size_t)1);
+    QCOMPARE(dueTimers[0].id, (TimerID)1);
+    QCOMPARE(dueTimers[0].dueTick, (Tick)50);
+}
+
+void ScriptTimerWheelTests::testHigherLevels() {
+    // past the first level (256 ticks), the second (16384 ticks) and the third (1048576 ticks)
+    const Tick LEVEL_1_TICK = 256 + 44;
+    const Tick LEVEL_2_TICK = 16384 + 1000;
+    const Tick LEVEL_3_TICK = 1048576 + 3;
+
+    ScriptTimerWheel wheel;
+    wheel.add(3, LEVEL_3_TICK);
+    wheel.add(2, LEVEL_2_TICK);
+    wheel.add(1, LEVEL_1_TICK);
+
+    auto fired = runUntil(wheel, LEVEL_3_TICK);
+    QCOMPARE(fired.size(), (size_t)3);
+    QCOMPARE(fired[0].id, (TimerID)1);
+    QCOMPARE(fired[0].tick, LEVEL_1_TICK);
+    QCOMPARE(fired[1].id, (TimerID)2);
+    QCOMPARE(fired[1].tick, LEVEL_2_TICK);
+    QCOMPARE(fired[2].id, (TimerID)3);
+    QCOMPARE(fired[2].tick, LEVEL_3_TICK);
+}
+
+void ScriptTimerWheelTests::testIntervalOnLevelBoundary() {
+    // the interval leaves the wheel stopped on the first tick of a turn of the first level,
+    // the timeout in the level above must still come down in time
+    ScriptTimerWheel wheel;
+    wheel.add(1, 255);
+    wheel.add(2, 300);
+
+    auto fired = runUntil(wheel, 600, { { 1, 255 } });
+    QCOMPARE(fired.size(), (size_t)3);
+    QCOMPARE(fired[0].id, (TimerID)1);
+    QCOMPARE(fired[0].tick, (Tick)255);
+    QCOMPARE(fired[1].id, (TimerID)2);
+    QCOMPARE(fired[1].tick, (Tick)300);
+    QCOMPARE(fired[2].id, (TimerID)1);
+    QCOMPARE(fired[2].tick, (Tick)510);
+}
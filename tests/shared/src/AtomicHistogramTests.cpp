@@ -0,0 +1,73 @@
+//
+//  AtomicHistogramTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AtomicHistogramTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <AtomicHistogram.h>
+
+QTEST_MAIN(AtomicHistogramTests)
+
+void AtomicHistogramTests::testBuckets() {
+    using Histogram = AtomicHistogram<8>;
+
+    QCOMPARE(Histogram::bucketForSample(0), 0);
+    QCOMPARE(Histogram::bucketForSample(1), 1);
+    QCOMPARE(Histogram::bucketForSample(2), 2);
+    QCOMPARE(Histogram::bucketForSample(3), 2);
+    QCOMPARE(Histogram::bucketForSample(4), 3);
+    QCOMPARE(Histogram::bucketForSample(63), 6);
+    QCOMPARE(Histogram::bucketForSample(64), 7);
+    QCOMPARE(Histogram::bucketForSample(1000000), 7);
+
+    for (int bucket = 0; bucket < 7; bucket++) {
+        uint64_t upperBound = Histogram::getBucketUpperBound(bucket);
+        QCOMPARE(Histogram::bucketForSample(upperBound - 1), bucket);
+        QCOMPARE(Histogram::bucketForSample(upperBound), bucket + 1);
+    }
+    QCOMPARE(Histogram::getBucketUpperBound(7), (uint64_t)0);
+
+    Histogram histogram;
+    histogram.addSample(0);
+    histogram.addSample(5);
+    histogram.addSample(6);
+    histogram.addSample(5000);
+
+    auto counts = histogram.getCounts();
+    QCOMPARE(counts[0], (uint64_t)1);
+    QCOMPARE(counts[3], (uint64_t)2);
+    QCOMPARE(counts[7], (uint64_t)1);
+    QCOMPARE(histogram.getSampleCount(), (uint64_t)4);
+
+    histogram.reset();
+    QCOMPARE(histogram.getSampleCount(), (uint64_t)0);
+}
+
+void AtomicHistogramTests::testConcurrentSamples() {
+    const int NUM_THREADS = 8;
+    const int SAMPLES_PER_THREAD = 100000;
+
+    AtomicHistogram<> histogram;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; i++) {
+        threads.emplace_back([&histogram, i] {
+            for (int j = 0; j < SAMPLES_PER_THREAD; j++) {
+                histogram.addSample((uint64_t)(i * j));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    QCOMPARE(histogram.getSampleCount(), (uint64_t)(NUM_THREADS * SAMPLES_PER_THREAD));
+}
@@ -0,0 +1,23 @@
+//
+//  AtomicHistogramTests.h
+//  tests/shared/src
+//
+//  Copyright 2018 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AtomicHistogramTests_h
+#define hifi_AtomicHistogramTests_h
+
+#include <QtTest/QtTest>
+
+class AtomicHistogramTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testBuckets();
+    void testConcurrentSamples();
+};
+
+#endif // hifi_AtomicHistogramTests_h
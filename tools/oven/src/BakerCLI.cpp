@@ -16,8 +16,13 @@
 #include <QtCore/QDebug>
 #include <QFile>
 
+#include <iostream>
+#include <string>
+#include <thread>
 #include <unordered_map>
 
+#include <AssetUtils.h>
+
 #include "OvenCLIApplication.h"
 #include "ModelBakingLoggingCategory.h"
 #include "FBXBaker.h"
@@ -28,6 +33,34 @@ BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
     
 }
 
+BakerCLI::~BakerCLI() {
+    // a worker only quits once its input thread has read the end of stdin, so this doesn't wait for long
+    if (_workerInputThread.joinable()) {
+        _workerInputThread.join();
+    }
+}
+
+void BakerCLI::startWorker() {
+    _isWorker = true;
+
+    // stdin can't be watched by the event loop on every platform, so read it on its own thread. The asset server
+    // waits for the result of each bake before sending the next one, so at most one bake is queued at a time.
+    _workerInputThread = std::thread([this] {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            auto fields = QString::fromStdString(line).split('\t');
+            if (fields.size() != 3) {
+                qCDebug(model_baking) << "Ignoring malformed bake request:" << QString::fromStdString(line);
+                continue;
+            }
+            QMetaObject::invokeMethod(this, "bakeFile", Qt::QueuedConnection,
+                                      Q_ARG(QUrl, QUrl(QDir::fromNativeSeparators(fields[0]))),
+                                      Q_ARG(QString, QDir::fromNativeSeparators(fields[1])), Q_ARG(QString, fields[2]));
+        }
+        QMetaObject::invokeMethod(QCoreApplication::instance(), "quit", Qt::QueuedConnection);
+    });
+}
+
 void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
 
     // if the URL doesn't have a scheme, assume it is a local file
@@ -85,13 +118,14 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
         auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
         if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
             qCDebug(model_baking) << "Unknown texture usage type:" << type;
-            QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+            finish(OVEN_STATUS_CODE_FAIL);
+            return;
         }
         _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
         _baker->moveToThread(Oven::instance().getNextWorkerThread());
     } else {
         qCDebug(model_baking) << "Failed to determine baker type for file" << inputUrl;
-        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        finish(OVEN_STATUS_CODE_FAIL);
         return;
     }
 
@@ -116,5 +150,20 @@ void BakerCLI::handleFinishedBaker() {
             errorFile.close();
         }
     }
-    QCoreApplication::exit(exitCode);
+    finish(exitCode);
+}
+
+void BakerCLI::finish(int statusCode) {
+    if (!_isWorker) {
+        QCoreApplication::exit(statusCode);
+        return;
+    }
+
+    // the baker lives on a worker thread, let it be deleted there
+    if (_baker) {
+        disconnect(_baker.get(), nullptr, this, nullptr);
+        _baker.release()->deleteLater();
+    }
+
+    std::cout << AssetUtils::OVEN_WORKER_RESULT_PREFIX.toStdString() << statusCode << std::endl;
 }
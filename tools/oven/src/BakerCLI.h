@@ -17,6 +17,7 @@
 #include <QUrl>
 
 #include <memory>
+#include <thread>
 
 #include "Baker.h"
 #include "OvenCLIApplication.h"
@@ -32,6 +33,11 @@ class BakerCLI : public QObject {
 
 public:
     BakerCLI(OvenCLIApplication* parent);
+    ~BakerCLI();
+
+    /// Keep running and bake one file for each line of "<input>\t<output>\t<type>" read from stdin,
+    /// until stdin is closed. Lets the asset server reuse one oven process for many bakes.
+    void startWorker();
 
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString::null);
@@ -40,6 +46,10 @@ private slots:
     void handleFinishedBaker();  
 
 private:
+    void finish(int statusCode);
+
+    bool _isWorker { false };
+    std::thread _workerInputThread; // reads the bake requests from stdin in worker mode
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
 };
@@ -18,6 +18,9 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
 #include "Gzip.h"
 #include "Oven.h"
 #include "FBXBaker.h"
@@ -40,6 +43,8 @@ DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainNam
 }
 
 void DomainBaker::bake() {
+    _bakeStartTime = usecTimestampNow();
+
     setupOutputFolder();
 
     if (hasErrors()) {
@@ -221,6 +226,9 @@ void DomainBaker::enumerateEntities() {
                             };
                         }
 
+                        // textures shared between models are only baked once
+                        baker->setTextureBakeCache(_textureBakeCache);
+
                         // make sure our handler is called when the baker is done
                         connect(baker.data(), &Baker::finished, this, &DomainBaker::handleFinishedModelBaker);
 
@@ -293,6 +301,8 @@ void DomainBaker::bakeSkybox(QUrl skyboxURL, QJsonValueRef entity) {
                 &TextureBaker::deleteLater
             };
 
+            skyboxBaker->setBakeCache(_textureBakeCache);
+
             // make sure our handler is called when the skybox baker is done
             connect(skyboxBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedSkyboxBaker);
 
@@ -378,6 +388,8 @@ void DomainBaker::handleFinishedModelBaker() {
                 // replace our temp object with the value referenced by our QJsonValueRef
                 entityValue = entity;
             }
+
+            recordModelBakeTimings(baker);
         } else {
             // this model failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the model to our warnings
@@ -485,11 +497,48 @@ void DomainBaker::checkIfRewritingComplete() {
             return;
         }
 
+        reportBakeTimings();
+
         // we've now written out our new models file - time to say that we are finished up
         emit finished();
     }
 }
 
+void DomainBaker::recordModelBakeTimings(ModelBaker* baker) {
+    const auto& timings = baker->getStageTimings();
+    _totalModelBakeTime += timings.total;
+
+    if (timings.total > _slowestModelTimings.total) {
+        _slowestModelURL = baker->getModelURL();
+        _slowestModelTimings = timings;
+    }
+}
+
+void DomainBaker::reportBakeTimings() {
+    static const float USECS_PER_MSEC_F = (float)USECS_PER_MSEC;
+    auto elapsed = usecTimestampNow() - _bakeStartTime;
+
+    qDebug() << "Baked domain in" << elapsed / USECS_PER_MSEC_F << "ms";
+
+    // the model bakes run in parallel, so their total over the elapsed time is how much of the machine the bake used
+    if (elapsed > 0) {
+        qDebug() << "Model bakes took" << _totalModelBakeTime / USECS_PER_MSEC_F << "ms in total, an average of"
+                 << (float)_totalModelBakeTime / (float)elapsed << "running at once";
+    }
+
+    if (!_slowestModelURL.isEmpty()) {
+        qDebug() << "Critical path:" << _slowestModelURL << "in" << _slowestModelTimings.total / USECS_PER_MSEC_F << "ms -"
+                 << "load" << _slowestModelTimings.load / USECS_PER_MSEC_F << "ms,"
+                 << "parse" << _slowestModelTimings.parse / USECS_PER_MSEC_F << "ms,"
+                 << "mesh compression" << _slowestModelTimings.meshCompression / USECS_PER_MSEC_F << "ms,"
+                 << "textures" << _slowestModelTimings.textures / USECS_PER_MSEC_F << "ms"
+                 << "(slowest texture" << _slowestModelTimings.slowestTexture / USECS_PER_MSEC_F << "ms)";
+    }
+
+    qDebug() << "Re-used" << _textureBakeCache->getHits() << "texture bakes, baked"
+             << _textureBakeCache->getMisses() << "distinct textures";
+}
+
 void DomainBaker::writeNewEntitiesFile() {
     // we've enumerated all of our entities and re-written all the URLs we'll be able to re-write
     // time to write out a main models.json.gz file
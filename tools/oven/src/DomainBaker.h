@@ -19,14 +19,12 @@
 
 #include "Baker.h"
 #include "FBXBaker.h"
+#include "TextureBakeCache.h"
 #include "TextureBaker.h"
 
 class DomainBaker : public Baker {
     Q_OBJECT
 public:
-    // This is a real bummer, but the FBX SDK is not thread safe - even with separate FBXManager objects.
-    // This means that we need to put all of the FBX importing/exporting from the same process on the same thread.
-    // That means you must pass a usable running QThread when constructing a domain baker.
     DomainBaker(const QUrl& localEntitiesFileURL, const QString& domainName,
                 const QString& baseOutputPath, const QUrl& destinationPath,
                 bool shouldRebakeOriginals = false);
@@ -46,6 +44,8 @@ private:
     void enumerateEntities();
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
+    void recordModelBakeTimings(ModelBaker* baker);
+    void reportBakeTimings();
 
     void bakeSkybox(QUrl skyboxURL, QJsonValueRef entity);
     bool rewriteSkyboxURL(QJsonValueRef urlValue, TextureBaker* baker);
@@ -63,6 +63,15 @@ private:
 
     QHash<QUrl, QSharedPointer<ModelBaker>> _modelBakers;
     QHash<QUrl, QSharedPointer<TextureBaker>> _skyboxBakers;
+
+    // shared by every model and skybox of the domain, so each distinct texture is only baked once
+    std::shared_ptr<TextureBakeCache> _textureBakeCache { std::make_shared<TextureBakeCache>() };
+
+    // the domain bake is only as fast as its slowest model, keep its stage timings to report the critical path
+    quint64 _bakeStartTime { 0 };
+    quint64 _totalModelBakeTime { 0 };
+    QUrl _slowestModelURL;
+    ModelBaker::StageTimings _slowestModelTimings;
     
     QMultiHash<QUrl, QJsonValueRef> _entitiesNeedingRewrite;
 
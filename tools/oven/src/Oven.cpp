@@ -63,8 +63,9 @@ void Oven::setupWorkerThreads(int numWorkerThreads) {
 QThread* Oven::getNextWorkerThread() {
     // Here we replicate some of the functionality of QThreadPool by giving callers an available worker thread to use.
     // We can't use QThreadPool because we want to put QObjects with signals/slots on these threads.
-    // So instead we setup our own list of threads, up to one less than the ideal thread count
-    // (for the FBX Baker Thread to have room), and cycle through them to hand a usable running thread back to our callers.
+    // So instead we setup our own list of threads, one per core, and cycle through them to hand a usable running thread
+    // back to our callers. FBX parsing and writing use our own reader and writer, so model bakers are spread across
+    // these threads like every other baker.
 
     auto nextIndex = ++_nextWorkerThreadIndex;
     auto& nextThread = _workerThreads[nextIndex % _workerThreads.size()];
@@ -30,7 +30,6 @@ public:
 
 private:
     void setupWorkerThreads(int numWorkerThreads);
-    void setupFBXBakerThread();
 
     std::vector<std::unique_ptr<QThread>> _workerThreads;
 
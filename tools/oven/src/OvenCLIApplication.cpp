@@ -23,6 +23,8 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_WORKER_PARAMETER = "worker";
+static const QString CLI_COMPRESSION_THREADS_PARAMETER = "compression-threads";
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -34,12 +36,18 @@ OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset.", "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_WORKER_PARAMETER, "Bake the files listed on stdin, one \"input<TAB>output<TAB>type\" per line, until it is closed." },
+        { CLI_COMPRESSION_THREADS_PARAMETER, "Maximum number of threads used to compress a texture.", "threads" }
     });
 
     parser.addHelpOption();
     parser.process(*this);
 
+    if (parser.isSet(CLI_COMPRESSION_THREADS_PARAMETER)) {
+        image::setMaxTextureCompressionThreads(parser.value(CLI_COMPRESSION_THREADS_PARAMETER).toInt());
+    }
+
     if (parser.isSet(CLI_INPUT_PARAMETER) && parser.isSet(CLI_OUTPUT_PARAMETER)) {
         BakerCLI* cli = new BakerCLI(this);
         QUrl inputUrl(QDir::fromNativeSeparators(parser.value(CLI_INPUT_PARAMETER)));
@@ -53,6 +61,14 @@ OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
 
         QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, inputUrl),
                                     Q_ARG(QString, outputUrl.toString()), Q_ARG(QString, type));
+    } else if (parser.isSet(CLI_WORKER_PARAMETER)) {
+        if (parser.isSet(CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER)) {
+            qDebug() << "Disabling texture compression";
+            TextureBaker::setCompressionEnabled(false);
+        }
+
+        BakerCLI* cli = new BakerCLI(this);
+        cli->startWorker();
     } else {
         parser.showHelp();
         QCoreApplication::quit();